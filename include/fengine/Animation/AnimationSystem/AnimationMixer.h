@@ -0,0 +1,308 @@
+/*
+ * Animation mixer header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_ANIMATION_MIXER_H__
+#define __FORK_ANIMATION_MIXER_H__
+
+
+#include "Animation/AnimationSystem/SkeletalAnimation.h"
+#include "Scene/Geometry/FlatSkeleton.h"
+#include "Scene/Geometry/SkeletonPose.h"
+
+#include <vector>
+#include <memory>
+
+
+namespace Fork
+{
+
+namespace Anim
+{
+
+
+DECL_SHR_PTR(AnimationMixer);
+
+/**
+Pose based animation mixer. This is a small blend graph, which samples several skeletal animations (clips)
+into pose buffers and combines them with blend-, cross-fade and additive nodes, optionally with per-joint masks.
+The final pose is written once into a skeleton pose.
+\code
+// Setup (once per character)
+walkAnim->SetupJointIndices(*flatSkeleton);
+runAnim->SetupJointIndices(*flatSkeleton);
+waveAnim->SetupJointIndices(*flatSkeleton);
+
+Anim::AnimationMixer mixer(flatSkeleton);
+auto walk = mixer.AddClipNode(walkAnim.get());
+auto run  = mixer.AddClipNode(runAnim.get());
+auto wave = mixer.AddClipNode(waveAnim.get());
+auto locomotion = mixer.AddBlendNode(walk, run);
+auto upperBody = Anim::AnimationMixer::MakeJointMask(*flatSkeleton, flatSkeleton->FindJoint(spineJoint));
+mixer.AddBlendNode(locomotion, wave, 1.0f, upperBody);
+
+// Cross-fade from walking to running within 0.5 seconds
+mixer.FadeWeight(locomotion, 1.0f, 0.5);
+
+// Per frame
+walkAnim->playback.Update(deltaTime);
+runAnim->playback.Update(deltaTime);
+waveAnim->playback.Update(deltaTime);
+mixer.Update(deltaTime);
+mixer.Evaluate(*pose);
+pose->UpdateMatrices();
+\endcode
+\remarks The pose buffers are pooled inside the mixer, so after the first evaluation no memory is allocated per frame.
+The nodes can only refer to nodes which have been added before, so the graph is always free of cycles.
+\see Scene::SkeletonPose
+\ingroup animation
+*/
+class FORK_EXPORT AnimationMixer
+{
+
+    public:
+
+        //! Invalid node index.
+        static const size_t invalidNode = static_cast<size_t>(-1);
+
+        /**
+        Per-joint weights in the range [0.0 .. 1.0]. The mask weights are multiplied with the node weight.
+        An empty mask has the weight 1.0 for all joints.
+        \see MakeJointMask
+        */
+        typedef std::vector<float> JointMask;
+
+        /**
+        Creates an empty animation mixer for the specified flat skeleton.
+        \throws NullPointerException If 'skeleton' is null.
+        */
+        AnimationMixer(const Scene::FlatSkeletonPtr& skeleton);
+
+        AnimationMixer(const AnimationMixer&) = delete;
+        AnimationMixer& operator = (const AnimationMixer&) = delete;
+
+        /* === Graph construction === */
+
+        /**
+        Adds a clip node, which samples the keyframe joints of the specified skeletal animation.
+        Joints which are not animated by this clip keep their bind pose.
+        \param[in] animation Raw pointer to the skeletal animation. Its joint indices must have been setup for the flat skeleton of this mixer.
+        \param[in] playback Optional raw pointer to the playback, which is used instead of the animation's playback.
+        This can be used to play the same animation with different timings. By default null.
+        If the animation's joint groups are animated, this playback is used for all joint groups.
+        \return Index of the new node.
+        \throws NullPointerException If 'animation' is null.
+        \remarks The playbacks are not updated by the mixer, since several nodes may share the same playback.
+        \see SkeletalAnimation::SetupJointIndices
+        */
+        size_t AddClipNode(const SkeletalAnimation* animation, const Playback* playback = nullptr);
+
+        /**
+        Adds a bind pose node, i.e. a node with the local transformations of the flat skeleton's bind pose.
+        \return Index of the new node.
+        */
+        size_t AddBindPoseNode();
+
+        /**
+        Adds a blend node, which interpolates between the two input poses (linear for positions and scales,
+        normalized linear with shortest path for rotations).
+        \param[in] sourceNode Specifies the input node for the weight 0.0.
+        \param[in] destNode Specifies the input node for the weight 1.0.
+        \param[in] weight Specifies the blend weight. This will be clamped to the range [0.0 .. 1.0]. By default 0.0.
+        \param[in] mask Specifies the optional per-joint mask. By default empty.
+        \return Index of the new node.
+        \throws InvalidArgumentException If an input node or the mask is invalid.
+        \remarks If the weight is 0.0 or 1.0 and the mask is empty, only one input node is evaluated.
+        */
+        size_t AddBlendNode(size_t sourceNode, size_t destNode, float weight = 0.0f, const JointMask& mask = JointMask());
+
+        /**
+        Adds an additive node, which adds the difference between an additive pose and its reference pose
+        to a base pose (e.g. a breathing or leaning layer on top of a locomotion).
+        \param[in] baseNode Specifies the input node of the base pose.
+        \param[in] additiveNode Specifies the input node of the additive pose.
+        \param[in] weight Specifies the layer weight. This will be clamped to the range [0.0 .. 1.0]. By default 1.0.
+        \param[in] mask Specifies the optional per-joint mask. By default empty.
+        \param[in] referenceNode Specifies the input node of the reference pose.
+        If this is 'invalidNode', the bind pose is used as reference. By default invalidNode.
+        \return Index of the new node.
+        \throws InvalidArgumentException If an input node or the mask is invalid.
+        */
+        size_t AddAdditiveNode(
+            size_t baseNode, size_t additiveNode, float weight = 1.0f,
+            const JointMask& mask = JointMask(), size_t referenceNode = invalidNode
+        );
+
+        //! Removes all nodes. The pose buffer pool is kept.
+        void Clear();
+
+        /**
+        Sets the output node, whose pose is written by "Evaluate". By default the most recently added node.
+        \throws InvalidArgumentException If 'node' is invalid.
+        */
+        void SetOutputNode(size_t node);
+
+        //! Returns the output node or 'invalidNode' if the mixer has no nodes.
+        inline size_t GetOutputNode() const
+        {
+            return outputNode_;
+        }
+
+        /* === Weights and masks === */
+
+        /**
+        Sets the weight of the specified blend- or additive node. This stops a previous fade of this node.
+        \throws InvalidArgumentException If 'node' is invalid.
+        */
+        void SetWeight(size_t node, float weight);
+        /**
+        Returns the current weight of the specified node.
+        \throws InvalidArgumentException If 'node' is invalid.
+        */
+        float GetWeight(size_t node) const;
+
+        /**
+        Fades the weight of the specified blend- or additive node linearly to the target weight (e.g. to cross-fade two clips).
+        \param[in] node Specifies the blend- or additive node.
+        \param[in] targetWeight Specifies the final weight. This will be clamped to the range [0.0 .. 1.0].
+        \param[in] duration Specifies the fade duration (in seconds). If this is less than or equal to zero, the weight is set immediately.
+        \throws InvalidArgumentException If 'node' is invalid.
+        \see Update
+        */
+        void FadeWeight(size_t node, float targetWeight, double duration);
+
+        /**
+        Returns true if the weight of the specified node is currently fading.
+        \throws InvalidArgumentException If 'node' is invalid.
+        */
+        bool IsFading(size_t node) const;
+
+        /**
+        Sets the per-joint mask of the specified blend- or additive node.
+        \throws InvalidArgumentException If 'node' or 'mask' is invalid.
+        */
+        void SetMask(size_t node, const JointMask& mask);
+
+        /**
+        Makes a joint mask for the specified joint and all of its descendants (e.g. the upper body of a character).
+        \param[in] skeleton Specifies the flat skeleton.
+        \param[in] rootJoint Specifies the index of the root joint of the masked sub tree.
+        \param[in] weight Specifies the weight for the masked joints. All other joints have the weight 0.0. By default 1.0.
+        \throws InvalidArgumentException If 'rootJoint' is out of range.
+        */
+        static JointMask MakeJointMask(const Scene::FlatSkeleton& skeleton, size_t rootJoint, float weight = 1.0f);
+
+        /* === Evaluation === */
+
+        /**
+        Advances all weight fades.
+        \param[in] deltaTime Specifies the time derivation (in seconds).
+        \see FadeWeight
+        */
+        void Update(double deltaTime = 1.0/60.0);
+
+        /**
+        Evaluates the blend graph and writes the local transformations of the output node into the specified pose.
+        If the mixer has no nodes, the bind pose is written.
+        \remarks The matrices of the pose are not updated, call "Scene::SkeletonPose::UpdateMatrices" afterwards.
+        \throws InvalidArgumentException If the pose does not refer to the flat skeleton of this mixer.
+        */
+        void Evaluate(Scene::SkeletonPose& pose);
+
+        /**
+        Evaluates the blend graph and writes the local transformations of the output node into the specified SoA arrays.
+        The arrays are resized for the number of joints if necessary.
+        */
+        void Evaluate(Scene::SkeletonPose::LocalTransforms& localTransforms);
+
+        /**
+        Evaluates many mixers at once (e.g. a crowd) and updates the pose matrices in parallel (see Jobs::JobSystem).
+        \param[in] mixers Specifies the list of mixers. Null pointers are ignored.
+        \param[in] poses Specifies the list of poses. The pose 'poses[i]' is used for the mixer 'mixers[i]'.
+        \throws InvalidArgumentException If the two lists have different sizes or a pose does not refer to the flat skeleton of its mixer.
+        */
+        static void EvaluatePoses(const std::vector<AnimationMixer*>& mixers, const std::vector<Scene::SkeletonPose*>& poses);
+
+        //! Returns the number of nodes.
+        inline size_t NumNodes() const
+        {
+            return nodes_.size();
+        }
+
+        //! Returns the number of pooled pose buffers. This only grows during the first evaluation of a graph.
+        inline size_t NumPoseBuffers() const
+        {
+            return poseBuffers_.size();
+        }
+
+        //! Returns the flat skeleton of this mixer.
+        inline const Scene::FlatSkeleton* GetSkeleton() const
+        {
+            return skeleton_.get();
+        }
+
+    private:
+
+        typedef Scene::SkeletonPose::LocalTransforms PoseBuffer;
+
+        enum class NodeTypes
+        {
+            Clip,
+            BindPose,
+            Blend,
+            Additive,
+        };
+
+        struct Node
+        {
+            NodeTypes                   type;
+            const SkeletalAnimation*    animation       = nullptr;
+            const Playback*             playback        = nullptr;
+            size_t                      inputs[3];                  //!< Source/dest or base/additive/reference nodes.
+            float                       weight          = 0.0f;
+            float                       targetWeight    = 0.0f;
+            double                      fadeSpeed       = 0.0;      //!< Weight change per second (0.0 if the node is not fading).
+            JointMask                   mask;
+        };
+
+        size_t AddNode(const Node& node);
+
+        Node& GetWeightedNode(const char* procName, size_t node);
+        const Node& GetNode(const char* procName, size_t node) const;
+
+        void ValidateInputNode(const char* procName, const char* paramName, size_t node) const;
+        void ValidateMask(const char* procName, const JointMask& mask) const;
+
+        size_t EvaluateNode(size_t node);
+
+        void SampleClip(const Node& node, PoseBuffer& buffer) const;
+
+        size_t AcquirePoseBuffer();
+        void ReleasePoseBuffer(size_t buffer);
+
+        Scene::FlatSkeletonPtr                  skeleton_;
+
+        PoseBuffer                              bindPose_;
+
+        std::vector<Node>                       nodes_;
+        size_t                                  outputNode_ = invalidNode;
+
+        std::vector<std::unique_ptr<PoseBuffer>> poseBuffers_;
+        std::vector<size_t>                     freePoseBuffers_;
+
+};
+
+
+} // /namespace Anim
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
@@ -1,6 +1,6 @@
 /*
  * Morph-target animation header
- * 
+ *
  * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
  * See "LICENSE.txt" for license information.
  */
@@ -11,6 +11,12 @@
 
 #include "Animation/AnimationSystem/Animation.h"
 #include "Scene/Geometry/Node/MeshGeometry.h"
+#include "Video/BufferFormat/AttributeIterator.h"
+#include "Core/Exception/InvalidArgumentException.h"
+#include "Math/Core/Vector4.h"
+
+#include <string>
+#include <vector>
 
 
 namespace Fork
@@ -23,29 +29,251 @@ namespace Anim
 DECL_SHR_PTR(MorphTargetAnimation);
 
 /**
-Morph-target animation implementation.
+Morph-target animation implementation. Each morph target (or 'blend shape') stores sparse per-vertex deltas
+(vertex index plus position- and normal delta), which are accumulated with their weights onto the base mesh.
+\code
+// Setup
+auto morphAnim = std::make_shared<Anim::MorphTargetAnimation>();
+morphAnim->SetupVertexStream(*headMesh);
+auto smile = morphAnim->AddTarget("Smile", smileIndices, smilePositionDeltas, smileNormalDeltas);
+
+// Per frame (either with weight keyframes and the playback, or with manual weights)
+morphAnim->GetTarget(smile).weight = 0.5f;
+morphAnim->Update(deltaTime);
+\endcode
+\remarks Targets with zero weight are skipped, and only the vertex ranges which have been modified are re-uploaded to the vertex buffer.
 \ingroup animation
-\todo Incomplete
 */
 class FORK_EXPORT MorphTargetAnimation : public Animation
 {
 
     public:
-        
+
+        //! Invalid attribute offset. This can be used for vertex streams without normals.
+        static const size_t invalidOffset = static_cast<size_t>(-1);
+
+        //! Morph target class.
+        class FORK_EXPORT Target
+        {
+
+            public:
+
+                //! Returns the sorted list of vertex indices.
+                inline const std::vector<unsigned int>& GetIndices() const
+                {
+                    return indices_;
+                }
+
+                //! Returns the position deltas. The 'w' component is always 0 (it's only used as padding for SIMD).
+                inline const std::vector<Math::Vector4f>& GetPositionDeltas() const
+                {
+                    return positionDeltas_;
+                }
+
+                //! Returns the normal deltas. This is empty if the target has no normal deltas.
+                inline const std::vector<Math::Vector4f>& GetNormalDeltas() const
+                {
+                    return normalDeltas_;
+                }
+
+                //! Name of this morph target.
+                std::string         name;
+
+                //! Current weight. If the weight keyframes are not empty, this is overwritten by "Update". By default 0.0.
+                float               weight = 0.0f;
+
+                /**
+                Optional weight keyframes (one weight per frame). These are interpolated with the playback in "Update".
+                \see Update
+                */
+                std::vector<float>  weightKeyframes;
+
+            private:
+
+                friend class MorphTargetAnimation;
+
+                std::vector<unsigned int>   indices_;
+                std::vector<Math::Vector4f> positionDeltas_;
+                std::vector<Math::Vector4f> normalDeltas_;
+
+                float                       appliedWeight_ = 0.0f;  //!< Weight which has been applied to the vertex stream.
+
+        };
+
+        //! Vertex range structure (e.g. a dirty range of the vertex stream).
+        struct VertexRange
+        {
+            size_t first;   //!< First vertex index.
+            size_t count;   //!< Number of vertices.
+        };
+
         Types Type() const override;
 
         /**
-        Updates the playback and transforms the mesh geometry.
-        \todo Not yet implemented!
+        Updates the playback, interpolates the weight keyframes of all targets, applies the targets to the vertex stream
+        and re-uploads the dirty vertex ranges to the hardware vertex buffer of the geometry (if the geometry and its vertex buffer exist).
+        If any vertex has been modified, the bounding volume of the geometry is recomputed as well (see updateBoundingVolume).
+        \see Apply
+        \see geometry
         */
         void Update(double deltaTime = 1.0/60.0) override;
 
         /**
-        Mesh geometry reference.
+        Sets up the vertex stream, the morph targets are applied to. The current vertex positions and normals are stored as base mesh.
+        \param[in,out] vertexData Raw pointer to the first vertex. The vertex data must stay valid as long as it is used by this animation.
+        \param[in] numVertices Specifies the number of vertices.
+        \param[in] stride Specifies the stride (in bytes) between two vertices.
+        \param[in] positionOffset Specifies the offset (in bytes) of the position attribute (Math::Vector3f) inside each vertex.
+        \param[in] normalOffset Specifies the offset (in bytes) of the normal attribute (Math::Vector3f) inside each vertex.
+        If this is 'invalidOffset', the normal deltas are ignored. By default invalidOffset.
+        \throws NullPointerException If 'vertexData' is null.
+        \throws InvalidArgumentException If 'numVertices' or 'stride' is zero or a target refers to a vertex out of range.
+        */
+        void SetupVertexStream(
+            void* vertexData, size_t numVertices, size_t stride,
+            size_t positionOffset, size_t normalOffset = invalidOffset
+        );
+
+        /**
+        Sets up the vertex stream with the vertices of the specified mesh geometry.
+        This also sets the 'geometry' member to the specified mesh.
+        \tparam MeshT Specifies the mesh geometry type. This must be a Scene::BaseMeshGeometry (e.g. Scene::Simple3DMeshGeometry),
+        whose vertex type has the 'coord' and 'normal' attributes.
+        \remarks The vertex list of the mesh must not be resized afterwards.
+        \throws InvalidArgumentException If the mesh has no vertices.
+        */
+        template <class MeshT> void SetupVertexStream(MeshT& mesh)
+        {
+            if (mesh.vertices.empty())
+                throw InvalidArgumentException(__FUNCTION__, "mesh", "Mesh must have at least one vertex");
+
+            auto vertexData = reinterpret_cast<char*>(mesh.vertices.data());
+
+            SetupVertexStream(
+                vertexData, mesh.vertices.size(), sizeof(mesh.vertices[0]),
+                static_cast<size_t>(reinterpret_cast<char*>(&(mesh.vertices[0].coord)) - vertexData),
+                static_cast<size_t>(reinterpret_cast<char*>(&(mesh.vertices[0].normal)) - vertexData)
+            );
+
+            geometry = &mesh;
+        }
+
+        /**
+        Adds a new morph target with sparse deltas.
+        \param[in] name Specifies the target name.
+        \param[in] indices Specifies the vertex indices. Each vertex must only occur once.
+        \param[in] positionDeltas Specifies the position deltas. This must have the same size as 'indices'.
+        \param[in] normalDeltas Specifies the optional normal deltas. This must be empty or have the same size as 'indices'.
+        \return Index of the new target.
+        \throws InvalidArgumentException If the lists have different sizes, or a vertex index occurs twice or is out of range of the vertex stream.
+        */
+        size_t AddTarget(
+            const std::string& name,
+            const std::vector<unsigned int>& indices,
+            const std::vector<Math::Vector3f>& positionDeltas,
+            const std::vector<Math::Vector3f>& normalDeltas = std::vector<Math::Vector3f>()
+        );
+
+        /**
+        Adds a new morph target out of a complete target mesh (e.g. an imported blend shape).
+        Only the vertices which differ from the base mesh are stored.
+        \param[in] name Specifies the target name.
+        \param[in] positions Specifies the target mesh positions. This must have as many attributes as the vertex stream.
+        \param[in] normals Optional pointer to the target mesh normals. By default null.
+        \param[in] threshold Specifies the minimal delta (for each component) which is stored. By default 0.00001.
+        \return Index of the new target.
+        \throws InvalidStateException If the vertex stream has not been setup.
+        \throws InvalidArgumentException If the number of attributes does not match the vertex stream.
+        \see SetupVertexStream
+        */
+        size_t AddTarget(
+            const std::string& name,
+            const Video::AttributeConstIterator& positions,
+            const Video::AttributeConstIterator* normals = nullptr,
+            float threshold = 0.00001f
+        );
+
+        /**
+        Removes all morph targets. The vertices which have been modified by the targets are reset to the base mesh,
+        and re-uploaded to the hardware vertex buffer of the geometry (if the geometry and its vertex buffer exist).
+        Afterwards "GetDirtyRanges" returns the vertex ranges which have been reset.
+        */
+        void ClearTargets();
+
+        /**
+        Applies all morph targets with their current weights to the vertex stream.
+        Only the vertices of targets, whose weight is non-zero or has been non-zero at the previous call, are modified.
+        If no weight has changed since the previous call, this returns immediately.
+        \return True if any vertex has been modified. In this case "GetDirtyRanges" returns the modified vertex ranges.
+        \throws InvalidStateException If the vertex stream has not been setup.
+        \see GetDirtyRanges
+        */
+        bool Apply();
+
+        //! Returns the specified target. \throws IndexOutOfBoundsException If 'index' is out of range.
+        Target& GetTarget(size_t index);
+        //! Returns the specified target. \throws IndexOutOfBoundsException If 'index' is out of range.
+        const Target& GetTarget(size_t index) const;
+
+        //! Returns the number of morph targets.
+        inline size_t NumTargets() const
+        {
+            return targets_.size();
+        }
+
+        /**
+        Returns the vertex ranges which have been modified by the previous call to "Apply" (sorted and non-overlapping).
+        \see Apply
+        */
+        inline const std::vector<VertexRange>& GetDirtyRanges() const
+        {
+            return dirtyRanges_;
+        }
+
+        /**
+        Mesh geometry reference. If this is not null, the dirty vertex ranges are re-uploaded in "Update".
         \note This is just a raw pointer since an animation must not own a geometry.
         */
         Scene::MeshGeometry* geometry = nullptr;
 
+        /**
+        Specifies the maximal gap (in vertices) between two dirty ranges, which are merged into a single range
+        to reduce the number of buffer uploads. By default 64.
+        */
+        size_t mergeRangeGap = 64;
+
+        /**
+        Specifies whether the bounding volume of the geometry is recomputed in "Update", after its vertices have been modified.
+        This iterates over all vertices of the geometry. The bounding volumes of its parent geometries (e.g. a composition geometry)
+        are not updated. By default true.
+        */
+        bool updateBoundingVolume = true;
+
+    private:
+
+        void ValidateTarget(const Target& target) const;
+        void SampleWeights();
+        void MergeDirtyRanges();
+        void UploadDirtyRanges();
+
+        char*                       vertexData_     = nullptr;
+        size_t                      numVertices_    = 0;
+        size_t                      stride_         = 0;
+        size_t                      positionOffset_ = 0;
+        size_t                      normalOffset_   = invalidOffset;
+
+        std::vector<Target>         targets_;
+
+        std::vector<Math::Vector4f> basePositions_;
+        std::vector<Math::Vector4f> baseNormals_;
+        std::vector<Math::Vector4f> positionAccum_;
+        std::vector<Math::Vector4f> normalAccum_;
+
+        std::vector<unsigned int>   vertexStamps_;      //!< Apply counter of the last modification for each vertex.
+        unsigned int                applyCounter_ = 0;
+        std::vector<unsigned int>   dirtyVertices_;
+        std::vector<VertexRange>    dirtyRanges_;
+
 };
 
 
@@ -58,4 +286,4 @@ class FORK_EXPORT MorphTargetAnimation : public Animation
 
 
 
-// ========================
\ No newline at end of file
+// ========================
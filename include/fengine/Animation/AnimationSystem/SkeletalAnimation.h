@@ -12,6 +12,7 @@
 #include "Animation/AnimationSystem/Animation.h"
 #include "Animation/Core/KeyframeSequence.h"
 #include "Scene/Geometry/Skeleton.h"
+#include "Scene/Geometry/SkeletonPose.h"
 
 #include <string>
 #include <vector>
@@ -55,18 +56,52 @@ class FORK_EXPORT SkeletalAnimation : public Animation
                 */
                 static void Update(std::vector<KeyframeJoint>& keyframeJoints, const Playback& playback);
 
+                /**
+                Updates the interpolation of all keyframe joints and stores the local transformations in the specified pose,
+                instead of the joint transformations. Keyframe joints without a valid joint index are ignored.
+                \see SetupJointIndex
+                */
+                static void Update(const std::vector<KeyframeJoint>& keyframeJoints, const Playback& playback, Scene::SkeletonPose& pose);
+
+                /**
+                Updates the interpolation of all keyframe joints and stores the local transformations in the specified SoA arrays
+                (e.g. a pose buffer of an animation mixer). Keyframe joints without a valid joint index are ignored.
+                \param[in] numJoints Specifies the number of joints in the SoA arrays.
+                \see SetupJointIndex
+                */
+                static void Update(
+                    const std::vector<KeyframeJoint>& keyframeJoints, const Playback& playback,
+                    Scene::SkeletonPose::LocalTransforms& localTransforms, size_t numJoints
+                );
+
+                /**
+                Sets up the index of the joint inside the specified flat skeleton.
+                \see Scene::FlatSkeleton::FindJoint
+                */
+                void SetupJointIndex(const Scene::FlatSkeleton& flatSkeleton);
+
                 //! Returns the joint reference.
                 inline Joint* GetJoint() const
                 {
                     return joint_;
                 }
 
+                /**
+                Returns the index of the joint inside a flat skeleton or Scene::FlatSkeleton::invalidIndex if the index has not been setup.
+                \see SetupJointIndex
+                */
+                inline size_t GetJointIndex() const
+                {
+                    return jointIndex_;
+                }
+
                 //! Animation keyframe sequence for this joint.
                 KeyframeSequence keyframeSequence;
 
             private:
                 
-                Joint* joint_ = nullptr; //!< Reference to the joint node.
+                Joint*  joint_      = nullptr;                              //!< Reference to the joint node.
+                size_t  jointIndex_ = Scene::FlatSkeleton::invalidIndex;    //!< Index of the joint inside a flat skeleton.
 
         };
 
@@ -97,6 +132,37 @@ class FORK_EXPORT SkeletalAnimation : public Animation
         */
         void Update(double deltaTime = 1.0/60.0) override;
 
+        /**
+        Sets up the joint indices of all keyframe joints (including those of the joint groups) for the specified flat skeleton.
+        This must be called once, before "UpdatePose" or "UpdatePoses" is used with poses of this flat skeleton.
+        \see KeyframeJoint::SetupJointIndex
+        */
+        void SetupJointIndices(const Scene::FlatSkeleton& flatSkeleton);
+
+        /**
+        Updates the playback and stores the interpolated keyframe joints in the specified pose,
+        instead of the joint transformations of the skeleton. This is the data-oriented counterpart of "Update".
+        \remarks The matrices of the pose are not updated, call "Scene::SkeletonPose::UpdateMatrices" afterwards.
+        \see SetupJointIndices
+        */
+        void UpdatePose(Scene::SkeletonPose& pose, double deltaTime = 1.0/60.0);
+
+        /**
+        Updates many animated characters at once (e.g. a crowd). The playbacks are updated on the calling thread
+        (so the playback event handlers do not need to be thread-safe), then each animation is sampled into
+        its pose and the pose matrices are updated in parallel (see Jobs::JobSystem).
+        \param[in] animations Specifies the list of animations. Null pointers are ignored.
+        \param[in] poses Specifies the list of poses. The pose 'poses[i]' is used for the animation 'animations[i]'.
+        \param[in] deltaTime Specifies the time derivation for the playbacks.
+        \throws InvalidArgumentException If the two lists have different sizes.
+        \see UpdatePose
+        */
+        static void UpdatePoses(
+            const std::vector<SkeletalAnimation*>& animations,
+            const std::vector<Scene::SkeletonPose*>& poses,
+            double deltaTime = 1.0/60.0
+        );
+
         //! Returns the mesh skeleton.
         inline Scene::Skeleton* GetSkeleton() const
         {
@@ -117,6 +183,9 @@ class FORK_EXPORT SkeletalAnimation : public Animation
 
     private:
         
+        void UpdatePlaybacks(double deltaTime);
+        void SamplePose(Scene::SkeletonPose& pose) const;
+
         Scene::SkeletonPtr skeleton_;
 
 };
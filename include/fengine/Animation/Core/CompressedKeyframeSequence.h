@@ -0,0 +1,205 @@
+/*
+ * Compressed keyframe sequence header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_COMPRESSED_KEYFRAME_SEQUENCE_H__
+#define __FORK_COMPRESSED_KEYFRAME_SEQUENCE_H__
+
+
+#include "Core/Export.h"
+#include "Math/Core/Vector3.h"
+#include "Math/Core/Quaternion.h"
+#include "Math/Core/Transform3D.h"
+
+#include <vector>
+
+
+namespace Fork
+{
+
+namespace Anim
+{
+
+
+class KeyframeSequence;
+
+/**
+Compressed animation keyframe sequence. In contrast to the dense keyframe list of a KeyframeSequence
+(one full transformation per frame), this class only stores the sparse keys of each track:
+positions and scales are quantized to 16 bits per component (relative to the bounding box of the track),
+and rotations are quantized with the "smallest three" method to 48 bits per quaternion.
+Keys which can be reconstructed by interpolating their neighbors (within a specified error tolerance) are removed.
+\remarks The tracks can be sampled at arbitrary (fractional) frames, and this class has no mutable state,
+i.e. a single sequence can be sampled from several threads at the same time.
+\see KeyframeSequence::CompressKeyframes
+\ingroup animation
+*/
+class FORK_EXPORT CompressedKeyframeSequence
+{
+
+    public:
+
+        //! Compression description structure.
+        struct Description
+        {
+            /**
+            Maximal position error for the key reduction. Keys whose interpolated (and quantized)
+            position differs less than this tolerance from their original position are removed. By default 0.0001.
+            \remarks The quantization step is the extent of the track's bounding box divided by 65535,
+            so the error of a track which moves far (e.g. the root joint) may be up to half this step.
+            */
+            float positionTolerance = 0.0001f;
+            //! Maximal rotation error (in radians) for the key reduction. By default 0.0001.
+            float rotationTolerance = 0.0001f;
+            //! Maximal scale error for the key reduction. By default 0.0001.
+            float scaleTolerance    = 0.0001f;
+        };
+
+        /**
+        Sampling cursor structure. This stores the last key index of each track, so that successive
+        samples with (nearly) increasing or decreasing frames do not need a binary search.
+        A cursor must only be used with one sequence at a time, but it can be owned by the caller (e.g. one per thread).
+        */
+        struct Cursor
+        {
+            size_t positionKey  = 0; //!< Last position key index.
+            size_t rotationKey  = 0; //!< Last rotation key index.
+            size_t scaleKey     = 0; //!< Last scale key index.
+        };
+
+        /**
+        Compresses the sub keyframe lists of the specified keyframe sequence.
+        \param[in] keyframeSequence Specifies the keyframe sequence whose position-, rotation- and scale keyframes are to be compressed.
+        The keys do not need to be sorted. The dense keyframe list of this sequence is not required.
+        \param[in] desc Specifies the compression description.
+        \remarks Before the first key and after the last key of a track, the track is clamped (just like KeyframeSequence::BuildKeyframes).
+        Empty tracks result in the identity (i.e. position 0, no rotation and scale 1).
+        */
+        void Compress(const KeyframeSequence& keyframeSequence, const Description& desc);
+
+        //! Releases all compressed tracks.
+        void Clear();
+
+        /**
+        Samples the compressed tracks at the specified frame.
+        \param[out] transform Specifies the resulting 3D transformation.
+        \param[in] frame Specifies the (fractional) frame. This may also be outside the range [0 .. NumFrames()).
+        \remarks This uses a binary search to find the keys of each track.
+        */
+        void Sample(Math::Transform3Df& transform, float frame) const;
+        /**
+        Samples the compressed tracks at the specified frame and updates the specified cursor.
+        \remarks This is the fastest way to sample a sequence during playback, since the next keys are
+        mostly the same or the neighbors of the previous keys.
+        \see Sample(Math::Transform3Df&, float)
+        */
+        void Sample(Math::Transform3Df& transform, float frame, Cursor& cursor) const;
+
+        /**
+        Interpolates the keyframes with the specified frame and interpolator.
+        This has the same interface as KeyframeSequence::Interpolate.
+        \remarks If 'frameFrom' and 'frameTo' are neighbors, the tracks are sampled only once
+        at the fractional frame between them, otherwise the two frames are sampled and interpolated.
+        \see KeyframeSequence::Interpolate
+        */
+        void Interpolate(Math::Transform3Df& transform, size_t frameFrom, size_t frameTo, float interpolator) const;
+
+        //! Returns the number of keys of all tracks.
+        size_t NumKeys() const;
+
+        //! Returns the memory usage (in bytes) of all tracks.
+        size_t MemoryUsage() const;
+
+        /**
+        Returns the number of frames. This is the last frame index of the source keyframe sequence plus one,
+        i.e. the same number of frames a dense keyframe list would have.
+        */
+        inline size_t NumFrames() const
+        {
+            return numFrames_;
+        }
+
+        //! Returns true if this sequence has no tracks.
+        inline bool Empty() const
+        {
+            return numFrames_ == 0;
+        }
+
+    private:
+
+        //! 16-bit quantized 3D vector (relative to the bounding box of its track).
+        struct QuantizedVector
+        {
+            unsigned short components[3];
+        };
+
+        /**
+        48-bit "smallest three" quantized quaternion. The three smallest components are stored with 15 bits each,
+        the index of the largest component is stored in the highest bits of the first two components.
+        */
+        struct QuantizedQuaternion
+        {
+            unsigned short components[3];
+        };
+
+        //! Position or scale track.
+        struct VectorTrack
+        {
+            void Clear();
+
+            QuantizedVector Quantize(const Math::Vector3f& vector) const;
+            Math::Vector3f Dequantize(const QuantizedVector& key) const;
+
+            Math::Vector3f Sample(float frame, size_t& key) const;
+
+            std::vector<unsigned int>       frames;
+            std::vector<QuantizedVector>    keys;
+            Math::Vector3f                  offset;     //!< Minimum of the bounding box.
+            Math::Vector3f                  scale;      //!< Extent of the bounding box divided by the quantization range.
+        };
+
+        //! Rotation track.
+        struct RotationTrack
+        {
+            void Clear();
+
+            static QuantizedQuaternion Quantize(const Math::Quaternionf& rotation);
+            static Math::Quaternionf Dequantize(const QuantizedQuaternion& key);
+
+            Math::Quaternionf Sample(float frame, size_t& key) const;
+
+            std::vector<unsigned int>           frames;
+            std::vector<QuantizedQuaternion>    keys;
+        };
+
+        static void CompressVectorTrack(
+            VectorTrack& track, const std::vector<unsigned int>& frames, const std::vector<Math::Vector3f>& vectors, float tolerance
+        );
+        static void CompressRotationTrack(
+            RotationTrack& track, const std::vector<unsigned int>& frames, const std::vector<Math::Quaternionf>& rotations, float tolerance
+        );
+
+        void SampleTracks(Math::Transform3Df& transform, float frame, Cursor& cursor) const;
+
+        VectorTrack     positionTrack_;
+        RotationTrack   rotationTrack_;
+        VectorTrack     scaleTrack_;
+
+        size_t          numFrames_ = 0;
+
+};
+
+
+} // /namespace Anim
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
@@ -14,6 +14,7 @@
 #include "Math/Core/Quaternion.h"
 #include "Math/Core/Transform3D.h"
 #include "Animation/Core/Playback.h"
+#include "Animation/Core/CompressedKeyframeSequence.h"
 #include "IO/FileSystem/File.h"
 
 #include <vector>
@@ -105,6 +106,28 @@ class FORK_EXPORT KeyframeSequence
         */
         void BuildKeyframes(bool clampEdges = true);
 
+        /**
+        Builds the compressed keyframe tracks out of the three keyframe sub lists and releases the dense keyframe list.
+        Afterwards "Interpolate" samples the compressed tracks instead of the dense keyframe list.
+        \param[in] desc Specifies the compression description, i.e. the error tolerances for the key reduction.
+        \param[in] releaseSubKeyframes Specifies whether the three keyframe sub lists are to be released as well. By default true.
+        Only then the sequence takes a small fraction of the memory for long animations (e.g. motion capture clips),
+        because the sub lists of such clips store one key per frame, too.
+        \remarks Call "BuildKeyframes" to switch back to the dense keyframe list. This requires that the sub lists have not been released.
+        \code
+        seq.AddTransform(0, transformA);
+        seq.AddTransform(1000, transformB);
+        // Stores only two keys per track instead of 1001 baked transformations.
+        seq.CompressKeyframes();
+        \endcode
+        \see CompressedKeyframeSequence
+        \see BuildKeyframes
+        */
+        void CompressKeyframes(
+            const CompressedKeyframeSequence::Description& desc = CompressedKeyframeSequence::Description(),
+            bool releaseSubKeyframes = true
+        );
+
         /**
         Returns the first frame index.
         \note This may take a little time because all three keyframe lists
@@ -126,9 +149,20 @@ class FORK_EXPORT KeyframeSequence
         \param[in] interpolator Specifies the frame interpolator. This should be in the range [0.0 .. 1.0].
         This will be used to interpolate between the two frames specified by 'frameFrom' and 'frameTo'.
         \remarks If 'frameFrom' or 'frameTo' is out of range, the resulting transformation 'transform' will not be modified.
+        \remarks If the keyframes have been compressed, the compressed tracks are sampled instead of the dense keyframe list.
+        \see CompressKeyframes
         */
         void Interpolate(Math::Transform3Df& transform, size_t frameFrom, size_t frameTo, float interpolator) const;
 
+        /**
+        Samples the keyframes at the specified (fractional) frame.
+        \param[out] transform Specifies the resulting 3D transformation.
+        \param[in] frame Specifies the frame. This is clamped to the range [0 .. number-of-keyframes - 1].
+        \remarks This is equivalent to interpolating the two frames around the specified frame.
+        \see Interpolate
+        */
+        void Sample(Math::Transform3Df& transform, float frame) const;
+
         /**
         Writes the entire keyframe sequence to the specified file.
         \see ReadFromFile
@@ -164,6 +198,22 @@ class FORK_EXPORT KeyframeSequence
             return keyframes_;
         }
 
+        /**
+        Returns the compressed keyframe tracks. Call "CompressKeyframes" to build the compressed tracks
+        out of the other three keyframe sub lists ('positionKeyframes', 'rotationKeyframes' and 'scaleKeyframes').
+        \see CompressKeyframes
+        */
+        inline const CompressedKeyframeSequence& GetCompressedKeyframes() const
+        {
+            return compressedKeyframes_;
+        }
+
+        //! Returns true if the keyframes have been compressed. \see CompressKeyframes
+        inline bool IsCompressed() const
+        {
+            return !compressedKeyframes_.Empty();
+        }
+
         //! Position keyframe list.
         std::vector<VectorKeyframe>     positionKeyframes;
 
@@ -176,6 +226,7 @@ class FORK_EXPORT KeyframeSequence
     private:
         
         std::vector<Math::Transform3Df> keyframes_;
+        CompressedKeyframeSequence      compressedKeyframes_;
 
 };
 
@@ -25,30 +25,76 @@ DECL_SHR_PTR(IdentityFactory);
 /**
 This class will generate uniquely identity numbers.
 The minimal ID number will be 1 and 0 is the only invalid ID number.
+\remarks Each ID is composed of a slot index (lower 'indexBits' bits) and a generation counter (upper 'generationBits' bits).
+Released slots are recycled in constant time via a free list and their generation counter is incremented,
+so that stale IDs (i.e. IDs which have already been released) can be detected with "IsAlive".
+Freshly generated IDs (which do not recycle a released slot) are always 1, 2, 3, etc.
 */
 class FORK_EXPORT IdentityFactory
 {
     
     public:
         
+        //! Number of bits for the slot index. This limits the number of simultaneously used IDs to 2^24 - 1.
+        static const unsigned int indexBits = 24;
+        //! Number of bits for the generation counter.
+        static const unsigned int generationBits = 8;
+
         IdentityFactory() = default;
 
         IdentityFactory(const IdentityFactory&) = delete;
         IdentityFactory& operator = (const IdentityFactory&) = delete;
 
+        /**
+        Returns true if the specified ID is currently in use, i.e. it has been generated by this factory and has not been released yet.
+        \remarks This will return false for stale IDs, whose slot has already been recycled for another object.
+        */
+        bool IsAlive(const Identifiable::IDType& id) const;
+
+        //! Returns the number of IDs which are currently in use.
+        inline size_t NumActiveIDs() const
+        {
+            return slots_.size() - freeSlots_.size();
+        }
+
+        //! Returns the slot index of the specified ID.
+        static inline Identifiable::IDType IDIndex(const Identifiable::IDType& id)
+        {
+            return id & ((1u << IdentityFactory::indexBits) - 1);
+        }
+        //! Returns the generation counter of the specified ID.
+        static inline Identifiable::IDType IDGeneration(const Identifiable::IDType& id)
+        {
+            return id >> IdentityFactory::indexBits;
+        }
+
     protected:
         
         friend class Identifiable;
 
-        //! Generates a new ID.
+        /**
+        Generates a new ID.
+        \throws InvalidStateException If all slots are in use.
+        */
         Identifiable::IDType GenerateID();
-        //! Releases the specified ID.
+        //! Releases the specified ID. Stale or invalid IDs are ignored.
         void ReleaseID(const Identifiable::IDType& id);
 
     private:
         
-        //! Container for all ID numbers.
-        std::vector<Identifiable::IDType> idList_;
+        struct Slot
+        {
+            unsigned char   generation  = 0;
+            bool            used        = false;
+        };
+
+        /**
+        Slot list. The ID with slot index i is stored at slots_[i - 1],
+        because the slot index 0 is reserved for the invalid ID.
+        */
+        std::vector<Slot>                   slots_;
+        //! Stack of released slot indices, which will be recycled first.
+        std::vector<Identifiable::IDType>   freeSlots_;
 
 };
 
@@ -60,4 +106,4 @@ class FORK_EXPORT IdentityFactory
 
 
 
-// ========================
\ No newline at end of file
+// ========================
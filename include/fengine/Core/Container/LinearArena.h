@@ -0,0 +1,98 @@
+/*
+ * Linear arena header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_LINEAR_ARENA_H__
+#define __FORK_LINEAR_ARENA_H__
+
+
+#include "Core/Export.h"
+
+#include <vector>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+
+namespace Fork
+{
+
+
+/**
+Linear memory arena (also called "bump allocator"). Allocations are only pointer increments,
+and all allocations are released at once with "Reset", e.g. once per frame.
+\remarks The memory blocks are kept after a reset. If several blocks were used in the previous cycle,
+they are merged into a single block, so that after a few cycles all allocations fit into one block.
+\note Destructors of objects allocated with "New" are never called,
+so only use this for trivially destructible types (e.g. plain structures).
+*/
+class FORK_EXPORT LinearArena
+{
+
+    public:
+
+        /**
+        Linear arena constructor.
+        \param[in] blockSize Specifies the initial block size (in bytes). By default 64 KB.
+        */
+        LinearArena(size_t blockSize = 65536);
+
+        LinearArena(const LinearArena&) = delete;
+        LinearArena& operator = (const LinearArena&) = delete;
+
+        /* === Functions === */
+
+        /**
+        Allocates the specified amount of memory.
+        \param[in] size Specifies the size (in bytes) of the memory which is to be allocated.
+        \param[in] alignment Specifies the memory alignment. This must be a power of two. By default 16.
+        \return Raw-pointer to the allocated memory. This is valid until the next call to "Reset".
+        */
+        void* Allocate(size_t size, size_t alignment = 16);
+
+        //! Allocates and constructs a new object of type T.
+        template <class T, class... Args> T* New(Args&&... args)
+        {
+            return new (Allocate(sizeof(T), std::alignment_of<T>::value)) T(std::forward<Args>(args)...);
+        }
+
+        //! Releases all allocations at once. The memory blocks are kept for the next cycle.
+        void Reset();
+
+        //! Returns the number of bytes, which have been allocated since the last reset (including alignment padding).
+        inline size_t Size() const
+        {
+            return size_;
+        }
+
+        //! Returns the number of bytes of all memory blocks.
+        size_t Capacity() const;
+
+    private:
+
+        typedef std::vector<char> Block;
+
+        void AppendBlock(size_t minSize);
+
+        std::vector<Block>  blocks_;
+
+        size_t              blockSize_  = 0;    //!< Minimal size for new blocks.
+        size_t              blockIndex_ = 0;    //!< Index of the current block.
+        size_t              offset_     = 0;    //!< Offset within the current block.
+        size_t              size_       = 0;    //!< Allocated size since the last reset.
+
+};
+
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
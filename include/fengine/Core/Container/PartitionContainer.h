@@ -15,6 +15,7 @@
 #include <vector>
 #include <map>
 #include <algorithm>
+#include <iterator>
 
 
 namespace Fork
@@ -24,12 +25,24 @@ namespace Fork
 /**
 The partition container is used to store several independent buffers in one single buffer.
 The "Video::PrimitiveRenderer" for instance stores all font-vertex-buffers in a single one.
+\remarks There are two allocation modes:
+- AllocationModes::Compact: The buffer is always compact, i.e. removing or resizing a partition moves all subsequent partitions.
+- AllocationModes::FreeList: Removed ranges are kept in a free list and re-used with a best-fit strategy.
+Partitions never move, unless "Resize" has to relocate a partition or "Defragment" is called explicitly.
+\see AllocationModes
 */
 template <typename Key> class PartitionContainer
 {
 
     public:
         
+        //! Partition allocation modes.
+        enum class AllocationModes
+        {
+            Compact,    //!< Keeps the buffer compact. Removing a partition moves all subsequent partitions.
+            FreeList,   //!< Keeps a best-fit free list. Removing a partition leaves a hole, which can be re-used.
+        };
+
         //! Partition meta data class.
         class Partition
         {
@@ -69,8 +82,22 @@ template <typename Key> class PartitionContainer
 
         };
 
+        //! Relocation record of a partition, which has been moved by "Defragment".
+        struct Relocation
+        {
+            Key     key;        //!< Key of the moved partition.
+            size_t  oldOffset;  //!< Offset (in bytes) before the partition was moved.
+            size_t  newOffset;  //!< Offset (in bytes) after the partition was moved.
+            size_t  size;       //!< Size (in bytes) of the moved partition.
+        };
+
         typedef std::map<Key, Partition> PartitionListType;
 
+        PartitionContainer(const AllocationModes mode = AllocationModes::Compact) :
+            mode_{ mode }
+        {
+        }
+
         /**
         Adds a new partition to the container.
         \param[in] key Specifies the partition key.
@@ -91,13 +118,11 @@ template <typename Key> class PartitionContainer
             if (it != partitions_.end())
                 throw PartitionContainerException(__FUNCTION__, "Partition already exists");
 
-            /* Append partition to the hash-map */
-            Partition partition(buffer_.size(), size);
+            /* Allocate range and append partition to the hash-map */
+            Partition partition(AllocateRange(size), size);
             partitions_[key] = partition;
 
             /* Update buffer */
-            buffer_.resize(buffer_.size() + size);
-
             if (data)
             {
                 auto byteAlignedData = reinterpret_cast<const char*>(data);
@@ -122,29 +147,150 @@ template <typename Key> class PartitionContainer
             /* Remove partition from the hash-map */
             const auto partitionToRemove = it->second;
 
-            if (buffer_.size() < partitionToRemove.GetSize())
+            if (buffer_.size() < partitionToRemove.GetOffset() + partitionToRemove.GetSize())
                 throw PartitionContainerException(__FUNCTION__, "Partition to remove is larger than the entire buffer");
 
             partitions_.erase(it);
 
-            /* Copy subsequent partitions to the removed place */
-            auto dest = buffer_.begin() + partitionToRemove.GetOffset();
-            auto destEnd = buffer_.end() - partitionToRemove.GetSize();
+            ReleaseRange(partitionToRemove.GetOffset(), partitionToRemove.GetSize());
+        }
 
-            auto src = buffer_.begin() + partitionToRemove.GetOffset() + partitionToRemove.GetSize();
+        /**
+        Resizes the specified partition. The data of the partition is kept (up to the minimum of the old and new size).
+        \param[in] key Specifies the partition which is to be resized.
+        \param[in] newSize Specifies the new partition size (in bytes).
+        \return The resized partition. In free-list mode, the partition might have been relocated.
+        In compact mode, all subsequent partitions are moved.
+        \throws PartitionContainerException If the new size is zero.
+        \throws PartitionContainerException If the partition does not exist.
+        */
+        Partition Resize(const Key& key, const size_t newSize)
+        {
+            if (!newSize)
+                throw PartitionContainerException(__FUNCTION__, "Invalid size for partition");
+
+            /* Find partition */
+            auto it = partitions_.find(key);
+            if (it == partitions_.end())
+                throw PartitionContainerException(__FUNCTION__, "Partition does not exist");
 
-            for (; dest != destEnd; ++dest, ++src)
-                *dest = *src;
+            auto& partition = it->second;
 
-            /* Update subsequent partition offsets */
-            for (auto it : partitions_)
+            const auto offset   = partition.GetOffset();
+            const auto oldSize  = partition.GetSize();
+            const auto end      = offset + oldSize;
+
+            if (newSize == oldSize)
+                return partition;
+
+            if (mode_ == AllocationModes::Compact)
+            {
+                /* Insert or erase bytes at the end of the partition */
+                if (newSize > oldSize)
+                    buffer_.insert(buffer_.begin() + end, newSize - oldSize, 0);
+                else
+                    buffer_.erase(buffer_.begin() + offset + newSize, buffer_.begin() + end);
+
+                /* Update subsequent partition offsets */
+                for (auto& entry : partitions_)
+                {
+                    if (entry.second.offset_ > offset)
+                        entry.second.offset_ = entry.second.offset_ + newSize - oldSize;
+                }
+            }
+            else if (newSize < oldSize)
             {
-                if (it.second.GetOffset() > partitionToRemove.GetOffset())
-                    it.second.offset_ -= partitionToRemove.GetSize();
+                /* Release the tail of the partition */
+                ReleaseRange(offset + newSize, oldSize - newSize);
+            }
+            else
+            {
+                const auto growth = newSize - oldSize;
+
+                if (end == buffer_.size())
+                {
+                    /* Partition is at the end of the buffer -> grow buffer */
+                    buffer_.resize(offset + newSize);
+                }
+                else
+                {
+                    auto next = freeBlocks_.find(end);
+                    if (next != freeBlocks_.end() && (next->second >= growth || end + next->second == buffer_.size()))
+                    {
+                        /* Grow in place into the adjacent free block */
+                        const auto blockSize = next->second;
+                        EraseFreeBlock(end, blockSize);
+
+                        if (blockSize > growth)
+                            InsertFreeBlock(end + growth, blockSize - growth);
+                        else if (blockSize < growth)
+                            buffer_.resize(offset + newSize);
+                    }
+                    else
+                    {
+                        /* Relocate partition */
+                        const auto newOffset = AllocateRange(newSize);
+                        std::copy(buffer_.begin() + offset, buffer_.begin() + end, buffer_.begin() + newOffset);
+                        ReleaseRange(offset, oldSize);
+                        partition.offset_ = newOffset;
+                    }
+                }
+            }
+
+            partition.size_ = newSize;
+
+            return partition;
+        }
+
+        /**
+        Moves all partitions to the front of the buffer, so that there are no more holes between them.
+        \return List of all partitions which have been moved. This can be used to update only
+        these ranges in a mirrored buffer (e.g. a hardware vertex buffer).
+        \remarks This is only required for free-list mode. In compact mode, the returned list is always empty.
+        */
+        std::vector<Relocation> Defragment()
+        {
+            std::vector<Relocation> relocations;
+
+            /* Sort partitions by their offsets */
+            std::vector<typename PartitionListType::iterator> sortedPartitions;
+            sortedPartitions.reserve(partitions_.size());
+
+            for (auto it = partitions_.begin(); it != partitions_.end(); ++it)
+                sortedPartitions.push_back(it);
+
+            std::sort(
+                sortedPartitions.begin(), sortedPartitions.end(),
+                [](const typename PartitionListType::iterator& lhs, const typename PartitionListType::iterator& rhs)
+                {
+                    return lhs->second.offset_ < rhs->second.offset_;
+                }
+            );
+
+            /* Move partitions to the front (forward copy is safe, because partitions only move to lower offsets) */
+            size_t offset = 0;
+
+            for (auto it : sortedPartitions)
+            {
+                auto& partition = it->second;
+
+                if (partition.offset_ != offset)
+                {
+                    auto src = buffer_.begin() + partition.offset_;
+                    std::copy(src, src + partition.size_, buffer_.begin() + offset);
+                    relocations.push_back({ it->first, partition.offset_, offset, partition.size_ });
+                    partition.offset_ = offset;
+                }
+
+                offset += partition.size_;
             }
 
             /* Shrink container size */
-            buffer_.resize(buffer_.size() - partitionToRemove.GetSize());
+            buffer_.resize(offset);
+            freeBlocks_.clear();
+            freeBlocksBySize_.clear();
+
+            return relocations;
         }
 
         //! Clears the entire contianer with all its partitions.
@@ -152,6 +298,8 @@ template <typename Key> class PartitionContainer
         {
             buffer_.clear();
             partitions_.clear();
+            freeBlocks_.clear();
+            freeBlocksBySize_.clear();
         }
 
         //! Returns the size of the entire container.
@@ -160,10 +308,20 @@ template <typename Key> class PartitionContainer
             return buffer_.size();
         }
 
-        /*void Resize(const Key& key, size_t newSize)
+        //! Returns the number of unused bytes between the partitions. This is always 0 in compact mode.
+        inline size_t FreeSize() const
         {
-            //todo ...
-        }*/
+            size_t size = 0;
+            for (const auto& block : freeBlocks_)
+                size += block.second;
+            return size;
+        }
+
+        //! Returns the allocation mode.
+        inline AllocationModes GetAllocationMode() const
+        {
+            return mode_;
+        }
 
         //! Trys to find the specified partition.
         Partition Find(const Key& key) const
@@ -214,9 +372,128 @@ template <typename Key> class PartitionContainer
 
     private:
 
-        std::vector<char> buffer_;
+        //! Allocates a new range of the specified size and returns its offset.
+        size_t AllocateRange(const size_t size)
+        {
+            if (mode_ == AllocationModes::FreeList)
+            {
+                /* Find smallest free block which fits (best-fit) */
+                auto it = freeBlocksBySize_.lower_bound(size);
+                if (it != freeBlocksBySize_.end())
+                {
+                    const auto blockSize    = it->first;
+                    const auto blockOffset  = it->second;
+
+                    EraseFreeBlock(blockOffset, blockSize);
+                    if (blockSize > size)
+                        InsertFreeBlock(blockOffset + size, blockSize - size);
+
+                    return blockOffset;
+                }
+
+                /* Extend the last free block, if it is at the end of the buffer */
+                if (!freeBlocks_.empty())
+                {
+                    auto last = std::prev(freeBlocks_.end());
+
+                    const auto blockOffset  = last->first;
+                    const auto blockSize    = last->second;
+
+                    if (blockOffset + blockSize == buffer_.size())
+                    {
+                        EraseFreeBlock(blockOffset, blockSize);
+                        buffer_.resize(blockOffset + size);
+                        return blockOffset;
+                    }
+                }
+            }
+
+            /* Append range to the end of the buffer */
+            const auto offset = buffer_.size();
+            buffer_.resize(offset + size);
+            return offset;
+        }
+
+        //! Releases the specified range, which must no longer be used by any partition.
+        void ReleaseRange(size_t offset, size_t size)
+        {
+            if (mode_ == AllocationModes::Compact)
+            {
+                /* Copy subsequent partitions to the removed place */
+                std::copy(buffer_.begin() + offset + size, buffer_.end(), buffer_.begin() + offset);
+
+                /* Update subsequent partition offsets */
+                for (auto& entry : partitions_)
+                {
+                    if (entry.second.offset_ > offset)
+                        entry.second.offset_ -= size;
+                }
+
+                /* Shrink container size */
+                buffer_.resize(buffer_.size() - size);
+                return;
+            }
+
+            /* Merge with previous adjacent free block */
+            auto next = freeBlocks_.lower_bound(offset);
+
+            if (next != freeBlocks_.begin())
+            {
+                auto prev = std::prev(next);
+                if (prev->first + prev->second == offset)
+                {
+                    offset = prev->first;
+                    size += prev->second;
+                    EraseFreeBlock(prev->first, prev->second);
+                }
+            }
+
+            /* Merge with next adjacent free block */
+            next = freeBlocks_.find(offset + size);
+            if (next != freeBlocks_.end())
+            {
+                size += next->second;
+                EraseFreeBlock(next->first, next->second);
+            }
+
+            /* Shrink container if the free block is at the end, otherwise store it */
+            if (offset + size == buffer_.size())
+                buffer_.resize(offset);
+            else
+                InsertFreeBlock(offset, size);
+        }
+
+        void InsertFreeBlock(size_t offset, size_t size)
+        {
+            freeBlocks_[offset] = size;
+            freeBlocksBySize_.insert({ size, offset });
+        }
+
+        void EraseFreeBlock(size_t offset, size_t size)
+        {
+            freeBlocks_.erase(offset);
+
+            auto range = freeBlocksBySize_.equal_range(size);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (it->second == offset)
+                {
+                    freeBlocksBySize_.erase(it);
+                    break;
+                }
+            }
+        }
+
+        AllocationModes                 mode_ = AllocationModes::Compact;
+
+        std::vector<char>               buffer_;
+
+        PartitionListType               partitions_;
 
-        PartitionListType partitions_;
+        //! Free blocks, sorted by offset (offset -> size). Only used in free-list mode.
+        std::map<size_t, size_t>        freeBlocks_;
+        //! Free blocks, sorted by size (size -> offset). Only used in free-list mode.
+        std::multimap<size_t, size_t>   freeBlocksBySize_;
 
 };
 
@@ -0,0 +1,93 @@
+/*
+ * Radix sort header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_RADIX_SORT_H__
+#define __FORK_RADIX_SORT_H__
+
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+
+namespace Fork
+{
+
+
+/**
+Sorts the entries by their 64-bit keys with a stable LSD (least-significant-digit) radix sort with 8-bit digits.
+Passes, in which all keys have the same digit, are skipped.
+\tparam T Specifies the entry type. This must have a member "key" of type std::uint64_t.
+\param[in,out] entries Specifies the entries which are to be sorted.
+\param[in,out] tempEntries Specifies the temporary entry list. This will be resized to the number of entries.
+It can be reused over several calls to avoid reallocations.
+*/
+template <class T> void RadixSortByKey(std::vector<T>& entries, std::vector<T>& tempEntries)
+{
+    const auto numEntries = entries.size();
+
+    if (numEntries < 2)
+        return;
+
+    tempEntries.resize(numEntries);
+
+    auto src = &entries;
+    auto dst = &tempEntries;
+
+    for (unsigned int shift = 0; shift < 64; shift += 8)
+    {
+        /* Build histogram for the current digit */
+        size_t offsets[256] = { 0 };
+
+        for (const auto& entry : *src)
+            ++offsets[(entry.key >> shift) & 0xff];
+
+        if (offsets[((*src)[0].key >> shift) & 0xff] == numEntries)
+            continue;
+
+        /* Convert histogram into prefix sums */
+        size_t sum = 0;
+        for (auto& offset : offsets)
+        {
+            const auto count = offset;
+            offset = sum;
+            sum += count;
+        }
+
+        /* Scatter entries */
+        for (const auto& entry : *src)
+            (*dst)[offsets[(entry.key >> shift) & 0xff]++] = entry;
+
+        std::swap(src, dst);
+    }
+
+    if (src != &entries)
+        entries.swap(tempEntries);
+}
+
+/**
+Converts the specified floating-point value into an unsigned integer with the same ordering,
+i.e. (a < b) is equivalent to (FloatToOrderedBits(a) < FloatToOrderedBits(b)) for all non-NaN values.
+This can be used to put floating-point values (e.g. depth values) into radix sort keys.
+*/
+inline std::uint32_t FloatToOrderedBits(float value)
+{
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) != 0 ? ~bits : (bits | 0x80000000u);
+}
+
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
@@ -0,0 +1,148 @@
+/*
+ * Asynchronous result header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_JOBS_ASYNC_RESULT_H__
+#define __FORK_JOBS_ASYNC_RESULT_H__
+
+
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <string>
+
+
+namespace Fork
+{
+
+namespace Jobs
+{
+
+
+/**
+Asynchronous result (a future-like handle). The result is pending until the producer either
+resolves it with a value or lets it fail with an error message. The consumer polls the state (e.g. once per frame),
+since the producer often needs the render thread to finish the result (e.g. to create the GPU resources).
+\code
+auto texture = textureManager->LoadTexture2DAsync("Brick.png");
+// ...
+if (texture->IsReady())
+    texturedGeometry->textures.push_back(texture->Get());
+\endcode
+\remarks All functions are thread-safe.
+\see AsyncResultPtr
+*/
+template <typename T> class AsyncResult
+{
+
+    public:
+
+        //! Asynchronous result states.
+        enum class States
+        {
+            Pending,    //!< The result is not yet available.
+            Ready,      //!< The result is available. \see Get
+            Failed,     //!< The result could not be produced. \see Error
+        };
+
+        AsyncResult() = default;
+
+        AsyncResult(const AsyncResult&) = delete;
+        AsyncResult& operator = (const AsyncResult&) = delete;
+
+        /* === Functions === */
+
+        //! Returns the current state.
+        inline States State() const
+        {
+            return state_;
+        }
+
+        //! Returns true if the result is still pending.
+        inline bool IsPending() const
+        {
+            return state_ == States::Pending;
+        }
+        //! Returns true if the result is available.
+        inline bool IsReady() const
+        {
+            return state_ == States::Ready;
+        }
+        //! Returns true if the result could not be produced.
+        inline bool IsFailed() const
+        {
+            return state_ == States::Failed;
+        }
+
+        /**
+        Returns the result value. If the result is not ready (yet), the default value of 'T' is returned.
+        \see IsReady
+        */
+        T Get() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return value_;
+        }
+
+        //! Returns the error message, if the result could not be produced.
+        std::string Error() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return error_;
+        }
+
+        /**
+        Resolves this result with the specified value. This is only used by the producer.
+        \remarks This has no effect, if this result is no longer pending.
+        */
+        void Resolve(const T& value)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (state_ == States::Pending)
+            {
+                value_ = value;
+                state_ = States::Ready;
+            }
+        }
+
+        /**
+        Lets this result fail with the specified error message. This is only used by the producer.
+        \remarks This has no effect, if this result is no longer pending.
+        */
+        void Fail(const std::string& error)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (state_ == States::Pending)
+            {
+                error_ = error;
+                state_ = States::Failed;
+            }
+        }
+
+    private:
+
+        mutable std::mutex  mutex_;
+        std::atomic<States> state_ { States::Pending };
+
+        T                   value_ = T();
+        std::string         error_;
+
+};
+
+//! Shared pointer type of an asynchronous result.
+template <typename T> using AsyncResultPtr = std::shared_ptr<AsyncResult<T>>;
+
+
+} // /namespace Jobs
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
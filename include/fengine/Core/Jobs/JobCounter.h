@@ -0,0 +1,91 @@
+/*
+ * Job counter header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_JOBS_JOB_COUNTER_H__
+#define __FORK_JOBS_JOB_COUNTER_H__
+
+
+#include "Core/Export.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <functional>
+#include <exception>
+
+
+namespace Fork
+{
+
+namespace Jobs
+{
+
+
+//! Job function type.
+typedef std::function<void()> JobFunction;
+
+class JobSystem;
+
+/**
+Job counter (or rather dependency counter). Each job, which is submitted with a counter,
+increments the counter, and decrements it again, when the job has been executed.
+Jobs can depend on a counter, i.e. they will not be scheduled before the counter has reached zero.
+\see JobSystem::Submit
+\see JobSystem::Wait
+*/
+class FORK_EXPORT JobCounter
+{
+
+    public:
+
+        JobCounter() = default;
+
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator = (const JobCounter&) = delete;
+
+        //! Returns the number of pending jobs.
+        inline unsigned int Value() const
+        {
+            return value_;
+        }
+
+        //! Returns true if all jobs of this counter have been executed.
+        inline bool IsDone() const
+        {
+            return value_ == 0;
+        }
+
+    private:
+
+        friend class JobSystem;
+
+        //! Job which has been submitted with this counter as dependency.
+        struct Continuation
+        {
+            JobFunction job;
+            JobCounter* counter;
+        };
+
+        std::atomic<unsigned int>   value_ { 0 };
+
+        mutable std::mutex          mutex_;         //!< Mutex for the value transition to zero, the continuation list and the exception.
+        std::vector<Continuation>   continuations_; //!< Jobs which wait until this counter reaches zero.
+        mutable std::exception_ptr  exception_;     //!< First exception thrown by a job of this counter (taken by "JobSystem::Wait").
+
+};
+
+
+} // /namespace Jobs
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
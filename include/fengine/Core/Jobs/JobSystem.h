@@ -0,0 +1,200 @@
+/*
+ * Job system header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_JOBS_JOB_SYSTEM_H__
+#define __FORK_JOBS_JOB_SYSTEM_H__
+
+
+#include "Core/Export.h"
+#include "Core/Jobs/JobCounter.h"
+
+#include <thread>
+#include <deque>
+#include <condition_variable>
+#include <memory>
+#include <algorithm>
+
+
+namespace Fork
+{
+
+namespace Jobs
+{
+
+
+/**
+Job system with a fixed number of worker threads. Each worker has its own job queue (a double-ended queue):
+the worker takes its jobs from the back (LIFO, which is cache friendly), and idle workers steal jobs
+from the front of other workers' queues (FIFO, which takes the largest remaining work first).
+\code
+Jobs::JobCounter counter;
+jobSystem.Submit([]() { StepA(); }, &counter);
+jobSystem.Submit([]() { StepB(); }, &counter);
+jobSystem.Submit([]() { StepC(); }, nullptr, &counter); // StepC runs after StepA and StepB
+jobSystem.Wait(counter);
+\endcode
+\remarks If a job throws an exception, the first exception of its counter is rethrown by "Wait" (after all jobs of the counter have been executed).
+Exceptions of jobs without a counter are discarded.
+\note The thread which calls "Wait" also executes jobs while it is waiting, so a job can wait for other jobs (e.g. nested "ParallelFor").
+*/
+class FORK_EXPORT JobSystem
+{
+
+    public:
+
+        /**
+        Job system constructor.
+        \param[in] numWorkers Specifies the number of worker threads. If this is 0, the number of
+        hardware threads minus one is used, since the calling thread participates in "Wait".
+        */
+        JobSystem(unsigned int numWorkers = 0);
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator = (const JobSystem&) = delete;
+
+        /* === Functions === */
+
+        //! Returns the default job system instance, with one worker for each hardware thread (except the calling thread).
+        static JobSystem* Instance();
+
+        /**
+        Submits the specified job.
+        \param[in] job Specifies the job function.
+        \param[in] counter Optional raw-pointer to the counter, which is incremented now and decremented when the job has been executed.
+        \param[in] dependency Optional raw-pointer to the counter this job depends on.
+        The job will not be scheduled before this counter has reached zero.
+        */
+        void Submit(const JobFunction& job, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+
+        /**
+        Waits until the specified counter has reached zero.
+        In the meantime the calling thread executes other pending jobs.
+        \remarks If a job of this counter has thrown an exception, the first of these exceptions is rethrown here.
+        */
+        void Wait(const JobCounter& counter);
+
+        /**
+        Calls the specified function for each index in the range [first, last) in parallel.
+        \param[in] first Specifies the first index.
+        \param[in] last Specifies the index after the last one.
+        \param[in] func Specifies the function, which must have the following interface: void func(size_t index).
+        \param[in] grainSize Specifies the number of indices, which are processed by a single job.
+        If this is 0, the range is split into 4 chunks per worker. By default 0.
+        \remarks If the function throws an exception, the remaining chunks are still processed,
+        and the first exception is rethrown on the calling thread, when all chunks are done.
+        \see ParallelForRange
+        */
+        template <class Function>
+        void ParallelFor(size_t first, size_t last, Function func, size_t grainSize = 0)
+        {
+            ParallelForRange(
+                first, last,
+                [&func](size_t begin, size_t end)
+                {
+                    for (; begin < end; ++begin)
+                        func(begin);
+                },
+                grainSize
+            );
+        }
+
+        /**
+        Calls the specified function for each chunk of the range [first, last) in parallel.
+        \param[in] func Specifies the function, which must have the following interface: void func(size_t begin, size_t end).
+        \see ParallelFor
+        */
+        template <class Function>
+        void ParallelForRange(size_t first, size_t last, Function func, size_t grainSize = 0)
+        {
+            if (first >= last)
+                return;
+
+            const auto count = last - first;
+
+            if (grainSize == 0)
+                grainSize = std::max(size_t(1), count / (queues_.size() * 4));
+
+            if (count <= grainSize)
+            {
+                /* Process small ranges directly */
+                func(first, last);
+                return;
+            }
+
+            JobCounter counter;
+
+            for (auto begin = first; begin < last; begin += grainSize)
+            {
+                const auto end = std::min(begin + grainSize, last);
+                Submit([&func, begin, end]() { func(begin, end); }, &counter);
+            }
+
+            Wait(counter);
+        }
+
+        //! Returns the number of worker threads.
+        inline size_t NumWorkers() const
+        {
+            return workers_.size();
+        }
+
+    private:
+
+        /* === Structures === */
+
+        struct Job
+        {
+            JobFunction job;
+            JobCounter* counter;
+        };
+
+        struct JobQueue
+        {
+            std::mutex      mutex;
+            std::deque<Job> jobs;
+        };
+
+        /* === Functions === */
+
+        void WorkerLoop(size_t queueIndex);
+
+        //! Pushes the job into the queue of the current worker (or any queue, if this is not a worker thread).
+        void PushJob(Job&& job);
+        //! Takes a job from the own queue or steals a job from another queue.
+        bool FindJob(size_t queueIndex, Job& job);
+        //! Executes the job and schedules all jobs, which depend on its counter.
+        void ExecuteJob(Job& job);
+
+        //! Returns the queue index of the calling thread, or the number of queues if this is not a worker thread.
+        size_t CurrentQueueIndex() const;
+
+        /* === Members === */
+
+        std::vector<std::unique_ptr<JobQueue>>  queues_;
+        std::vector<std::thread>                workers_;
+
+        std::atomic<size_t>                     numQueuedJobs_  { 0 };
+        std::atomic<size_t>                     nextQueue_      { 0 };
+        std::atomic<bool>                       quit_           { false };
+
+        std::mutex                              sleepMutex_;
+        std::condition_variable                 sleepCondition_;
+
+};
+
+
+} // /namespace Jobs
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
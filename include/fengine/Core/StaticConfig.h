@@ -39,6 +39,24 @@ Otherwise all common 3D file formats can not be loaded!
 /* Enable special case exception: "Not Yet Implemented". */
 #define FORK_ENABLE_EXCEPTION_NOTYETIMPLEMENTED
 
+/*
+Enables SSE2 code paths for performance critical CPU functions (e.g. batched frustum culling).
+This is enabled automatically when the compiler targets SSE2 (which is always the case for x64).
+*/
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#   define FORK_ENABLE_SSE2
+#endif
+
+/* Enables AVX code paths. This is enabled automatically when the compiler targets AVX (e.g. "/arch:AVX" or "-mavx"). */
+#if defined(__AVX__)
+#   define FORK_ENABLE_AVX
+#endif
+
+/* Enables AVX2 code paths (256-bit integer operations). This is enabled automatically when the compiler targets AVX2 (e.g. "/arch:AVX2" or "-mavx2"). */
+#if defined(__AVX2__)
+#   define FORK_ENABLE_AVX2
+#endif
+
 
 /* --- Further macros --- */
 
@@ -76,6 +76,12 @@ class FORK_EXPORT SimpleApp : public App
         {
             bool            enableDebugDump         = false;
             bool            useNormalMapping        = false;
+            /**
+            Specifies whether the scene is rendered with the bounding volume hierarchy of the scene manager.
+            Only enable this, if all geometry nodes of the scene graph have been created by the scene manager. By default false.
+            \see Scene::ForwardSceneRenderer::sceneHierarchy
+            */
+            bool            useSceneHierarchy       = false;
             std::wstring    renderSystemLibrary     = L"ForkRendererGL";
             std::wstring    physicsSystemLibrary    = L"ForkPhysicsNw";
             std::wstring    soundSystemLibrary      = L"ForkAudioXA2";
@@ -185,8 +185,9 @@ The indentation string can be set with 'SetIndent'.
 \see IncIndent
 \see DecIndent
 \see ScopedIndent
+\remarks This returns a copy, since the indentation can be changed by other threads.
 */
-FORK_EXPORT const std::string& GetFullIndent();
+FORK_EXPORT std::string GetFullIndent();
 
 //! Increases indentation.
 FORK_EXPORT void IncIndent();
@@ -14,6 +14,8 @@
 #include "Math/Geometry/Plane.h"
 #include "Math/Geometry/Triangle.h"
 #include "Math/Geometry/OBB.h"
+#include "Math/Geometry/AABB.h"
+#include "Math/Core/Matrix4.h"
 #include "Math/Collision/Intersection.h"
 
 
@@ -77,6 +79,33 @@ inline OBB<V, T> Transform(const M<T>& mat, const OBB<V, T>& box)
     );
 }
 
+/**
+Transforms the specified AABB by the specified matrix.
+The result is the smallest AABB which encloses the transformed box, i.e. it may be larger than the original box.
+*/
+template <typename T>
+inline AABB3<T> Transform(const Matrix4<T>& mat, const AABB3<T>& box)
+{
+    if (!box.IsValid())
+        return box;
+
+    const auto center = mat * box.Center();
+    const auto extent = (box.max - box.min) / T(2);
+
+    /* Project the box extent onto each axis of the transformed coordinate system */
+    Vector3<T> worldExtent;
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        worldExtent[i] =
+            std::abs(mat(0, i)) * extent.x +
+            std::abs(mat(1, i)) * extent.y +
+            std::abs(mat(2, i)) * extent.z;
+    }
+
+    return AABB3<T>(center - worldExtent, center + worldExtent);
+}
+
 //! Transforms the specified intersection by the specified matrix.
 template <
     template <typename> class M,
@@ -51,8 +51,26 @@ template <typename T = float> class Transform3D
         {
         }
 
+        Transform3D(const Transform3D<T>&) = default;
+
         /* === Operators === */
 
+        /**
+        Copies the transformation. The revision number is not copied but incremented,
+        so that every assignment is recognized as a modification.
+        \see Revision
+        */
+        Transform3D<T>& operator = (const Transform3D<T>& other)
+        {
+            position_   = other.position_;
+            rotation_   = other.rotation_;
+            scale_      = other.scale_;
+            matrix_     = other.matrix_;
+            changed_    = other.changed_;
+            revision_   = (other.revision_ > revision_ ? other.revision_ : revision_) + 1;
+            return *this;
+        }
+
         Transform3D<T>& operator *= (const Transform3D<T>& other)
         {
             *this = (other.GetMatrix() * GetMatrix());
@@ -79,6 +97,17 @@ template <typename T = float> class Transform3D
             return matrix_;
         }
 
+        /**
+        Returns the revision number of this transformation. This will be incremented every time the
+        transformation is modified, i.e. every time the 'changed' bit is set. In contrast to this bit,
+        the revision is not reset by "GetMatrix", so it can be used by several independent caches
+        (e.g. the global transformation cache of a scene node) to detect modifications.
+        */
+        inline unsigned int Revision() const
+        {
+            return revision_;
+        }
+
         /**
         Returns this transformation as inverse. This will be computed as inverse affine matrix.
         \see Matrix4::MakeAffineInverse
@@ -108,14 +137,14 @@ template <typename T = float> class Transform3D
             Math::Lerp(position_, from.position_, to.position_, t);
             Math::Lerp(scale_, from.scale_, to.scale_, t);
             rotation_.SLerp(from.rotation_, to.rotation_, t);
-            changed_ = true;
+            MarkChanged();
         }
 
         //! Sets the position of this transformation.
         inline void SetPosition(const Point3<T>& position)
         {
             position_ = position;
-            changed_ = true;
+            MarkChanged();
         }
         //! Returns the position of this transformation.
         inline const Point3<T>& GetPosition() const
@@ -127,7 +156,7 @@ template <typename T = float> class Transform3D
         inline void SetRotation(const Quaternion<T>& rotation)
         {
             rotation_ = rotation;
-            changed_ = true;
+            MarkChanged();
         }
         //! Returns the rotation of this transformation.
         inline const Quaternion<T>& GetRotation() const
@@ -139,7 +168,7 @@ template <typename T = float> class Transform3D
         inline void SetScale(const Vector3<T>& scale)
         {
             scale_ = scale;
-            changed_ = true;
+            MarkChanged();
         }
         //! Returns the scale of this transformation.
         inline const Vector3<T>& GetScale() const
@@ -155,7 +184,7 @@ template <typename T = float> class Transform3D
         inline void MoveGlobal(const Vector3<T>& vec)
         {
             position_ += vec;
-            changed_ = true;
+            MarkChanged();
         }
         /**
         Moves the position into the specified (local) direction.
@@ -179,7 +208,7 @@ template <typename T = float> class Transform3D
         inline void Turn(const Quaternion<T>& rotation)
         {
             rotation_ *= rotation;
-            changed_ = true;
+            MarkChanged();
         }
 
         /**
@@ -195,7 +224,7 @@ template <typename T = float> class Transform3D
                 rotation_ = rotation * rotation_;
             else
                 rotation_ *= rotation;
-            changed_ = true;
+            MarkChanged();
         }
 
         /**
@@ -213,7 +242,7 @@ template <typename T = float> class Transform3D
             position_ += moveOffset;
             rotation_ *= rotation;
 
-            changed_ = true;
+            MarkChanged();
         }
 
         /**
@@ -224,7 +253,7 @@ template <typename T = float> class Transform3D
         inline void Scale(const Vector3<T>& scale)
         {
             scale_ += scale;
-            changed_ = true;
+            MarkChanged();
         }
 
         /**
@@ -299,6 +328,7 @@ template <typename T = float> class Transform3D
             scale_      = matrix.GetScale();
             matrix_     = matrix;
             changed_    = false;
+            ++revision_;
         }
 
         /**
@@ -310,11 +340,19 @@ template <typename T = float> class Transform3D
         {
             position_   = matrix.GetPosition();
             rotation_   = matrix.GetRotation();
-            changed_    = true;
+            MarkChanged();
         }
 
     private:
         
+        /* === Functions === */
+
+        inline void MarkChanged()
+        {
+            changed_ = true;
+            ++revision_;
+        }
+
         /* === Members === */
 
         Point3<T> position_;
@@ -325,6 +363,8 @@ template <typename T = float> class Transform3D
 
         mutable bool changed_ = false;
 
+        unsigned int revision_ = 0;
+
 };
 
 
@@ -12,8 +12,11 @@
 #include "Core/Export.h"
 #include "Scene/Node/GeometryNode.h"
 #include "Scene/FileHandler/ModelReader.h"
+#include "Scene/Geometry/Node/TexturedGeometry.h"
+#include "Video/RenderSystem/Texture/TextureManager.h"
 
 #include <string>
+#include <vector>
 
 
 namespace Fork
@@ -48,6 +51,60 @@ FORK_EXPORT ModelReader::AnimatedModel ReadAnimatedModel(
     const ModelReader::Flags::DataType flags = 0
 );
 
+/**
+Deferred resources of a model, which has been read with "ReadModelDeferred".
+\see ReadModelDeferred
+\see FinalizeDeferredModel
+*/
+struct FORK_EXPORT DeferredResources
+{
+    //! Textured geometry, whose textures are still loading.
+    struct TextureBinding
+    {
+        TexturedGeometryPtr                     geometry;
+        std::vector<Video::AsyncTexture2DPtr>   textures;
+        std::vector<std::string>                textureNames;   //!< Texture filenames of the 'textures' entries (for the cooked model file).
+    };
+
+    //! Returns true if no texture is pending anymore (i.e. all textures are either ready or failed).
+    bool AreTexturesLoaded() const;
+
+    std::string                     filename;           //!< Model filename.
+    IO::PathDictionary              texPathDict;        //!< Texture path dictionary, the model has been read with.
+    ModelReader::Flags::DataType    flags       = 0;    //!< Model reading flags.
+    bool                            isCooked    = false;//!< Specifies whether the model has been read from its cooked model file.
+    std::vector<TextureBinding>     textureBindings;    //!< Textured geometries, whose textures are still loading.
+    std::vector<std::string>        failedTextures;     //!< Texture filenames, which could not be found.
+};
+
+/**
+Reads the specified model without creating any GPU resources, so that it can be called on a worker thread.
+The hardware buffers of the meshes are not created, and the textures are requested with "TextureManager::LoadTexture2DAsync".
+\param[out] resources Specifies the output deferred resources, which must be passed to "FinalizeDeferredModel",
+once all textures have been loaded (see DeferredResources::AreTexturesLoaded).
+\return Shared pointer to the geometry graph, or null if the model could not be read.
+\remarks The geometry graph is not optimized here (see ModelReader::Flags::OptimizeGeometryGraph),
+since the geometries are grouped by their textures, which are not available yet.
+\see ReadModel
+\see FinalizeDeferredModel
+*/
+FORK_EXPORT GeometryPtr ReadModelDeferred(
+    const std::string& filename,
+    const IO::PathDictionary& texPathDict,
+    const ModelReader::Flags::DataType flags,
+    DeferredResources& resources
+);
+
+/**
+Finalizes the specified model, which has been read with "ReadModelDeferred". This appends the loaded textures,
+optimizes the geometry graph, computes the bounding volumes and writes the cooked model file (if the respective flags are set).
+\param[in,out] model Specifies the model. This may be replaced by the geometry graph optimization.
+\remarks This does not create any GPU resources either, so it can also be called on a worker thread.
+The hardware buffers of the meshes must still be created afterwards on the render thread.
+\see ReadModelDeferred
+*/
+FORK_EXPORT void FinalizeDeferredModel(GeometryPtr& model, const DeferredResources& resources);
+
 
 } // /namespace ModelFileHandler
 
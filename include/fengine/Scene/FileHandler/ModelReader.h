@@ -50,6 +50,15 @@ class FORK_EXPORT ModelReader
                 \see GeometryConverter::OptimizeGeometryGraph
                 */
                 OptimizeGeometryGraph   = (1 << 1),
+                /**
+                Reads the model from its cooked model file (the model filename with the extension ".fkcg"),
+                if the cooked model file matches the content of the model file and the other flags.
+                Otherwise the model is imported as usual and the cooked model file is written afterwards.
+                This avoids the entire model import (and the geometry graph optimization) on repeated loads.
+                \remarks Only the geometry graph, the texture filenames and the bounding volumes are cooked, but no animations.
+                \see ModelFileHandler::ReadModel
+                */
+                CookedCache             = (1 << 2),
             };
         };
 
@@ -0,0 +1,115 @@
+/*
+ * Flat skeleton header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_FLAT_SKELETON_H__
+#define __FORK_FLAT_SKELETON_H__
+
+
+#include "Scene/Geometry/Skeleton.h"
+#include "Math/Core/Matrix4.h"
+#include "Math/Core/Transform3D.h"
+
+#include <vector>
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+DECL_SHR_PTR(FlatSkeleton);
+
+/**
+Flattened (data-oriented) representation of a skeleton joint hierarchy. The joints are stored in
+'pre-order depth-first-search' order (the same order as Skeleton::Joint::FillMatrixBuffer), so every parent
+joint is stored before its children and the hierarchy can be processed in a single linear pass.
+\remarks This class only stores the immutable data of a skeleton (parent indices, origin matrices and the bind pose),
+so it can be shared between all characters with the same skeleton. The animated state of each character is stored in a SkeletonPose.
+\see SkeletonPose
+*/
+class FORK_EXPORT FlatSkeleton
+{
+
+    public:
+
+        //! Invalid joint index. This is the parent index of the root joint.
+        static const size_t invalidIndex = static_cast<size_t>(-1);
+
+        /**
+        Builds the flat skeleton out of the joint hierarchy of the specified skeleton.
+        \remarks The origin matrices are copied from the joints, so call "Skeleton::Joint::UpdateOriginMatrix"
+        on the root joint before. The current joint transformations are stored as bind pose.
+        \see Skeleton::Joint::UpdateOriginMatrix
+        */
+        FlatSkeleton(const Skeleton& skeleton);
+
+        FlatSkeleton(const FlatSkeleton&) = delete;
+        FlatSkeleton& operator = (const FlatSkeleton&) = delete;
+
+        /**
+        Returns the index of the specified joint or 'invalidIndex' if the joint is not part of this skeleton.
+        \note This performs a linear search, so only use it to setup the joint indices (e.g. for an animation).
+        */
+        size_t FindJoint(const Skeleton::Joint* joint) const;
+
+        //! Returns the number of joints.
+        inline size_t NumJoints() const
+        {
+            return parents_.size();
+        }
+
+        /**
+        Returns the list of joints (in the same order as all other lists).
+        \note These joints are owned by the skeleton this flat skeleton was built from.
+        */
+        inline const std::vector<const Skeleton::Joint*>& GetJoints() const
+        {
+            return joints_;
+        }
+
+        //! Returns the list of parent indices. The parent index of the root joint is 'invalidIndex'.
+        inline const std::vector<size_t>& GetParents() const
+        {
+            return parents_;
+        }
+
+        //! Returns the list of (global) origin matrices. \see Skeleton::Joint::GetOriginMatrix
+        inline const std::vector<Math::Matrix4f>& GetOriginMatrices() const
+        {
+            return originMatrices_;
+        }
+
+        //! Returns the local transformations of the bind pose, i.e. the joint transformations when this skeleton was built.
+        inline const std::vector<Math::Transform3Df>& GetBindPose() const
+        {
+            return bindPose_;
+        }
+
+    private:
+
+        void AddJoint(const Skeleton::Joint& joint, size_t parent);
+
+        std::vector<const Skeleton::Joint*> joints_;
+        std::vector<size_t>                 parents_;
+        std::vector<Math::Matrix4f>         originMatrices_;
+        std::vector<Math::Transform3Df>     bindPose_;
+
+};
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
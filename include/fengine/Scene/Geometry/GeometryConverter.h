@@ -14,8 +14,10 @@
 #include "Math/Geometry/Sphere.h"
 #include "Math/Common/Convert.h"
 #include "Video/BufferFormat/AttributeIterator.h"
+#include "Video/BufferFormat/VertexFormat.h"
 #include "Scene/Geometry/Node/Geometry.h"
 #include "Scene/Geometry/BoundingVolume.h"
+#include "Scene/Geometry/MeshGeometryAtlas.h"
 
 #include <algorithm>
 #include <vector>
@@ -32,6 +34,7 @@ namespace Scene
 {
 
 class Geometry;
+class LODGeometry;
 
 /**
 Geometry converter namespace. As the name implies, it provides functions to convert geometry data.
@@ -74,8 +77,21 @@ FORK_EXPORT void GenerateNormalsFlat(
 );
 /**
 Generates smooth normals for the specified vertex range.
+\param[in] coordIterator Specifies the attribute iterator for the vertex coordinates.
+\param[in,out] normalIterator Specifies the attribute iterator for the normal vectors.
+\param[in] indexBuffer Specifies the index buffer. This will be treated as indices of a triangle list.
+\param[in] angleThreshold Specifies the angle threshold (in radians) for hard edges.
+A face normal is only averaged into a vertex normal, if the angle between this face and any face of the vertex
+is less than or equal to this threshold. If this is negative, all adjacent faces are averaged. By default -1.
+\remarks Vertices with (nearly) the same position are welded with a spatial hash before the normals are averaged,
+i.e. split vertices (e.g. at texture seams) get the same normal, unless they are separated by a hard edge.
+The face normals are weighted by the angle of the triangle corner at the respective vertex.
+Large meshes are processed in parallel with the default job system.
+Normals of vertices, which are not used by any triangle, are not modified, even if they are welded with used vertices.
+\throws IndexOutOfBoundsException If any index of 'indexBuffer' is out of bounds.
+\throws InvalidArgumentException If the number of vertex coordinates and normals don't match.
 \see GenerateNormalsFlat
-\todo Not yet implemented!
+\see Jobs::JobSystem::Instance
 */
 FORK_EXPORT void GenerateNormalsSmooth(
     Video::AttributeConstIterator coordIterator,
@@ -125,8 +141,15 @@ FORK_EXPORT void GenerateTangentSpaceFlat(
 );
 /**
 Generates smooth tangent space vectors for the specified vertex range.
+The normals are generated in the same way as with "GenerateNormalsSmooth".
+\param[in] angleThreshold Specifies the angle threshold (in radians) for hard edges. By default -1.
+\remarks The tangents and bitangents are only averaged over faces with the same texture coordinates
+at the welded vertex (i.e. not across texture seams), and the tangents are orthogonalized to the normals.
+For all other parameters see "GenerateTangentSpaceFlat".
+\throws IndexOutOfBoundsException If any index of 'indexBuffer' is out of bounds.
+\throws InvalidArgumentException If the number of elements in all attribute iterators don't match.
 \see GenerateTangentSpaceFlat
-\todo Not yet implemented!
+\see GenerateNormalsSmooth
 */
 FORK_EXPORT void GenerateTangentSpaceSmooth(
     Video::AttributeConstIterator coordIterator,
@@ -139,10 +162,186 @@ FORK_EXPORT void GenerateTangentSpaceSmooth(
     bool ignoreNormals = false
 );
 
+/**
+Welds all vertices which are exactly equal (bitwise) in all attributes of the specified vertex format.
+The unique vertices are compacted to the front of the vertex buffer (in the order of their first occurrence)
+and the index buffer is remapped accordingly.
+\param[in] vertexFormat Specifies the vertex format. Only the bytes of its attributes are compared,
+i.e. padding bytes between the attributes are ignored.
+\param[in,out] vertices Raw-pointer to the vertex buffer.
+\param[in] numVertices Specifies the number of vertices.
+\param[in] vertexStride Specifies the stride (in bytes) of each vertex, e.g. sizeof(Video::Simple3DVertex).
+\param[in,out] indexBuffer Specifies the index buffer. If this is empty, an index buffer for the
+non-indexed vertices [0 .. numVertices) is generated.
+\return Number of unique vertices. All vertices behind this number are undefined and should be removed.
+\throws IndexOutOfBoundsException If any index of 'indexBuffer' is out of bounds.
+\throws InvalidArgumentException If the vertex format does not fit into the vertex stride.
+*/
+FORK_EXPORT size_t WeldVertices(
+    const Video::VertexFormat& vertexFormat,
+    void* vertices, size_t numVertices, size_t vertexStride,
+    CommonIndexBuffer& indexBuffer
+);
+
+/**
+Reorders the triangles of the specified index buffer for the post-transform vertex cache (Forsyth's algorithm).
+Each triangle is emitted greedily by a score, which prefers vertices in the simulated LRU cache
+and vertices with only a few remaining triangles (to avoid isolated triangles).
+\param[in,out] indexBuffer Specifies the index buffer. This will be treated as indices of a triangle list.
+\param[in] numVertices Specifies the number of vertices.
+\throws IndexOutOfBoundsException If any index of 'indexBuffer' is out of bounds.
+\see AnalyzeVertexCache
+*/
+FORK_EXPORT void OptimizeVertexCache(CommonIndexBuffer& indexBuffer, size_t numVertices);
+
+/**
+Reorders the vertices in the order of their first occurrence in the specified index buffer (pre-transform vertex fetch),
+and remaps the index buffer accordingly. Vertices which are not referenced by any index are removed.
+\param[in,out] vertices Raw-pointer to the vertex buffer.
+\param[in] numVertices Specifies the number of vertices.
+\param[in] vertexStride Specifies the stride (in bytes) of each vertex.
+\param[in,out] indexBuffer Specifies the index buffer.
+\return Number of referenced vertices. All vertices behind this number are undefined and should be removed.
+\throws IndexOutOfBoundsException If any index of 'indexBuffer' is out of bounds.
+\remarks This should be called after "OptimizeVertexCache".
+*/
+FORK_EXPORT size_t OptimizeVertexFetch(
+    void* vertices, size_t numVertices, size_t vertexStride, CommonIndexBuffer& indexBuffer
+);
+
+//! Post-transform vertex cache statistics.
+struct VertexCacheStatistics
+{
+    size_t  numTransformedVertices  = 0;    //!< Number of vertex cache misses, i.e. vertex shader invocations.
+    size_t  numTriangles            = 0;    //!< Number of triangles.
+    size_t  numVertices             = 0;    //!< Number of vertices.
+
+    //! Returns the average cache miss ratio (ACMR), i.e. transformed vertices per triangle. The optimum is 0.5.
+    inline float ACMR() const
+    {
+        return numTriangles > 0 ? static_cast<float>(numTransformedVertices) / numTriangles : 0.0f;
+    }
+    //! Returns the average transform to vertex ratio (ATVR), i.e. transformed vertices per vertex. The optimum is 1.0.
+    inline float ATVR() const
+    {
+        return numVertices > 0 ? static_cast<float>(numTransformedVertices) / numVertices : 0.0f;
+    }
+};
+
+/**
+Simulates a FIFO post-transform vertex cache for the specified index buffer.
+\param[in] indexBuffer Specifies the index buffer. This will be treated as indices of a triangle list.
+\param[in] numVertices Specifies the number of vertices.
+\param[in] cacheSize Specifies the number of vertices in the simulated cache. By default 16.
+\throws IndexOutOfBoundsException If any index of 'indexBuffer' is out of bounds.
+\see VertexCacheStatistics
+*/
+FORK_EXPORT VertexCacheStatistics AnalyzeVertexCache(
+    const CommonIndexBuffer& indexBuffer, size_t numVertices, size_t cacheSize = 16
+);
+
+/**
+Partitions the specified triangle mesh into clusters for per-cluster culling.
+Each cluster is grown greedily over adjacent triangles (preferring triangles which add the fewest new vertices
+and which are closest to the cluster center), so the clusters are compact and have tight normal cones.
+\param[in] coordIterator Specifies the attribute iterator for the vertex coordinates.
+\param[in,out] indexBuffer Specifies the index buffer. This will be treated as indices of a triangle list.
+The triangles are reordered, so that each cluster is a contiguous index range.
+\param[out] clusters Specifies the resulting clusters with their index ranges (in 'numVertices' and 'firstIndex'),
+bounding boxes and normal cones. The previous content will get lost!
+\param[in] maxTrianglesPerCluster Specifies the maximal number of triangles per cluster. By default 128.
+\remarks Vertices with the same position are welded (like in "GenerateNormalsSmooth"), so clusters also grow over split vertices.
+The normal cones refer to the face normals in the same orientation as in "GenerateNormalsFlat". Clusters whose triangles face into too many directions get no normal cone (see MeshGeometryAtlas::Partition::coneCutoff).
+This should be called after "OptimizeVertexCache", because the order of the input triangles is used to seed the clusters.
+\throws IndexOutOfBoundsException If any index of 'indexBuffer' is out of bounds.
+\throws InvalidArgumentException If 'maxTrianglesPerCluster' is 0.
+\see MeshGeometryAtlas::RecordClusters
+*/
+FORK_EXPORT void GenerateMeshClusters(
+    Video::AttributeConstIterator coordIterator,
+    CommonIndexBuffer& indexBuffer,
+    std::vector<MeshGeometryAtlas::Partition>& clusters,
+    size_t maxTrianglesPerCluster = 128
+);
+
+/**
+Simplifies the specified triangle mesh with the quadric error metric (QEM).
+Edges are collapsed onto one of their end points (half-edge collapse) in the order of the smallest error,
+so the simplified index buffer only refers to the original vertices and all vertex attributes are kept.
+\param[in] coordIterator Specifies the attribute iterator for the vertex coordinates.
+\param[in] indexBuffer Specifies the index buffer. This will be treated as indices of a triangle list.
+\param[out] simplifiedIndexBuffer Specifies the resulting index buffer. The previous content will get lost!
+\param[in] targetNumTriangles Specifies the number of triangles, at which the simplification stops.
+\return Geometric error of the simplified mesh, i.e. the largest root-mean-square distance (in object space)
+between a collapsed vertex and the planes of its original triangles.
+\remarks Vertices with the same position are welded (like in "GenerateNormalsSmooth").
+Split vertices (e.g. at UV or normal seams) are only collapsed along their seam, so the seams are preserved.
+Open borders are only collapsed along the border, and non-manifold edges are never collapsed.
+Collapses which would flip a triangle are rejected, so the target is not reached in every case.
+\throws IndexOutOfBoundsException If any index of 'indexBuffer' is out of bounds.
+\see GenerateLODGeometry
+*/
+FORK_EXPORT float SimplifyMesh(
+    Video::AttributeConstIterator coordIterator,
+    const CommonIndexBuffer& indexBuffer,
+    CommonIndexBuffer& simplifiedIndexBuffer,
+    size_t targetNumTriangles
+);
+
+/**
+Level-of-detail generation description structure.
+\see GenerateLODGeometry
+*/
+struct FORK_EXPORT LODDescription
+{
+    LODDescription();
+
+    /**
+    Triangle ratios for each generated level, in descending order.
+    The original geometry is always the first level. By default { 0.5, 0.25, 0.125 }.
+    */
+    std::vector<float>  triangleRatios;
+
+    //! Maximal screen-space error (in pixels), at which a level is selected. By default 1.
+    float               pixelError      = 1.0f;
+    /**
+    Vertical field of view (in radians) of the camera projection. By default 74 degrees.
+    \remarks This should match the reference view of the LOD selector, which scales the switch distances to the actual view.
+    \see LODSelector::referenceFieldOfView
+    */
+    float               fieldOfView     = 1.29154f;
+    /**
+    Screen (or rather viewport) height (in pixels). By default 768.
+    \see LODSelector::referenceScreenHeight
+    */
+    float               screenHeight    = 768.0f;
+};
+
+/**
+Generates a level-of-detail geometry for the specified geometry graph.
+All (indexed) triangle mesh geometries of the graph are simplified for each level (see "SimplifyMesh"),
+and the switch distances of the levels are derived from their geometric errors,
+so that the projected error does not exceed the pixel error.
+\param[in] geometry Specifies the geometry graph. This will be the first level of the LOD geometry.
+Composition and textured geometries are copied for each level, all other geometries are shared between the levels.
+\param[in] desc Specifies the LOD description.
+\return Shared pointer to the new LOD geometry. Levels which can not be simplified any further are omitted.
+\remarks All meshes and levels are simplified in parallel with the default job system.
+Non-indexed meshes are not simplified, so "OptimizeGeometryGraph" should be called first.
+The hardware buffers of the new meshes are only created, if the original meshes have hardware buffers.
+\note The switch distances do not consider the scaling of the scene node.
+\throws NullPointerException If 'geometry' is null.
+\see LODGeometry::lodDistances
+*/
+FORK_EXPORT std::shared_ptr<LODGeometry> GenerateLODGeometry(
+    const GeometryPtr& geometry, const LODDescription& desc = LODDescription()
+);
+
 /**
 Optimizes the specified geometry graph. This will optimize especially the texture usages,
 i.e. it will group geometry to a composition which uses the same texture constellation.
 This is done in several optimization passes like it's usual in optimizing compilers.
+The last pass welds the vertices and optimizes the vertex cache of all triangle mesh geometries.
 \note After this call, the bounding volumes should be updated!
 \see Geometry::ComputeBoundingVolumes
 */
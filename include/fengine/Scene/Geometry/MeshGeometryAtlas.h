@@ -10,6 +10,9 @@
 
 
 #include "Scene/Geometry/Node/MeshGeometry.h"
+#include "Scene/Node/CameraNode.h"
+#include "Math/Geometry/AABB.h"
+#include "Math/Core/Vector3.h"
 
 #include <vector>
 
@@ -24,6 +27,10 @@ namespace Scene
 /**
 Mesh geometry atlas class. This class holds a list of
 mesh partitions (with first vertex index and number of vertices).
+Partitions can also be recorded as mesh clusters with their own bounds,
+so that only the visible draw ranges of a large mesh must be rendered.
+\see GeometryConverter::GenerateMeshClusters
+\see CullPartitions
 */
 class FORK_EXPORT MeshGeometryAtlas
 {
@@ -33,12 +40,39 @@ class FORK_EXPORT MeshGeometryAtlas
         //! Atlas partition structure.
         struct Partition
         {
-            unsigned int numVertices = 0;
-            unsigned int firstVertex = 0;
+            unsigned int    numVertices = 0;    //!< Number of vertices to draw (or rather number of indices for indexed geometries).
+            unsigned int    firstVertex = 0;    //!< First vertex (or rather index offset for indexed geometries).
+            unsigned int    firstIndex  = 0;    //!< First index within the index buffer (only for indexed geometries).
+
+            /**
+            Bounding box of the partition (in object space).
+            By default invalid, i.e. the partition has no bounds and is never culled.
+            */
+            Math::AABB3f    box;
+
+            Math::Point3f   coneApex;           //!< Apex of the normal cone.
+            Math::Vector3f  coneAxis;           //!< Normalized axis of the normal cone.
+            /**
+            Sine of the normal cone angle. All triangles are back-facing,
+            if the angle between the cone axis and the direction from the viewer to the cone apex is less than the arc cosine of this value.
+            If this is greater than or equal to 1, the partition is never back-face culled. By default 1.
+            */
+            float           coneCutoff  = 1.0f;
         };
 
         MeshGeometryAtlas(const MeshGeometry& geometry);
 
+        /**
+        Returns true if the specified partition is potentially visible.
+        \param[in] partition Specifies the partition which is to be tested.
+        \param[in] frustum Specifies the view frustum (in object space).
+        \param[in] viewPosition Specifies the view position (in object space).
+        \remarks The back-face cone test assumes a perspective projection.
+        */
+        static bool IsPartitionVisible(
+            const Partition& partition, const ViewFrustum& frustum, const Math::Point3f& viewPosition
+        );
+
         /**
         Records a new mesh partition. This depends on the current
         number of vertices and indices and the previous partition.
@@ -47,6 +81,29 @@ class FORK_EXPORT MeshGeometryAtlas
         */
         Partition RecordPartition();
 
+        /**
+        Records the specified mesh clusters as new partitions. This depends on the current
+        number of vertices and indices and the previous partition (like "RecordPartition").
+        \param[in] clusters Specifies the clusters, whose index ranges refer to the indices
+        which have been added to the geometry since the previous partition.
+        \throws InvalidArgumentException If any cluster range is out of the range of the new indices.
+        \see GeometryConverter::GenerateMeshClusters
+        */
+        void RecordClusters(const std::vector<Partition>& clusters);
+
+        /**
+        Culls all partitions against the view frustum and their back-face cones.
+        \param[in] frustum Specifies the view frustum (in object space).
+        \param[in] viewPosition Specifies the view position (in object space).
+        \param[out] drawRanges Specifies the output list of the visible draw ranges. The list is not cleared.
+        Successive visible partitions are merged into a single draw range, which only has valid range members.
+        \return Number of visible partitions.
+        \see IsPartitionVisible
+        */
+        size_t CullPartitions(
+            const ViewFrustum& frustum, const Math::Point3f& viewPosition, std::vector<Partition>& drawRanges
+        ) const;
+
         //! Returns the list of all atlases.
         inline const std::vector<Partition>& GetPartitions() const
         {
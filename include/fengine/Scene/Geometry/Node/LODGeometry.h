@@ -56,11 +56,23 @@ class FORK_EXPORT LODGeometry : public Geometry
         \param[in] maxDistance Specifies the maximal distance.
         If (distance >= maxDistance) the last geometry will be selected. Must be greater than 'minDistance'.
         \return Raw-pointer to the selected goemetry or null if the geometry list (lodGeometries) is empty.
+        \remarks If 'lodDistances' is not empty, the level is selected by these distances instead.
         \see SetThreshold
         \see lodGeometries
+        \see lodDistances
         */
         virtual Geometry* SelectLOD(float distance) const;
 
+        /**
+        Selects the index of a specific level-of-detail geometry by the given distance.
+        \return Index of the selected geometry (in the range [0 .. lodGeometries.size()) ),
+        or 0 if the geometry list (lodGeometries) is empty.
+        \remarks The selection is monotonic, i.e. a greater distance never selects a higher level-of-detail.
+        \see SelectLOD
+        \see LODSelector
+        */
+        size_t SelectLODIndex(float distance) const;
+
         /**
         Sets up the minimal and maximal distances.
         \param[in] minDistance Specifies the minimal distance in which applies: 0 <= minDistance < maxDistance.
@@ -104,6 +116,13 @@ class FORK_EXPORT LODGeometry : public Geometry
         */
         std::vector<GeometryPtr> lodGeometries;
 
+        /**
+        Optional switch distances: lodDistances[i] is the distance from which lodGeometries[i + 1] is selected.
+        The distances must be in ascending order. If this is empty, the level is selected by the range and threshold.
+        \see GeometryConverter::GenerateLODGeometry
+        */
+        std::vector<float> lodDistances;
+
     private:
         
         float minDistance_  = 10.0f;    //!< Minimal distance.
@@ -11,6 +11,7 @@
 
 #include "Scene/Geometry/Node/Geometry.h"
 #include "Scene/Geometry/Node/TerrainMeshGeometry.h"
+#include "Scene/Terrain/TerrainQuadTree.h"
 
 
 namespace Fork
@@ -24,7 +25,12 @@ namespace Scene
 Terrain geometry class. This should always be a child node (or children's child node)
 of a "TexturedGeometry", because the terrain needs at least a single height field texture,
 which is used by the respective vertex shader to transform the terrain vertices.
+If a quad-tree is specified, the visible quad-tree nodes can be selected with CDLOD (see SelectNodes).
+\note This only provides the CPU-side selection: the scene renderers do not draw the selected nodes yet.
+A terrain renderer must render the template geometry once for each selected node and morph the vertices
+in its vertex shader (see TerrainQuadTree::MorphVertex for the reference implementation).
 \see TerrainMeshGeometry
+\see TerrainQuadTree
 \ingroup std_geometries
 */
 class FORK_EXPORT TerrainGeometry : public Geometry
@@ -49,11 +55,17 @@ class FORK_EXPORT TerrainGeometry : public Geometry
         Types Type() const override;
 
         /**
-        Copies the bounding volume of the actual geometry.
-        \todo Incomplete (bounding volume works differently for terrains!).
+        Computes the bounding volume from the quad-tree, which includes the height field.
+        If no quad-tree has been built, the bounding volume of the template geometry is copied.
         */
         void ComputeBoundingVolume() override;
 
+        /**
+        Selects the quad-tree nodes, which are to be rendered. This is not called by the scene renderers.
+        \see TerrainQuadTree::Select
+        */
+        void SelectNodes(const ViewFrustum& frustum, const Math::Point3f& cameraPosition, std::vector<TerrainNodeSelection>& selection) const;
+
         /* === Members === */
 
         /**
@@ -63,12 +75,27 @@ class FORK_EXPORT TerrainGeometry : public Geometry
         */
         TerrainMeshGeometryPtr templateGeometry;
 
+        /**
+        CDLOD quad-tree with the node bounds of the height field.
+        The grid size of the template geometry must match the leaf node size of the quad-tree.
+        \see TerrainQuadTree::Description::leafNodeSize
+        */
+        TerrainQuadTreePtr quadTree;
+
+        /**
+        Tile cache of the height field. The height tiles are paged in on demand (e.g. for height queries),
+        so the height field of very large terrains never needs to be entirely resident.
+        \see TerrainTileCache
+        */
+        TerrainTileCachePtr tileCache;
+
         /**
         Specifies the number of geometry MIP levels to render the terrain.
         If this is 0, no geometry will be rendered.
         If this is 1, only a single geometry LOD (level-of-detail) will be rendered for the entire terrain.
         If this is 2+, several geometry MIP levels will be rendered depending on the view camera distance to the terrain.
         By default 5.
+        \remarks This is ignored if a quad-tree is specified (see TerrainQuadTree::NumLODLevels).
         */
         unsigned short geoMIPLevels = 5;
 
@@ -10,6 +10,7 @@
 
 
 #include "Scene/Node/SceneNode.h"
+#include "Scene/Node/GlobalTransformCache.h"
 
 #include <vector>
 
@@ -67,6 +68,20 @@ class FORK_EXPORT Skeleton
                 //! Returns the global transformation of this joint.
                 Math::Matrix4f GlobalTransform() const;
 
+                /**
+                Returns the cached global transformation of this joint. The cache is only recomputed
+                if the local transformation of this joint or of one of its parents has been modified.
+                \note This function modifies a 'mutable' member. Recall that when you use this class with multi-threading!
+                */
+                const Math::Matrix4f& CachedGlobalTransform() const;
+
+                /**
+                Updates the cached global transformations of this joint and all its children in a single top-down pass.
+                This should be called from the root joint, e.g. after a skeletal animation has been updated.
+                \see CachedGlobalTransform
+                */
+                void UpdateGlobalTransforms();
+
                 /**
                 Fills the specified 4x4 matrix buffer with the matrices of this and all children joint nodes.
                 The hierarchy traversal is done in 'pre-order depth-first-search' (DFS).
@@ -175,6 +190,8 @@ class FORK_EXPORT Skeleton
 
                 Math::Matrix4f  originMatrix_;  //!< Origin matrix is the inverse parent matrix.
 
+                mutable GlobalTransformCache globalTransformCache_;
+
         };
 
         //! Root skeleton joint. This joint has no parent joint.
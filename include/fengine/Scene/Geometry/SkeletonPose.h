@@ -0,0 +1,175 @@
+/*
+ * Skeleton pose header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_SKELETON_POSE_H__
+#define __FORK_SKELETON_POSE_H__
+
+
+#include "Scene/Geometry/FlatSkeleton.h"
+
+#include <vector>
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+DECL_SHR_PTR(SkeletonPose);
+
+/**
+Skeleton pose class. This stores the animated state of a single character for a (shared) flat skeleton:
+the local joint transformations as structure of arrays (SoA), and the resulting model- and skinning matrices.
+\code
+// Setup (once per skeleton and once per character)
+skeleton->rootJoint.UpdateOriginMatrix();
+auto flatSkeleton = std::make_shared<Scene::FlatSkeleton>(*skeleton);
+auto pose = std::make_shared<Scene::SkeletonPose>(flatSkeleton);
+
+// Per frame
+pose->SetLocalTransform(jointIndex, transform);
+pose->UpdateMatrices();
+std::copy(pose->GetSkinMatrices().begin(), pose->GetSkinMatrices().end(), vertexParam.matrices);
+renderSystem->UpdateBuffer(vertexConstBuffer.get(), vertexParam);
+\endcode
+\see FlatSkeleton
+*/
+class FORK_EXPORT SkeletonPose
+{
+
+    public:
+
+        //! Local joint transformations as structure of arrays. All arrays have the same size (a multiple of 4).
+        struct FORK_EXPORT LocalTransforms
+        {
+            /**
+            Resizes all arrays for the specified number of joints (rounded up to a multiple of 4).
+            New entries are initialized with the identity transformation.
+            */
+            void Resize(size_t numJoints);
+
+            //! Sets the transformation of the specified joint.
+            void SetTransform(size_t index, const Math::Transform3Df& transform);
+            //! Returns the transformation of the specified joint.
+            Math::Transform3Df GetTransform(size_t index) const;
+
+            //! Returns the size of all arrays.
+            inline size_t Size() const
+            {
+                return positionX.size();
+            }
+
+            std::vector<float> positionX, positionY, positionZ;
+            std::vector<float> rotationX, rotationY, rotationZ, rotationW;
+            std::vector<float> scaleX, scaleY, scaleZ;
+        };
+
+        /**
+        Creates a new skeleton pose for the specified flat skeleton. The local transformations are initialized with the bind pose.
+        \throws NullPointerException If 'skeleton' is null.
+        */
+        SkeletonPose(const FlatSkeletonPtr& skeleton);
+
+        //! Resets the local transformations to the bind pose of the flat skeleton.
+        void ResetToBindPose();
+
+        /**
+        Sets the local transformation of the specified joint.
+        \param[in] index Specifies the joint index. This must be in the range [0 .. NumJoints()).
+        \see FlatSkeleton::FindJoint
+        */
+        void SetLocalTransform(size_t index, const Math::Transform3Df& transform);
+        //! Returns the local transformation of the specified joint.
+        Math::Transform3Df GetLocalTransform(size_t index) const;
+
+        /**
+        Updates the model- and skinning matrices of all joints in a single linear pass.
+        The local matrices are generated from the SoA transformations four joints at a time (with SSE if available).
+        */
+        void UpdateMatrices();
+
+        /**
+        Updates the matrices of all specified poses in parallel (see Jobs::JobSystem).
+        \param[in] poses Specifies the list of poses. Null pointers are ignored.
+        \see UpdateMatrices()
+        */
+        static void UpdateMatrices(const std::vector<SkeletonPose*>& poses);
+
+        //! Returns the number of joints.
+        inline size_t NumJoints() const
+        {
+            return skeleton_->NumJoints();
+        }
+
+        //! Returns the flat skeleton this pose refers to.
+        inline const FlatSkeleton* GetSkeleton() const
+        {
+            return skeleton_.get();
+        }
+
+        //! Returns the local joint transformations.
+        inline const LocalTransforms& GetLocalTransforms() const
+        {
+            return localTransforms_;
+        }
+        /**
+        Returns the local joint transformations for direct modification (e.g. by an animation mixer).
+        \note The arrays must not be resized.
+        */
+        inline LocalTransforms& GetLocalTransforms()
+        {
+            return localTransforms_;
+        }
+
+        /**
+        Returns the list of model matrices, i.e. the global transformations of all joints relative to the skeleton root.
+        This will be updated when "UpdateMatrices" is called.
+        \see UpdateMatrices
+        */
+        inline const std::vector<Math::Matrix4f>& GetModelMatrices() const
+        {
+            return modelMatrices_;
+        }
+
+        /**
+        Returns the list of skinning matrices, i.e. the model matrices multiplied by the origin matrices.
+        This is the same as Skeleton::Joint::FillMatrixBuffer with 'isGlobal' and 'isRelative' set to true.
+        This will be updated when "UpdateMatrices" is called.
+        \see UpdateMatrices
+        */
+        inline const std::vector<Math::Matrix4f>& GetSkinMatrices() const
+        {
+            return skinMatrices_;
+        }
+
+    private:
+
+        void ConvertLocalTransforms(size_t first);
+
+        FlatSkeletonPtr             skeleton_;
+
+        LocalTransforms             localTransforms_;
+
+        std::vector<Math::Matrix4f> localMatrices_;
+        std::vector<Math::Matrix4f> modelMatrices_;
+        std::vector<Math::Matrix4f> skinMatrices_;
+
+};
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
@@ -0,0 +1,183 @@
+/*
+ * Skin weights header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_SKIN_WEIGHTS_H__
+#define __FORK_SKIN_WEIGHTS_H__
+
+
+#include "Scene/Geometry/FlatSkeleton.h"
+#include "Scene/Geometry/SkeletonPose.h"
+#include "Scene/Geometry/BoundingVolume.h"
+#include "Video/BufferFormat/AttributeIterator.h"
+#include "Core/Exception/InvalidArgumentException.h"
+#include "Math/Geometry/AABB.h"
+
+#include <vector>
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+DECL_SHR_PTR(SkinWeights);
+
+/**
+Vertex-major skin weights for CPU skinning. The joint-major vertex weights of a skeleton (see Skeleton::Joint::weights)
+are repacked into a structure of arrays with up to four influences per vertex, which is used for linear blend skinning
+of vertex positions and normals (with SSE/AVX if available, and in parallel over blocks of vertices).
+\code
+// Setup (once per mesh)
+skeleton->rootJoint.UpdateOriginMatrix();
+auto flatSkeleton = std::make_shared<Scene::FlatSkeleton>(*skeleton);
+Scene::SkinWeights skinWeights(*flatSkeleton, bindVertices.size());
+
+// Per frame (e.g. on a server for physics or picking)
+pose->UpdateMatrices();
+skinWeights.SkinMesh(*pose, bindVertices, *mesh);
+\endcode
+\see SkeletonPose
+*/
+class FORK_EXPORT SkinWeights
+{
+
+    public:
+
+        //! Maximal number of joint influences per vertex.
+        static const size_t maxNumInfluences = 4;
+
+        /**
+        Builds the vertex-major skin weights out of the vertex weights of all joints of the specified flat skeleton.
+        For each vertex the (up to) four largest weights are used and normalized. Vertices without any weight are bound to the root joint.
+        \param[in] skeleton Specifies the flat skeleton. The joint indices refer to this skeleton.
+        \param[in] numVertices Specifies the number of vertices of the skinned mesh.
+        \throws InvalidArgumentException If a vertex weight refers to a vertex index out of range.
+        */
+        SkinWeights(const FlatSkeleton& skeleton, size_t numVertices);
+
+        /**
+        Transforms the bind pose vertices by the specified skinning matrices (linear blend skinning).
+        \param[in] skinMatrices Specifies the skinning matrices (one for each joint, see SkeletonPose::GetSkinMatrices).
+        \param[in] srcPositions Specifies the bind pose vertex positions (Math::Point3f).
+        \param[in] srcNormals Optional pointer to the bind pose vertex normals (Math::Vector3f). May be null.
+        \param[out] dstPositions Specifies the skinned vertex positions. This must not overlap with the source attributes.
+        \param[out] dstNormals Optional pointer to the skinned vertex normals (normalized). Must be null if 'srcNormals' is null.
+        \param[out] boundingVolume Optional pointer to a bounding volume, which receives the bounds of the skinned positions. By default null.
+        \throws InvalidArgumentException If there are not enough skinning matrices, the number of attributes does not match
+        the number of vertices, or only one of the normal iterators is specified.
+        \remarks The vertices are processed in parallel (see Jobs::JobSystem). This function does not modify the skin weights,
+        so several meshes (e.g. the characters of a crowd) can be skinned with the same skin weights at once.
+        */
+        void Skin(
+            const std::vector<Math::Matrix4f>& skinMatrices,
+            const Video::AttributeConstIterator& srcPositions, const Video::AttributeConstIterator* srcNormals,
+            const Video::AttributeIterator& dstPositions, const Video::AttributeIterator* dstNormals,
+            BoundingVolume* boundingVolume = nullptr
+        ) const;
+
+        //! Transforms the bind pose vertices by the skinning matrices of the specified pose. \see Skin
+        void Skin(
+            const SkeletonPose& pose,
+            const Video::AttributeConstIterator& srcPositions, const Video::AttributeConstIterator* srcNormals,
+            const Video::AttributeIterator& dstPositions, const Video::AttributeIterator* dstNormals,
+            BoundingVolume* boundingVolume = nullptr
+        ) const;
+
+        /**
+        Transforms the bind pose vertices into the vertices of the specified mesh geometry, updates its bounding volume
+        and re-uploads its vertex buffer (if it has already been created).
+        \tparam MeshT Specifies the mesh geometry type. This must be a Scene::BaseMeshGeometry (e.g. Scene::Simple3DMeshGeometry),
+        whose vertex type has the 'coord' and 'normal' attributes.
+        \tparam VtxT Specifies the vertex type of the mesh geometry.
+        \param[in] pose Specifies the skeleton pose. Its matrices must have been updated.
+        \param[in] bindVertices Specifies the bind pose vertices. This must have the same size as the mesh vertices.
+        \param[in,out] mesh Specifies the mesh geometry which receives the skinned vertices.
+        \throws InvalidArgumentException If the number of vertices does not match.
+        \see Skin
+        */
+        template <class MeshT, class VtxT> void SkinMesh(const SkeletonPose& pose, const std::vector<VtxT>& bindVertices, MeshT& mesh) const
+        {
+            if (bindVertices.size() != numVertices_ || mesh.vertices.size() != numVertices_)
+                throw InvalidArgumentException(__FUNCTION__, "bindVertices", "Number of vertices does not match the skin weights");
+            if (numVertices_ == 0)
+                return;
+
+            const Video::AttributeConstIterator srcNormals(&(bindVertices[0].normal), numVertices_, sizeof(VtxT));
+            const Video::AttributeIterator dstNormals(&(mesh.vertices[0].normal), numVertices_, sizeof(VtxT));
+
+            Skin(
+                pose,
+                Video::AttributeConstIterator(&(bindVertices[0].coord), numVertices_, sizeof(VtxT)), &srcNormals,
+                Video::AttributeIterator(&(mesh.vertices[0].coord), numVertices_, sizeof(VtxT)), &dstNormals,
+                &(mesh.boundingVolume)
+            );
+
+            if (mesh.GetVertexBuffer())
+                mesh.UpdateVertexBuffer();
+        }
+
+        //! Returns the number of vertices.
+        inline size_t NumVertices() const
+        {
+            return numVertices_;
+        }
+
+        //! Returns the number of joints of the flat skeleton these skin weights refer to.
+        inline size_t NumJoints() const
+        {
+            return numJoints_;
+        }
+
+        //! Returns the number of influences for each vertex (in the range [1 .. maxNumInfluences]).
+        inline const std::vector<unsigned char>& GetNumInfluences() const
+        {
+            return numInfluences_;
+        }
+
+        //! Returns the joint indices of the specified influence slot for all vertices.
+        inline const std::vector<unsigned int>& GetJointIndices(size_t influence) const
+        {
+            return jointIndices_[influence];
+        }
+
+        //! Returns the (normalized) weights of the specified influence slot for all vertices.
+        inline const std::vector<float>& GetWeights(size_t influence) const
+        {
+            return weights_[influence];
+        }
+
+    private:
+
+        void SkinVertices(
+            size_t begin, size_t end, const Math::Matrix4f* skinMatrices,
+            const Video::AttributeConstIterator& srcPositions, const Video::AttributeConstIterator* srcNormals,
+            const Video::AttributeIterator& dstPositions, const Video::AttributeIterator* dstNormals,
+            Math::AABB3f& box
+        ) const;
+
+        size_t                      numVertices_    = 0;
+        size_t                      numJoints_      = 0;
+
+        std::vector<unsigned char>  numInfluences_;
+        std::vector<unsigned int>   jointIndices_[maxNumInfluences];
+        std::vector<float>          weights_[maxNumInfluences];
+
+};
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
@@ -0,0 +1,192 @@
+/*
+ * Bounding volume hierarchy header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_SCENE_BOUNDING_VOLUME_HIERARCHY_H__
+#define __FORK_SCENE_BOUNDING_VOLUME_HIERARCHY_H__
+
+
+#include "Core/Export.h"
+#include "Math/Geometry/AABB.h"
+#include "Math/Geometry/Ray.h"
+#include "Scene/Node/SceneNode.h"
+
+#include <vector>
+#include <limits>
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+/**
+Dynamic bounding volume hierarchy (or rather AABB tree) for spatial scene queries.
+Each leaf (or rather proxy) refers to a geometry node and its world-space bounding box.
+The tree is built incrementally: proxies can be inserted, removed and moved at any time,
+and the tree is kept balanced with tree rotations after each insertion and removal.
+\remarks Internal nodes store "fat" boxes, i.e. leaf boxes enlarged by a margin.
+Thus moving a proxy only changes the tree structure when its box leaves the fat box.
+\see SceneManager::UpdateBoundingVolumeHierarchy
+*/
+class FORK_EXPORT BoundingVolumeHierarchy
+{
+
+    public:
+
+        //! Proxy ID type. This is the index of the leaf node.
+        typedef unsigned int ProxyID;
+
+        //! Invalid proxy ID.
+        static const ProxyID invalidProxy = ~0u;
+
+        //! Ray query hit structure.
+        struct RayHit
+        {
+            GeometryNode*   node;       //!< Raw-pointer to the geometry node which has been hit.
+            float           distance;   //!< Distance from the ray origin to the entry point of the node's bounding box.
+        };
+
+        /**
+        Bounding volume hierarchy constructor.
+        \param[in] margin Specifies the margin by which the leaf boxes are enlarged. By default 0.1.
+        */
+        BoundingVolumeHierarchy(float margin = 0.1f);
+
+        /* === Functions === */
+
+        /**
+        Inserts a new proxy into the hierarchy.
+        \param[in] box Specifies the world-space bounding box. This must be a valid box.
+        \param[in] node Raw-pointer to the geometry node, which will be returned by the queries.
+        \return ID of the new proxy.
+        */
+        ProxyID InsertProxy(const Math::AABB3f& box, GeometryNode* node);
+        /**
+        Removes the specified proxy from the hierarchy.
+        \throws InvalidArgumentException If 'proxy' is not a valid proxy ID.
+        */
+        void RemoveProxy(ProxyID proxy);
+        /**
+        Moves the specified proxy to the new bounding box. If the new box is still
+        enclosed by the fat box of the proxy, only the leaf box will be updated (refit).
+        \return True if the proxy has been re-inserted into the hierarchy.
+        \throws InvalidArgumentException If 'proxy' is not a valid proxy ID.
+        */
+        bool MoveProxy(ProxyID proxy, const Math::AABB3f& box);
+
+        //! Removes all proxies from the hierarchy.
+        void Clear();
+
+        /**
+        Collects all geometry nodes whose bounding boxes intersect the specified view frustum.
+        Subtrees which are completely outside the frustum are culled at once,
+        and subtrees which are completely inside the frustum are collected without further tests.
+        Planes which a subtree is completely in front of are not tested again for its children.
+        \param[in] frustum Specifies the world-space view frustum. Its planes must point into the frustum.
+        \param[out] nodes Specifies the output list. The nodes will be appended.
+        */
+        void QueryFrustum(const ViewFrustum& frustum, std::vector<GeometryNode*>& nodes) const;
+
+        /**
+        Collects all geometry nodes whose bounding boxes are hit by the specified ray.
+        \param[in] ray Specifies the world-space ray.
+        \param[out] hits Specifies the output list. The hits will be appended and the whole list is sorted by distance.
+        \param[in] maxDistance Specifies the maximal distance along the ray. By default unlimited.
+        */
+        void QueryRay(
+            const Math::Ray3f& ray, std::vector<RayHit>& hits,
+            float maxDistance = std::numeric_limits<float>::max()
+        ) const;
+
+        /**
+        Collects all geometry nodes whose bounding boxes overlap the specified box.
+        \param[in] box Specifies the world-space box.
+        \param[out] nodes Specifies the output list. The nodes will be appended.
+        */
+        void QueryOverlap(const Math::AABB3f& box, std::vector<GeometryNode*>& nodes) const;
+
+        //! Returns the height of the hierarchy. This is 0 for an empty hierarchy and 1 for a single proxy.
+        unsigned int Height() const;
+
+        //! Returns the geometry node of the specified proxy.
+        GeometryNode* GetProxyNode(ProxyID proxy) const;
+        //! Returns the (tight) world-space bounding box of the specified proxy.
+        const Math::AABB3f& GetProxyBox(ProxyID proxy) const;
+
+        //! Returns the number of proxies.
+        inline size_t NumProxies() const
+        {
+            return numProxies_;
+        }
+
+        //! Returns the margin by which the leaf boxes are enlarged.
+        inline float GetMargin() const
+        {
+            return margin_;
+        }
+
+    private:
+
+        /* === Structures === */
+
+        struct Node
+        {
+            inline bool IsLeaf() const
+            {
+                return children[0] == invalidProxy;
+            }
+
+            Math::AABB3f    box;                                    //!< Fat box (enclosing all children).
+            Math::AABB3f    leafBox;                                //!< Tight box (only used for leaves).
+            GeometryNode*   sceneNode   = nullptr;                  //!< Geometry node (only used for leaves).
+            ProxyID         parent      = invalidProxy;             //!< Parent node, or next free node if this node is unused.
+            ProxyID         children[2] { invalidProxy, invalidProxy };
+            int             height      = -1;                       //!< Node height (0 for leaves, -1 for unused nodes).
+        };
+
+        /* === Functions === */
+
+        ProxyID AllocateNode();
+        void FreeNode(ProxyID index);
+
+        void InsertLeaf(ProxyID leaf);
+        void RemoveLeaf(ProxyID leaf);
+
+        //! Balances the subtree of the specified node with a single tree rotation. Returns the new subtree root.
+        ProxyID Balance(ProxyID index);
+
+        //! Refits the boxes and heights from the specified node up to the root.
+        void RefitAncestors(ProxyID index);
+
+        const Node& GetLeafNode(ProxyID proxy) const;
+
+        /* === Members === */
+
+        std::vector<Node>   nodes_;
+
+        ProxyID             root_       = invalidProxy;
+        ProxyID             freeList_   = invalidProxy;
+
+        size_t              numProxies_ = 0;
+
+        float               margin_     = 0.1f;
+
+};
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
@@ -69,11 +69,40 @@ class FORK_EXPORT CullingManager
         bool IsBoundingBoxInsideFrustum(const Math::AABB3f& boundingBox) const;
         /**
         Tests the specified bounding sphere against the current view frustum.
+        \remarks The sphere is transformed by the current world matrix. For non-uniform scaled
+        world matrices, the largest scale factor is used for the radius, i.e. the test is conservative.
         \see IsBoundingVolumeInsideFrustum
-        \todo Incomplete!
         */
         bool IsBoundingSphereInsideFrustum(const Math::Sphere<>& boundingSphere) const;
 
+        /**
+        Tests all specified bounding boxes (in world space) against the current view frustum.
+        The current world matrix is ignored, since each box must already be in world space.
+        \param[in] boxes Raw-pointer to the contiguous array of world-space bounding boxes.
+        \param[in] numBoxes Specifies the number of bounding boxes.
+        \param[out] visibilityMask Raw-pointer to the output bitmask. Bit (i % 32) of visibilityMask[i / 32]
+        will be set if the i-th box is (at least partially) inside the view frustum. This array must have at least (numBoxes + 31) / 32 entries.
+        \remarks This uses SSE2 or AVX (depending on the static configuration) to test 4 or 8 boxes at once
+        against each frustum plane, with the "p-vertex" test (box center and extent against the plane).
+        Otherwise a scalar fallback is used.
+        \throws NullPointerException If 'boxes' or 'visibilityMask' is null while 'numBoxes' is greater than zero.
+        \see SetupViewMatrix
+        */
+        void CullBoundingBoxes(const Math::AABB3f* boxes, size_t numBoxes, unsigned int* visibilityMask) const;
+
+        /**
+        Tests all specified bounding spheres (in world space) against the current view frustum.
+        \see CullBoundingBoxes
+        \throws NullPointerException If 'spheres' or 'visibilityMask' is null while 'numSpheres' is greater than zero.
+        */
+        void CullBoundingSpheres(const Math::Sphere<>* spheres, size_t numSpheres, unsigned int* visibilityMask) const;
+
+        //! Returns the current (world-space) view frustum.
+        inline const ViewFrustum& GetViewFrustum() const
+        {
+            return viewFrustum_;
+        }
+
         /**
         Specifies whether culling is enabled or disabled. If this is false,
         all culling testing functions will alreadys return true. By default true.
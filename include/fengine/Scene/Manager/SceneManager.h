@@ -13,13 +13,18 @@
 #include "Core/DeclPtr.h"
 #include "Core/Container/SharedHashMap.h"
 #include "Scene/Node/SceneNode.h"
+#include "Scene/Manager/BoundingVolumeHierarchy.h"
 #include "Scene/LightSource/LightSource.h"
 #include "Scene/Geometry/Node/Geometry.h"
 #include "Scene/Geometry/Generator/GeometryGenerator.h"
 #include "Scene/FileHandler/ModelReader.h"
+#include "Scene/FileHandler/ModelFileHandler.h"
+#include "Core/Jobs/AsyncResult.h"
+#include "Core/Jobs/JobCounter.h"
 
 #include <vector>
 #include <string>
+#include <unordered_map>
 
 
 namespace Fork
@@ -31,6 +36,10 @@ namespace Scene
 
 DECL_SHR_PTR(SceneManager);
 
+//! Asynchronous geometry handle. \see SceneManager::LoadGeometryAsync
+typedef Jobs::AsyncResult<GeometryPtr> AsyncGeometry;
+typedef Jobs::AsyncResultPtr<GeometryPtr> AsyncGeometryPtr;
+
 //! Scene node base class.
 class FORK_EXPORT SceneManager
 {
@@ -58,6 +67,29 @@ class FORK_EXPORT SceneManager
         */
         GeometryPtr LoadGeometry(const std::string& filename, const ModelReader::Flags::DataType flags = 0);
 
+        /**
+        Loads a geometry asynchronously. The model file is read (and optimized) on the job system,
+        its textures are loaded with "TextureManager::LoadTexture2DAsync",
+        and the hardware buffers are created on the render thread by "CommitAsyncLoads".
+        Like with "LoadGeometry", geometries which are loaded with flags 0 are shared.
+        \return Shared pointer to the asynchronous geometry handle. This is never null.
+        \see CommitAsyncLoads
+        \see LoadGeometry
+        */
+        AsyncGeometryPtr LoadGeometryAsync(const std::string& filename, const ModelReader::Flags::DataType flags = 0);
+
+        /**
+        Commits the asynchronous texture and geometry loads, i.e. creates their GPU resources and resolves their handles.
+        Call this once per frame on the render thread.
+        \param[in] byteBudget Specifies the maximal number of bytes, which are uploaded to the GPU in this call,
+        for the textures and for the hardware buffers respectively. At least one texture and one mesh are uploaded per call.
+        If this is 0, the budget is unlimited.
+        \return Number of asynchronous geometry loads, which are still pending.
+        \see LoadGeometryAsync
+        \see Video::TextureManager::CommitAsyncTextures
+        */
+        size_t CommitAsyncLoads(size_t byteBudget);
+
         GeometryGenerator::GeometryTypePtr GenerateCube     (const GeometryGenerator::CubeDescription&      desc = GeometryGenerator::CubeDescription       ());
         GeometryGenerator::GeometryTypePtr GenerateWireCube (const GeometryGenerator::CubeDescription&      desc = GeometryGenerator::CubeDescription       ());
         GeometryGenerator::GeometryTypePtr GenerateCone     (const GeometryGenerator::ConeDescription&      desc = GeometryGenerator::ConeDescription       ());
@@ -84,6 +116,28 @@ class FORK_EXPORT SceneManager
         void ReleaseSceneNode(const SceneNode* sceneNode);
         void ReleaseAllSceneNodes();
 
+        /* --- Spatial functions --- */
+
+        /**
+        Updates the bounding volume hierarchy for all geometry nodes, which have been created by this scene manager.
+        The world-space bounding box of each node is computed from its geometry's bounding box and its global transformation.
+        Nodes without geometry (or without a valid bounding box) are removed from the hierarchy.
+        \remarks Call this once per frame, after all scene nodes have been moved.
+        Moving a node only changes the hierarchy structure, when it leaves its "fat" box.
+        \see BoundingVolumeHierarchy::MoveProxy
+        */
+        void UpdateBoundingVolumeHierarchy();
+
+        /**
+        Returns the bounding volume hierarchy of all geometry nodes, which have been created by this scene manager.
+        Use this for frustum, ray (e.g. picking) and overlap (e.g. triggers) queries.
+        \see UpdateBoundingVolumeHierarchy
+        */
+        inline const BoundingVolumeHierarchy& GetBoundingVolumeHierarchy() const
+        {
+            return boundingVolumeHierarchy_;
+        }
+
         /* === Members === */
 
         /**
@@ -147,9 +201,55 @@ class FORK_EXPORT SceneManager
 
     private:
 
+        /* === Structures === */
+
+        struct GeometryNodeProxy
+        {
+            GeometryNode*                       node;
+            BoundingVolumeHierarchy::ProxyID    proxy;
+        };
+
+        //! Asynchronous geometry load. The job counter is shared by the read and the finalize job.
+        struct AsyncGeometryLoad
+        {
+            enum class States
+            {
+                Reading,        //!< The model file is being read on the job system.
+                LoadingTextures,//!< Waiting for the asynchronous textures.
+                Finalizing,     //!< The model is being finalized (optimized) on the job system.
+                Uploading,      //!< The hardware buffers are being created on the render thread.
+            };
+
+            std::string                         filename;
+            ModelReader::Flags::DataType        flags       = 0;
+            AsyncGeometryPtr                    handle;
+            States                              state       = States::Reading;
+            Jobs::JobCounter                    counter;
+
+            GeometryPtr                         model;
+            ModelFileHandler::DeferredResources resources;
+
+            std::vector<Geometry*>              meshes;             //!< Meshes, whose hardware buffers must be created.
+            size_t                              numUploadedMeshes   = 0;
+        };
+
+        typedef std::shared_ptr<AsyncGeometryLoad> AsyncGeometryLoadPtr;
+
+        /* === Functions === */
+
         template <class GenProc, class Desc, class Container>
         GeometryGenerator::GeometryTypePtr GenerateBasicGeometry(GenProc genProc, const Desc& desc, Container& container);
 
+        //! Advances the specified asynchronous load. Returns true when the load is finished (or has failed).
+        bool CommitAsyncLoad(const AsyncGeometryLoadPtr& load, size_t byteBudget, size_t& numUploadedBytes);
+
+        /* === Members === */
+
+        BoundingVolumeHierarchy                                         boundingVolumeHierarchy_;
+        std::unordered_map<const SceneNode*, GeometryNodeProxy>         geometryNodeProxies_;
+
+        std::vector<AsyncGeometryLoadPtr>                               asyncLoads_;
+
 };
 
 
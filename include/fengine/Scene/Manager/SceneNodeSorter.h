@@ -31,7 +31,12 @@ enum class SortMethods
 {
     NearToFar,              //!< Sort all objects from near to far.
     FarToNear,              //!< Sort all objects from far to near.
-    OpaqueToTransparent,    //!< Sort opaque (near to far) to transparent (far to near).
+    /**
+    Sort opaque (near to far) to transparent (far to near).
+    Opaque objects are additionally grouped by their render states (shader and textures) within coarse depth layers.
+    An object is transparent, if its textured geometry has a material whose color alpha channel is less than 1.
+    */
+    OpaqueToTransparent,
 };
 
 
@@ -42,6 +47,11 @@ Sorts the scene node list with the specified sort method.
 This should be the camera's transformation (in world space and not the view space!).
 \param[in] method Specifies the sort method.
 \param[in] isGlobal Specifies whether the object transformations should be global or local.
+\remarks The sort key of each scene node (view depth, opacity and render state hash) is computed only once,
+then the keys are sorted with a radix sort in linear time.
+\note If 'isGlobal' is true, the global transformations are computed with "SceneNode::GlobalTransform",
+which lazily updates the transformation caches of the nodes and their parents. Thus this function must not be called
+from several threads at the same time, unless these caches have been updated before (see SceneNode::UpdateGlobalTransforms).
 \see SortMethods
 \see SortSceneNodesGlobal
 */
@@ -40,7 +40,8 @@ class FORK_EXPORT DefaultSceneVisitor : public SceneVisitor
 
     protected:
         
-        void VisitSceneNodeChildren(SceneNode* node);
+        //! Visits all children of the specified scene node.
+        virtual void VisitSceneNodeChildren(SceneNode* node);
         void VisitSubGeometries(const std::vector<GeometryPtr>& subGeometries);
 
 };
@@ -10,6 +10,7 @@
 
 
 #include "Scene/Node/SceneNode.h"
+#include "Scene/Node/GlobalTransformCache.h"
 
 
 namespace Fork
@@ -39,6 +40,14 @@ class FORK_EXPORT DynamicSceneNode : public SceneNode
         void GlobalTransform(Math::Matrix4f& matrix) const;
         Math::Matrix4f GlobalTransform() const;
 
+        /**
+        Returns the cached global transformation. The cache is only recomputed if the local transformation
+        of this node or of one of its dynamic parents has been modified.
+        \note This function modifies a 'mutable' member. Recall that when you use this class with multi-threading!
+        \see SceneNode::UpdateGlobalTransforms
+        */
+        const Math::Matrix4f& CachedGlobalTransform() const;
+
         bool HasTransform() const;
 
         /**
@@ -47,6 +56,17 @@ class FORK_EXPORT DynamicSceneNode : public SceneNode
         */
         Transform transform;
 
+    protected:
+        
+        void UpdateGlobalTransformCache() override;
+
+    private:
+        
+        //! Returns the parent as dynamic scene node or null if there is no parent or the parent has no transformation.
+        const DynamicSceneNode* DynamicParent() const;
+
+        mutable GlobalTransformCache globalTransformCache_;
+
 };
 
 
@@ -57,6 +57,14 @@ class FORK_EXPORT GeometryNode : public DynamicSceneNode
         */
         Video::ShaderCompositionPtr shaderComposition;
 
+        /**
+        Optional shader composition for hardware instancing. If this is set, geometry nodes which share the same geometry
+        and shaders can be drawn with a single instanced draw call. This shader must read the world matrix
+        from the instance texture (by the instance ID) instead of the world matrix constant.
+        \see QueuedSceneRenderer::enableInstancing
+        */
+        Video::ShaderCompositionPtr instancedShaderComposition;
+
 };
 
 
@@ -0,0 +1,101 @@
+/*
+ * Global transform cache header
+ * 
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_GLOBAL_TRANSFORM_CACHE_H__
+#define __FORK_GLOBAL_TRANSFORM_CACHE_H__
+
+
+#include "Math/Core/Transform3D.h"
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+/**
+Cache for a global (or rather world) transformation of a hierarchy node (e.g. a scene node or a skeleton joint).
+The cache is outdated when the local transformation has been modified or when the parent cache has been updated.
+This is detected with revision numbers, so the 'dirty' state propagates down the hierarchy without any back references.
+\see Math::Transform3D::Revision
+*/
+class GlobalTransformCache
+{
+    
+    public:
+        
+        /**
+        Returns true if this cache is outdated.
+        \param[in] local Specifies the local transformation of the node.
+        \param[in] parent Raw-pointer to the parent's cache (which must already be up-to-date). This may also be null.
+        */
+        inline bool IsOutdated(const Math::Transform3Df& local, const GlobalTransformCache* parent) const
+        {
+            return
+                revision_ == 0 ||
+                localRevision_ != local.Revision() ||
+                parent_ != parent ||
+                ( parent != nullptr && parentRevision_ != parent->revision_ );
+        }
+
+        /**
+        Updates the cached global matrix.
+        \param[in] local Specifies the local transformation of the node.
+        \param[in] parent Raw-pointer to the parent's cache (which must already be up-to-date). This may also be null.
+        */
+        void Update(const Math::Transform3Df& local, const GlobalTransformCache* parent)
+        {
+            if (parent)
+            {
+                matrix_ = parent->matrix_;
+                matrix_ *= local.GetMatrix();
+                parentRevision_ = parent->revision_;
+            }
+            else
+            {
+                matrix_ = local.GetMatrix();
+                parentRevision_ = 0;
+            }
+
+            localRevision_ = local.Revision();
+            parent_ = parent;
+
+            /* Increment revision (skip zero, which marks an uninitialized cache) */
+            if (++revision_ == 0)
+                revision_ = 1;
+        }
+
+        //! Returns the cached global matrix.
+        inline const Math::Matrix4f& GetMatrix() const
+        {
+            return matrix_;
+        }
+
+    private:
+        
+        Math::Matrix4f              matrix_;
+
+        unsigned int                revision_       = 0;        //!< Revision of this cache, incremented on each update.
+        unsigned int                localRevision_  = 0;        //!< Revision of the local transformation this cache was computed from.
+        unsigned int                parentRevision_ = 0;        //!< Revision of the parent cache this cache was computed from.
+        const GlobalTransformCache* parent_         = nullptr;  //!< Parent cache this cache was computed from.
+
+};
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
@@ -0,0 +1,91 @@
+/*
+ * Parallel scene visitor header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_PARALLEL_SCENE_VISITOR_H__
+#define __FORK_PARALLEL_SCENE_VISITOR_H__
+
+
+#include "Scene/Node/DefaultSceneVisitor.h"
+#include "Core/Jobs/JobSystem.h"
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+/**
+Parallel scene visitor class. This visitor traverses the scene graph like the DefaultSceneVisitor,
+but the child subtrees of the upper hierarchy levels are distributed across the workers of a job system.
+\remarks This is intended for CPU-only passes (e.g. transformation update, culling or LOD selection).
+All overridden visitor functions must be thread-safe, i.e. they may only modify the visited node
+(or thread-safe shared state), since sibling subtrees are visited concurrently.
+Don't use this for render passes, since a render context can only be used by a single thread!
+\see Jobs::JobSystem
+*/
+class FORK_EXPORT ParallelSceneVisitor : public DefaultSceneVisitor
+{
+
+    public:
+
+        /**
+        Parallel scene visitor constructor.
+        \param[in] jobSystem Raw-pointer to the job system. If this is null, the default job system instance is used.
+        \param[in] splitDepth Specifies the number of hierarchy levels, whose children are visited in parallel.
+        Deeper subtrees are visited sequentially by the worker which visits its root. By default 2.
+        \see Jobs::JobSystem::Instance
+        */
+        ParallelSceneVisitor(Jobs::JobSystem* jobSystem = nullptr, unsigned int splitDepth = 2);
+
+        /**
+        Visits the specified scene graph and returns when all subtrees have been visited.
+        \param[in] sceneGraph Raw-pointer to the root of the scene graph. If this is null, the function has no effect.
+        */
+        void VisitParallel(SceneNode* sceneGraph);
+
+        //! Returns the job system which is used by this visitor.
+        inline Jobs::JobSystem* GetJobSystem() const
+        {
+            return jobSystem_;
+        }
+
+        /**
+        Number of child subtrees which are visited by a single job. If this is 0, the children
+        are split into chunks automatically. By default 0.
+        \see Jobs::JobSystem::ParallelFor
+        */
+        size_t grainSize = 0;
+
+    protected:
+
+        void VisitSceneNodeChildren(SceneNode* node) override;
+
+    private:
+
+        //! Returns the depth of the specified node relative to the current scene graph root.
+        unsigned int NodeDepth(const SceneNode* node) const;
+
+        Jobs::JobSystem*    jobSystem_  = nullptr;
+        unsigned int        splitDepth_ = 2;
+
+        const SceneNode*    root_       = nullptr;  //!< Root of the current traversal (only read by the workers).
+
+};
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
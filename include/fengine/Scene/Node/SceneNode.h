@@ -23,6 +23,8 @@
 namespace Fork
 {
 
+namespace Jobs { class JobSystem; }
+
 namespace Scene
 {
 
@@ -67,6 +69,22 @@ class FORK_EXPORT SceneNode
         //! Returns the global transformation of this scene node (depending on its parent).
         virtual Math::Matrix4f GlobalTransform() const;
 
+        /**
+        Updates the cached global transformations of this scene node and all its children in a single top-down pass.
+        Only those nodes, whose local transformation or whose parent's global transformation has changed, will be recomputed.
+        Call this once per frame on the scene graph root, before the scene is rendered.
+        \remarks Afterwards "GlobalTransform" only returns the cached matrices.
+        Without this pass, the caches are updated lazily on demand.
+        \see DynamicSceneNode::CachedGlobalTransform
+        */
+        void UpdateGlobalTransforms();
+        /**
+        Parallel variant of "UpdateGlobalTransforms". The child subtrees of this
+        scene node are updated concurrently by the workers of the specified job system.
+        \see Jobs::JobSystem::ParallelFor
+        */
+        void UpdateGlobalTransforms(Jobs::JobSystem& jobSystem);
+
         /**
         Returns true if this scene node has a transformation,
         e.g. DynamicSceneNode has a transformation but StaticSceneNode does not.
@@ -118,6 +136,17 @@ class FORK_EXPORT SceneNode
         //! Scene node meta data.
         NodeMetaData    metaData;
 
+    protected:
+
+        /* === Functions === */
+
+        /**
+        Updates the cached global transformation of this scene node only. The parent's cache is assumed to be up-to-date.
+        By default this function has no effect.
+        \see UpdateGlobalTransforms
+        */
+        virtual void UpdateGlobalTransformCache();
+
     private:
 
         /* === Members === */
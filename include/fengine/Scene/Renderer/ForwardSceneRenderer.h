@@ -10,6 +10,7 @@
 
 
 #include "Scene/Renderer/SceneRenderer.h"
+#include "Scene/Manager/BoundingVolumeHierarchy.h"
 
 
 namespace Fork
@@ -31,8 +32,25 @@ class FORK_EXPORT ForwardSceneRenderer : public SceneRenderer
     
     public:
         
+        /**
+        Renders the specified scene graph.
+        \remarks If 'sceneHierarchy' is set, only the geometry nodes of this hierarchy are rendered (see "RenderSceneHierarchy").
+        \see sceneHierarchy
+        */
         void RenderScene(SceneNode* sceneGraph) override;
 
+        /**
+        Renders all geometry nodes of the specified bounding volume hierarchy, which are inside the current view frustum.
+        In contrast to "RenderScene", whole subtrees of the hierarchy are culled at once.
+        The nodes are rendered with their cached global transformations, i.e. with the same transformations
+        the hierarchy has been built with (see DynamicSceneNode::CachedGlobalTransform).
+        \param[in] hierarchy Specifies the bounding volume hierarchy.
+        \param[in] sceneGraph Specifies the scene graph root. Only nodes, which are attached to this root and
+        whose parents are all enabled, are rendered. If this is null, only the parents' enable state is checked.
+        \see SceneManager::UpdateBoundingVolumeHierarchy
+        */
+        void RenderSceneHierarchy(const BoundingVolumeHierarchy& hierarchy, const SceneNode* sceneGraph);
+
         void VisitGeometryNode              (GeometryNode*              node) override;
 
         void VisitLODGeometry               (LODGeometry*               node) override;
@@ -42,9 +60,23 @@ class FORK_EXPORT ForwardSceneRenderer : public SceneRenderer
         void VisitSimple3DMeshGeometry      (Simple3DMeshGeometry*      node) override;
         void VisitTangentSpaceMeshGeometry  (TangentSpaceMeshGeometry*  node) override;
 
+        /**
+        Optional bounding volume hierarchy of the scene. If this is set, "RenderScene" culls the
+        geometry nodes with this hierarchy, instead of traversing the whole scene graph. By default null.
+        \remarks The hierarchy must contain all geometry nodes of the scene graph which are to be rendered,
+        and it must be updated before each frame (see SceneManager::UpdateBoundingVolumeHierarchy).
+        \see RenderSceneHierarchy
+        */
+        const BoundingVolumeHierarchy* sceneHierarchy = nullptr;
+
     private:
         
         const Video::ShaderComposition* prevShader_ = nullptr;
+        const GeometryNode*             geometryNode_ = nullptr;    //!< Current geometry node (for the LOD selection).
+        Math::Matrix4f                  worldMatrix_;               //!< World matrix of the current geometry node (for the LOD selection).
+        bool                            useGlobalTransforms_ = false;
+
+        std::vector<GeometryNode*>      visibleNodes_;  //!< Temporary list of visible nodes (to avoid reallocations each frame).
 
 };
 
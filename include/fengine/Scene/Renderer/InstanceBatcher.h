@@ -0,0 +1,114 @@
+/*
+ * Instance batcher header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_INSTANCE_BATCHER_H__
+#define __FORK_INSTANCE_BATCHER_H__
+
+
+#include "Scene/Renderer/RenderQueue.h"
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+/**
+Instance batch structure.
+\see InstanceBatcher
+*/
+struct InstanceBatch
+{
+    size_t          firstPacket     = 0; //!< Index of the first draw packet (within the render queue) of this batch.
+    unsigned int    numInstances    = 1; //!< Number of instances, i.e. number of draw packets. If this is 1, the packet is drawn without instancing.
+    size_t          firstInstance   = 0; //!< Index of the first world matrix (within the instance matrix list) of this batch.
+};
+
+
+/**
+Instance batcher class. This groups the draw packets of a sorted render queue into instance batches:
+Consecutive draw packets, which share the same geometry (vertex- and index buffer, primitive and number of vertices/ indices),
+textures and shaders, are merged into a single batch, and their world matrices are packed into one list,
+so that each batch can be drawn with a single instanced draw call.
+\remarks Only draw packets with an instanced shader are grouped, since the shader must read the
+world matrices from the instance buffer (by the instance ID) instead of the world matrix constant.
+This is a pure CPU component, i.e. it doesn't need a render context.
+\see DrawPacket::instancedShader
+\see RenderQueue::Submit(CommandDispatcher&, const InstanceBatcher&, Video::RendererProfilerModel*)
+*/
+class FORK_EXPORT InstanceBatcher
+{
+
+    public:
+
+        /**
+        Builds the instance batches for the specified render queue.
+        \param[in] queue Specifies the render queue. This should already be sorted, otherwise only few packets can be grouped.
+        \remarks The batches refer to the packet indices of the render queue,
+        so the queue must not be modified until the batches have been submitted.
+        \see RenderQueue::Sort
+        */
+        void Build(const RenderQueue& queue);
+
+        //! Removes all batches and instance matrices.
+        void Clear();
+
+        /**
+        Returns true if the two draw packets can be drawn within the same instance batch.
+        This is the case if both packets have the same instanced shader (which must not be null),
+        the same shader, textures, buffers, primitive and number of vertices and indices.
+        */
+        static bool CanBatch(const DrawPacket& lhs, const DrawPacket& rhs);
+
+        //! Returns the list of all instance batches.
+        inline const std::vector<InstanceBatch>& GetBatches() const
+        {
+            return batches_;
+        }
+
+        //! Returns the world matrices of all instanced batches.
+        inline const std::vector<Math::Matrix4f>& GetInstanceMatrices() const
+        {
+            return instanceMatrices_;
+        }
+
+        //! Returns the number of draw calls, which are required to draw all batches.
+        inline size_t NumDrawCalls() const
+        {
+            return batches_.size();
+        }
+
+        /**
+        Minimal number of draw packets to form an instanced batch. Smaller groups are drawn without instancing. By default 2.
+        */
+        unsigned int minNumInstances = 2;
+
+        /**
+        Maximal number of instances per batch, i.e. the capacity of the instance buffer. Larger groups are split up. By default 16384.
+        */
+        unsigned int maxNumInstances = 16384;
+
+    private:
+
+        std::vector<InstanceBatch>  batches_;
+        std::vector<Math::Matrix4f> instanceMatrices_;
+
+};
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
@@ -0,0 +1,216 @@
+/*
+ * LOD selector header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_LOD_SELECTOR_H__
+#define __FORK_LOD_SELECTOR_H__
+
+
+#include "Core/Export.h"
+#include "Scene/Node/CameraNode.h"
+#include "Math/Core/Matrix4.h"
+#include "Math/Core/Vector3.h"
+
+#include <vector>
+#include <map>
+#include <unordered_map>
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+class LODGeometry;
+
+/**
+LOD selection request structure.
+\see LODSelector::SelectLevels
+*/
+struct LODRequest
+{
+    const LODGeometry*  geometry    = nullptr;  //!< LOD geometry whose level is to be selected. This must not be null.
+    const void*         instance    = nullptr;  //!< Key of the instance (e.g. the geometry node) which refers to the LOD geometry.
+    Math::Matrix4f      worldMatrix;            //!< World matrix of the instance.
+    size_t              level       = 0;        //!< Output: selected level (index into LODGeometry::lodGeometries).
+};
+
+
+/**
+Screen-space LOD (level-of-detail) selector class. The level of a LOD geometry is selected by the projected size of its
+bounding sphere, i.e. the object size, the field-of-view and the screen resolution are taken into account.
+The projected size is converted to the distance, in which the (unscaled) bounding sphere would have the same size
+in the reference view, and this "reference distance" is passed to LODGeometry::SelectLODIndex.
+This way the switch distances of a LOD geometry are resolution independent,
+and the switch distances generated by GeometryConverter::GenerateLODGeometry are exact.
+\remarks To avoid that the levels pop back and forth at the switch distances, the selector keeps the selected
+level of each instance and only changes it when the reference distance leaves a hysteresis band around the switch distance.
+This selection state is stored per view (e.g. per camera, cube map or shadow map), so that rendering the same
+scene from several views does not reset the hysteresis. The states of views and instances, which are no longer used,
+are released automatically after a while (see maxStateAge), or explicitly with "ReleaseView" and "ReleaseInstance".
+This is a pure CPU component, i.e. it doesn't need a render context.
+\see LODGeometry::SelectLODIndex
+\see GeometryConverter::LODDescription
+*/
+class FORK_EXPORT LODSelector
+{
+
+    public:
+
+        /**
+        Sets the current view.
+        \param[in] view Specifies the key of the view (e.g. the camera). Each view has its own selection state.
+        \param[in] cameraPosition Specifies the global camera position.
+        \param[in] projection Specifies the view projection. The field-of-view and the screen height
+        (or the orthogonal size for orthogonal projections) determine the projected size.
+        \param[in] screenHeight Specifies the height (in pixels) of the render target, the view is rendered into.
+        If this is 0, the viewport height of the projection is used. This must be specified, if the projection
+        viewport is not the actual render target size (e.g. for cube maps, see CubeMapRenderer). By default 0.
+        */
+        void SetupView(const void* view, const Math::Point3f& cameraPosition, const Projection& projection, int screenHeight = 0);
+
+        /**
+        Selects the level for the specified LOD geometry instance in the current view.
+        \param[in] geometry Specifies the LOD geometry.
+        \param[in] instance Specifies the key of the instance (e.g. the geometry node).
+        The same LOD geometry can be shared by several instances, each with its own selection state.
+        \param[in] worldMatrix Specifies the world matrix of the instance.
+        \return Index of the selected level. To select the levels of many instances, use "SelectLevels".
+        \see SelectLevels
+        */
+        size_t SelectLevel(const LODGeometry& geometry, const void* instance, const Math::Matrix4f& worldMatrix);
+
+        /**
+        Selects the levels for all specified requests in the current view, as a single batched pass.
+        The levels are computed in parallel by the job system.
+        \param[in,out] requests Specifies the LOD requests. The selected level is written to 'LODRequest::level'.
+        \see LODRequest
+        \see Jobs::JobSystem
+        */
+        void SelectLevels(std::vector<LODRequest>& requests);
+
+        /**
+        Returns the reference distance of the specified LOD geometry instance in the current view.
+        This is the distance, in which the unscaled bounding sphere would have the same projected size in the reference view.
+        */
+        float ReferenceDistance(const LODGeometry& geometry, const Math::Matrix4f& worldMatrix) const;
+
+        //! Removes the selection states of all views.
+        void Clear();
+
+        /**
+        Removes the selection states of the specified view. Call this when a view is destroyed (e.g. a camera),
+        so that a new view, which is allocated at the same address, does not take over its selection states.
+        */
+        void ReleaseView(const void* view);
+
+        //! Removes the selection states of the specified instance in all views. Call this when an instance is destroyed.
+        void ReleaseInstance(const void* instance);
+
+        //! Returns the number of selection states (i.e. instances) of all views.
+        size_t NumStates() const;
+
+        /**
+        Relative width of the hysteresis band (in the range [0 .. 1]). A level switch to a lower level-of-detail
+        happens at the switch distance times (1 + hysteresis), and back to a higher level-of-detail at the switch
+        distance divided by (1 + hysteresis). If this is 0, there is no hysteresis. By default 0.1.
+        */
+        float hysteresis = 0.1f;
+
+        /**
+        Vertical field-of-view (in radians) of the reference view. By default 1.29154 (74 degrees).
+        \see GeometryConverter::LODDescription::fieldOfView
+        */
+        float referenceFieldOfView = 1.29154f;
+
+        /**
+        Screen height (in pixels) of the reference view. By default 768.
+        \see GeometryConverter::LODDescription::screenHeight
+        */
+        float referenceScreenHeight = 768.0f;
+
+        /**
+        Maximal age (in number of "SetupView" calls over all views) of unused selection states.
+        A view, which has not been set up, and an instance, which has not been selected within this age, is released.
+        If this is 0, the selection states are only released explicitly. By default 1000.
+        \see ReleaseView
+        \see ReleaseInstance
+        */
+        unsigned int maxStateAge = 1000;
+
+    private:
+
+        //! Selection state key of a LOD geometry instance.
+        struct StateKey
+        {
+            inline bool operator == (const StateKey& rhs) const
+            {
+                return geometry == rhs.geometry && instance == rhs.instance;
+            }
+
+            const LODGeometry*  geometry;
+            const void*         instance;
+        };
+
+        struct StateKeyHash
+        {
+            size_t operator () (const StateKey& key) const;
+        };
+
+        //! Selection state of a LOD geometry instance.
+        struct State
+        {
+            size_t          level;      //!< Previously selected level.
+            unsigned int    lastUsed;   //!< Setup counter when the state has been used the last time.
+        };
+
+        typedef std::unordered_map<StateKey, State, StateKeyHash> StateMap;
+
+        //! Selection states of a view.
+        struct ViewStates
+        {
+            StateMap        states;
+            unsigned int    lastSetup   = 0;    //!< Setup counter when the view has been set up the last time.
+            unsigned int    lastRelease = 0;    //!< Setup counter when the unused states have been released the last time.
+        };
+
+        //! Returns the selection state of the specified instance in the current view. The state is created on demand.
+        State& FetchState(const LODGeometry& geometry, const void* instance);
+
+        //! Releases all views and states, which are older than 'maxStateAge'.
+        void ReleaseUnusedStates();
+
+        //! Returns true if the specified setup counter is older than 'maxStateAge'.
+        bool IsExpired(unsigned int setupCounter) const;
+
+        //! Selects the level by the specified reference distance and previous level (with hysteresis).
+        size_t ComputeLevel(const LODGeometry& geometry, const Math::Matrix4f& worldMatrix, size_t prevLevel) const;
+
+        std::map<const void*, ViewStates>   views_;                 //!< Selection states of all views.
+        ViewStates*                         activeView_ = nullptr;  //!< Selection states of the current view.
+        unsigned int                        setupCounter_ = 0;      //!< Number of "SetupView" calls.
+
+        Math::Point3f                       cameraPosition_;
+        float                               projectionScale_ = 0.0f; //!< Ratio between reference and current projection scale.
+        bool                                isOrtho_ = false;
+
+        std::vector<State*>                 requestStates_;
+
+};
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
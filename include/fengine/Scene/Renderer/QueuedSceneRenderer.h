@@ -0,0 +1,123 @@
+/*
+ * Queued scene renderer header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_QUEUED_SCENE_RENDERER_H__
+#define __FORK_QUEUED_SCENE_RENDERER_H__
+
+
+#include "Scene/Renderer/SceneRenderer.h"
+#include "Scene/Renderer/RenderQueue.h"
+#include "Scene/Renderer/InstanceBatcher.h"
+#include "Video/RenderSystem/Texture/Texture2D.h"
+
+
+namespace Fork
+{
+
+namespace Video { class RendererProfilerModel; }
+
+namespace Scene
+{
+
+
+class MeshGeometry;
+
+/**
+Queued scene renderer class. In contrast to the ForwardSceneRenderer, this renderer works in two phases:
+First the scene graph is traversed and all visible geometries are recorded as draw packets into a render queue.
+Then the render queue is sorted by shader, textures, vertex buffer and depth,
+and submitted to the render context, whereby all redundant state bindings are filtered out.
+The levels of all LOD geometries are selected in a single batched pass after the traversal.
+\see RenderQueue
+\see InstanceBatcher
+\see LODSelector::SelectLevels
+\see ForwardSceneRenderer
+*/
+class FORK_EXPORT QueuedSceneRenderer : public SceneRenderer
+{
+
+    public:
+
+        void RenderScene(SceneNode* sceneGraph) override;
+
+        void VisitGeometryNode              (GeometryNode*              node) override;
+
+        void VisitLODGeometry               (LODGeometry*               node) override;
+        void VisitCompositionGeometry       (CompositionGeometry*       node) override;
+        void VisitTexturedGeometry          (TexturedGeometry*          node) override;
+
+        void VisitSimple3DMeshGeometry      (Simple3DMeshGeometry*      node) override;
+        void VisitTangentSpaceMeshGeometry  (TangentSpaceMeshGeometry*  node) override;
+
+        //! Returns the render queue of the last rendered scene.
+        inline const RenderQueue& GetRenderQueue() const
+        {
+            return renderQueue_;
+        }
+
+        //! Returns the instance batcher of the last rendered scene.
+        inline const InstanceBatcher& GetInstanceBatcher() const
+        {
+            return instanceBatcher_;
+        }
+
+        /**
+        Optional profiler model, to which the skipped (i.e. redundant) bindings
+        and the batched draw calls are recorded. By default null.
+        \see Video::RendererProfilerModel::NumSkippedBindings
+        \see Video::RendererProfilerModel::NumBatchedDrawCalls
+        */
+        Video::RendererProfilerModel* profilerModel = nullptr;
+
+        /**
+        Specifies whether hardware instancing is enabled. If enabled, all geometry nodes which share the same geometry,
+        textures and shaders, and which have an instanced shader composition, are drawn with a single instanced draw call.
+        The world matrices are stored in an RGBA32Float texture (4 texels per matrix, row by row),
+        which is bound to the texture layer 'DrawPacket::maxNumTextures'. By default false.
+        \see GeometryNode::instancedShaderComposition
+        \see InstanceBatcher
+        */
+        bool enableInstancing = false;
+
+    private:
+
+        void CreateInstanceTexture();
+
+        //! Records a draw packet for the specified mesh geometry with the current state.
+        void PushMeshGeometry(const MeshGeometry& geometry);
+
+        //! Selects the levels of all deferred LOD geometries and visits the selected geometries.
+        void ResolveLODRequests();
+
+        RenderQueue                     renderQueue_;
+        InstanceBatcher                 instanceBatcher_;
+
+        Video::Texture2DPtr             instanceTexture_;       //!< World matrix texture for hardware instancing.
+
+        DrawPacket                      packet_;                //!< Current draw packet state (shader, textures and world matrix).
+
+        const Video::ShaderComposition* prevShader_ = nullptr;
+        const GeometryNode*             geometryNode_ = nullptr; //!< Current geometry node (for the LOD selection).
+
+        std::vector<LODRequest>         lodRequests_;           //!< Deferred LOD geometries of the current traversal.
+        std::vector<DrawPacket>         lodPackets_;            //!< Draw packet states of the deferred LOD geometries.
+        std::vector<LODRequest>         pendingLODRequests_;
+        std::vector<DrawPacket>         pendingLODPackets_;
+
+};
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
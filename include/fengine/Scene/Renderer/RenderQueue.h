@@ -0,0 +1,321 @@
+/*
+ * Render queue header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_RENDER_QUEUE_H__
+#define __FORK_RENDER_QUEUE_H__
+
+
+#include "Core/Export.h"
+#include "Core/Container/LinearArena.h"
+#include "Math/Core/Matrix4.h"
+#include "Video/RenderSystem/RenderState/GeometryPrimitives.h"
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+
+namespace Fork
+{
+
+namespace Video
+{
+
+class ShaderComposition;
+class Texture;
+class VertexBuffer;
+class IndexBuffer;
+class RenderContext;
+class RendererProfilerModel;
+class Texture2D;
+
+}
+
+namespace Scene
+{
+
+
+class InstanceBatcher;
+
+/**
+Draw packet structure. This contains everything which is required to draw a single geometry,
+so that draw packets can be sorted and submitted independently of the scene graph traversal.
+\see RenderQueue
+*/
+struct DrawPacket
+{
+    //! Maximal number of textures per draw packet.
+    static const size_t maxNumTextures = 8;
+
+    const Video::ShaderComposition* shader                      = nullptr;      //!< Shader composition. If this is null, the default shader is used. \see RenderQueue::defaultShader
+    const Video::ShaderComposition* instancedShader             = nullptr;      //!< Optional shader composition for hardware instancing. \see InstanceBatcher
+    const Video::Texture*           textures[maxNumTextures];                   //!< Textures for the layers [0 .. numTextures). The other entries are undefined.
+    unsigned int                    numTextures                 = 0;            //!< Number of textures.
+    Video::VertexBuffer*            vertexBuffer                = nullptr;      //!< Vertex buffer. This must never be null.
+    Video::IndexBuffer*             indexBuffer                 = nullptr;      //!< Index buffer. If this is null, non-indexed geometry will be drawn.
+    Video::GeometryPrimitives       primitive                   = Video::GeometryPrimitives::Triangles;
+    unsigned int                    numVertices                 = 0;            //!< Number of vertices (for non-indexed geometry).
+    unsigned int                    numIndices                  = 0;            //!< Number of indices (for indexed geometry).
+    Math::Matrix4f                  worldMatrix;                                //!< World matrix of the geometry.
+    float                           depth                       = 0.0f;         //!< Distance to the camera. Packets with equal states are drawn front-to-back.
+};
+
+
+/**
+Render queue class. This is the second phase of a two-phase scene renderer:
+Draw packets are recorded (e.g. by a scene visitor) into a frame-linear memory arena,
+then they are sorted by a 64-bit key with a radix sort, and finally submitted to a command dispatcher,
+whereby all redundant state bindings are filtered out.
+\remarks The sort key has the following layout (from the most- to the least significant bits):
+- [63 .. 48]: Shader ID (16 bits).
+- [47 .. 32]: Texture set ID (16 bits).
+- [31 .. 16]: Vertex buffer ID (16 bits).
+- [15 ..  0]: Depth (16 bits), i.e. packets with equal states are sorted front-to-back.
+The IDs are assigned in the order in which the states appear for the first time in the current frame.
+IDs which exceed their bit range only reduce the grouping quality, but never the correctness.
+\see DrawPacket
+\see QueuedSceneRenderer
+*/
+class FORK_EXPORT RenderQueue
+{
+
+    public:
+
+        /**
+        Command dispatcher interface. All draw commands of a render queue are submitted to this interface.
+        \remarks This decouples the render queue from the render context,
+        e.g. to test the state sorting without a GPU.
+        \see RenderQueue::RenderContextDispatcher
+        */
+        class FORK_EXPORT CommandDispatcher
+        {
+
+            public:
+
+                virtual ~CommandDispatcher()
+                {
+                }
+
+                virtual void BindShader         (const Video::ShaderComposition* shaderComposition) = 0;
+                virtual void BindTexture        (const Video::Texture* texture, unsigned int layer) = 0;
+                virtual void UnbindTexture      (const Video::Texture* texture, unsigned int layer) = 0;
+                virtual void BindVertexBuffer   (Video::VertexBuffer* vertexBuffer) = 0;
+                virtual void BindIndexBuffer    (Video::IndexBuffer* indexBuffer) = 0;
+                virtual void SetupDrawMode      (const Video::GeometryPrimitives primitive) = 0;
+
+                /**
+                Sets the world matrix for the next draw call. This is called for every draw packet.
+                \param[in] worldMatrix Specifies the new world matrix.
+                \param[in] shaderComposition Raw-pointer to the currently bound shader composition. May be null.
+                */
+                virtual void SetupWorldMatrix(const Math::Matrix4f& worldMatrix, const Video::ShaderComposition* shaderComposition) = 0;
+
+                /**
+                Sets the world matrices for the next instanced draw call. This is called for every instanced batch.
+                \param[in] worldMatrices Raw-pointer to the world matrices of all instances.
+                \param[in] numInstances Specifies the number of instances.
+                \param[in] shaderComposition Raw-pointer to the currently bound shader composition. May be null.
+                */
+                virtual void SetupInstanceData(
+                    const Math::Matrix4f* worldMatrices, unsigned int numInstances, const Video::ShaderComposition* shaderComposition
+                ) = 0;
+
+                virtual void Draw                   (unsigned int numVertices) = 0;
+                virtual void DrawIndexed            (unsigned int numIndices) = 0;
+                virtual void DrawInstanced          (unsigned int numVertices, unsigned int numInstances) = 0;
+                virtual void DrawInstancedIndexed   (unsigned int numIndices, unsigned int numInstances) = 0;
+
+        };
+
+        /**
+        Default command dispatcher, which forwards all commands to a render context.
+        The shader constant buffers are updated after each world matrix change.
+        \remarks For instanced draw calls, the world matrices are written into an RGBA32Float instance texture
+        (4 texels per matrix, row by row), which is bound to the instance texture layer.
+        */
+        class FORK_EXPORT RenderContextDispatcher : public CommandDispatcher
+        {
+
+            public:
+
+                /**
+                Render context dispatcher constructor.
+                \param[in] renderContext Raw-pointer to the render context.
+                \param[in] instanceTexture Optional raw-pointer to the instance texture.
+                This is only required when instance batches are submitted. By default null.
+                \param[in] instanceTextureLayer Specifies the texture layer for the instance texture. By default DrawPacket::maxNumTextures.
+                \throws NullPointerException If 'renderContext' is null.
+                */
+                RenderContextDispatcher(
+                    Video::RenderContext* renderContext, Video::Texture2D* instanceTexture = nullptr,
+                    unsigned int instanceTextureLayer = DrawPacket::maxNumTextures
+                );
+                ~RenderContextDispatcher();
+
+                void BindShader         (const Video::ShaderComposition* shaderComposition) override;
+                void BindTexture        (const Video::Texture* texture, unsigned int layer) override;
+                void UnbindTexture      (const Video::Texture* texture, unsigned int layer) override;
+                void BindVertexBuffer   (Video::VertexBuffer* vertexBuffer) override;
+                void BindIndexBuffer    (Video::IndexBuffer* indexBuffer) override;
+                void SetupDrawMode      (const Video::GeometryPrimitives primitive) override;
+                void SetupWorldMatrix   (const Math::Matrix4f& worldMatrix, const Video::ShaderComposition* shaderComposition) override;
+
+                //! \throws InvalidStateException If no instance texture has been specified.
+                void SetupInstanceData(
+                    const Math::Matrix4f* worldMatrices, unsigned int numInstances, const Video::ShaderComposition* shaderComposition
+                ) override;
+
+                void Draw                   (unsigned int numVertices) override;
+                void DrawIndexed            (unsigned int numIndices) override;
+                void DrawInstanced          (unsigned int numVertices, unsigned int numInstances) override;
+                void DrawInstancedIndexed   (unsigned int numIndices, unsigned int numInstances) override;
+
+            private:
+
+                Video::RenderContext*       renderContext_          = nullptr;
+
+                Video::Texture2D*           instanceTexture_        = nullptr;
+                unsigned int                instanceTextureLayer_   = 0;
+                bool                        isInstanceTextureBound_ = false;
+
+                std::vector<Math::Matrix4f> instanceMatrices_;      //!< Staging buffer for complete texture rows.
+
+        };
+
+        /* === Functions === */
+
+        /**
+        Adds a copy of the specified draw packet to the queue.
+        \param[in] packet Specifies the draw packet. If its vertex buffer is null, the packet is ignored.
+        \remarks The packet is copied into the frame-linear memory arena, which is released with "Clear".
+        */
+        void Push(const DrawPacket& packet);
+
+        /**
+        Sorts all draw packets by their sort keys.
+        \see RadixSortByKey
+        */
+        void Sort();
+
+        /**
+        Submits all draw packets (in their current order) to the specified command dispatcher.
+        Shaders, textures, vertex- and index buffers are only bound if they differ from the previously bound ones.
+        All textures are unbound at the end.
+        \param[in,out] dispatcher Specifies the command dispatcher.
+        \param[in,out] profilerModel Optional raw-pointer to a profiler model,
+        to which all skipped (i.e. redundant) bindings are recorded. By default null.
+        \see Video::RendererProfilerModel::RecordSkippedBinding
+        */
+        void Submit(CommandDispatcher& dispatcher, Video::RendererProfilerModel* profilerModel = nullptr) const;
+
+        /**
+        Submits all instance batches to the specified command dispatcher.
+        Each instanced batch is drawn with its instanced shader and a single instanced draw call.
+        \param[in,out] dispatcher Specifies the command dispatcher.
+        \param[in] batcher Specifies the instance batcher. This must have been built for this render queue (in its current order).
+        \param[in,out] profilerModel Optional raw-pointer to a profiler model,
+        to which all skipped bindings and batched draw calls are recorded. By default null.
+        \see InstanceBatcher::Build
+        \see Video::RendererProfilerModel::RecordBatchedDrawCalls
+        */
+        void Submit(
+            CommandDispatcher& dispatcher, const InstanceBatcher& batcher,
+            Video::RendererProfilerModel* profilerModel = nullptr
+        ) const;
+
+        /**
+        Removes all draw packets and releases the memory arena for the next frame.
+        \remarks The allocated memory is kept, to avoid reallocations each frame.
+        */
+        void Clear();
+
+        //! Returns the number of draw packets.
+        inline size_t NumPackets() const
+        {
+            return entries_.size();
+        }
+
+        //! Returns the draw packet with the specified index (in the current order). The index must be valid!
+        inline const DrawPacket& GetPacket(size_t index) const
+        {
+            return *entries_[index].packet;
+        }
+
+        //! Returns the sort key of the draw packet with the specified index (in the current order). The index must be valid!
+        inline std::uint64_t GetSortKey(size_t index) const
+        {
+            return entries_[index].key;
+        }
+
+        /* === Members === */
+
+        /**
+        Shader composition, which is bound for all draw packets without a shader (see DrawPacket::shader),
+        so that such a packet never inherits the shader of the previous packet.
+        If this is also null, the currently bound shader is kept. By default null.
+        */
+        const Video::ShaderComposition* defaultShader = nullptr;
+
+    private:
+
+        struct SortEntry
+        {
+            std::uint64_t       key;
+            const DrawPacket*   packet;
+        };
+
+        //! Currently bound states during submission.
+        struct BindingState
+        {
+            const Video::ShaderComposition* shader                                  = nullptr;
+            const Video::Texture*           textures[DrawPacket::maxNumTextures];
+            unsigned int                    numTextures                             = 0;
+            Video::VertexBuffer*            vertexBuffer                            = nullptr;
+            Video::IndexBuffer*             indexBuffer                             = nullptr;
+            Video::GeometryPrimitives       primitive                               = Video::GeometryPrimitives::Triangles;
+            bool                            isPrimitiveBound                        = false;
+        };
+
+        /**
+        Binds all states of the specified packet, which differ from the currently bound states.
+        \param[in] shader Specifies the shader which is to be bound instead of the packet's shader.
+        */
+        static void BindStates(
+            const DrawPacket& packet, const Video::ShaderComposition* shader, BindingState& state,
+            CommandDispatcher& dispatcher, Video::RendererProfilerModel* profilerModel
+        );
+
+        //! Unbinds all remaining textures.
+        static void UnbindStates(BindingState& state, CommandDispatcher& dispatcher);
+
+        //! Returns the ID for the specified state and assigns a new one, if the state appears for the first time.
+        static unsigned int StateID(std::unordered_map<std::uint64_t, unsigned int>& stateIDs, std::uint64_t state);
+
+        std::uint64_t SortKey(const DrawPacket& packet);
+
+        LinearArena                                         arena_;
+
+        std::vector<SortEntry>                              entries_;
+        std::vector<SortEntry>                              tempEntries_;   //!< Temporary list for the radix sort (to avoid reallocations each frame).
+
+        std::unordered_map<std::uint64_t, unsigned int>     shaderIDs_;
+        std::unordered_map<std::uint64_t, unsigned int>     textureSetIDs_;
+        std::unordered_map<std::uint64_t, unsigned int>     vertexBufferIDs_;
+
+};
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
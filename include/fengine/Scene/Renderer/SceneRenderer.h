@@ -12,6 +12,7 @@
 #include "Core/Export.h"
 #include "Scene/Node/SceneVisitor.h"
 #include "Scene/Manager/CullingManager.h"
+#include "Scene/Renderer/LODSelector.h"
 #include "Video/RenderSystem/HardwareBuffer/VertexBuffer.h"
 #include "Video/RenderSystem/HardwareBuffer/IndexBuffer.h"
 #include "Math/Core/Vector3.h"
@@ -32,6 +33,7 @@ class FORK_EXPORT SceneRenderer : public SceneVisitor
         
         /**
         Sets the projection, view matrix and view frustum of the specified camera to the current render context.
+        This also sets the camera as the current view of the LOD selector.
         \param[in] camera Specifies the camera scene node from which the view will be set.
         \see Video::RenderContext::SetupProjectionm
         \see Video::RenderContext::SetupViewMatrix
@@ -68,6 +70,12 @@ class FORK_EXPORT SceneRenderer : public SceneVisitor
         //! Scene node culling manager.
         CullingManager cullingManager;
 
+        /**
+        Screen-space LOD selector. This keeps the selected levels of all LOD geometries per view.
+        \see LODSelector::SetupView
+        */
+        LODSelector lodSelector;
+
     protected:
         
         SceneRenderer() = default;
@@ -98,8 +106,9 @@ class FORK_EXPORT SceneRenderer : public SceneVisitor
         /**
         Global position of the current scene node.
         This must be written by each individual scene renderer.
-        It should be used for LOD (level-of-detail) selections by computing the
-        distance between "globalSceneNodePosition" and "globalCameraPosition".
+        \remarks LOD (level-of-detail) geometries are selected by the LOD selector,
+        which uses the bounding sphere of the geometry instead of this position.
+        \see lodSelector
         */
         Math::Point3f globalSceneNodePosition;
 
@@ -0,0 +1,206 @@
+/*
+ * Terrain quad-tree header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_TERRAIN_QUAD_TREE_H__
+#define __FORK_TERRAIN_QUAD_TREE_H__
+
+
+#include "Scene/Terrain/TerrainTileCache.h"
+#include "Scene/Node/CameraNode.h"
+#include "Math/Geometry/AABB.h"
+#include "Math/Core/Vector3.h"
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+DECL_SHR_PTR(TerrainQuadTree);
+
+/**
+Selected terrain quad-tree node.
+Each selected node is to be rendered with the terrain template grid, scaled to the node area.
+\see TerrainQuadTree::Select
+*/
+struct TerrainNodeSelection
+{
+    Math::AABB3f    box;                    //!< Bounding box of the node (in terrain space).
+    Math::Point2ui  origin;                 //!< First height sample of the node.
+    unsigned int    size            = 0;    //!< Number of height samples per node side (without the shared border sample).
+    unsigned int    lodLevel        = 0;    //!< LOD level of the node (0 is the highest level-of-detail).
+    /**
+    Bit mask of the node quadrants, which are to be rendered:
+    Bit 0 (-X, -Z), bit 1 (+X, -Z), bit 2 (-X, +Z), bit 3 (+X, +Z).
+    The other quadrants are covered by the child nodes. By default 0xF (entire node).
+    */
+    unsigned int    quadrantMask    = 0xF;
+    float           morphStart      = 0.0f; //!< Distance where the vertices start to morph to the next lower level-of-detail.
+    float           morphEnd        = 0.0f; //!< Distance where the vertices are completely morphed to the next lower level-of-detail.
+};
+
+
+/**
+CDLOD (Continuous Distance-Dependent Level of Detail) terrain quad-tree. Each node stores the minimal and
+maximal height of its area, so the quad-tree can be traversed on the CPU against the view frustum and the LOD ranges.
+Each LOD level has a range, which is twice as large as the range of the next higher level-of-detail, and the
+vertices are morphed to the next lower level-of-detail at the end of each range, so there are no cracks between nodes.
+\remarks The node bounds are computed from the tile cache, so the height field is streamed through the cache only once
+and must never be entirely resident. The terrain space is the height sample grid, scaled by 'Description::scale'.
+\see TerrainTileCache
+\see TerrainGeometry::quadTree
+*/
+class FORK_EXPORT TerrainQuadTree
+{
+
+    public:
+
+        //! Quad-tree description structure.
+        struct Description
+        {
+            /**
+            Number of height samples per leaf node side (without the shared border sample).
+            This must match the grid size of the terrain template geometry. By default 32.
+            \see GeometryGenerator::GenerateTerrainTemplate
+            */
+            unsigned int    leafNodeSize        = 32;
+
+            //! Number of LOD levels, i.e. quad-tree depth. By default 8.
+            unsigned int    numLODLevels        = 8;
+
+            //! Range of the highest level-of-detail. By default 32.
+            float           detailDistance      = 32.0f;
+
+            //! Ratio between the ranges of two successive LOD levels. Must be at least 2. By default 2.
+            float           lodDistanceRatio    = 2.0f;
+
+            //! Relative distance within a LOD range, where the morphing begins. By default 0.66.
+            float           morphStartRatio     = 0.66f;
+
+            //! Size of a height sample (X and Z) and height scale (Y). By default (1, 1, 1).
+            Math::Vector3f  scale               { 1.0f, 1.0f, 1.0f };
+        };
+
+        //! Minimal and maximal height of a quad-tree node.
+        struct NodeBounds
+        {
+            float minHeight;
+            float maxHeight;
+        };
+
+        /* === Functions === */
+
+        /**
+        Builds the quad-tree node bounds from the specified tile cache.
+        \param[in] tileCache Specifies the terrain tile cache, through which the height field is streamed.
+        \param[in] desc Specifies the quad-tree description.
+        \throws InvalidArgumentException If the description is invalid or the height field has less than 2x2 samples.
+        */
+        void Build(TerrainTileCache& tileCache, const Description& desc);
+
+        /**
+        Selects the quad-tree nodes, which are to be rendered.
+        \param[in] frustum Specifies the view frustum (in terrain space).
+        \param[in] cameraPosition Specifies the camera position (in terrain space).
+        \param[out] selection Specifies the output list of the selected nodes. The list is not cleared.
+        \remarks Only nodes within the range of the lowest level-of-detail are selected.
+        */
+        void Select(const ViewFrustum& frustum, const Math::Point3f& cameraPosition, std::vector<TerrainNodeSelection>& selection) const;
+
+        //! Returns the morph factor (in the range [0 .. 1]) for the specified LOD level and distance to the camera.
+        float MorphFactor(unsigned int lodLevel, float distance) const;
+
+        /**
+        Morphs the specified grid vertex to the next lower level-of-detail. This is the CPU reference for the vertex morph of a terrain vertex shader.
+        \param[in] gridPos Specifies the vertex position within the node (in the range [0 .. 1]).
+        \param[in] gridSize Specifies the number of grid cells per node side (see Description::leafNodeSize).
+        \param[in] morphFactor Specifies the morph factor (in the range [0 .. 1]).
+        \return Morphed vertex position. If the morph factor is 1, every odd vertex is moved onto its even neighbor,
+        i.e. the grid matches the grid of the next lower level-of-detail.
+        \see MorphFactor
+        */
+        static Math::Point2f MorphVertex(const Math::Point2f& gridPos, unsigned int gridSize, float morphFactor);
+
+        //! Returns the bounds of the specified node. The node must be inside the range [(0, 0) .. NumNodes(lodLevel)).
+        const NodeBounds& GetNodeBounds(unsigned int lodLevel, unsigned int x, unsigned int z) const;
+
+        //! Returns the bounding box (in terrain space) of the specified node.
+        Math::AABB3f NodeBox(unsigned int lodLevel, unsigned int x, unsigned int z) const;
+
+        //! Returns the number of nodes of the specified LOD level in X and Z direction.
+        Math::Size2ui NumNodes(unsigned int lodLevel) const;
+
+        //! Returns the range of the specified LOD level.
+        float LODRange(unsigned int lodLevel) const;
+
+        //! Returns the number of LOD levels.
+        inline unsigned int NumLODLevels() const
+        {
+            return static_cast<unsigned int>(levels_.size());
+        }
+
+        //! Returns the bounding box (in terrain space) of the entire terrain.
+        inline const Math::AABB3f& GetBoundingBox() const
+        {
+            return boundingBox_;
+        }
+
+        //! Returns the quad-tree description.
+        inline const Description& GetDesc() const
+        {
+            return desc_;
+        }
+
+        //! Returns true if the quad-tree has been built.
+        inline bool IsBuilt() const
+        {
+            return !levels_.empty();
+        }
+
+    private:
+
+        struct Level
+        {
+            unsigned int            nodeSize = 0;   //!< Number of height samples per node side.
+            Math::Size2ui           numNodes;
+            std::vector<NodeBounds> nodes;
+            float                   range = 0.0f;
+            float                   morphStart = 0.0f;
+        };
+
+        //! Returns true if the node has been handled (i.e. selected or culled). False if it is out of its LOD range.
+        bool SelectNode(
+            const ViewFrustum& frustum, const Math::Point3f& cameraPosition, std::vector<TerrainNodeSelection>& selection,
+            unsigned int lodLevel, unsigned int x, unsigned int z, bool isInsideFrustum
+        ) const;
+
+        void AddSelection(
+            std::vector<TerrainNodeSelection>& selection, const Math::AABB3f& box,
+            unsigned int lodLevel, unsigned int x, unsigned int z, unsigned int quadrantMask
+        ) const;
+
+        Description         desc_;
+        Math::Size2ui       numSamples_;
+
+        std::vector<Level>  levels_;        //!< Quad-tree levels, from the highest to the lowest level-of-detail.
+        Math::AABB3f        boundingBox_;
+
+};
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
@@ -0,0 +1,164 @@
+/*
+ * Terrain tile cache header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_TERRAIN_TILE_CACHE_H__
+#define __FORK_TERRAIN_TILE_CACHE_H__
+
+
+#include "Scene/Terrain/TerrainTileSource.h"
+
+#include <list>
+#include <unordered_map>
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+DECL_SHR_PTR(TerrainTileCache);
+
+/**
+Terrain tile cache class. Height tiles are paged in from the tile source on demand,
+and the least recently used (LRU) tiles are evicted when the memory budget is exceeded.
+\see TerrainTileSource
+*/
+class FORK_EXPORT TerrainTileCache
+{
+
+    public:
+
+        /**
+        Terrain tile cache constructor.
+        \param[in] source Shared pointer to the tile source. This must not be null.
+        \param[in] memoryBudget Specifies the memory budget (in bytes) for the resident tiles.
+        At least one tile is always resident. By default 64 MB.
+        \throws NullPointerException If 'source' is null.
+        */
+        TerrainTileCache(const TerrainTileSourcePtr& source, size_t memoryBudget = 64*1024*1024);
+
+        TerrainTileCache(const TerrainTileCache&) = delete;
+        TerrainTileCache& operator = (const TerrainTileCache&) = delete;
+
+        /**
+        Returns the heights of the specified tile and marks it as most recently used.
+        The tile is loaded from the tile source if it is not resident.
+        \return Constant raw-pointer to the (TileSize() * TileSize()) heights of the tile (row by row).
+        \remarks The pointer is only valid until the next call to "FetchTile", since the tile can be evicted.
+        */
+        const float* FetchTile(const Math::Point2ui& tile);
+
+        /**
+        Returns the height at the specified sample position.
+        The position is clamped to the range [(0, 0) .. NumSamples()).
+        */
+        float SampleHeight(unsigned int x, unsigned int z);
+
+        //! Removes all resident tiles.
+        void Clear();
+
+        /**
+        Sets the new memory budget (in bytes). Tiles are evicted immediately if the budget is exceeded.
+        \see TerrainTileCache(const TerrainTileSourcePtr&, size_t)
+        */
+        void SetMemoryBudget(size_t memoryBudget);
+
+        //! Returns the memory budget (in bytes).
+        inline size_t GetMemoryBudget() const
+        {
+            return memoryBudget_;
+        }
+
+        //! Returns the maximal number of resident tiles, which is determined by the memory budget.
+        inline size_t MaxNumResidentTiles() const
+        {
+            return maxNumTiles_;
+        }
+
+        //! Returns the number of resident tiles.
+        inline size_t NumResidentTiles() const
+        {
+            return tiles_.size();
+        }
+
+        //! Returns the number of tiles, which have been loaded from the tile source so far.
+        inline size_t NumLoadedTiles() const
+        {
+            return numLoadedTiles_;
+        }
+
+        //! Returns the number of tiles, which have been evicted so far.
+        inline size_t NumEvictedTiles() const
+        {
+            return numEvictedTiles_;
+        }
+
+        //! Returns the number of height samples per tile side.
+        inline unsigned int TileSize() const
+        {
+            return tileSize_;
+        }
+
+        //! Returns the number of height samples of the entire height field in X and Z direction.
+        inline const Math::Size2ui& NumSamples() const
+        {
+            return numSamples_;
+        }
+
+        //! Returns the tile source.
+        inline const TerrainTileSourcePtr& GetSource() const
+        {
+            return source_;
+        }
+
+    private:
+
+        typedef unsigned long long TileKey;
+
+        struct Tile
+        {
+            std::vector<float>          heights;
+            std::list<TileKey>::iterator lruEntry;
+        };
+
+        //! Evicts the least recently used tiles until the specified number of tiles is resident.
+        void EvictTiles(size_t maxNumTiles);
+
+        TerrainTileSourcePtr                source_;
+
+        unsigned int                        tileSize_       = 0;
+        Math::Size2ui                       numSamples_;
+
+        size_t                              memoryBudget_   = 0;
+        size_t                              maxNumTiles_    = 1;
+
+        std::unordered_map<TileKey, Tile>   tiles_;
+        std::list<TileKey>                  lruList_;       //!< Tile keys from the most to the least recently used tile.
+
+        std::vector<float>                  evictedHeights_; //!< Buffer of the last evicted tile (to avoid reallocations).
+
+        TileKey                             lastKey_        = ~0ull;
+        const float*                        lastHeights_    = nullptr;
+
+        size_t                              numLoadedTiles_ = 0;
+        size_t                              numEvictedTiles_ = 0;
+
+};
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
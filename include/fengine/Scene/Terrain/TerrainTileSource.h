@@ -0,0 +1,129 @@
+/*
+ * Terrain tile source header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_TERRAIN_TILE_SOURCE_H__
+#define __FORK_TERRAIN_TILE_SOURCE_H__
+
+
+#include "Core/Export.h"
+#include "Core/DeclPtr.h"
+#include "Math/Core/Vector2.h"
+#include "Math/Core/Size2.h"
+#include "Video/Image/Image.h"
+
+#include <vector>
+#include <string>
+#include <fstream>
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+DECL_SHR_PTR(TerrainTileSource);
+
+/**
+Terrain height tile source interface. The height field of a terrain is divided into square tiles,
+which are loaded on demand by the terrain tile cache, so that the entire height field never needs to be resident.
+\see TerrainTileCache
+\see TerrainTileFile
+*/
+class FORK_EXPORT TerrainTileSource
+{
+
+    public:
+
+        virtual ~TerrainTileSource();
+
+        //! Returns the number of height samples per tile side.
+        virtual unsigned int TileSize() const = 0;
+
+        //! Returns the number of tiles in X and Z direction.
+        virtual Math::Size2ui NumTiles() const = 0;
+
+        /**
+        Loads the heights of the specified tile.
+        \param[in] tile Specifies the tile position. This must be inside the range [(0, 0) .. NumTiles()).
+        \param[out] heights Specifies the output buffer. This will be resized to (TileSize() * TileSize()) heights (row by row).
+        */
+        virtual void LoadTile(const Math::Point2ui& tile, std::vector<float>& heights) = 0;
+
+        /**
+        Returns the number of height samples of the entire height field in X and Z direction.
+        By default (NumTiles() * TileSize()), i.e. the last tiles are entirely filled.
+        */
+        virtual Math::Size2ui NumSamples() const;
+
+};
+
+
+/**
+Tiled terrain height file. The file consists of a small header
+followed by the height tiles (row by row), each stored as (tileSize * tileSize) 32-bit floats.
+Thus a single tile can be read with one seek and one read operation.
+\see WriteTiles
+*/
+class FORK_EXPORT TerrainTileFile : public TerrainTileSource
+{
+
+    public:
+
+        /**
+        Opens the specified tiled terrain height file.
+        \throws FileOpenException If the file could not be opened or has an invalid header.
+        */
+        TerrainTileFile(const std::string& filename);
+
+        TerrainTileFile(const TerrainTileFile&) = delete;
+        TerrainTileFile& operator = (const TerrainTileFile&) = delete;
+
+        unsigned int TileSize() const override;
+        Math::Size2ui NumTiles() const override;
+        Math::Size2ui NumSamples() const override;
+
+        /**
+        \throws IndexOutOfBoundsException If 'tile' is out of bounds.
+        \throws FileOpenException If the tile could not be read.
+        */
+        void LoadTile(const Math::Point2ui& tile, std::vector<float>& heights) override;
+
+        /**
+        Writes the specified height field into a new tiled terrain height file.
+        \param[in] filename Specifies the output filename.
+        \param[in] heightField Specifies the height field image. Only the first color component is used.
+        The last tiles are filled by repeating the border samples, but the file keeps the actual number of samples.
+        \param[in] tileSize Specifies the number of height samples per tile side. Must be greater than 0.
+        \throws InvalidArgumentException If 'tileSize' is 0 or the height field is empty.
+        \throws FileOpenException If the file could not be created.
+        */
+        static void WriteTiles(const std::string& filename, const Video::ImageFloat& heightField, unsigned int tileSize);
+
+    private:
+
+        std::ifstream   stream_;
+        std::string     filename_;
+
+        unsigned int    tileSize_ = 0;
+        Math::Size2ui   numTiles_;
+        Math::Size2ui   numSamples_;
+
+};
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
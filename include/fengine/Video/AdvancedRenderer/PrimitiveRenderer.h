@@ -468,6 +468,7 @@ class FORK_EXPORT PrimitiveRenderer
         /* === Functions === */
 
         void UpdateFontVertexBufferAtlas();
+        void UpdateFontVertexBufferAtlas(const TextureFont::PartitionContianerType::Partition& partition);
 
         void BeginDrawingText(const TextureFont* font);
         void EndDrawingText(const TextureFont* font);
@@ -513,7 +514,10 @@ class FORK_EXPORT PrimitiveRenderer
             ShaderCompositionPtr                shader;
             ConstantBufferPtr                   constBuffer;
 
-            TextureFont::PartitionContianerType vertexDataAtlas;
+            TextureFont::PartitionContianerType vertexDataAtlas
+            {
+                TextureFont::PartitionContianerType::AllocationModes::FreeList
+            };
             VertexBufferPtr                     vertexBufferAtlas;
         };
 
@@ -41,6 +41,15 @@ Returns the format type of the specified image file.
 */
 FORK_EXPORT ImageFileFormats DetectFileFormat(const std::string& filename);
 
+/**
+Returns the format type of the specified image file content.
+\param[in] data Raw pointer to the image file content (at least the first 4 bytes).
+\param[in] size Specifies the size (in bytes) of the image file content.
+\param[in] filename Optional filename. Its extension is used for the file formats, which have no magic number (TGA and HDR).
+\see ImageFileFormats
+*/
+FORK_EXPORT ImageFileFormats DetectFileFormat(const void* data, size_t size, const std::string& filename = "");
+
 
 } // /namespace Video
 
@@ -12,6 +12,7 @@
 #include "Core/Export.h"
 #include "Video/Image/Image.h"
 #include "Video/FileHandler/ImageFileFormats.h"
+#include "IO/FileSystem/File.h"
 
 #include <string>
 
@@ -40,6 +41,41 @@ Reads the specified image from file and automatically detects its file format.
 */
 FORK_EXPORT ImageFloatPtr ReadImageHDR(const std::string& filename, float gamma = 2.2f, float scale = 1.0f);
 
+/**
+Reads the specified image from memory and automatically detects its file format.
+The image data is decoded directly from the specified memory, i.e. no temporary copy of the file content is made.
+\param[in] data Raw pointer to the image file content.
+\param[in] size Specifies the size (in bytes) of the image file content.
+\param[in] name Optional image name, which is used for error messages and to detect the file formats without magic number (TGA and HDR).
+\see ImageReader::ReadImageFromMemory
+*/
+FORK_EXPORT ImageUBytePtr ReadImageFromMemory(const void* data, size_t size, const std::string& name = "");
+
+/**
+Reads the specified HDR image from memory.
+\see ReadImageFromMemory
+\see ImageReader::ReadImageHDRFromMemory
+*/
+FORK_EXPORT ImageFloatPtr ReadImageHDRFromMemory(
+    const void* data, size_t size, const std::string& name = "", float gamma = 2.2f, float scale = 1.0f
+);
+
+/**
+Reads the image from the current position of the specified file (e.g. a virtual file of a package)
+and automatically detects its file format. The file content is streamed into the decoder.
+\param[in] file Specifies the file, which is read until its end.
+\param[in] name Optional image name, which is used for error messages and to detect the file formats without magic number (TGA and HDR).
+\see ImageReader::ReadImage
+*/
+FORK_EXPORT ImageUBytePtr ReadImage(IO::File& file, const std::string& name = "");
+
+/**
+Reads the HDR image from the current position of the specified file.
+\see ReadImage(IO::File&, const std::string&)
+\see ImageReader::ReadImageHDR
+*/
+FORK_EXPORT ImageFloatPtr ReadImageHDR(IO::File& file, const std::string& name = "", float gamma = 2.2f, float scale = 1.0f);
+
 /**
 Writes the specified image to file using the specified image writer. By default PNG format is used.
 \see ImageWriter::WriteImage
@@ -13,6 +13,7 @@
 #include "Core/DeclPtr.h"
 #include "Video/Image/Image.h"
 #include "Video/FileHandler/ImageFileFormats.h"
+#include "IO/FileSystem/File.h"
 
 #include <string>
 
@@ -53,6 +54,39 @@ class FORK_EXPORT ImageReader
         */
         virtual ImageFloatPtr ReadImageHDR(const std::string& filename, float gamma = 2.2f, float scale = 1.0f) = 0;
 
+        /**
+        Reads the image data from the specified memory buffer, which contains the entire image file content
+        (e.g. an image file, which has been loaded from an archive).
+        \param[in] data Raw pointer to the image file content.
+        \param[in] size Specifies the size (in bytes) of the image file content.
+        \param[in] name Specifies the image name, which is only used for the error messages.
+        \see ReadImage
+        */
+        virtual ImageUBytePtr ReadImageFromMemory(const void* data, size_t size, const std::string& name) = 0;
+        /**
+        Reads the HDR image data from the specified memory buffer.
+        \see ReadImageFromMemory
+        \see ReadImageHDR
+        */
+        virtual ImageFloatPtr ReadImageHDRFromMemory(
+            const void* data, size_t size, const std::string& name, float gamma = 2.2f, float scale = 1.0f
+        ) = 0;
+
+        /**
+        Reads the image data from the specified file, beginning at the current file position.
+        The image is decoded directly from the file, i.e. the file content is not copied into a temporary buffer first.
+        \param[in] file Specifies the file with read access. This can also be a virtual file.
+        \param[in] name Specifies the image name, which is only used for the error messages.
+        \see ReadImage
+        */
+        virtual ImageUBytePtr ReadImage(IO::File& file, const std::string& name) = 0;
+        /**
+        Reads the HDR image data from the specified file, beginning at the current file position.
+        \see ReadImage(IO::File&, const std::string&)
+        \see ReadImageHDR
+        */
+        virtual ImageFloatPtr ReadImageHDR(IO::File& file, const std::string& name, float gamma = 2.2f, float scale = 1.0f) = 0;
+
     protected:
         
         ImageReader() = default;
@@ -320,6 +320,27 @@ template <typename T> class Image
                 std::fill(buffer_.get(), buffer_.get() + NumElements(), T(0));
         }
 
+        /**
+        Image constructor, which adopts the specified buffer without copying it.
+        This can be used to take over a buffer, which has been allocated by an image decoder (e.g. with a custom deleter).
+        \param[in] size Specifies the image size.
+        \param[in] format Specifies the image color format.
+        \param[in] buffer Specifies the image buffer. This must contain at least (size.Volume() * NumColorComponents(format)) elements.
+        If this is null, a new uninitialized buffer is allocated.
+        \code
+        auto imageData = stbi_load(filename.c_str(), &width, &height, &components, 0);
+        auto image = std::make_shared<ImageUByte>(imageSize, colorFormat, ImageUByte::BufferType(imageData, stbi_image_free));
+        \endcode
+        */
+        Image(const SizeType& size, const ImageColorFormats format, const BufferType& buffer) :
+            format_ { format },
+            size_   { size   },
+            buffer_ { buffer }
+        {
+            if (!buffer_)
+                ResizeBuffer(NumElements());
+        }
+
         /**
         Resizes the image buffer.
         \param[in] size Specifies the new image size.
@@ -329,7 +350,6 @@ template <typename T> class Image
         \see ImageResizeModes
         \see ImageConverter::ResizeImageNearest
         \see ImageConverter::ResizeImageLinear
-        \todo 'ImageResizeModes::Linear' mode not yet implemented!
         */
         void Resize(const SizeType& size, const ImageResizeModes mode = ImageResizeModes::Nearest)
         {
@@ -352,8 +372,8 @@ template <typename T> class Image
                 case ImageResizeModes::Nearest:
                     ImageConverter::ResizeImageNearest(buffer_.get(), prevSize, scaledBuffer.get(), size_, NumColorComponents());
                     break;
-                case ImageResizeModes::Linear: //!!!
-                    ImageConverter::/*ResizeImageLinear*/ResizeImageNearest(buffer_.get(), prevSize, scaledBuffer.get(), size_, NumColorComponents());
+                case ImageResizeModes::Linear:
+                    ImageConverter::ResizeImageLinear(buffer_.get(), prevSize, scaledBuffer.get(), size_, NumColorComponents());
                     break;
             }
 
@@ -420,9 +440,8 @@ template <typename T> class Image
         std::shared_ptr<Image<T>> Copy() const
         {
             /* Create new image object */
-            auto newImage = std::make_shared<Image<T>>(format_, size_);
+            auto newImage = std::make_shared<Image<T>>(size_, format_, false);
 
-            newImage->ResizeBuffer(newImage->BufferSize());
             std::copy(buffer_.get(), buffer_.get() + NumElements(), newImage->buffer_.get());
 
             return newImage;
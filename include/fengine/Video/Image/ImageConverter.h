@@ -12,15 +12,19 @@
 #include "Video/Image/ImageConversionException.h"
 #include "Video/Image/ImageAttributes.h"
 #include "Video/Core/AvgColorValue.h"
+#include "Video/Core/MaxColorValue.h"
+#include "Video/Core/ColorRGB.h"
 #include "Core/Exception/NullPointerException.h"
 #include "Core/Exception/InvalidArgumentException.h"
 #include "Core/Exception/InvalidStateException.h"
 #include "Math/Core/BaseMath.h"
 #include "Math/Core/Size3.h"
 #include "Core/StaticConfig.h"
+#include "Core/Export.h"
 
 #include <memory>
 #include <algorithm>
+#include <type_traits>
 
 
 namespace Fork
@@ -73,7 +77,10 @@ template <typename T> void FlipImageX(T* imageBuffer, const SizeType& size, size
 
 /**
 Flips the image data on the y-axis
+\remarks For 'unsigned char' and 'float' the scanlines are swapped with SSE2/AVX,
+and large images are processed in parallel row bands (see Jobs::JobSystem).
 \see FlipImageX
+\see Scalar::FlipImageY
 */
 template <typename T> void FlipImageY(T* imageBuffer, const SizeType& size, size_t components);
 
@@ -96,6 +103,11 @@ template <typename T> void ResizeImageNearest(
 /**
 Copies the source image in a scaled form to the destination image
 with linear interpolation (interpolate between the surrounding pixels).
+The image is interpolated bilinearly on each slice, the slices themselves are selected without interpolation.
+\remarks For 'unsigned char' and 'float' an SSE2/AVX2 implementation is used, which processes large images in parallel row bands.
+The 'unsigned char' implementation uses 8-bit fixed-point weights, so the result may differ by one or two from the scalar implementation.
+\throws ImageConversionException if an image buffer is null or components is less than 1 or greater than 4.
+\see Scalar::ResizeImageLinear
 */
 template <typename T> void ResizeImageLinear(
     const T* srcImageBuffer, const SizeType& srcSize,
@@ -139,9 +151,13 @@ Video::ConvertImageFormat<unsigned char>(
 //       0,  0,  0,255,   160,  0,100,255
 // }
 \endcode
+\remarks For 'unsigned char' and 'float' the conversions RGB/BGR to RGBA/BGRA and RGBA to BGRA (or vice versa)
+are implemented with SSE2/AVX2, and large images are processed in parallel (see Jobs::JobSystem).
+All other conversions use the scalar implementation.
 \throws NullPointerException If 'srcBuffer' or 'destBuffer' is null.
 \throws InvalidArgumentException If 'srcFormat' or 'destFormat' is invalid (see remarks).
 \see MaxColorValue
+\see Scalar::ConvertImageFormat
 */
 template <typename T> void ConvertImageFormat(
     const T* srcBuffer, const ImageColorFormats srcFormat,
@@ -149,6 +165,60 @@ template <typename T> void ConvertImageFormat(
     size_t numPixels, const T& defaultAlpha = MaxColorValue<T>()
 );
 
+/**
+Scalar reference implementations of the image converter functions, which have accelerated specializations.
+These are used for all other data types, and for the conversions which have no accelerated implementation.
+They can also be used to compare the results of the accelerated implementations.
+*/
+namespace Scalar
+{
+
+//! \see ImageConverter::FlipImageY
+template <typename T> void FlipImageY(T* imageBuffer, const SizeType& size, size_t components);
+
+//! \see ImageConverter::ResizeImageLinear
+template <typename T> void ResizeImageLinear(
+    const T* srcImageBuffer, const SizeType& srcSize,
+    T* destImageBuffer, const SizeType& destSize,
+    size_t components
+);
+
+//! \see ImageConverter::ConvertImageFormat
+template <typename T> void ConvertImageFormat(
+    const T* srcBuffer, const ImageColorFormats srcFormat,
+    T* destBuffer, const ImageColorFormats destFormat,
+    size_t numPixels, const T& defaultAlpha = MaxColorValue<T>()
+);
+
+} // /namespace Scalar
+
+/* --- Accelerated specializations --- */
+
+template <> FORK_EXPORT void FlipImageY<unsigned char>(unsigned char* imageBuffer, const SizeType& size, size_t components);
+template <> FORK_EXPORT void FlipImageY<float>(float* imageBuffer, const SizeType& size, size_t components);
+
+template <> FORK_EXPORT void ResizeImageLinear<unsigned char>(
+    const unsigned char* srcImageBuffer, const SizeType& srcSize,
+    unsigned char* destImageBuffer, const SizeType& destSize,
+    size_t components
+);
+template <> FORK_EXPORT void ResizeImageLinear<float>(
+    const float* srcImageBuffer, const SizeType& srcSize,
+    float* destImageBuffer, const SizeType& destSize,
+    size_t components
+);
+
+template <> FORK_EXPORT void ConvertImageFormat<unsigned char>(
+    const unsigned char* srcBuffer, const ImageColorFormats srcFormat,
+    unsigned char* destBuffer, const ImageColorFormats destFormat,
+    size_t numPixels, const unsigned char& defaultAlpha
+);
+template <> FORK_EXPORT void ConvertImageFormat<float>(
+    const float* srcBuffer, const ImageColorFormats srcFormat,
+    float* destBuffer, const ImageColorFormats destFormat,
+    size_t numPixels, const float& defaultAlpha
+);
+
 #if 0
 
 //! Scales the image to a new size
@@ -273,7 +343,7 @@ template <typename T> void FlipImageX(T* imageBuffer, const SizeType& size, size
             auto xPitch = x*components;
 
             /* Iterate over each color component in the current color */
-            for (int i = 0; i < components; ++i)
+            for (size_t i = 0; i < components; ++i)
             {
                 /*
                 Compute indices where the colors will be swaped:
@@ -294,6 +364,11 @@ template <typename T> void FlipImageX(T* imageBuffer, const SizeType& size, size
 }
 
 template <typename T> void FlipImageY(T* imageBuffer, const SizeType& size, size_t components)
+{
+    Scalar::FlipImageY(imageBuffer, size, components);
+}
+
+template <typename T> void Scalar::FlipImageY(T* imageBuffer, const SizeType& size, size_t components)
 {
     /* Check parameter validity */
     ASSERT_POINTER(imageBuffer);
@@ -334,7 +409,22 @@ template <typename T> void FlipImageY(T* imageBuffer, const SizeType& size, size
 
 template <typename T> void FlipImageZ(T* imageBuffer, const SizeType& size, size_t components)
 {
-    //...
+    /* Check parameter validity */
+    ASSERT_POINTER(imageBuffer);
+
+    if (components < 1 || components > 4)
+        throw ImageConversionException(__FUNCTION__, size, components);
+
+    /* Store stride size */
+    const size_t pitchHeight = size.width*size.height*components;
+
+    /* Iterate over each slice and swap it with its opposite slice */
+    for (size_t z = 0; z < size.depth/2; ++z)
+    {
+        auto sliceA = imageBuffer + z*pitchHeight;
+        auto sliceB = imageBuffer + (size.depth - z - 1)*pitchHeight;
+        std::swap_ranges(sliceA, sliceA + pitchHeight, sliceB);
+    }
 }
 
 template <typename T> void ResizeImageNearest(
@@ -388,13 +478,83 @@ template <typename T> void ResizeImageLinear(
     T* destImageBuffer, const SizeType& destSize,
     size_t components)
 {
-    //...
+    Scalar::ResizeImageLinear(srcImageBuffer, srcSize, destImageBuffer, destSize, components);
+}
+
+template <typename T> void Scalar::ResizeImageLinear(
+    const T* srcImageBuffer, const SizeType& srcSize,
+    T* destImageBuffer, const SizeType& destSize,
+    size_t components)
+{
+    /* Check parameter validity */
+    ASSERT_POINTER(srcImageBuffer);
+    ASSERT_POINTER(destImageBuffer);
+
+    if (components < 1 || components > 4)
+        throw ImageConversionException(__FUNCTION__, srcSize, components);
+
+    if (srcSize.Volume() == 0 || destSize.Volume() == 0)
+        return;
+
+    /* Scale factors between destination and source pixel centers */
+    const float scaleX = static_cast<float>(srcSize.width ) / destSize.width;
+    const float scaleY = static_cast<float>(srcSize.height) / destSize.height;
+
+    const size_t pitchSrcWidth = srcSize.width*components;
+
+    auto dst = destImageBuffer;
+
+    /* Iterate over each slice */
+    for (size_t z = 0; z < destSize.depth; ++z)
+    {
+        const auto srcSlice = srcImageBuffer + ( z * srcSize.depth / destSize.depth ) * srcSize.height * pitchSrcWidth;
+
+        /* Iterate over each scanline */
+        for (size_t y = 0; y < destSize.height; ++y)
+        {
+            /* Compute the two source scanlines and the interpolation factor */
+            const float fy = std::max(0.0f, (y + 0.5f)*scaleY - 0.5f);
+            const size_t y0 = std::min(static_cast<size_t>(fy), srcSize.height - 1);
+            const size_t y1 = std::min(y0 + 1, srcSize.height - 1);
+            const float ty = std::min(fy - y0, 1.0f);
+
+            const auto row0 = srcSlice + y0*pitchSrcWidth;
+            const auto row1 = srcSlice + y1*pitchSrcWidth;
+
+            /* Iterate over each color */
+            for (size_t x = 0; x < destSize.width; ++x)
+            {
+                /* Compute the two source colors and the interpolation factor */
+                const float fx = std::max(0.0f, (x + 0.5f)*scaleX - 0.5f);
+                const size_t x0 = std::min(static_cast<size_t>(fx), srcSize.width - 1);
+                const size_t x1 = std::min(x0 + 1, srcSize.width - 1);
+                const float tx = std::min(fx - x0, 1.0f);
+
+                /* Interpolate each color component */
+                for (size_t c = 0; c < components; ++c)
+                {
+                    const float a = Math::Lerp(static_cast<float>(row0[x0*components + c]), static_cast<float>(row0[x1*components + c]), tx);
+                    const float b = Math::Lerp(static_cast<float>(row1[x0*components + c]), static_cast<float>(row1[x1*components + c]), tx);
+                    const float v = Math::Lerp(a, b, ty);
+                    *dst++ = static_cast<T>(std::is_integral<T>::value ? v + 0.5f : v);
+                }
+            }
+        }
+    }
 }
 
 template <typename T> void ConvertImageFormat(
     const T* srcBuffer, const ImageColorFormats srcFormat,
     T* destBuffer, const ImageColorFormats destFormat,
     size_t numPixels, const T& defaultAlpha)
+{
+    Scalar::ConvertImageFormat(srcBuffer, srcFormat, destBuffer, destFormat, numPixels, defaultAlpha);
+}
+
+template <typename T> void Scalar::ConvertImageFormat(
+    const T* srcBuffer, const ImageColorFormats srcFormat,
+    T* destBuffer, const ImageColorFormats destFormat,
+    size_t numPixels, const T& defaultAlpha)
 {
     /* Validate parameters */
     ASSERT_POINTER(srcBuffer);
@@ -0,0 +1,111 @@
+/*
+ * MIP chain builder header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_MIP_CHAIN_BUILDER_H__
+#define __FORK_MIP_CHAIN_BUILDER_H__
+
+
+#include "Core/Export.h"
+#include "Video/Image/Image.h"
+
+#include <vector>
+
+
+namespace Fork
+{
+
+namespace Video
+{
+
+
+//! MIP chain of 8-bit images. The first entry is the original image (MIP level 0), the last entry has a size of 1x1.
+typedef std::vector<ImageUBytePtr> MIPChainUByte;
+//! MIP chain of floating-point images. \see MIPChainUByte
+typedef std::vector<ImageFloatPtr> MIPChainFloat;
+
+/**
+MIP chain builder namespace. This generates the entire MIP chain of an image on the CPU,
+so that textures can be cooked once (e.g. headless in a tool), instead of being filtered on the GPU at load time.
+\code
+Video::MIPChainBuilder::Description desc;
+desc.filter                 = Video::MIPChainBuilder::Filters::Kaiser;
+desc.sRGB                   = true;
+desc.preserveAlphaCoverage  = true;
+
+auto mipChain = Video::MIPChainBuilder::BuildMIPChain(*image, desc);
+renderSystem->WriteTexture(texture.get(), mipChain);
+\endcode
+\see RenderSystem::WriteTexture(Texture2D*, const MIPChainUByte&)
+*/
+namespace MIPChainBuilder
+{
+
+
+//! Separable downsampling filters.
+enum class Filters
+{
+    Box,        //!< Box filter (average of 2x2 pixels). This is the fastest filter, but it is rather blurry.
+    Kaiser,     //!< Kaiser windowed sinc filter (with a radius of 3 pixels). This is sharp, with only little ringing.
+    Lanczos,    //!< Lanczos filter (with a radius of 3 pixels). This is the sharpest filter, but it may produce visible ringing.
+};
+
+//! MIP chain description.
+struct Description
+{
+    Filters         filter                  = Filters::Kaiser;  //!< Downsampling filter. By default Filters::Kaiser.
+    /**
+    Specifies whether the color components are stored in sRGB color space. If true, the color components are converted
+    into linear space before they are filtered, and converted back to sRGB afterwards (gamma-correct downsampling).
+    The alpha channel is always filtered in linear space. By default false.
+    */
+    bool            sRGB                    = false;
+    /**
+    Specifies whether the alpha-test coverage is to be preserved. If true, the alpha channel of each MIP level is scaled,
+    so that the same fraction of pixels passes the alpha test with 'alphaReference' as in the original image.
+    This prevents cutout textures (e.g. foliage) from fading out in the distance. By default false.
+    */
+    bool            preserveAlphaCoverage   = false;
+    float           alphaReference          = 0.5f;             //!< Alpha-test reference value in the range [0, 1]. By default 0.5.
+    bool            wrap                    = false;            //!< Specifies whether the filter wraps around the image borders (for tileable textures). By default false (clamp to edge).
+    size_t          maxNumLevels            = 0;                //!< Maximal number of MIP levels. By default 0, i.e. the entire MIP chain is built.
+};
+
+
+/**
+Builds the MIP chain for the specified image.
+\param[in] image Specifies the source image (MIP level 0). This must have one of the color formats
+Gray, GrayAlpha, RGB, BGR, RGBA or BGRA. For 3D images, each slice is filtered independently.
+\param[in] desc Specifies the MIP chain description.
+\return MIP chain, where the first entry is a copy of the source image.
+\remarks The MIP levels are filtered in linear floating-point precision, each from its previous level.
+The scanlines of each level are filtered in parallel row bands, and each finished level is converted
+into its final format (including the alpha coverage correction) in parallel to the next level (see Jobs::JobSystem).
+\throws InvalidArgumentException If the color format of the image is invalid.
+*/
+FORK_EXPORT MIPChainUByte BuildMIPChain(const ImageUByte& image, const Description& desc = Description());
+
+/**
+Builds the MIP chain for the specified floating-point image.
+\remarks Only the sRGB conversion clamps negative values (e.g. from the filter ringing) to zero,
+otherwise high-dynamic range values are kept.
+\see BuildMIPChain(const ImageUByte&, const Description&)
+*/
+FORK_EXPORT MIPChainFloat BuildMIPChain(const ImageFloat& image, const Description& desc = Description());
+
+
+} // /namespace MIPChainBuilder
+
+} // /namespace Video
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
@@ -33,6 +33,7 @@
 
 #include "Video/BufferFormat/HardwareBufferUsage.h"
 #include "Video/Image/Image.h"
+#include "Video/Image/MIPChainBuilder.h"
 #include "Video/Image/ImageAttributes.h"
 #include "Video/Core/Viewport.h"
 #include "Video/Core/Scissor.h"
@@ -389,6 +390,18 @@ class FORK_EXPORT RenderSystem
         //! Creates the texture data from the specified image.
         virtual void WriteTexture(Texture2D* texture, const ImageUByte& image);
         /**
+        Creates the texture data from the specified MIP chain, i.e. all MIP levels are uploaded
+        and no MIP-maps need to be generated at load time.
+        \param[in] texture Raw-pointer to the texture which is to be written.
+        \param[in] mipChain Specifies the MIP chain. All images must have the same color format, and each image
+        must have half the size of its previous image (see MIPChainBuilder::BuildMIPChain).
+        \remarks Each MIP level is written with the level-allocating 'WriteTexture' function, i.e. the hardware MIP-maps are never generated.
+        \see MIPChainBuilder::BuildMIPChain
+        */
+        virtual void WriteTexture(Texture2D* texture, const MIPChainUByte& mipChain);
+        //! \see WriteTexture(Texture2D*, const MIPChainUByte&)
+        virtual void WriteTexture(Texture2D* texture, const MIPChainFloat& mipChain);
+        /**
         \note For OpenGL texture arrays no integer texture formats are supported! They will be converted automatically into floating-pointer texture formats.
         \see WriteTexture(Texture1D*, const TextureFormats, const Texture1D::SizeType&, unsigned int, const ImageColorFormats, const RendererDataTypes, const void*)
         */
@@ -397,6 +410,21 @@ class FORK_EXPORT RenderSystem
             const TextureFormats textureFormat, const Texture2D::SizeType& textureSize, unsigned int arraySize,
             const ImageColorFormats imageFormat, const RendererDataTypes imageDataType, const void* imageData
         ) = 0;
+        /**
+        Creates the texture data of the specified MIP level, without generating any other MIP-maps.
+        \param[in] textureSize Specifies the size of this MIP level.
+        \param[in] mipLevel Specifies the MIP level which is to be created. For 0 this is equivalent to the other 'WriteTexture' function.
+        \remarks The default implementation writes all other levels than 0 with 'WriteSubTexture',
+        i.e. it requires that the render system already allocates all MIP levels when the base level is created.
+        \note The base level (0) and all previous levels must be written first, with the same texture format and array size.
+        \see WriteTexture(Texture2D*, const TextureFormats, const Texture2D::SizeType&, unsigned int, const ImageColorFormats, const RendererDataTypes, const void*)
+        */
+        virtual void WriteTexture(
+            Texture2D* texture,
+            const TextureFormats textureFormat, const Texture2D::SizeType& textureSize, unsigned int arraySize,
+            const ImageColorFormats imageFormat, const RendererDataTypes imageDataType, const void* imageData,
+            unsigned int mipLevel
+        );
         //! \see WriteSubTexture(Texture1D*, const Texture1D::PositionType&, const Texture1D::SizeType&, unsigned int, const ImageColorFormats, const RendererDataTypes, const void*)
         virtual void WriteSubTexture(
             Texture2D* texture,
@@ -690,6 +718,8 @@ class FORK_EXPORT RenderSystem
         void ChangeBufferFormat(VertexBuffer* vertexBuffer, const VertexFormat& format);
         //! \note This pointer must never be null!
         void ChangeTextureFormat(Texture* texture, TextureFormats format);
+        //! \note This pointer must never be null!
+        void ChangeTextureMIPState(Texture* texture, bool hasMIPMaps);
 
         /**
         Creates and initializes the default render states (rasterizer-, depth-stenicl- and blend states),
@@ -59,6 +59,17 @@ class FORK_EXPORT RendererProfilerModel
             renderedTriangleCounter_ += numRenderedTriangles;
         }
         
+        /**
+        Increments the batched draw call counter.
+        \param[in] numDrawCalls Specifies the number of draw calls which have been saved,
+        by merging several draw calls into a single instanced draw call.
+        \see Scene::InstanceBatcher
+        */
+        inline void RecordBatchedDrawCalls(const CounterType& numDrawCalls)
+        {
+            batchedDrawCallCounter_ += numDrawCalls;
+        }
+
         //! Increments the render target binding counter.
         inline void RecordRenderTargetBinding()
         {
@@ -80,6 +91,17 @@ class FORK_EXPORT RendererProfilerModel
             ++shaderBindingCounter_;
         }
 
+        /**
+        Increments the skipped binding counter.
+        \remarks This is used for redundant bindings (texture-, buffer- or shader bindings),
+        which have been filtered out before they were passed to the render context, e.g. by a sorted render queue.
+        \see Scene::RenderQueue::Submit
+        */
+        inline void RecordSkippedBinding()
+        {
+            ++skippedBindingCounter_;
+        }
+
         //! Increments the texture creation counter.
         inline void RecordTextureCreation()
         {
@@ -126,6 +148,12 @@ class FORK_EXPORT RendererProfilerModel
             return renderedTriangleCounter_;
         }
 
+        //! Returns the number of draw calls which have been saved by instancing.
+        inline CounterType NumBatchedDrawCalls() const
+        {
+            return batchedDrawCallCounter_;
+        }
+
         //! Returns the number of recorded render target bindinds.
         inline CounterType NumRenderTargetBindings() const
         {
@@ -147,6 +175,12 @@ class FORK_EXPORT RendererProfilerModel
             return shaderBindingCounter_;
         }
 
+        //! Returns the number of recorded skipped bindings.
+        inline CounterType NumSkippedBindings() const
+        {
+            return skippedBindingCounter_;
+        }
+
         //! Returns the number of recorded texture creations.
         inline CounterType NumTextureCreations() const
         {
@@ -184,11 +218,13 @@ class FORK_EXPORT RendererProfilerModel
         
         CounterType drawCallCounter_            = 0;
         CounterType renderedTriangleCounter_    = 0;
+        CounterType batchedDrawCallCounter_     = 0;
 
         CounterType renderTargetBindingCounter_ = 0;
         CounterType textureBindingCounter_      = 0;
         CounterType bufferBindingCounter_       = 0;
         CounterType shaderBindingCounter_       = 0;
+        CounterType skippedBindingCounter_      = 0;
         
         CounterType textureCreationCounter_     = 0;
         CounterType textureUpdateCounter_       = 0;
@@ -14,11 +14,17 @@
 #include "Video/RenderSystem/Texture/Texture2D.h"
 #include "Video/RenderSystem/Texture/TextureCube.h"
 #include "Core/Container/SharedHashMap.h"
+#include "Core/Jobs/AsyncResult.h"
+#include "Core/Jobs/JobCounter.h"
+#include "Video/Image/Image.h"
 #include "Math/Core/Cuboid.h"
 //#include "Core/Container/EventEmitter.h"
 
 #include <string>
 #include <vector>
+#include <deque>
+#include <map>
+#include <mutex>
 
 
 namespace Fork
@@ -30,6 +36,10 @@ namespace Video
 
 DECL_SHR_PTR(TextureManager);
 
+//! Asynchronous 2D texture handle. \see TextureManager::LoadTexture2DAsync
+typedef Jobs::AsyncResult<Texture2DPtr> AsyncTexture2D;
+typedef Jobs::AsyncResultPtr<Texture2DPtr> AsyncTexture2DPtr;
+
 /**
 Texture manager class.
 This class should be used to create textures from image files.
@@ -96,6 +106,12 @@ class FORK_EXPORT TextureManager// : public EventEmitter<TextureManager::EventHa
 
         typedef std::shared_ptr<EventHandler> EventHandlerPtr;
 
+        TextureManager() = default;
+        ~TextureManager();
+
+        TextureManager(const TextureManager&) = delete;
+        TextureManager& operator = (const TextureManager&) = delete;
+
         /**
         Creates a 2D texture and initializes it with the image, loaded from the specified file.
         This is a 'helper function', if you need access to that image object, create the texture
@@ -127,10 +143,36 @@ class FORK_EXPORT TextureManager// : public EventEmitter<TextureManager::EventHa
 
         /**
         Loads the specified 2D image texture. If the texture was already loaded, this texture will be returned.
+        If the texture is still pending from "LoadTexture2DAsync", this waits for its decode job and commits it.
         \see CreateTexture2DFromFile
         */
         Texture2DPtr LoadTexture2D(const std::string& filename, bool hasHDR = false);
 
+        /**
+        Loads the specified 2D image texture asynchronously. The image file is read and decoded on the job system,
+        and the texture is created on the render thread by "CommitAsyncTextures".
+        If the texture was already loaded or is already pending, the same texture respectively the same handle will be returned.
+        \return Shared pointer to the asynchronous texture handle. This is never null.
+        \remarks This function is thread-safe, i.e. it can also be called from worker threads (e.g. while a model is read).
+        \see CommitAsyncTextures
+        \see LoadTexture2D
+        */
+        AsyncTexture2DPtr LoadTexture2DAsync(const std::string& filename, bool hasHDR = false);
+
+        /**
+        Creates the textures for all asynchronously decoded images and resolves their handles.
+        Call this once per frame on the render thread.
+        \param[in] byteBudget Specifies the maximal number of image bytes, which are uploaded to the GPU in this call.
+        At least one texture is created per call, so that a large texture can not stall the others. If this is 0, the budget is unlimited.
+        \return Number of asynchronous textures, which are still pending (i.e. which are decoding or waiting for their commit).
+        \throws NullPointerException If no render system or no render context is active.
+        \see LoadTexture2DAsync
+        */
+        size_t CommitAsyncTextures(size_t byteBudget);
+
+        //! Returns the number of asynchronous textures, which are still pending.
+        size_t NumPendingAsyncTextures() const;
+
         //! Releases the specified texture.
         void ReleaseTexture(const Texture* texture);
         //! Releases all textures in this texture manager.
@@ -146,16 +188,42 @@ class FORK_EXPORT TextureManager// : public EventEmitter<TextureManager::EventHa
 
     private:
         
+        //! Asynchronous 2D texture request. The images are null until the request has been decoded.
+        struct AsyncTexture2DRequest
+        {
+            std::string         filename;
+            bool                hasHDR = false;
+            AsyncTexture2DPtr   handle;
+            ImageUBytePtr       image;
+            ImageFloatPtr       imageHDR;
+            Jobs::JobCounter    decodeCounter;  //!< Counter of the decode job of this request.
+        };
+
+        typedef std::shared_ptr<AsyncTexture2DRequest> AsyncTexture2DRequestPtr;
+
         template <class T> T AddTexture(const T& texture)
         {
             textures_.push_back(texture);
             return texture;
         }
 
-        std::vector<TexturePtr>                 textures_;          //!< Main texture container.
-        std::vector<EventHandlerPtr>            eventHandlers_;     //!< Event handler container.
+        //! Creates the texture for the specified decoded image (either 'image' or 'imageHDR' must be non-null).
+        Texture2DPtr CreateTexture2DFromImage(const std::string& filename, const ImageUBytePtr& image, const ImageFloatPtr& imageHDR);
+
+        //! Reads and decodes the image of the specified request. This is executed on the job system.
+        void DecodeAsyncTexture(const AsyncTexture2DRequestPtr& request);
+
+        //! Creates the texture for the specified decoded request, resolves its handle and removes it from the pending requests.
+        Texture2DPtr CommitAsyncTexture(const AsyncTexture2DRequestPtr& request);
+
+        std::vector<TexturePtr>                         textures_;          //!< Main texture container.
+        std::vector<EventHandlerPtr>                    eventHandlers_;     //!< Event handler container.
+
+        SharedHashMap<std::string, Texture2D>           loaded2DTextures_;  //!< Loaded texture shared map.
 
-        SharedHashMap<std::string, Texture2D>   loaded2DTextures_;  //!< Loaded texture shared map.
+        mutable std::mutex                              asyncMutex_;        //!< Mutex for the loaded texture map and the asynchronous requests.
+        std::map<std::string, AsyncTexture2DRequestPtr> pendingTextures_;   //!< Asynchronous requests, which have not been committed yet.
+        std::deque<AsyncTexture2DRequestPtr>            decodedTextures_;   //!< Decoded requests in the order of their completion.
 
 };
 
@@ -18,6 +18,7 @@
 
 #include "Animation/Core/Playback.h"
 #include "Animation/Core/KeyframeSequence.h"
+#include "Animation/Core/CompressedKeyframeSequence.h"
 #include "Animation/Core/DefaultPlaybackEventHandlers.h"
 
 
@@ -26,6 +27,7 @@
 #include "Animation/AnimationSystem/SkeletalAnimation.h"
 #include "Animation/AnimationSystem/MorphTargetAnimation.h"
 #include "Animation/AnimationSystem/NodeAnimation.h"
+#include "Animation/AnimationSystem/AnimationMixer.h"
 
 
 #endif
@@ -21,6 +21,12 @@
 #include "Core/SDKGuard.h"
 #include "Core/Container/StrideBuffer.h"
 #include "Core/Container/MementoHierarchy.h"
+#include "Core/Container/IdentityFactory.h"
+#include "Core/Container/PartitionContainer.h"
+#include "Core/Container/LinearArena.h"
+#include "Core/Container/RadixSort.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Core/Jobs/AsyncResult.h"
 #include "Core/TreeHierarchy/KDTreeNode.h"
 #include "Core/CiString.h"
 #include "Core/DefaultValue.h"
@@ -144,6 +150,7 @@
 #include "Video/Core/Spaces.h"
 
 #include "Video/Image/ImageConverter.h"
+#include "Video/Image/MIPChainBuilder.h"
 
 
 
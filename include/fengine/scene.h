@@ -26,6 +26,7 @@
 #include "Scene/Node/CameraNode.h"
 #include "Scene/Node/LightNode.h"
 #include "Scene/Node/GeometryNode.h"
+#include "Scene/Node/ParallelSceneVisitor.h"
 
 
 /* --- Light source header files --- */
@@ -46,17 +47,29 @@
 #include "Scene/Geometry/Node/Simple2DMeshGeometry.h"
 #include "Scene/Geometry/Node/Simple3DMeshGeometry.h"
 #include "Scene/Geometry/Node/TangentSpaceMeshGeometry.h"
+#include "Scene/Geometry/Node/TerrainGeometry.h"
 #include "Scene/Geometry/Generator/GeometryGenerator.h"
 #include "Scene/Geometry/Modifier/GeometryAutoUVMapModifier.h"
 #include "Scene/Geometry/GeometryConverter.h"
 #include "Scene/Geometry/MeshGeometryAtlas.h"
 #include "Scene/Geometry/GeometrySearchFilter.h"
 #include "Scene/Geometry/Skeleton.h"
+#include "Scene/Geometry/FlatSkeleton.h"
+#include "Scene/Geometry/SkeletonPose.h"
+#include "Scene/Geometry/SkinWeights.h"
+
+
+/* --- Terrain header files --- */
+
+#include "Scene/Terrain/TerrainTileSource.h"
+#include "Scene/Terrain/TerrainTileCache.h"
+#include "Scene/Terrain/TerrainQuadTree.h"
 
 
 /* --- Manager header files --- */
 
 #include "Scene/Manager/SceneManager.h"
+#include "Scene/Manager/BoundingVolumeHierarchy.h"
 #include "Scene/Manager/FreeViewSceneNodeController.h"
 #include "Scene/Manager/PresentSceneNodeController.h"
 
@@ -64,6 +77,10 @@
 /* --- Renderer header files --- */
 
 #include "Scene/Renderer/ForwardSceneRenderer.h"
+#include "Scene/Renderer/QueuedSceneRenderer.h"
+#include "Scene/Renderer/RenderQueue.h"
+#include "Scene/Renderer/InstanceBatcher.h"
+#include "Scene/Renderer/LODSelector.h"
 #include "Scene/Renderer/SimpleSceneRenderer.h"
 #include "Scene/Renderer/BoundingBoxSceneRenderer.h"
 #include "Scene/Renderer/LogSceneRenderer.h"
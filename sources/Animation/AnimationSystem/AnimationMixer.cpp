@@ -0,0 +1,549 @@
+/*
+ * Animation mixer file
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Animation/AnimationSystem/AnimationMixer.h"
+#include "Core/Exception/NullPointerException.h"
+#include "Core/Exception/InvalidArgumentException.h"
+#include "Core/Jobs/JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace Fork
+{
+
+namespace Anim
+{
+
+
+/* --- Internal functions --- */
+
+typedef Scene::SkeletonPose::LocalTransforms PoseBuffer;
+
+static float ClampWeight(float weight)
+{
+    return std::max(0.0f, std::min(weight, 1.0f));
+}
+
+//! Returns the weight of the specified joint, i.e. the node weight multiplied by the (optional) mask weight.
+static float JointWeight(float weight, const AnimationMixer::JointMask& mask, size_t index)
+{
+    return mask.empty() ? weight : weight * mask[index];
+}
+
+/*
+Interpolates the quaternion 'a' to 'b' (normalized linear interpolation along the shortest path)
+and stores the result in 'a'.
+*/
+static void NLerpQuaternion(float& ax, float& ay, float& az, float& aw, float bx, float by, float bz, float bw, float t)
+{
+    const auto dot = ax*bx + ay*by + az*bz + aw*bw;
+    const auto s = (dot < 0.0f ? -t : t);
+    const auto r = 1.0f - t;
+
+    ax = ax*r + bx*s;
+    ay = ay*r + by*s;
+    az = az*r + bz*s;
+    aw = aw*r + bw*s;
+
+    const auto len = std::sqrt(ax*ax + ay*ay + az*az + aw*aw);
+    if (len > 0.0f)
+    {
+        const auto invLen = 1.0f / len;
+        ax *= invLen;
+        ay *= invLen;
+        az *= invLen;
+        aw *= invLen;
+    }
+}
+
+//! Blends the pose 'b' into the pose 'a' (a = a*(1 - w) + b*w, with the per-joint weights w).
+static void BlendPoses(
+    PoseBuffer& a, const PoseBuffer& b, float weight, const AnimationMixer::JointMask& mask, size_t numJoints)
+{
+    for (size_t i = 0; i < numJoints; ++i)
+    {
+        const auto t = JointWeight(weight, mask, i);
+        if (t <= 0.0f)
+            continue;
+
+        a.positionX[i] += (b.positionX[i] - a.positionX[i]) * t;
+        a.positionY[i] += (b.positionY[i] - a.positionY[i]) * t;
+        a.positionZ[i] += (b.positionZ[i] - a.positionZ[i]) * t;
+
+        NLerpQuaternion(
+            a.rotationX[i], a.rotationY[i], a.rotationZ[i], a.rotationW[i],
+            b.rotationX[i], b.rotationY[i], b.rotationZ[i], b.rotationW[i],
+            t
+        );
+
+        a.scaleX[i] += (b.scaleX[i] - a.scaleX[i]) * t;
+        a.scaleY[i] += (b.scaleY[i] - a.scaleY[i]) * t;
+        a.scaleZ[i] += (b.scaleZ[i] - a.scaleZ[i]) * t;
+    }
+}
+
+//! Returns the relative scale (additive / reference) for an additive layer.
+static float RelativeScale(float additive, float reference)
+{
+    return (reference != 0.0f ? additive / reference : 1.0f);
+}
+
+/*
+Adds the difference between the additive pose and the reference pose to the base pose (with the per-joint weights w):
+position = base + (additive - reference)*w, rotation = base * nlerp(identity, reference^-1 * additive, w),
+scale = base * lerp(1, additive/reference, w).
+*/
+static void AddPoses(
+    PoseBuffer& base, const PoseBuffer& additive, const PoseBuffer& reference,
+    float weight, const AnimationMixer::JointMask& mask, size_t numJoints)
+{
+    for (size_t i = 0; i < numJoints; ++i)
+    {
+        const auto t = JointWeight(weight, mask, i);
+        if (t <= 0.0f)
+            continue;
+
+        /* Add position difference */
+        base.positionX[i] += (additive.positionX[i] - reference.positionX[i]) * t;
+        base.positionY[i] += (additive.positionY[i] - reference.positionY[i]) * t;
+        base.positionZ[i] += (additive.positionZ[i] - reference.positionZ[i]) * t;
+
+        /* Compute rotation difference: delta = conjugate(reference) * additive */
+        const auto rx = -reference.rotationX[i];
+        const auto ry = -reference.rotationY[i];
+        const auto rz = -reference.rotationZ[i];
+        const auto rw =  reference.rotationW[i];
+
+        const auto qx = additive.rotationX[i];
+        const auto qy = additive.rotationY[i];
+        const auto qz = additive.rotationZ[i];
+        const auto qw = additive.rotationW[i];
+
+        const auto dx = rw*qx + rx*qw + ry*qz - rz*qy;
+        const auto dy = rw*qy - rx*qz + ry*qw + rz*qx;
+        const auto dz = rw*qz + rx*qy - ry*qx + rz*qw;
+        const auto dw = rw*qw - rx*qx - ry*qy - rz*qz;
+
+        /* Weight rotation difference: delta = nlerp(identity, delta, t) */
+        float ix = 0.0f, iy = 0.0f, iz = 0.0f, iw = 1.0f;
+        NLerpQuaternion(ix, iy, iz, iw, dx, dy, dz, dw, t);
+
+        /* Apply rotation difference: base = base * delta */
+        const auto bx = base.rotationX[i];
+        const auto by = base.rotationY[i];
+        const auto bz = base.rotationZ[i];
+        const auto bw = base.rotationW[i];
+
+        base.rotationX[i] = bw*ix + bx*iw + by*iz - bz*iy;
+        base.rotationY[i] = bw*iy - bx*iz + by*iw + bz*ix;
+        base.rotationZ[i] = bw*iz + bx*iy - by*ix + bz*iw;
+        base.rotationW[i] = bw*iw - bx*ix - by*iy - bz*iz;
+
+        /* Apply scale difference */
+        base.scaleX[i] *= 1.0f + (RelativeScale(additive.scaleX[i], reference.scaleX[i]) - 1.0f) * t;
+        base.scaleY[i] *= 1.0f + (RelativeScale(additive.scaleY[i], reference.scaleY[i]) - 1.0f) * t;
+        base.scaleZ[i] *= 1.0f + (RelativeScale(additive.scaleZ[i], reference.scaleZ[i]) - 1.0f) * t;
+    }
+}
+
+
+/*
+ * AnimationMixer class
+ */
+
+AnimationMixer::AnimationMixer(const Scene::FlatSkeletonPtr& skeleton) :
+    skeleton_{ skeleton }
+{
+    ASSERT_POINTER(skeleton);
+
+    /* Store bind pose as SoA, so that each pose buffer can be reset by a plain copy */
+    const auto& bindPose = skeleton_->GetBindPose();
+
+    bindPose_.Resize(bindPose.size());
+    for (size_t i = 0; i < bindPose.size(); ++i)
+        bindPose_.SetTransform(i, bindPose[i]);
+}
+
+size_t AnimationMixer::AddClipNode(const SkeletalAnimation* animation, const Playback* playback)
+{
+    ASSERT_POINTER(animation);
+
+    Node node;
+    {
+        node.type       = NodeTypes::Clip;
+        node.animation  = animation;
+        node.playback   = playback;
+    }
+    return AddNode(node);
+}
+
+size_t AnimationMixer::AddBindPoseNode()
+{
+    Node node;
+    {
+        node.type = NodeTypes::BindPose;
+    }
+    return AddNode(node);
+}
+
+size_t AnimationMixer::AddBlendNode(size_t sourceNode, size_t destNode, float weight, const JointMask& mask)
+{
+    ValidateInputNode(__FUNCTION__, "sourceNode", sourceNode);
+    ValidateInputNode(__FUNCTION__, "destNode", destNode);
+    ValidateMask(__FUNCTION__, mask);
+
+    Node node;
+    {
+        node.type           = NodeTypes::Blend;
+        node.inputs[0]      = sourceNode;
+        node.inputs[1]      = destNode;
+        node.weight         = ClampWeight(weight);
+        node.targetWeight   = node.weight;
+        node.mask           = mask;
+    }
+    return AddNode(node);
+}
+
+size_t AnimationMixer::AddAdditiveNode(
+    size_t baseNode, size_t additiveNode, float weight, const JointMask& mask, size_t referenceNode)
+{
+    ValidateInputNode(__FUNCTION__, "baseNode", baseNode);
+    ValidateInputNode(__FUNCTION__, "additiveNode", additiveNode);
+    if (referenceNode != invalidNode)
+        ValidateInputNode(__FUNCTION__, "referenceNode", referenceNode);
+    ValidateMask(__FUNCTION__, mask);
+
+    Node node;
+    {
+        node.type           = NodeTypes::Additive;
+        node.inputs[0]      = baseNode;
+        node.inputs[1]      = additiveNode;
+        node.inputs[2]      = referenceNode;
+        node.weight         = ClampWeight(weight);
+        node.targetWeight   = node.weight;
+        node.mask           = mask;
+    }
+    return AddNode(node);
+}
+
+void AnimationMixer::Clear()
+{
+    nodes_.clear();
+    outputNode_ = invalidNode;
+}
+
+void AnimationMixer::SetOutputNode(size_t node)
+{
+    GetNode(__FUNCTION__, node);
+    outputNode_ = node;
+}
+
+void AnimationMixer::SetWeight(size_t node, float weight)
+{
+    auto& mixNode = GetWeightedNode(__FUNCTION__, node);
+    mixNode.weight          = ClampWeight(weight);
+    mixNode.targetWeight    = mixNode.weight;
+    mixNode.fadeSpeed       = 0.0;
+}
+
+float AnimationMixer::GetWeight(size_t node) const
+{
+    return GetNode(__FUNCTION__, node).weight;
+}
+
+void AnimationMixer::FadeWeight(size_t node, float targetWeight, double duration)
+{
+    auto& mixNode = GetWeightedNode(__FUNCTION__, node);
+
+    targetWeight = ClampWeight(targetWeight);
+
+    if (duration > 0.0 && mixNode.weight != targetWeight)
+    {
+        mixNode.targetWeight    = targetWeight;
+        mixNode.fadeSpeed       = std::abs(targetWeight - mixNode.weight) / duration;
+    }
+    else
+    {
+        mixNode.weight          = targetWeight;
+        mixNode.targetWeight    = targetWeight;
+        mixNode.fadeSpeed       = 0.0;
+    }
+}
+
+bool AnimationMixer::IsFading(size_t node) const
+{
+    return GetNode(__FUNCTION__, node).fadeSpeed > 0.0;
+}
+
+void AnimationMixer::SetMask(size_t node, const JointMask& mask)
+{
+    ValidateMask(__FUNCTION__, mask);
+    GetWeightedNode(__FUNCTION__, node).mask = mask;
+}
+
+AnimationMixer::JointMask AnimationMixer::MakeJointMask(const Scene::FlatSkeleton& skeleton, size_t rootJoint, float weight)
+{
+    const auto numJoints = skeleton.NumJoints();
+
+    if (rootJoint >= numJoints)
+        throw InvalidArgumentException(__FUNCTION__, "rootJoint", "Joint index out of range");
+
+    /* Parents are stored before their children, so the descendants follow the root joint in a single pass */
+    const auto& parents = skeleton.GetParents();
+
+    std::vector<bool> masked(numJoints, false);
+    JointMask mask(numJoints, 0.0f);
+
+    for (size_t i = rootJoint; i < numJoints; ++i)
+    {
+        if (i == rootJoint || (parents[i] != Scene::FlatSkeleton::invalidIndex && masked[parents[i]]))
+        {
+            masked[i] = true;
+            mask[i] = weight;
+        }
+    }
+
+    return mask;
+}
+
+void AnimationMixer::Update(double deltaTime)
+{
+    for (auto& node : nodes_)
+    {
+        if (node.fadeSpeed > 0.0)
+        {
+            /* Move weight towards the target weight */
+            const auto step = static_cast<float>(node.fadeSpeed * deltaTime);
+
+            if (std::abs(node.targetWeight - node.weight) <= step)
+            {
+                node.weight     = node.targetWeight;
+                node.fadeSpeed  = 0.0;
+            }
+            else if (node.weight < node.targetWeight)
+                node.weight += step;
+            else
+                node.weight -= step;
+        }
+    }
+}
+
+void AnimationMixer::Evaluate(Scene::SkeletonPose& pose)
+{
+    if (pose.GetSkeleton() != skeleton_.get())
+        throw InvalidArgumentException(__FUNCTION__, "pose", "Pose does not refer to the flat skeleton of this animation mixer");
+    Evaluate(pose.GetLocalTransforms());
+}
+
+void AnimationMixer::Evaluate(Scene::SkeletonPose::LocalTransforms& localTransforms)
+{
+    if (outputNode_ == invalidNode)
+    {
+        localTransforms = bindPose_;
+        return;
+    }
+
+    /* Evaluate graph and copy the final pose buffer (no reallocation if the arrays already have the same size) */
+    const auto buffer = EvaluateNode(outputNode_);
+    localTransforms = *poseBuffers_[buffer];
+    ReleasePoseBuffer(buffer);
+}
+
+void AnimationMixer::EvaluatePoses(const std::vector<AnimationMixer*>& mixers, const std::vector<Scene::SkeletonPose*>& poses)
+{
+    if (mixers.size() != poses.size())
+        throw InvalidArgumentException(__FUNCTION__, "poses", "Number of poses must be equal to the number of animation mixers");
+
+    /* Validate all poses before, since the jobs must not throw exceptions */
+    for (size_t i = 0; i < mixers.size(); ++i)
+    {
+        if (mixers[i] && poses[i] && poses[i]->GetSkeleton() != mixers[i]->GetSkeleton())
+            throw InvalidArgumentException(__FUNCTION__, "poses", "Pose does not refer to the flat skeleton of its animation mixer");
+    }
+
+    /* Evaluate all mixers and update the pose matrices in parallel */
+    Jobs::JobSystem::Instance()->ParallelFor(
+        0, mixers.size(),
+        [&mixers, &poses](size_t i)
+        {
+            if (mixers[i] && poses[i])
+            {
+                mixers[i]->Evaluate(poses[i]->GetLocalTransforms());
+                poses[i]->UpdateMatrices();
+            }
+        }
+    );
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+size_t AnimationMixer::AddNode(const Node& node)
+{
+    nodes_.push_back(node);
+    outputNode_ = nodes_.size() - 1;
+    return outputNode_;
+}
+
+AnimationMixer::Node& AnimationMixer::GetWeightedNode(const char* procName, size_t node)
+{
+    if (node >= nodes_.size())
+        throw InvalidArgumentException(procName, "node", "Node index out of range");
+
+    auto& mixNode = nodes_[node];
+    if (mixNode.type != NodeTypes::Blend && mixNode.type != NodeTypes::Additive)
+        throw InvalidArgumentException(procName, "node", "Node must be a blend- or additive node");
+
+    return mixNode;
+}
+
+const AnimationMixer::Node& AnimationMixer::GetNode(const char* procName, size_t node) const
+{
+    if (node >= nodes_.size())
+        throw InvalidArgumentException(procName, "node", "Node index out of range");
+    return nodes_[node];
+}
+
+void AnimationMixer::ValidateInputNode(const char* procName, const char* paramName, size_t node) const
+{
+    if (node >= nodes_.size())
+        throw InvalidArgumentException(procName, paramName, "Input node index out of range");
+}
+
+void AnimationMixer::ValidateMask(const char* procName, const JointMask& mask) const
+{
+    if (!mask.empty() && mask.size() != skeleton_->NumJoints())
+        throw InvalidArgumentException(procName, "mask", "Joint mask must be empty or have one weight for each joint");
+}
+
+/*
+Evaluates the specified node recursively and returns the index of the pose buffer with the result.
+The caller must release this buffer. Each node combines its inputs in the buffer of its first input,
+so the number of buffers in use is bounded by the depth of the graph.
+*/
+size_t AnimationMixer::EvaluateNode(size_t node)
+{
+    const auto& mixNode = nodes_[node];
+    const auto numJoints = skeleton_->NumJoints();
+
+    switch (mixNode.type)
+    {
+        case NodeTypes::Clip:
+        {
+            const auto buffer = AcquirePoseBuffer();
+            SampleClip(mixNode, *poseBuffers_[buffer]);
+            return buffer;
+        }
+
+        case NodeTypes::BindPose:
+        {
+            const auto buffer = AcquirePoseBuffer();
+            *poseBuffers_[buffer] = bindPose_;
+            return buffer;
+        }
+
+        case NodeTypes::Blend:
+        {
+            /* Skip the evaluation of an input node which has no influence */
+            if (mixNode.mask.empty())
+            {
+                if (mixNode.weight <= 0.0f)
+                    return EvaluateNode(mixNode.inputs[0]);
+                if (mixNode.weight >= 1.0f)
+                    return EvaluateNode(mixNode.inputs[1]);
+            }
+
+            const auto source = EvaluateNode(mixNode.inputs[0]);
+            const auto dest = EvaluateNode(mixNode.inputs[1]);
+
+            BlendPoses(*poseBuffers_[source], *poseBuffers_[dest], mixNode.weight, mixNode.mask, numJoints);
+
+            ReleasePoseBuffer(dest);
+            return source;
+        }
+
+        case NodeTypes::Additive:
+        {
+            const auto base = EvaluateNode(mixNode.inputs[0]);
+
+            /* Skip the evaluation of the additive layer if it has no influence */
+            if (mixNode.weight <= 0.0f)
+                return base;
+
+            const auto additive = EvaluateNode(mixNode.inputs[1]);
+
+            if (mixNode.inputs[2] != invalidNode)
+            {
+                const auto reference = EvaluateNode(mixNode.inputs[2]);
+                AddPoses(*poseBuffers_[base], *poseBuffers_[additive], *poseBuffers_[reference], mixNode.weight, mixNode.mask, numJoints);
+                ReleasePoseBuffer(reference);
+            }
+            else
+                AddPoses(*poseBuffers_[base], *poseBuffers_[additive], bindPose_, mixNode.weight, mixNode.mask, numJoints);
+
+            ReleasePoseBuffer(additive);
+            return base;
+        }
+    }
+
+    return invalidNode;
+}
+
+void AnimationMixer::SampleClip(const Node& node, PoseBuffer& buffer) const
+{
+    typedef SkeletalAnimation::KeyframeJoint KeyframeJoint;
+
+    const auto numJoints = skeleton_->NumJoints();
+    const auto anim = node.animation;
+
+    /* Start with the bind pose for all joints which are not animated by this clip */
+    buffer = bindPose_;
+
+    /* The node's playback only replaces the timing, the joint groups still select the animated joints */
+    if (anim->animateJointGroup)
+    {
+        for (const auto& group : anim->jointGroups)
+            KeyframeJoint::Update(group.keyframeJoints, (node.playback ? *node.playback : group.playback), buffer, numJoints);
+    }
+    else
+        KeyframeJoint::Update(anim->keyframeJoints, (node.playback ? *node.playback : anim->playback), buffer, numJoints);
+}
+
+size_t AnimationMixer::AcquirePoseBuffer()
+{
+    if (!freePoseBuffers_.empty())
+    {
+        const auto buffer = freePoseBuffers_.back();
+        freePoseBuffers_.pop_back();
+        return buffer;
+    }
+
+    /* Allocate new pose buffer (this only happens while the pool grows to the depth of the graph) */
+    poseBuffers_.push_back(std::unique_ptr<PoseBuffer>(new PoseBuffer()));
+    poseBuffers_.back()->Resize(skeleton_->NumJoints());
+    freePoseBuffers_.reserve(poseBuffers_.size());
+
+    return poseBuffers_.size() - 1;
+}
+
+void AnimationMixer::ReleasePoseBuffer(size_t buffer)
+{
+    freePoseBuffers_.push_back(buffer);
+}
+
+
+} // /namespace Anim
+
+} // /namespace Fork
+
+
+
+// ========================
@@ -1,11 +1,23 @@
 /*
  * Morph-target animation file
- * 
+ *
  * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
  * See "LICENSE.txt" for license information.
  */
 
 #include "Animation/AnimationSystem/MorphTargetAnimation.h"
+#include "Core/Exception/NullPointerException.h"
+#include "Core/Exception/InvalidStateException.h"
+#include "Core/Exception/IndexOutOfBoundsException.h"
+#include "Core/StringModifier.h"
+#include "Core/StaticConfig.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(FORK_ENABLE_SSE2)
+#   include <emmintrin.h>
+#endif
 
 
 namespace Fork
@@ -15,6 +27,58 @@ namespace Anim
 {
 
 
+/* --- Internal functions --- */
+
+static Math::Vector4f PaddedVector(const Math::Vector3f& vec)
+{
+    return Math::Vector4f(vec.x, vec.y, vec.z, 0.0f);
+}
+
+static size_t RangeEnd(const MorphTargetAnimation::VertexRange& range)
+{
+    return range.first + range.count;
+}
+
+static bool CompareVertexRanges(const MorphTargetAnimation::VertexRange& a, const MorphTargetAnimation::VertexRange& b)
+{
+    return a.first < b.first;
+}
+
+//! Accumulates the weighted sparse deltas: accum[indices[i]] += deltas[i] * weight.
+static void AccumulateDeltas(
+    Math::Vector4f* accum, const std::vector<unsigned int>& indices, const std::vector<Math::Vector4f>& deltas, float weight)
+{
+    const auto num = indices.size();
+
+    #if defined(FORK_ENABLE_SSE2)
+
+    const __m128 w = _mm_set1_ps(weight);
+
+    for (size_t i = 0; i < num; ++i)
+    {
+        auto dest = accum[indices[i]].Ptr();
+        _mm_storeu_ps(dest, _mm_add_ps(_mm_loadu_ps(dest), _mm_mul_ps(_mm_loadu_ps(deltas[i].Ptr()), w)));
+    }
+
+    #else
+
+    for (size_t i = 0; i < num; ++i)
+    {
+        auto& dest = accum[indices[i]];
+        const auto& delta = deltas[i];
+        dest.x += delta.x * weight;
+        dest.y += delta.y * weight;
+        dest.z += delta.z * weight;
+    }
+
+    #endif
+}
+
+
+/*
+ * MorphTargetAnimation class
+ */
+
 Animation::Types MorphTargetAnimation::Type() const
 {
     return Types::MorphTarget;
@@ -23,7 +87,367 @@ Animation::Types MorphTargetAnimation::Type() const
 void MorphTargetAnimation::Update(double deltaTime)
 {
     playback.Update(deltaTime);
-    //todo...
+
+    if (vertexData_)
+    {
+        SampleWeights();
+        if (Apply())
+        {
+            UploadDirtyRanges();
+            if (geometry && updateBoundingVolume)
+                geometry->ComputeBoundingVolume();
+        }
+    }
+}
+
+void MorphTargetAnimation::SetupVertexStream(
+    void* vertexData, size_t numVertices, size_t stride, size_t positionOffset, size_t normalOffset)
+{
+    ASSERT_POINTER(vertexData);
+
+    if (numVertices == 0)
+        throw InvalidArgumentException(__FUNCTION__, "numVertices", "Number of vertices must not be zero");
+    if (stride == 0)
+        throw InvalidArgumentException(__FUNCTION__, "stride", "Vertex stride must not be zero");
+
+    for (const auto& target : targets_)
+    {
+        if (!target.indices_.empty() && target.indices_.back() >= numVertices)
+            throw InvalidArgumentException(__FUNCTION__, "numVertices", "Morph target \"" + target.name + "\" refers to a vertex out of range");
+    }
+
+    /* Store vertex stream */
+    vertexData_     = reinterpret_cast<char*>(vertexData);
+    numVertices_    = numVertices;
+    stride_         = stride;
+    positionOffset_ = positionOffset;
+    normalOffset_   = normalOffset;
+
+    /* Store base mesh (padded to four components for SIMD) */
+    basePositions_.resize(numVertices);
+    positionAccum_.resize(numVertices);
+
+    Video::AttributeConstIterator positionIt(vertexData_ + positionOffset_, numVertices_, stride_);
+    for (size_t i = 0; i < numVertices; ++i)
+        basePositions_[i] = PaddedVector(positionIt.Get<Math::Vector3f>(i));
+
+    if (normalOffset_ != invalidOffset)
+    {
+        baseNormals_.resize(numVertices);
+        normalAccum_.resize(numVertices);
+
+        Video::AttributeConstIterator normalIt(vertexData_ + normalOffset_, numVertices_, stride_);
+        for (size_t i = 0; i < numVertices; ++i)
+            baseNormals_[i] = PaddedVector(normalIt.Get<Math::Vector3f>(i));
+    }
+    else
+    {
+        baseNormals_.clear();
+        normalAccum_.clear();
+    }
+
+    /* Reserve memory for the dirty vertices (only the list of dirty ranges may grow during the first calls to "Apply") */
+    vertexStamps_.assign(numVertices, 0);
+    applyCounter_ = 0;
+    dirtyVertices_.clear();
+    dirtyVertices_.reserve(numVertices);
+    dirtyRanges_.clear();
+
+    /* The base mesh is the current vertex stream, so no target has been applied */
+    for (auto& target : targets_)
+        target.appliedWeight_ = 0.0f;
+}
+
+size_t MorphTargetAnimation::AddTarget(
+    const std::string& name, const std::vector<unsigned int>& indices,
+    const std::vector<Math::Vector3f>& positionDeltas, const std::vector<Math::Vector3f>& normalDeltas)
+{
+    if (positionDeltas.size() != indices.size())
+        throw InvalidArgumentException(__FUNCTION__, "positionDeltas", "Number of position deltas must be equal to the number of indices");
+    if (!normalDeltas.empty() && normalDeltas.size() != indices.size())
+        throw InvalidArgumentException(__FUNCTION__, "normalDeltas", "Number of normal deltas must be zero or equal to the number of indices");
+
+    /* Sort deltas by vertex index (for a more cache friendly accumulation) */
+    std::vector<size_t> order(indices.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+
+    std::sort(
+        order.begin(), order.end(),
+        [&indices](size_t a, size_t b)
+        {
+            return indices[a] < indices[b];
+        }
+    );
+
+    Target target;
+    target.name = name;
+
+    target.indices_.reserve(indices.size());
+    target.positionDeltas_.reserve(indices.size());
+    target.normalDeltas_.reserve(normalDeltas.size());
+
+    for (auto i : order)
+    {
+        if (!target.indices_.empty() && target.indices_.back() == indices[i])
+            throw InvalidArgumentException(__FUNCTION__, "indices", "Vertex index " + ToStr(indices[i]) + " occurs more than once");
+
+        target.indices_.push_back(indices[i]);
+        target.positionDeltas_.push_back(PaddedVector(positionDeltas[i]));
+        if (!normalDeltas.empty())
+            target.normalDeltas_.push_back(PaddedVector(normalDeltas[i]));
+    }
+
+    ValidateTarget(target);
+
+    targets_.push_back(target);
+    return targets_.size() - 1;
+}
+
+size_t MorphTargetAnimation::AddTarget(
+    const std::string& name, const Video::AttributeConstIterator& positions,
+    const Video::AttributeConstIterator* normals, float threshold)
+{
+    if (!vertexData_)
+        throw InvalidStateException(__FUNCTION__, "Vertex stream has not been setup");
+    if (positions.GetCount() != numVertices_)
+        throw InvalidArgumentException(__FUNCTION__, "positions", "Number of target positions must be equal to the number of vertices");
+    if (normals && normals->GetCount() != numVertices_)
+        throw InvalidArgumentException(__FUNCTION__, "normals", "Number of target normals must be equal to the number of vertices");
+
+    auto IsDelta = [threshold](const Math::Vector3f& delta)
+    {
+        return std::abs(delta.x) > threshold || std::abs(delta.y) > threshold || std::abs(delta.z) > threshold;
+    };
+
+    /* Store only the vertices which differ from the base mesh */
+    const bool hasNormals = (normals != nullptr && !baseNormals_.empty());
+
+    std::vector<unsigned int> indices;
+    std::vector<Math::Vector3f> positionDeltas, normalDeltas;
+
+    for (size_t i = 0; i < numVertices_; ++i)
+    {
+        const auto& base = basePositions_[i];
+        const auto positionDelta = positions.Get<Math::Vector3f>(i) - Math::Vector3f(base.x, base.y, base.z);
+
+        Math::Vector3f normalDelta;
+        if (hasNormals)
+        {
+            const auto& baseNormal = baseNormals_[i];
+            normalDelta = normals->Get<Math::Vector3f>(i) - Math::Vector3f(baseNormal.x, baseNormal.y, baseNormal.z);
+        }
+
+        if (IsDelta(positionDelta) || IsDelta(normalDelta))
+        {
+            indices.push_back(static_cast<unsigned int>(i));
+            positionDeltas.push_back(positionDelta);
+            if (hasNormals)
+                normalDeltas.push_back(normalDelta);
+        }
+    }
+
+    return AddTarget(name, indices, positionDeltas, normalDeltas);
+}
+
+void MorphTargetAnimation::ClearTargets()
+{
+    /* Reset the vertices of all applied targets to the base mesh and re-upload them */
+    if (vertexData_)
+    {
+        for (auto& target : targets_)
+            target.weight = 0.0f;
+
+        if (Apply())
+            UploadDirtyRanges();
+    }
+    else
+        dirtyRanges_.clear();
+
+    targets_.clear();
+}
+
+bool MorphTargetAnimation::Apply()
+{
+    if (!vertexData_)
+        throw InvalidStateException(__FUNCTION__, "Vertex stream has not been setup");
+
+    dirtyVertices_.clear();
+    dirtyRanges_.clear();
+
+    /* Skip all targets if no weight has changed since the previous call */
+    auto IsWeightChanged = [](const Target& target)
+    {
+        return target.weight != target.appliedWeight_;
+    };
+
+    if (std::none_of(targets_.begin(), targets_.end(), IsWeightChanged))
+        return false;
+
+    /* Begin new stamp generation (reset all stamps when the counter wraps around) */
+    if (++applyCounter_ == 0)
+    {
+        std::fill(vertexStamps_.begin(), vertexStamps_.end(), 0);
+        applyCounter_ = 1;
+    }
+
+    const bool hasNormals = !normalAccum_.empty();
+
+    /*
+    Collect the vertices of all targets which are active now or have been active before
+    (those must be reset to the base mesh), and reset their accumulators to the base mesh
+    */
+    for (const auto& target : targets_)
+    {
+        if (target.weight == 0.0f && target.appliedWeight_ == 0.0f)
+            continue;
+
+        for (auto i : target.indices_)
+        {
+            if (vertexStamps_[i] != applyCounter_)
+            {
+                vertexStamps_[i] = applyCounter_;
+                dirtyVertices_.push_back(i);
+
+                positionAccum_[i] = basePositions_[i];
+                if (hasNormals)
+                    normalAccum_[i] = baseNormals_[i];
+            }
+
+            /* Extend the last dirty range or begin a new one (the indices of each target are sorted) */
+            if (!dirtyRanges_.empty() && i >= dirtyRanges_.back().first && i <= RangeEnd(dirtyRanges_.back()) + mergeRangeGap)
+            {
+                auto& range = dirtyRanges_.back();
+                range.count = std::max(range.count, i - range.first + 1);
+            }
+            else
+            {
+                const VertexRange range { i, 1 };
+                dirtyRanges_.push_back(range);
+            }
+        }
+    }
+
+    if (dirtyVertices_.empty())
+        return false;
+
+    /* Accumulate weighted deltas of all targets with non-zero weight */
+    for (auto& target : targets_)
+    {
+        if (target.weight != 0.0f)
+        {
+            AccumulateDeltas(positionAccum_.data(), target.indices_, target.positionDeltas_, target.weight);
+            if (hasNormals && !target.normalDeltas_.empty())
+                AccumulateDeltas(normalAccum_.data(), target.indices_, target.normalDeltas_, target.weight);
+        }
+        target.appliedWeight_ = target.weight;
+    }
+
+    /* Write final positions and normals into the vertex stream */
+    Video::AttributeIterator positionIt(vertexData_ + positionOffset_, numVertices_, stride_);
+
+    for (auto i : dirtyVertices_)
+    {
+        const auto& pos = positionAccum_[i];
+        positionIt.Get<Math::Vector3f>(i) = Math::Vector3f(pos.x, pos.y, pos.z);
+    }
+
+    if (hasNormals)
+    {
+        Video::AttributeIterator normalIt(vertexData_ + normalOffset_, numVertices_, stride_);
+
+        for (auto i : dirtyVertices_)
+        {
+            const auto& normal = normalAccum_[i];
+            const auto len = std::sqrt(normal.x*normal.x + normal.y*normal.y + normal.z*normal.z);
+            const auto invLen = (len > 0.0f ? 1.0f / len : 0.0f);
+            normalIt.Get<Math::Vector3f>(i) = Math::Vector3f(normal.x*invLen, normal.y*invLen, normal.z*invLen);
+        }
+    }
+
+    MergeDirtyRanges();
+
+    return true;
+}
+
+MorphTargetAnimation::Target& MorphTargetAnimation::GetTarget(size_t index)
+{
+    if (index >= targets_.size())
+        throw IndexOutOfBoundsException(__FUNCTION__, index);
+    return targets_[index];
+}
+
+const MorphTargetAnimation::Target& MorphTargetAnimation::GetTarget(size_t index) const
+{
+    if (index >= targets_.size())
+        throw IndexOutOfBoundsException(__FUNCTION__, index);
+    return targets_[index];
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void MorphTargetAnimation::ValidateTarget(const Target& target) const
+{
+    if (vertexData_ && !target.indices_.empty() && target.indices_.back() >= numVertices_)
+        throw InvalidArgumentException(__FUNCTION__, "indices", "Vertex index " + ToStr(target.indices_.back()) + " out of range");
+}
+
+void MorphTargetAnimation::SampleWeights()
+{
+    const auto from = playback.frame;
+    const auto to = playback.nextFrame;
+    const auto interpolator = static_cast<float>(playback.interpolator);
+
+    for (auto& target : targets_)
+    {
+        const auto& keyframes = target.weightKeyframes;
+        if (from < keyframes.size() && to < keyframes.size())
+            target.weight = keyframes[from] + (keyframes[to] - keyframes[from]) * interpolator;
+    }
+}
+
+//! Sorts the dirty ranges and merges all ranges which overlap or are separated by at most 'mergeRangeGap' vertices.
+void MorphTargetAnimation::MergeDirtyRanges()
+{
+    if (dirtyRanges_.empty())
+        return;
+
+    std::sort(dirtyRanges_.begin(), dirtyRanges_.end(), CompareVertexRanges);
+
+    size_t numRanges = 1;
+
+    for (size_t i = 1; i < dirtyRanges_.size(); ++i)
+    {
+        auto& last = dirtyRanges_[numRanges - 1];
+        const auto& next = dirtyRanges_[i];
+
+        const auto lastEnd = RangeEnd(last);
+
+        if (next.first <= lastEnd + mergeRangeGap)
+            last.count = std::max(lastEnd, RangeEnd(next)) - last.first;
+        else
+            dirtyRanges_[numRanges++] = next;
+    }
+
+    dirtyRanges_.resize(numRanges);
+}
+
+void MorphTargetAnimation::UploadDirtyRanges()
+{
+    if (!geometry || !geometry->GetVertexBuffer())
+        return;
+
+    for (const auto& range : dirtyRanges_)
+    {
+        geometry->UpdateVertexBuffer(
+            vertexData_ + range.first * stride_,
+            range.count * stride_,
+            range.first * stride_
+        );
+    }
 }
 
 
@@ -33,4 +457,4 @@ void MorphTargetAnimation::Update(double deltaTime)
 
 
 
-// ========================
\ No newline at end of file
+// ========================
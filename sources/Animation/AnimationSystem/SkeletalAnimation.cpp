@@ -7,6 +7,8 @@
 
 #include "Animation/AnimationSystem/SkeletalAnimation.h"
 #include "Core/Exception/NullPointerException.h"
+#include "Core/Exception/InvalidArgumentException.h"
+#include "Core/Jobs/JobSystem.h"
 
 
 namespace Fork
@@ -33,6 +35,34 @@ void SkeletalAnimation::KeyframeJoint::Update(
         keyJoint.keyframeSequence.Interpolate(keyJoint.GetJoint()->transform, playback);
 }
 
+void SkeletalAnimation::KeyframeJoint::Update(
+    const std::vector<KeyframeJoint>& keyframeJoints, const Playback& playback, Scene::SkeletonPose& pose)
+{
+    Update(keyframeJoints, playback, pose.GetLocalTransforms(), pose.NumJoints());
+}
+
+void SkeletalAnimation::KeyframeJoint::Update(
+    const std::vector<KeyframeJoint>& keyframeJoints, const Playback& playback,
+    Scene::SkeletonPose::LocalTransforms& localTransforms, size_t numJoints)
+{
+    for (const auto& keyJoint : keyframeJoints)
+    {
+        const auto index = keyJoint.GetJointIndex();
+        if (index < numJoints)
+        {
+            /* Interpolate into a temporary transformation (which is left unmodified for out-of-range frames) */
+            auto transform = localTransforms.GetTransform(index);
+            keyJoint.keyframeSequence.Interpolate(transform, playback);
+            localTransforms.SetTransform(index, transform);
+        }
+    }
+}
+
+void SkeletalAnimation::KeyframeJoint::SetupJointIndex(const Scene::FlatSkeleton& flatSkeleton)
+{
+    jointIndex_ = flatSkeleton.FindJoint(joint_);
+}
+
 
 /*
  * SkeletalAnimation class
@@ -69,6 +99,79 @@ void SkeletalAnimation::Update(double deltaTime)
     }
 }
 
+void SkeletalAnimation::SetupJointIndices(const Scene::FlatSkeleton& flatSkeleton)
+{
+    for (auto& keyJoint : keyframeJoints)
+        keyJoint.SetupJointIndex(flatSkeleton);
+
+    for (auto& group : jointGroups)
+    {
+        for (auto& keyJoint : group.keyframeJoints)
+            keyJoint.SetupJointIndex(flatSkeleton);
+    }
+}
+
+void SkeletalAnimation::UpdatePose(Scene::SkeletonPose& pose, double deltaTime)
+{
+    UpdatePlaybacks(deltaTime);
+    SamplePose(pose);
+}
+
+void SkeletalAnimation::UpdatePoses(
+    const std::vector<SkeletalAnimation*>& animations, const std::vector<Scene::SkeletonPose*>& poses, double deltaTime)
+{
+    if (animations.size() != poses.size())
+        throw InvalidArgumentException(__FUNCTION__, "poses", "Number of poses must be equal to the number of animations");
+
+    /* Update all playbacks on this thread, since the playback event handlers may not be thread-safe */
+    for (auto anim : animations)
+    {
+        if (anim)
+            anim->UpdatePlaybacks(deltaTime);
+    }
+
+    /* Sample all animations and update the pose matrices in parallel */
+    Jobs::JobSystem::Instance()->ParallelFor(
+        0, animations.size(),
+        [&animations, &poses](size_t i)
+        {
+            if (animations[i] && poses[i])
+            {
+                animations[i]->SamplePose(*poses[i]);
+                poses[i]->UpdateMatrices();
+            }
+        }
+    );
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void SkeletalAnimation::UpdatePlaybacks(double deltaTime)
+{
+    /* Update animation playback (or the playbacks of all joint groups) */
+    if (animateJointGroup)
+    {
+        for (auto& group : jointGroups)
+            group.playback.Update(deltaTime);
+    }
+    else
+        playback.Update(deltaTime);
+}
+
+void SkeletalAnimation::SamplePose(Scene::SkeletonPose& pose) const
+{
+    if (animateJointGroup)
+    {
+        for (const auto& group : jointGroups)
+            KeyframeJoint::Update(group.keyframeJoints, group.playback, pose);
+    }
+    else
+        KeyframeJoint::Update(keyframeJoints, playback, pose);
+}
+
 
 } // /namespace Anim
 
@@ -0,0 +1,567 @@
+/*
+ * Compressed keyframe sequence file
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Animation/Core/CompressedKeyframeSequence.h"
+#include "Animation/Core/KeyframeSequence.h"
+#include "Math/Core/BaseMath.h"
+
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+
+namespace Fork
+{
+
+namespace Anim
+{
+
+
+/* --- Internal functions --- */
+
+//! Maximal value of a 16-bit quantized vector component.
+static const float maxVectorValue       = 65535.0f;
+//! Maximal value of a 15-bit quantized quaternion component.
+static const float maxQuaternionValue   = 32767.0f;
+//! Range of the three smallest quaternion components is [-1/sqrt(2) .. 1/sqrt(2)].
+static const float sqrtTwo              = 1.41421356f;
+
+/*
+Copies the frames and values of the specified keyframe list, sorted by their frame indices.
+If several keys have the same frame index, only the last one is used.
+*/
+template <class Keyframe, typename T, class Accessor> static void SortKeys(
+    const std::vector<Keyframe>& keyframes, std::vector<unsigned int>& frames, std::vector<T>& values, Accessor accessor)
+{
+    std::vector<size_t> order(keyframes.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    std::stable_sort(
+        order.begin(), order.end(),
+        [&keyframes](size_t a, size_t b)
+        {
+            return keyframes[a].frame < keyframes[b].frame;
+        }
+    );
+
+    frames.clear();
+    values.clear();
+
+    for (auto i : order)
+    {
+        const auto frame = static_cast<unsigned int>(keyframes[i].frame);
+        if (!frames.empty() && frames.back() == frame)
+            values.back() = accessor(keyframes[i]);
+        else
+        {
+            frames.push_back(frame);
+            values.push_back(accessor(keyframes[i]));
+        }
+    }
+}
+
+/*
+Returns the indices of all keys which can not be reconstructed by interpolating their remaining neighbors.
+The function 'Error(first, last, i)' returns the error between the interpolation of the keys 'first' and 'last'
+and the original key 'i'. If 'first' and 'last' are equal, the key 'first' is to be used without interpolation.
+Each segment is extended greedily, as long as all inner keys are within the tolerance.
+*/
+template <class ErrorFunc> static std::vector<size_t> ReduceKeys(size_t numKeys, float tolerance, ErrorFunc Error)
+{
+    std::vector<size_t> keptKeys;
+
+    if (numKeys == 0)
+        return keptKeys;
+
+    keptKeys.push_back(0);
+
+    /* Check if the entire track is constant */
+    bool isConstant = true;
+    for (size_t i = 1; i < numKeys && isConstant; ++i)
+        isConstant = (Error(0, 0, i) <= tolerance);
+
+    if (isConstant)
+        return keptKeys;
+
+    /* Remove all inner keys of the longest segments within the tolerance */
+    size_t first = 0;
+
+    while (first + 1 < numKeys)
+    {
+        auto last = first + 1;
+
+        while (last + 1 < numKeys)
+        {
+            /* Check if the keys (first .. last] can be reconstructed by the keys 'first' and 'last + 1' */
+            const auto candidate = last + 1;
+            bool withinTolerance = true;
+
+            for (auto i = first + 1; i < candidate && withinTolerance; ++i)
+                withinTolerance = (Error(first, candidate, i) <= tolerance);
+
+            if (!withinTolerance)
+                break;
+
+            last = candidate;
+        }
+
+        keptKeys.push_back(last);
+        first = last;
+    }
+
+    return keptKeys;
+}
+
+//! Returns the interpolation factor of the key 'i' between the keys 'first' and 'last'.
+static float KeyInterpolator(const std::vector<unsigned int>& frames, size_t first, size_t last, size_t i)
+{
+    if (frames[last] == frames[first])
+        return 0.0f;
+    return static_cast<float>(frames[i] - frames[first]) / static_cast<float>(frames[last] - frames[first]);
+}
+
+/*
+Returns the index of the last key whose frame is less than or equal to the specified frame (or 0 if there is no such key).
+The previous key 'key' (and its successor) are checked first, so that a playback does not need a binary search.
+*/
+static size_t FindKey(const std::vector<unsigned int>& frames, float frame, size_t key)
+{
+    const auto numKeys = frames.size();
+
+    if (numKeys == 1 || frame <= static_cast<float>(frames.front()))
+        return 0;
+
+    /* Cursor search */
+    if (key < numKeys && static_cast<float>(frames[key]) <= frame)
+    {
+        if (key + 1 == numKeys || frame < static_cast<float>(frames[key + 1]))
+            return key;
+        if (key + 2 == numKeys || frame < static_cast<float>(frames[key + 2]))
+            return key + 1;
+    }
+
+    /* Binary search */
+    auto it = std::upper_bound(
+        frames.begin(), frames.end(), frame,
+        [](float lhs, unsigned int rhs)
+        {
+            return lhs < static_cast<float>(rhs);
+        }
+    );
+
+    return static_cast<size_t>(it - frames.begin()) - 1;
+}
+
+static unsigned short QuantizeComponent(float value, float offset, float scale)
+{
+    if (scale <= 0.0f)
+        return 0;
+    return static_cast<unsigned short>(Math::Clamp((value - offset) / scale + 0.5f, 0.0f, maxVectorValue));
+}
+
+//! Returns the distance between the two quaternions, where q and -q are the same rotation.
+static float QuaternionDistance(const Math::Quaternionf& a, const Math::Quaternionf& b)
+{
+    const float sign = (a.x*b.x + a.y*b.y + a.z*b.z + a.w*b.w < 0.0f ? -1.0f : 1.0f);
+
+    const float x = a.x - b.x*sign;
+    const float y = a.y - b.y*sign;
+    const float z = a.z - b.z*sign;
+    const float w = a.w - b.w*sign;
+
+    return std::sqrt(x*x + y*y + z*z + w*w);
+}
+
+
+/*
+ * VectorTrack structure
+ */
+
+void CompressedKeyframeSequence::VectorTrack::Clear()
+{
+    frames.clear();
+    keys.clear();
+    frames.shrink_to_fit();
+    keys.shrink_to_fit();
+}
+
+CompressedKeyframeSequence::QuantizedVector CompressedKeyframeSequence::VectorTrack::Quantize(const Math::Vector3f& vector) const
+{
+    QuantizedVector key;
+
+    key.components[0] = QuantizeComponent(vector.x, offset.x, scale.x);
+    key.components[1] = QuantizeComponent(vector.y, offset.y, scale.y);
+    key.components[2] = QuantizeComponent(vector.z, offset.z, scale.z);
+
+    return key;
+}
+
+Math::Vector3f CompressedKeyframeSequence::VectorTrack::Dequantize(const QuantizedVector& key) const
+{
+    return Math::Vector3f(
+        offset.x + scale.x * static_cast<float>(key.components[0]),
+        offset.y + scale.y * static_cast<float>(key.components[1]),
+        offset.z + scale.z * static_cast<float>(key.components[2])
+    );
+}
+
+Math::Vector3f CompressedKeyframeSequence::VectorTrack::Sample(float frame, size_t& key) const
+{
+    key = FindKey(frames, frame, key);
+
+    const auto from = Dequantize(keys[key]);
+
+    if (key + 1 < keys.size() && frame > static_cast<float>(frames[key]))
+    {
+        /* Interpolate keys */
+        const auto t = (frame - static_cast<float>(frames[key])) / static_cast<float>(frames[key + 1] - frames[key]);
+        return Math::Lerp(from, Dequantize(keys[key + 1]), t);
+    }
+
+    return from;
+}
+
+
+/*
+ * RotationTrack structure
+ */
+
+void CompressedKeyframeSequence::RotationTrack::Clear()
+{
+    frames.clear();
+    keys.clear();
+    frames.shrink_to_fit();
+    keys.shrink_to_fit();
+}
+
+CompressedKeyframeSequence::QuantizedQuaternion CompressedKeyframeSequence::RotationTrack::Quantize(const Math::Quaternionf& rotation)
+{
+    auto q = rotation;
+    q.Normalize();
+
+    /* Find largest component */
+    const float components[4] = { q.x, q.y, q.z, q.w };
+
+    unsigned short largest = 0;
+    for (unsigned short i = 1; i < 4; ++i)
+    {
+        if (std::abs(components[i]) > std::abs(components[largest]))
+            largest = i;
+    }
+
+    /* Quantize the three smallest components, with a positive largest component (q and -q are the same rotation) */
+    const float sign = (components[largest] < 0.0f ? -1.0f : 1.0f);
+
+    QuantizedQuaternion key;
+
+    for (unsigned short i = 0, j = 0; i < 4; ++i)
+    {
+        if (i != largest)
+        {
+            const auto value = Math::Clamp(components[i] * sign * sqrtTwo * 0.5f + 0.5f, 0.0f, 1.0f);
+            key.components[j++] = static_cast<unsigned short>(value * maxQuaternionValue + 0.5f);
+        }
+    }
+
+    /* Store index of the largest component */
+    key.components[0] |= ((largest & 0x1) << 15);
+    key.components[1] |= ((largest & 0x2) << 14);
+
+    return key;
+}
+
+Math::Quaternionf CompressedKeyframeSequence::RotationTrack::Dequantize(const QuantizedQuaternion& key)
+{
+    const unsigned short largest = ((key.components[0] >> 15) | ((key.components[1] >> 15) << 1));
+
+    /* Decode the three smallest components */
+    float components[4];
+    float sqSum = 0.0f;
+
+    for (unsigned short i = 0, j = 0; i < 4; ++i)
+    {
+        if (i != largest)
+        {
+            const auto value = static_cast<float>(key.components[j++] & 0x7fff) / maxQuaternionValue;
+            components[i] = (value * 2.0f - 1.0f) / sqrtTwo;
+            sqSum += components[i]*components[i];
+        }
+    }
+
+    /* Reconstruct largest component from the unit length */
+    components[largest] = std::sqrt(std::max(0.0f, 1.0f - sqSum));
+
+    return Math::Quaternionf(components[0], components[1], components[2], components[3]);
+}
+
+Math::Quaternionf CompressedKeyframeSequence::RotationTrack::Sample(float frame, size_t& key) const
+{
+    key = FindKey(frames, frame, key);
+
+    const auto from = Dequantize(keys[key]);
+
+    if (key + 1 < keys.size() && frame > static_cast<float>(frames[key]))
+    {
+        /* Interpolate keys */
+        const auto t = (frame - static_cast<float>(frames[key])) / static_cast<float>(frames[key + 1] - frames[key]);
+        Math::Quaternionf rotation;
+        rotation.SLerp(from, Dequantize(keys[key + 1]), t);
+        return rotation;
+    }
+
+    return from;
+}
+
+
+/*
+ * CompressedKeyframeSequence class
+ */
+
+void CompressedKeyframeSequence::Compress(const KeyframeSequence& keyframeSequence, const Description& desc)
+{
+    Clear();
+
+    /* If all sub-keyframe lists are empty -> break */
+    if ( keyframeSequence.positionKeyframes.empty() &&
+         keyframeSequence.rotationKeyframes.empty() &&
+         keyframeSequence.scaleKeyframes.empty() )
+    {
+        return;
+    }
+
+    numFrames_ = keyframeSequence.LastFrame() + 1;
+
+    std::vector<unsigned int> frames;
+
+    /* Compress position and scale tracks */
+    std::vector<Math::Vector3f> vectors;
+
+    auto VectorAccessor = [](const KeyframeSequence::VectorKeyframe& keyframe)
+    {
+        return keyframe.vector;
+    };
+
+    SortKeys(keyframeSequence.positionKeyframes, frames, vectors, VectorAccessor);
+    CompressVectorTrack(positionTrack_, frames, vectors, desc.positionTolerance);
+
+    SortKeys(keyframeSequence.scaleKeyframes, frames, vectors, VectorAccessor);
+    CompressVectorTrack(scaleTrack_, frames, vectors, desc.scaleTolerance);
+
+    /* Compress rotation track */
+    std::vector<Math::Quaternionf> rotations;
+
+    SortKeys(
+        keyframeSequence.rotationKeyframes, frames, rotations,
+        [](const KeyframeSequence::QuaternionKeyframe& keyframe)
+        {
+            return keyframe.quaternion;
+        }
+    );
+    CompressRotationTrack(rotationTrack_, frames, rotations, desc.rotationTolerance);
+}
+
+void CompressedKeyframeSequence::Clear()
+{
+    positionTrack_.Clear();
+    rotationTrack_.Clear();
+    scaleTrack_.Clear();
+    numFrames_ = 0;
+}
+
+void CompressedKeyframeSequence::Sample(Math::Transform3Df& transform, float frame) const
+{
+    Cursor cursor;
+    SampleTracks(transform, frame, cursor);
+}
+
+void CompressedKeyframeSequence::Sample(Math::Transform3Df& transform, float frame, Cursor& cursor) const
+{
+    SampleTracks(transform, frame, cursor);
+}
+
+void CompressedKeyframeSequence::Interpolate(
+    Math::Transform3Df& transform, size_t frameFrom, size_t frameTo, float interpolator) const
+{
+    /* Check if frame indices are out-of-range */
+    if (frameFrom >= numFrames_ || frameTo >= numFrames_)
+        return;
+
+    Cursor cursor;
+
+    if (frameTo == frameFrom + 1)
+        SampleTracks(transform, static_cast<float>(frameFrom) + interpolator, cursor);
+    else if (frameFrom == frameTo + 1)
+        SampleTracks(transform, static_cast<float>(frameFrom) - interpolator, cursor);
+    else if (frameFrom == frameTo)
+        SampleTracks(transform, static_cast<float>(frameFrom), cursor);
+    else
+    {
+        /* Sample both frames (e.g. when the playback loops) and interpolate them */
+        Math::Transform3Df transformFrom, transformTo;
+        SampleTracks(transformFrom, static_cast<float>(frameFrom), cursor);
+        SampleTracks(transformTo, static_cast<float>(frameTo), cursor);
+        transform.Interpolate(transformFrom, transformTo, interpolator);
+    }
+}
+
+size_t CompressedKeyframeSequence::NumKeys() const
+{
+    return positionTrack_.keys.size() + rotationTrack_.keys.size() + scaleTrack_.keys.size();
+}
+
+size_t CompressedKeyframeSequence::MemoryUsage() const
+{
+    auto TrackUsage = [](const std::vector<unsigned int>& frames, size_t keysUsage)
+    {
+        return frames.capacity() * sizeof(unsigned int) + keysUsage;
+    };
+
+    return
+        sizeof(*this) +
+        TrackUsage(positionTrack_.frames, positionTrack_.keys.capacity() * sizeof(QuantizedVector)) +
+        TrackUsage(rotationTrack_.frames, rotationTrack_.keys.capacity() * sizeof(QuantizedQuaternion)) +
+        TrackUsage(scaleTrack_.frames, scaleTrack_.keys.capacity() * sizeof(QuantizedVector));
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void CompressedKeyframeSequence::CompressVectorTrack(
+    VectorTrack& track, const std::vector<unsigned int>& frames, const std::vector<Math::Vector3f>& vectors, float tolerance)
+{
+    if (vectors.empty())
+        return;
+
+    /* Compute bounding box of the track */
+    auto minVector = vectors.front();
+    auto maxVector = minVector;
+
+    for (const auto& vector : vectors)
+    {
+        minVector.x = std::min(minVector.x, vector.x);
+        minVector.y = std::min(minVector.y, vector.y);
+        minVector.z = std::min(minVector.z, vector.z);
+        maxVector.x = std::max(maxVector.x, vector.x);
+        maxVector.y = std::max(maxVector.y, vector.y);
+        maxVector.z = std::max(maxVector.z, vector.z);
+    }
+
+    track.offset = minVector;
+    track.scale = Math::Vector3f(
+        (maxVector.x - minVector.x) / maxVectorValue,
+        (maxVector.y - minVector.y) / maxVectorValue,
+        (maxVector.z - minVector.z) / maxVectorValue
+    );
+
+    /* Quantize all keys */
+    std::vector<QuantizedVector> quantizedKeys(vectors.size());
+    for (size_t i = 0; i < vectors.size(); ++i)
+        quantizedKeys[i] = track.Quantize(vectors[i]);
+
+    /* Remove all keys which can be reconstructed by interpolating the quantized neighbors */
+    auto keptKeys = ReduceKeys(
+        vectors.size(), tolerance,
+        [&](size_t first, size_t last, size_t i)
+        {
+            const auto vector = Math::Lerp(
+                track.Dequantize(quantizedKeys[first]),
+                track.Dequantize(quantizedKeys[last]),
+                KeyInterpolator(frames, first, last, i)
+            );
+            return (vector - vectors[i]).Length();
+        }
+    );
+
+    /* Store remaining keys */
+    track.frames.reserve(keptKeys.size());
+    track.keys.reserve(keptKeys.size());
+
+    for (auto i : keptKeys)
+    {
+        track.frames.push_back(frames[i]);
+        track.keys.push_back(quantizedKeys[i]);
+    }
+}
+
+void CompressedKeyframeSequence::CompressRotationTrack(
+    RotationTrack& track, const std::vector<unsigned int>& frames, const std::vector<Math::Quaternionf>& rotations, float tolerance)
+{
+    if (rotations.empty())
+        return;
+
+    /* Quantize all keys and normalize the originals for the error metric */
+    std::vector<QuantizedQuaternion> quantizedKeys(rotations.size());
+    std::vector<Math::Quaternionf> normalizedRotations(rotations.size());
+
+    for (size_t i = 0; i < rotations.size(); ++i)
+    {
+        quantizedKeys[i] = RotationTrack::Quantize(rotations[i]);
+        normalizedRotations[i] = rotations[i];
+        normalizedRotations[i].Normalize();
+    }
+
+    /*
+    Remove all keys which can be reconstructed by interpolating the quantized neighbors.
+    The distance between two unit quaternions (of the same hemisphere) is 2*sin(angle/4),
+    which is numerically more stable than the arc cosine of their dot product for small angles.
+    */
+    const auto distanceTolerance = 2.0f * std::sin(std::max(0.0f, tolerance) * 0.25f);
+
+    auto keptKeys = ReduceKeys(
+        rotations.size(), distanceTolerance,
+        [&](size_t first, size_t last, size_t i)
+        {
+            Math::Quaternionf rotation;
+            rotation.SLerp(
+                RotationTrack::Dequantize(quantizedKeys[first]),
+                RotationTrack::Dequantize(quantizedKeys[last]),
+                KeyInterpolator(frames, first, last, i)
+            );
+            return QuaternionDistance(rotation, normalizedRotations[i]);
+        }
+    );
+
+    /* Store remaining keys */
+    track.frames.reserve(keptKeys.size());
+    track.keys.reserve(keptKeys.size());
+
+    for (auto i : keptKeys)
+    {
+        track.frames.push_back(frames[i]);
+        track.keys.push_back(quantizedKeys[i]);
+    }
+}
+
+void CompressedKeyframeSequence::SampleTracks(Math::Transform3Df& transform, float frame, Cursor& cursor) const
+{
+    /* Sample all tracks (empty tracks result in the identity, just like the dense keyframe list) */
+    if (!positionTrack_.keys.empty())
+        transform.SetPosition(positionTrack_.Sample(frame, cursor.positionKey));
+    else
+        transform.SetPosition(Math::Point3f());
+
+    if (!rotationTrack_.keys.empty())
+        transform.SetRotation(rotationTrack_.Sample(frame, cursor.rotationKey));
+    else
+        transform.SetRotation(Math::Quaternionf());
+
+    if (!scaleTrack_.keys.empty())
+        transform.SetScale(scaleTrack_.Sample(frame, cursor.scaleKey));
+    else
+        transform.SetScale(Math::Vector3f(1.0f));
+}
+
+
+} // /namespace Anim
+
+} // /namespace Fork
+
+
+
+// ========================
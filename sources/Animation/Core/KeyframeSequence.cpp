@@ -8,6 +8,8 @@
 #include "Animation/Core/KeyframeSequence.h"
 
 #include <limits>
+#include <algorithm>
+#include <cmath>
 
 
 namespace Fork
@@ -33,6 +35,7 @@ void KeyframeSequence::BuildKeyframes(bool clampEdges /* <--- TODO!!! */)
     /* Get number of keyframes -> (last frame index) + 1 */
     const auto numFrames = LastFrame() + 1;
 
+    compressedKeyframes_.Clear();
     keyframes_.resize(numFrames);
 
     auto FrameInterpolator = [](size_t from, size_t to, size_t current)
@@ -139,6 +142,26 @@ void KeyframeSequence::BuildKeyframes(bool clampEdges /* <--- TODO!!! */)
     }
 }
 
+void KeyframeSequence::CompressKeyframes(const CompressedKeyframeSequence::Description& desc, bool releaseSubKeyframes)
+{
+    /* If the sub-keyframe lists have already been released -> keep the compressed tracks */
+    if (positionKeyframes.empty() && rotationKeyframes.empty() && scaleKeyframes.empty() && IsCompressed())
+        return;
+
+    compressedKeyframes_.Compress(*this, desc);
+
+    /* Release dense keyframe list */
+    std::vector<Math::Transform3Df>().swap(keyframes_);
+
+    /* Release sub keyframe lists */
+    if (releaseSubKeyframes)
+    {
+        std::vector<VectorKeyframe>().swap(positionKeyframes);
+        std::vector<QuaternionKeyframe>().swap(rotationKeyframes);
+        std::vector<VectorKeyframe>().swap(scaleKeyframes);
+    }
+}
+
 /*
 This internal template function is used by the "FirstFrame".
 If the index is zero, the function returns immediately since there is no smaller value.
@@ -221,6 +244,13 @@ size_t KeyframeSequence::LastFrame() const
 void KeyframeSequence::Interpolate(
     Math::Transform3Df& transform, size_t frameFrom, size_t frameTo, float interpolator) const
 {
+    /* Sample compressed tracks */
+    if (IsCompressed())
+    {
+        compressedKeyframes_.Interpolate(transform, frameFrom, frameTo, interpolator);
+        return;
+    }
+
     /* Check if frame indices are out-of-range */
     const auto numFrames = keyframes_.size();
     if (frameFrom >= numFrames || frameTo >= numFrames)
@@ -234,6 +264,28 @@ void KeyframeSequence::Interpolate(
     transform.Interpolate(transformFrom, transformTo, interpolator);
 }
 
+void KeyframeSequence::Sample(Math::Transform3Df& transform, float frame) const
+{
+    /* Sample compressed tracks */
+    if (IsCompressed())
+    {
+        const auto lastFrame = static_cast<float>(compressedKeyframes_.NumFrames() - 1);
+        compressedKeyframes_.Sample(transform, std::max(0.0f, std::min(frame, lastFrame)));
+        return;
+    }
+
+    if (keyframes_.empty())
+        return;
+
+    /* Interpolate the two frames around the specified frame */
+    const auto lastFrame = keyframes_.size() - 1;
+    const auto clampedFrame = std::max(0.0f, frame);
+    const auto frameFrom = std::min(static_cast<size_t>(clampedFrame), lastFrame);
+    const auto frameTo = std::min(frameFrom + 1, lastFrame);
+
+    Interpolate(transform, frameFrom, frameTo, clampedFrame - std::floor(clampedFrame));
+}
+
 /* Maximal size type (to be consistent along with 32- and 64 bit applications) for the <keyframe-sequence file format> */
 typedef unsigned long long FormatSizeType;
 
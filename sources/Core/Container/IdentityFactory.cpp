@@ -6,51 +6,69 @@
  */
 
 #include "Core/Container/IdentityFactory.h"
-#include "Core/STLHelper.h"
+#include "Core/Exception/InvalidStateException.h"
 
 
 namespace Fork
 {
 
 
+static const Identifiable::IDType maxSlotIndex = (1u << IdentityFactory::indexBits) - 1;
+
+static inline Identifiable::IDType MakeID(Identifiable::IDType index, Identifiable::IDType generation)
+{
+    return (generation << IdentityFactory::indexBits) | index;
+}
+
+bool IdentityFactory::IsAlive(const Identifiable::IDType& id) const
+{
+    const auto index = IDIndex(id);
+
+    if (index == 0 || index > slots_.size())
+        return false;
+
+    const auto& slot = slots_[index - 1];
+    return slot.used && slot.generation == IDGeneration(id);
+}
+
 Identifiable::IDType IdentityFactory::GenerateID()
 {
-    /* Search unused ID number in the list */
-    Identifiable::IDType id = 1;
+    Identifiable::IDType index = 0;
 
-    if (!idList_.empty())
+    if (!freeSlots_.empty())
+    {
+        /* Recycle the most recently released slot */
+        index = freeSlots_.back();
+        freeSlots_.pop_back();
+    }
+    else
     {
-        for (auto it = idList_.begin(); it != idList_.end(); ++it)
-        {
-            /* Find first free entry */
-            if (id != *it)
-            {
-                /*
-                Insert new ID exactly at this point to
-                keep the list sorted in ascending order
-                */
-                idList_.insert(it, id);
-                return id;
-            }
-
-            /* Try next ID */
-            ++id;
-        }
+        /* Append new slot (index 0 is reserved for the invalid ID) */
+        if (slots_.size() >= maxSlotIndex)
+            throw InvalidStateException(__FUNCTION__, "Out of identity slots");
+        slots_.push_back(Slot());
+        index = static_cast<Identifiable::IDType>(slots_.size());
     }
 
-    /*
-    Add entry to the back of the list if:
-    - this is the first entry or,
-    - all other ID numbers are already used
-    */
-    idList_.push_back(id);
+    auto& slot = slots_[index - 1];
+    slot.used = true;
 
-    return id;
+    return MakeID(index, slot.generation);
 }
 
 void IdentityFactory::ReleaseID(const Identifiable::IDType& id)
 {
-    RemoveFromList(idList_, id);
+    if (!IsAlive(id))
+        return;
+
+    const auto index = IDIndex(id);
+    auto& slot = slots_[index - 1];
+
+    /* Increment generation (wraps around) to invalidate all remaining copies of this ID */
+    slot.used = false;
+    ++slot.generation;
+
+    freeSlots_.push_back(index);
 }
 
 
@@ -58,4 +76,4 @@ void IdentityFactory::ReleaseID(const Identifiable::IDType& id)
 
 
 
-// ========================
\ No newline at end of file
+// ========================
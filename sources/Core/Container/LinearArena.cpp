@@ -0,0 +1,98 @@
+/*
+ * Linear arena file
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Core/Container/LinearArena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+
+namespace Fork
+{
+
+
+LinearArena::LinearArena(size_t blockSize) :
+    blockSize_{ std::max(blockSize, size_t(64)) }
+{
+}
+
+void* LinearArena::Allocate(size_t size, size_t alignment)
+{
+    while (true)
+    {
+        if (blockIndex_ < blocks_.size())
+        {
+            auto& block = blocks_[blockIndex_];
+
+            /* Align offset within the current block */
+            const auto address = reinterpret_cast<std::uintptr_t>(block.data()) + offset_;
+            const auto padding = static_cast<size_t>((alignment - (address & (alignment - 1))) & (alignment - 1));
+
+            if (offset_ + padding + size <= block.size())
+            {
+                auto ptr = block.data() + offset_ + padding;
+                offset_ += padding + size;
+                size_ += padding + size;
+                return ptr;
+            }
+
+            /* Continue with the next block */
+            if (blockIndex_ + 1 < blocks_.size())
+            {
+                ++blockIndex_;
+                offset_ = 0;
+                continue;
+            }
+        }
+
+        /* Append a new block, which is large enough for this allocation */
+        AppendBlock(size + alignment);
+    }
+}
+
+void LinearArena::Reset()
+{
+    if (blocks_.size() > 1 && blockIndex_ > 0)
+    {
+        /* Merge all blocks into a single block for the next cycle */
+        const auto capacity = Capacity();
+        blocks_.clear();
+        AppendBlock(capacity);
+    }
+
+    blockIndex_ = 0;
+    offset_     = 0;
+    size_       = 0;
+}
+
+size_t LinearArena::Capacity() const
+{
+    size_t capacity = 0;
+    for (const auto& block : blocks_)
+        capacity += block.size();
+    return capacity;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void LinearArena::AppendBlock(size_t minSize)
+{
+    blocks_.push_back(Block(std::max(minSize, blockSize_)));
+
+    blockIndex_ = blocks_.size() - 1;
+    offset_     = 0;
+}
+
+
+} // /namespace Fork
+
+
+
+// ========================
@@ -0,0 +1,244 @@
+/*
+ * Job system file
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Core/Jobs/JobSystem.h"
+
+
+namespace Fork
+{
+
+namespace Jobs
+{
+
+
+/* --- Internal members --- */
+
+//! Job system and queue index of the current worker thread.
+static thread_local const JobSystem*    workerJobSystem     = nullptr;
+static thread_local size_t              workerQueueIndex    = 0;
+
+
+JobSystem::JobSystem(unsigned int numWorkers)
+{
+    if (numWorkers == 0)
+    {
+        const auto numThreads = std::thread::hardware_concurrency();
+        numWorkers = (numThreads > 1 ? numThreads - 1 : 0);
+    }
+
+    /* Create one queue per worker (and at least one queue for the calling thread) */
+    const size_t numQueues = std::max(1u, numWorkers);
+
+    for (size_t i = 0; i < numQueues; ++i)
+        queues_.emplace_back(std::unique_ptr<JobQueue>(new JobQueue()));
+
+    /* Start worker threads */
+    for (size_t i = 0; i < numWorkers; ++i)
+        workers_.emplace_back(&JobSystem::WorkerLoop, this, i);
+}
+
+JobSystem::~JobSystem()
+{
+    /* Wake up all workers and wait until they have finished */
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        quit_ = true;
+    }
+    sleepCondition_.notify_all();
+
+    for (auto& worker : workers_)
+        worker.join();
+}
+
+JobSystem* JobSystem::Instance()
+{
+    static JobSystem instance;
+    return &instance;
+}
+
+void JobSystem::Submit(const JobFunction& job, JobCounter* counter, JobCounter* dependency)
+{
+    if (counter)
+        ++counter->value_;
+
+    if (dependency)
+    {
+        std::lock_guard<std::mutex> lock(dependency->mutex_);
+        if (dependency->value_ != 0)
+        {
+            /* Defer job until the dependency counter reaches zero */
+            dependency->continuations_.push_back({ job, counter });
+            return;
+        }
+    }
+
+    PushJob({ job, counter });
+}
+
+void JobSystem::Wait(const JobCounter& counter)
+{
+    const auto queueIndex = CurrentQueueIndex();
+
+    while (!counter.IsDone())
+    {
+        /* Help executing pending jobs while waiting */
+        Job job;
+        if (FindJob(queueIndex, job))
+            ExecuteJob(job);
+        else
+            std::this_thread::yield();
+    }
+
+    /* Synchronize with the thread which has decremented the counter to zero, before the counter may be destroyed */
+    std::exception_ptr exception;
+    {
+        std::lock_guard<std::mutex> lock(counter.mutex_);
+        exception.swap(counter.exception_);
+    }
+
+    /* Rethrow the first exception of the counter's jobs on the waiting thread */
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void JobSystem::WorkerLoop(size_t queueIndex)
+{
+    workerJobSystem     = this;
+    workerQueueIndex    = queueIndex;
+
+    while (!quit_)
+    {
+        Job job;
+        if (FindJob(queueIndex, job))
+            ExecuteJob(job);
+        else
+        {
+            /* Sleep until new jobs are available */
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            sleepCondition_.wait(
+                lock,
+                [this]()
+                {
+                    return quit_ || numQueuedJobs_ > 0;
+                }
+            );
+        }
+    }
+}
+
+void JobSystem::PushJob(Job&& job)
+{
+    /* Use own queue for worker threads, otherwise distribute jobs round-robin */
+    auto queueIndex = CurrentQueueIndex();
+    if (queueIndex >= queues_.size())
+        queueIndex = (nextQueue_++) % queues_.size();
+
+    /* Increment job count first (under the sleep mutex to avoid a lost wake-up) */
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        ++numQueuedJobs_;
+    }
+
+    auto& queue = *queues_[queueIndex];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+
+    /* Notify one sleeping worker */
+    sleepCondition_.notify_one();
+}
+
+bool JobSystem::FindJob(size_t queueIndex, Job& job)
+{
+    const auto numQueues = queues_.size();
+
+    /* Take the most recent job from the own queue */
+    if (queueIndex < numQueues)
+    {
+        auto& queue = *queues_[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            --numQueuedJobs_;
+            return true;
+        }
+    }
+
+    /* Steal the oldest job from another queue */
+    for (size_t i = 1; i <= numQueues; ++i)
+    {
+        auto& queue = *queues_[(queueIndex + i) % numQueues];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            --numQueuedJobs_;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void JobSystem::ExecuteJob(Job& job)
+{
+    /* Catch exceptions, so they neither terminate a worker nor skip the counter */
+    std::exception_ptr exception;
+
+    try
+    {
+        job.job();
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+
+    auto counter = job.counter;
+    if (!counter)
+        return;
+
+    /* Decrement counter and schedule all dependent jobs, when the counter reaches zero */
+    std::vector<JobCounter::Continuation> continuations;
+    {
+        std::lock_guard<std::mutex> lock(counter->mutex_);
+        if (exception && !counter->exception_)
+            counter->exception_ = exception;
+        if (--counter->value_ == 0)
+            continuations.swap(counter->continuations_);
+    }
+
+    /*
+    Don't touch the counter after this point,
+    because a waiting thread may destroy it as soon as it has reached zero.
+    */
+    for (auto& cont : continuations)
+        PushJob({ std::move(cont.job), cont.counter });
+}
+
+size_t JobSystem::CurrentQueueIndex() const
+{
+    return (workerJobSystem == this ? workerQueueIndex : queues_.size());
+}
+
+
+} // /namespace Jobs
+
+} // /namespace Fork
+
+
+
+// ========================
@@ -87,6 +87,13 @@ void SimpleApp::OnMain()
 
 void SimpleApp::OnRender()
 {
+    /* Update scene hierarchy with the current transformations */
+    if (sceneRenderer_->sceneHierarchy)
+    {
+        sceneGraph.UpdateGlobalTransforms();
+        sceneManager.UpdateBoundingVolumeHierarchy();
+    }
+
     /* Render scene graph with main scene renderer */
     mainCamera.UpdateView();
     sceneRenderer_->RenderSceneFromCamera(&sceneGraph, mainCamera);
@@ -188,6 +195,9 @@ void SimpleApp::InitEngine(
 
     /* Create the main scene renderer */
     sceneRenderer_ = std::make_unique<Scene::SimpleSceneRenderer>(config.useNormalMapping);
+
+    if (config.useSceneHierarchy)
+        sceneRenderer_->sceneHierarchy = &sceneManager.GetBoundingVolumeHierarchy();
 }
 
 void SimpleApp::OnFrameFileDrop(const std::wstring& filename, unsigned int index, unsigned int numFiles)
@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <regex>
 #include <stack>
+#include <mutex>
 
 
 namespace Fork
@@ -43,6 +44,8 @@ struct InternalState
     std::string                     indent { "  " };
 
     std::stack<size_t>              indentSizeStack;
+
+    std::recursive_mutex            mutex;  //!< Serializes the log output, since resources can also be loaded on worker threads.
 };
 
 static InternalState internalState;
@@ -109,6 +112,8 @@ static void EndLn()
 
 static int MessageLimit(const std::string& message, int messageLimit)
 {
+    std::lock_guard<std::recursive_mutex> lock(internalState.mutex);
+
     /* Check if message should be skiped */
     if (messageLimit > 0)
     {
@@ -163,19 +168,22 @@ FORK_EXPORT const std::string& GetIndent()
     return internalState.indent;
 }
 
-FORK_EXPORT const std::string& GetFullIndent()
+FORK_EXPORT std::string GetFullIndent()
 {
+    std::lock_guard<std::recursive_mutex> lock(internalState.mutex);
     return internalState.indentFull;
 }
 
 FORK_EXPORT void IncIndent()
 {
+    std::lock_guard<std::recursive_mutex> lock(internalState.mutex);
     internalState.indentFull += internalState.indent;
     internalState.indentSizeStack.push(internalState.indent.size());
 }
 
 FORK_EXPORT void DecIndent()
 {
+    std::lock_guard<std::recursive_mutex> lock(internalState.mutex);
     if (!internalState.indentSizeStack.empty())
     {
         /* Remove previous indent size from the full indentation */
@@ -191,6 +199,7 @@ FORK_EXPORT void DecIndent()
 
 FORK_EXPORT void Message(const std::string& message, const EntryTypes type)
 {
+    std::lock_guard<std::recursive_mutex> lock(internalState.mutex);
     ForEach(
         internalState.eventHandlers,
         [&](EventHandlerPtr& evtHandler)
@@ -202,6 +211,7 @@ FORK_EXPORT void Message(const std::string& message, const EntryTypes type)
 
 FORK_EXPORT void Message(const std::string& message, const ColorFlags colorFlags, const EntryTypes type)
 {
+    std::lock_guard<std::recursive_mutex> lock(internalState.mutex);
     PushFrontColor(colorFlags);
     Message(message, type);
     PopColor();
@@ -209,6 +219,7 @@ FORK_EXPORT void Message(const std::string& message, const ColorFlags colorFlags
 
 FORK_EXPORT void Message(const std::string& message, const ColorFlags colorFlagsFront, const ColorFlags colorFlagsBack, const EntryTypes type)
 {
+    std::lock_guard<std::recursive_mutex> lock(internalState.mutex);
     PushFrontAndBackColor(colorFlagsFront, colorFlagsBack);
     Message(message, type);
     PopColor();
@@ -216,6 +227,7 @@ FORK_EXPORT void Message(const std::string& message, const ColorFlags colorFlags
 
 FORK_EXPORT void MessageColored(const std::string& message, const EntryTypes type)
 {
+    std::lock_guard<std::recursive_mutex> lock(internalState.mutex);
     auto msg = message;
 
     /* Define color flags extraction lambda function */
@@ -323,6 +335,7 @@ FORK_EXPORT void Warning(const std::string& message)
 
 FORK_EXPORT void Blank()
 {
+    std::lock_guard<std::recursive_mutex> lock(internalState.mutex);
     ForEach(
         internalState.eventHandlers,
         [&](EventHandlerPtr& evtHandler)
@@ -95,6 +95,8 @@ ModelReader::AnimatedModel CommonModelReader::ReadModelExt(
 {
     AnimatedModel animModel;
 
+    failedTextures_.clear();
+
     /* Setup reading flags */
     createTangentSpaceMeshes_ = ((flags & Flags::GenerateTangentSpace) != 0);
 
@@ -163,6 +165,16 @@ Video::TexturePtr CommonModelReader::LoadTexture(std::string filename) const
     return LoadTextureFromFile(filename);
 }
 
+Video::AsyncTexture2DPtr CommonModelReader::LoadTextureAsync(std::string filename) const
+{
+    if (!texPathDict_.FindFile(filename))
+    {
+        IO::Log::Error("Searching texture \"" + filename + "\" failed");
+        return nullptr;
+    }
+    return Video::RenderSystem::Active()->GetTextureManager()->LoadTexture2DAsync(filename);
+}
+
 #ifdef _DEB_ASSIMP_
 void CommonModelReader::_DebNode(const aiNode* node)
 {
@@ -234,7 +246,25 @@ void CommonModelReader::VisitMaterial(const aiMaterial* material)
     {
         aiString filename;
         if (material->GetTexture(type, index, &filename) == AI_SUCCESS)
-            modelMaterial.AddTexture(LoadTexture(AIStr(filename)));
+        {
+            const auto name = AIStr(filename);
+
+            /* Store the names of the failed textures, so that the cooked model file can retry them */
+            if (deferredResources_)
+            {
+                auto texture = LoadTextureAsync(name);
+                if (!texture)
+                    failedTextures_.push_back(name);
+                modelMaterial.AddAsyncTexture(texture, name);
+            }
+            else
+            {
+                auto texture = LoadTexture(name);
+                if (!texture)
+                    failedTextures_.push_back(name);
+                modelMaterial.AddTexture(texture);
+            }
+        }
     };
 
     auto LoadAllTextures = [&](const aiTextureType type)
@@ -289,15 +319,18 @@ GeometryPtr CommonModelReader::VisitMesh(const aiMesh* mesh, bool loadAnimation)
     {
         auto& material = materials_[mesh->mMaterialIndex];
 
-        if (!material.textures.empty())
+        if (!material.textures.empty() || !material.asyncTextures.empty())
         {
             /* Create textured geometry */
             auto texturedGeometry = std::make_shared<TexturedGeometry>();
             texturedGeometry->actualGeometry = meshGeometry;
 
-            /* Append textures to the geoemtry */
+            /* Append textures to the geoemtry (or bind them later, when they are loaded asynchronously) */
             texturedGeometry->textures = material.textures;
 
+            if (!material.asyncTextures.empty())
+                deferredResources_->textureBindings.push_back({ texturedGeometry, material.asyncTextures, material.asyncTextureNames });
+
             return texturedGeometry;
         }
     }
@@ -381,7 +414,8 @@ Simple3DMeshGeometryPtr CommonModelReader::CreateSimple3DMeshGeometry(const aiMe
     }
 
     /* Setup final geometry data */
-    geometry->SetupHardwareBuffer();
+    if (!deferredResources_)
+        geometry->SetupHardwareBuffer();
 
     return geometry;
 }
@@ -412,7 +446,8 @@ TangentSpaceMeshGeometryPtr CommonModelReader::CreateTangentSpaceMeshGeometry(co
     }
 
     /* Setup final geometry data */
-    geometry->SetupHardwareBuffer();
+    if (!deferredResources_)
+        geometry->SetupHardwareBuffer();
     //geometry->GenerateTangentSpaceFlat(true);//!TEST!
 
     return geometry;
@@ -10,6 +10,7 @@
 
 
 #include "Scene/FileHandler/ModelReader.h"
+#include "Scene/FileHandler/ModelFileHandler.h"
 #include "Core/StaticConfig.h"
 #include "Video/RenderSystem/Texture/Texture.h"
 
@@ -44,6 +45,27 @@ class CommonModelReader : public ModelReader
             const Flags::DataType flags = 0
         ) override;
 
+        /**
+        Defers the GPU resources of the next models, so that they can be read on a worker thread:
+        no hardware buffers are created and all textures are requested asynchronously.
+        \param[out] deferredResources Raw-pointer to the output deferred resources, or null to disable this mode.
+        \see ModelFileHandler::ReadModelDeferred
+        */
+        inline void DeferResources(ModelFileHandler::DeferredResources* deferredResources)
+        {
+            deferredResources_ = deferredResources;
+        }
+
+        /**
+        Returns the texture filenames (as referenced by the model), which could not be found or loaded while the last model was read.
+        The asynchronously requested textures are only listed, if they could not be found.
+        \see ModelFileHandler::DeferredResources::TextureBinding::textureNames
+        */
+        inline const std::vector<std::string>& FailedTextures() const
+        {
+            return failedTextures_;
+        }
+
     private:
         
         #ifdef FORK_IMPORT_ASSIMP
@@ -57,7 +79,17 @@ class CommonModelReader : public ModelReader
                 if (texture)
                     textures.push_back(texture);
             }
-            std::vector<Video::TexturePtr> textures;
+            void AddAsyncTexture(const Video::AsyncTexture2DPtr& texture, const std::string& name)
+            {
+                if (texture)
+                {
+                    asyncTextures.push_back(texture);
+                    asyncTextureNames.push_back(name);
+                }
+            }
+            std::vector<Video::TexturePtr>          textures;
+            std::vector<Video::AsyncTexture2DPtr>   asyncTextures;
+            std::vector<std::string>                asyncTextureNames;
         };
 
         struct Bone
@@ -76,6 +108,7 @@ class CommonModelReader : public ModelReader
         );
 
         Video::TexturePtr LoadTexture(std::string filename) const;
+        Video::AsyncTexture2DPtr LoadTextureAsync(std::string filename) const;
 
         GeometryPtr VisitScene(const aiScene* scene, bool loadAnimation);
         void VisitMaterial(const aiMaterial* material);
@@ -108,6 +141,9 @@ class CommonModelReader : public ModelReader
 
         #endif
 
+        ModelFileHandler::DeferredResources*        deferredResources_ = nullptr;
+        std::vector<std::string>                    failedTextures_;
+
 };
 
 
@@ -0,0 +1,731 @@
+/*
+ * Cooked model file file
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CookedModelFile.h"
+#include "Scene/Geometry/Node/CompositionGeometry.h"
+#include "Scene/Geometry/Node/Simple3DMeshGeometry.h"
+#include "Scene/Geometry/Node/TangentSpaceMeshGeometry.h"
+#include "Scene/Geometry/Node/TexturedGeometry.h"
+#include "Video/RenderSystem/RenderSystem.h"
+#include "IO/Core/Log.h"
+#include "Core/StringModifier.h"
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <cstring>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+namespace CookedModelFile
+{
+
+
+/*
+ * Internal structures
+ */
+
+static const char           cookedFileMagic[4]  = { 'f', 'k', 'c', 'g' };
+static const std::uint32_t  cookedFileVersion   = 102;
+static const std::uint64_t  cookedDataAlignment = 16;
+
+#include "Core/PackPush.h"
+
+//! Cooked model file header.
+struct CookedFileHeader
+{
+    char            magic[4];
+    std::uint32_t   version;
+    std::uint64_t   sourceHash;
+    std::uint64_t   sourceSize;
+    std::uint64_t   sourceTime;
+    std::uint64_t   dependencyHash;
+    std::uint32_t   importFlags;
+    std::uint32_t   numNodes;
+    std::uint32_t   numTextures;
+    std::uint32_t   numFailedTextures;  //!< Number of failed texture filenames, which follow the regular texture table entries.
+    std::uint64_t   nodeTableOffset;
+    std::uint64_t   textureTableOffset;
+    std::uint64_t   fileSize;
+}
+PACK_STRUCT;
+
+//! Geometry node record. The nodes are stored in depth-first pre-order, i.e. the children of a node follow directly.
+struct CookedNode
+{
+    std::uint32_t   type;               //!< Geometry type (see Geometry::Types).
+    std::uint32_t   numChildren;        //!< Number of sub geometries (composition) or 1 (textured geometry).
+    std::uint32_t   firstTexture;       //!< First entry in the texture table (textured geometry).
+    std::uint32_t   numTextures;        //!< Number of entries in the texture table (textured geometry).
+    std::uint32_t   primitiveType;      //!< Geometry primitive type (mesh geometry).
+    std::uint32_t   vertexStride;       //!< Size (in bytes) of each vertex (mesh geometry).
+    std::uint64_t   vertexDataOffset;
+    std::uint64_t   numVertices;
+    std::uint64_t   indexDataOffset;
+    std::uint64_t   numIndices;
+    std::uint32_t   boundingVolumeType;
+    float           boxMin[3];
+    float           boxMax[3];
+    float           sphereCenter[3];
+    float           sphereRadius;
+}
+PACK_STRUCT;
+
+//! Texture filename record (regular and failed textures).
+struct CookedString
+{
+    std::uint64_t   offset;
+    std::uint64_t   length;
+}
+PACK_STRUCT;
+
+#include "Core/PackPop.h"
+
+//! Flattened geometry graph for writing.
+struct CookedGraph
+{
+    std::vector<CookedNode>     nodes;
+    std::vector<const void*>    vertexData;
+    std::vector<const void*>    indexData;
+    std::vector<std::string>    textureNames;
+};
+
+//! Read-only view of an entire cooked model file.
+struct CookedFileView
+{
+    //! Returns true if the specified byte range is inside the file.
+    bool IsRangeValid(std::uint64_t offset, std::uint64_t count, std::uint64_t elementSize) const
+    {
+        return elementSize > 0 && count <= size / elementSize && offset <= size - count*elementSize;
+    }
+
+    const char*         data        = nullptr;
+    std::uint64_t       size        = 0;
+    const CookedNode*   nodes       = nullptr;
+    std::uint32_t       numNodes    = 0;
+    const CookedString* textures    = nullptr;
+    std::uint32_t       numTextures = 0;
+
+    ModelFileHandler::DeferredResources* deferredResources = nullptr; //!< Non-null if the GPU resources are deferred.
+};
+
+
+/*
+ * Internal functions
+ */
+
+static const std::uint64_t fnvOffsetBasis   = 14695981039346656037ull;
+static const std::uint64_t fnvPrime         = 1099511628211ull;
+
+static void HashBytes(std::uint64_t& hash, const char* data, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= fnvPrime;
+    }
+}
+
+//! Hashes the string including its null terminator, so that consecutive strings can not be confused.
+static void HashString(std::uint64_t& hash, const std::string& str)
+{
+    HashBytes(hash, str.c_str(), str.size() + 1);
+}
+
+//! Hashes the entire content of the specified file. Returns false if the file could not be read.
+static bool HashFile(std::uint64_t& hash, std::uint64_t& size, const std::string& filename)
+{
+    std::ifstream file(filename, std::ios_base::in | std::ios_base::binary);
+    if (!file.good())
+        return false;
+
+    std::vector<char> buffer(1 << 16);
+
+    while (file.good())
+    {
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        const auto numBytes = static_cast<size_t>(file.gcount());
+
+        HashBytes(hash, buffer.data(), numBytes);
+        size += numBytes;
+    }
+
+    return !file.bad();
+}
+
+//! Retrieves the size and the last modification time of the specified file. Returns false if the file does not exist.
+static bool QueryFileStatus(const std::string& filename, std::uint64_t& size, std::uint64_t& time)
+{
+    struct stat status;
+    if (stat(filename.c_str(), &status) != 0)
+        return false;
+
+    size = static_cast<std::uint64_t>(status.st_size);
+    time = static_cast<std::uint64_t>(status.st_mtime);
+
+    return true;
+}
+
+//! Reads the header of the specified cooked model file. Returns false if the file could not be read or has another version.
+static bool ReadHeader(const std::string& cookedFilename, CookedFileHeader& header)
+{
+    std::ifstream file(cookedFilename, std::ios_base::in | std::ios_base::binary);
+    if (!file.good())
+        return false;
+
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    return file.good() && std::memcmp(header.magic, cookedFileMagic, 4) == 0 && header.version == cookedFileVersion;
+}
+
+/*
+Returns the filenames of the files, which are read together with the specified model file.
+Currently these are the material libraries of Wavefront OBJ files.
+*/
+static std::vector<std::string> DependentFiles(const std::string& filename)
+{
+    std::vector<std::string> filenames;
+
+    auto ext = ExtractFileExt(filename);
+    MakeLower(ext);
+
+    if (ext != "obj")
+        return filenames;
+
+    std::ifstream file(filename);
+    if (!file.good())
+        return filenames;
+
+    const auto path = ExtractFilePath(filename);
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.compare(0, 7, "mtllib ") != 0)
+            continue;
+
+        std::istringstream stream(line.substr(7));
+        std::string libFilename;
+
+        while (stream >> libFilename)
+            filenames.push_back(path + "/" + libFilename);
+    }
+
+    return filenames;
+}
+
+static std::uint64_t AlignOffset(std::uint64_t offset)
+{
+    return (offset + cookedDataAlignment - 1) / cookedDataAlignment * cookedDataAlignment;
+}
+
+/* --- Writing --- */
+
+template <class Geom> void FlattenMesh(CookedGraph& graph, size_t nodeIndex, const Geom& mesh)
+{
+    auto& node = graph.nodes[nodeIndex];
+
+    node.primitiveType  = static_cast<std::uint32_t>(mesh.primitiveType);
+    node.vertexStride   = static_cast<std::uint32_t>(sizeof(mesh.vertices[0]));
+    node.numVertices    = mesh.vertices.size();
+    node.numIndices     = mesh.indices.size();
+
+    graph.vertexData[nodeIndex] = mesh.vertices.data();
+    graph.indexData[nodeIndex]  = mesh.indices.data();
+}
+
+//! Returns false if the geometry graph contains geometries which can not be cooked.
+static bool FlattenGeometry(CookedGraph& graph, const Geometry& geometry)
+{
+    /* Add node with its bounding volume */
+    const auto nodeIndex = graph.nodes.size();
+
+    CookedNode node;
+    std::memset(&node, 0, sizeof(node));
+    {
+        const auto& boundingVolume = geometry.boundingVolume;
+
+        node.type               = static_cast<std::uint32_t>(geometry.Type());
+        node.boundingVolumeType = static_cast<std::uint32_t>(boundingVolume.type);
+
+        for (size_t i = 0; i < 3; ++i)
+        {
+            node.boxMin[i]          = boundingVolume.box.min[i];
+            node.boxMax[i]          = boundingVolume.box.max[i];
+            node.sphereCenter[i]    = boundingVolume.sphere.point[i];
+        }
+
+        node.sphereRadius = boundingVolume.sphere.radius;
+    }
+    graph.nodes.push_back(node);
+    graph.vertexData.push_back(nullptr);
+    graph.indexData.push_back(nullptr);
+
+    /* Add geometry specific data and child nodes */
+    switch (geometry.Type())
+    {
+        case Geometry::Types::Simple3DMesh:
+            FlattenMesh(graph, nodeIndex, static_cast<const Simple3DMeshGeometry&>(geometry));
+            break;
+
+        case Geometry::Types::TangentSpaceMesh:
+            FlattenMesh(graph, nodeIndex, static_cast<const TangentSpaceMeshGeometry&>(geometry));
+            break;
+
+        case Geometry::Types::Composition:
+        {
+            const auto& composition = static_cast<const CompositionGeometry&>(geometry);
+
+            graph.nodes[nodeIndex].numChildren = static_cast<std::uint32_t>(composition.subGeometries.size());
+
+            for (const auto& subGeometry : composition.subGeometries)
+            {
+                if (!subGeometry || !FlattenGeometry(graph, *subGeometry))
+                    return false;
+            }
+        }
+        break;
+
+        case Geometry::Types::Textured:
+        {
+            const auto& texturedGeometry = static_cast<const TexturedGeometry&>(geometry);
+
+            if (!texturedGeometry.actualGeometry)
+                return false;
+
+            /* Store texture filenames (textures, which have not been loaded from file, can not be cooked) */
+            graph.nodes[nodeIndex].numChildren  = 1;
+            graph.nodes[nodeIndex].firstTexture = static_cast<std::uint32_t>(graph.textureNames.size());
+            graph.nodes[nodeIndex].numTextures  = static_cast<std::uint32_t>(texturedGeometry.textures.size());
+
+            for (const auto& texture : texturedGeometry.textures)
+            {
+                if (!texture || texture->metaData.name.empty())
+                    return false;
+                graph.textureNames.push_back(texture->metaData.name);
+            }
+
+            if (!FlattenGeometry(graph, *texturedGeometry.actualGeometry))
+                return false;
+        }
+        break;
+
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+static void WriteData(std::ofstream& file, std::uint64_t& offset, const void* data, std::uint64_t size)
+{
+    if (size > 0)
+    {
+        file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+        offset += size;
+    }
+}
+
+static void WritePadding(std::ofstream& file, std::uint64_t& offset)
+{
+    static const char padding[cookedDataAlignment] = { 0 };
+    WriteData(file, offset, padding, AlignOffset(offset) - offset);
+}
+
+/* --- Reading --- */
+
+static GeometryPtr ReadCookedNode(const CookedFileView& view, std::uint32_t& nodeIndex);
+
+template <class Geom, class VtxT> std::shared_ptr<Geom> ReadCookedMesh(const CookedFileView& view, const CookedNode& node)
+{
+    /* Validate vertex and index data ranges */
+    if ( node.vertexStride != sizeof(VtxT) ||
+         !view.IsRangeValid(node.vertexDataOffset, node.numVertices, sizeof(VtxT)) ||
+         !view.IsRangeValid(node.indexDataOffset, node.numIndices, sizeof(unsigned int)) )
+    {
+        return nullptr;
+    }
+
+    /* Copy vertex and index data directly from the final vertex layout */
+    auto mesh = std::make_shared<Geom>();
+
+    auto vertices = reinterpret_cast<const VtxT*>(view.data + node.vertexDataOffset);
+    auto indices = reinterpret_cast<const unsigned int*>(view.data + node.indexDataOffset);
+
+    /* Validate index values, so that a corrupted file can not address vertices out of bounds */
+    for (std::uint64_t i = 0; i < node.numIndices; ++i)
+    {
+        if (indices[i] >= node.numVertices)
+            return nullptr;
+    }
+
+    mesh->vertices.assign(vertices, vertices + node.numVertices);
+    mesh->indices.assign(indices, indices + node.numIndices);
+    mesh->primitiveType = static_cast<Video::GeometryPrimitives>(node.primitiveType);
+
+    /* Setup final geometry data */
+    if (!view.deferredResources)
+        mesh->SetupHardwareBuffer();
+
+    return mesh;
+}
+
+static GeometryPtr ReadCookedComposition(const CookedFileView& view, const CookedNode& node, std::uint32_t& nodeIndex)
+{
+    auto composition = std::make_shared<CompositionGeometry>();
+
+    for (std::uint32_t i = 0; i < node.numChildren; ++i)
+    {
+        auto subGeometry = ReadCookedNode(view, nodeIndex);
+        if (!subGeometry)
+            return nullptr;
+        composition->subGeometries.push_back(subGeometry);
+    }
+
+    return composition;
+}
+
+static GeometryPtr ReadCookedTextured(const CookedFileView& view, const CookedNode& node, std::uint32_t& nodeIndex)
+{
+    if (node.numChildren != 1 || node.firstTexture > view.numTextures || node.numTextures > view.numTextures - node.firstTexture)
+        return nullptr;
+
+    auto texturedGeometry = std::make_shared<TexturedGeometry>();
+
+    /* Load textures (missing textures are reported by the texture manager) */
+    auto textureManager = Video::RenderSystem::Active()->GetTextureManager();
+
+    ModelFileHandler::DeferredResources::TextureBinding binding;
+
+    for (std::uint32_t i = 0; i < node.numTextures; ++i)
+    {
+        const auto& textureName = view.textures[node.firstTexture + i];
+        if (!view.IsRangeValid(textureName.offset, textureName.length, 1))
+            return nullptr;
+
+        const std::string textureFilename(view.data + textureName.offset, static_cast<size_t>(textureName.length));
+
+        if (view.deferredResources)
+        {
+            binding.textures.push_back(textureManager->LoadTexture2DAsync(textureFilename));
+            binding.textureNames.push_back(textureFilename);
+        }
+        else
+        {
+            auto texture = textureManager->LoadTexture2D(textureFilename);
+            if (texture)
+                texturedGeometry->textures.push_back(texture);
+        }
+    }
+
+    if (!binding.textures.empty())
+    {
+        binding.geometry = texturedGeometry;
+        view.deferredResources->textureBindings.push_back(binding);
+    }
+
+    /* Read actual geometry */
+    texturedGeometry->actualGeometry = ReadCookedNode(view, nodeIndex);
+    if (!texturedGeometry->actualGeometry)
+        return nullptr;
+
+    return texturedGeometry;
+}
+
+//! Returns null if the node is invalid.
+static GeometryPtr ReadCookedNode(const CookedFileView& view, std::uint32_t& nodeIndex)
+{
+    if (nodeIndex >= view.numNodes)
+        return nullptr;
+
+    const auto& node = view.nodes[nodeIndex++];
+
+    /* Read geometry specific data and child nodes */
+    GeometryPtr geometry;
+
+    switch (static_cast<Geometry::Types>(node.type))
+    {
+        case Geometry::Types::Simple3DMesh:
+            geometry = ReadCookedMesh<Simple3DMeshGeometry, Video::Simple3DVertex>(view, node);
+            break;
+        case Geometry::Types::TangentSpaceMesh:
+            geometry = ReadCookedMesh<TangentSpaceMeshGeometry, Video::TangentSpaceVertex>(view, node);
+            break;
+        case Geometry::Types::Composition:
+            geometry = ReadCookedComposition(view, node, nodeIndex);
+            break;
+        case Geometry::Types::Textured:
+            geometry = ReadCookedTextured(view, node, nodeIndex);
+            break;
+        default:
+            break;
+    }
+
+    if (!geometry)
+        return nullptr;
+
+    /* Setup bounding volume (it does not need to be computed again) */
+    auto& boundingVolume = geometry->boundingVolume;
+
+    boundingVolume.type = static_cast<BoundingVolume::Types>(node.boundingVolumeType);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        boundingVolume.box.min[i]       = node.boxMin[i];
+        boundingVolume.box.max[i]       = node.boxMax[i];
+        boundingVolume.sphere.point[i]  = node.sphereCenter[i];
+    }
+
+    boundingVolume.sphere.radius = node.sphereRadius;
+
+    return geometry;
+}
+
+
+/*
+ * Global functions
+ */
+
+std::string CookedFilename(const std::string& filename)
+{
+    return filename + ".fkcg";
+}
+
+bool ComputeKey(
+    const std::string& filename, const IO::PathDictionary& texPathDict, const ModelReader::Flags::DataType flags, Key& key)
+{
+    /* Query size and modification time of the source file */
+    std::uint64_t size = 0, time = 0;
+    if (!QueryFileStatus(filename, size, time))
+        return false;
+
+    /*
+    Take the source hash from the cooked model file, if the source file is unchanged since the cooked model file was written.
+    Otherwise compute FNV-1a hash of the entire file content.
+    */
+    std::uint64_t hash = fnvOffsetBasis;
+
+    CookedFileHeader header;
+    if (ReadHeader(CookedFilename(filename), header) && header.sourceSize == size && header.sourceTime == time)
+        hash = header.sourceHash;
+    else
+    {
+        size = 0;
+        if (!HashFile(hash, size, filename))
+            return false;
+    }
+
+    /* Compute FNV-1a hash of the texture search paths and the dependent files (missing files only hash their names) */
+    std::uint64_t dependencyHash = fnvOffsetBasis;
+
+    for (const auto& path : texPathDict.GetSearchPaths())
+        HashString(dependencyHash, path);
+
+    for (const auto& dependentFilename : DependentFiles(filename))
+    {
+        HashString(dependencyHash, dependentFilename);
+
+        std::uint64_t dependentSize = 0;
+        if (HashFile(dependencyHash, dependentSize, dependentFilename))
+            HashBytes(dependencyHash, reinterpret_cast<const char*>(&dependentSize), sizeof(dependentSize));
+    }
+
+    key.sourceHash      = hash;
+    key.sourceSize      = size;
+    key.sourceTime      = time;
+    key.dependencyHash  = dependencyHash;
+    key.importFlags     = (flags & ~static_cast<ModelReader::Flags::DataType>(ModelReader::Flags::CookedCache));
+
+    return true;
+}
+
+GeometryPtr ReadModel(
+    const std::string& cookedFilename, const Key& key, const IO::PathDictionary& texPathDict,
+    ModelFileHandler::DeferredResources* deferredResources)
+{
+    /* Read entire file at once */
+    std::ifstream file(cookedFilename, std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
+    if (!file.good())
+        return nullptr;
+
+    const auto fileSize = static_cast<std::uint64_t>(file.tellg());
+    if (fileSize < sizeof(CookedFileHeader))
+        return nullptr;
+
+    std::vector<char> buffer(static_cast<size_t>(fileSize));
+
+    file.seekg(0);
+    file.read(buffer.data(), static_cast<std::streamsize>(fileSize));
+
+    if (!file.good())
+        return nullptr;
+
+    /* Validate header and cache key */
+    CookedFileHeader header;
+    std::memcpy(&header, buffer.data(), sizeof(header));
+
+    if ( std::memcmp(header.magic, cookedFileMagic, 4) != 0 || header.version != cookedFileVersion ||
+         header.sourceHash != key.sourceHash || header.sourceSize != key.sourceSize || header.sourceTime != key.sourceTime ||
+         header.dependencyHash != key.dependencyHash || header.importFlags != key.importFlags )
+    {
+        return nullptr;
+    }
+
+    /* Setup file view */
+    CookedFileView view;
+    {
+        view.data               = buffer.data();
+        view.size               = fileSize;
+        view.numNodes           = header.numNodes;
+        view.numTextures        = header.numTextures;
+        view.deferredResources  = deferredResources;
+    }
+
+    if ( header.fileSize != fileSize ||
+         !view.IsRangeValid(header.nodeTableOffset, header.numNodes, sizeof(CookedNode)) ||
+         !view.IsRangeValid(header.textureTableOffset, std::uint64_t(header.numTextures) + header.numFailedTextures, sizeof(CookedString)) )
+    {
+        IO::Log::Warning("Invalid cooked model file \"" + cookedFilename + "\"");
+        return nullptr;
+    }
+
+    view.nodes      = reinterpret_cast<const CookedNode*>(view.data + header.nodeTableOffset);
+    view.textures   = reinterpret_cast<const CookedString*>(view.data + header.textureTableOffset);
+
+    /* The cooked model file is outdated, if one of its failed textures can be found now (the model reader adds the model path, too) */
+    if (header.numFailedTextures > 0)
+    {
+        auto searchPathDict = texPathDict;
+        searchPathDict.AddSearchPath(ExtractFilePath(cookedFilename));
+
+        for (std::uint32_t i = 0; i < header.numFailedTextures; ++i)
+        {
+            const auto& textureName = view.textures[header.numTextures + i];
+            if (!view.IsRangeValid(textureName.offset, textureName.length, 1))
+            {
+                IO::Log::Warning("Invalid cooked model file \"" + cookedFilename + "\"");
+                return nullptr;
+            }
+
+            std::string textureFilename(view.data + textureName.offset, static_cast<size_t>(textureName.length));
+            if (searchPathDict.FindFile(textureFilename))
+                return nullptr;
+        }
+    }
+
+    /* Build geometry graph from the root node */
+    std::uint32_t nodeIndex = 0;
+    auto model = ReadCookedNode(view, nodeIndex);
+
+    if (!model || nodeIndex != view.numNodes)
+    {
+        IO::Log::Warning("Invalid cooked model file \"" + cookedFilename + "\"");
+        return nullptr;
+    }
+
+    return model;
+}
+
+bool WriteModel(
+    const std::string& cookedFilename, const Key& key, const Geometry& model, const std::vector<std::string>& failedTextures)
+{
+    /* Flatten geometry graph */
+    CookedGraph graph;
+    if (!FlattenGeometry(graph, model))
+        return false;
+
+    /* Append the failed texture filenames behind the texture filenames, which are referenced by the nodes */
+    const auto numTextures = graph.textureNames.size();
+    graph.textureNames.insert(graph.textureNames.end(), failedTextures.begin(), failedTextures.end());
+
+    /* Setup header and file layout */
+    CookedFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    {
+        std::memcpy(header.magic, cookedFileMagic, 4);
+        header.version              = cookedFileVersion;
+        header.sourceHash           = key.sourceHash;
+        header.sourceSize           = key.sourceSize;
+        header.sourceTime           = key.sourceTime;
+        header.dependencyHash       = key.dependencyHash;
+        header.importFlags          = key.importFlags;
+        header.numNodes             = static_cast<std::uint32_t>(graph.nodes.size());
+        header.numTextures          = static_cast<std::uint32_t>(numTextures);
+        header.numFailedTextures    = static_cast<std::uint32_t>(failedTextures.size());
+        header.nodeTableOffset      = sizeof(CookedFileHeader);
+        header.textureTableOffset   = header.nodeTableOffset + sizeof(CookedNode)*graph.nodes.size();
+    }
+
+    std::vector<CookedString> textureTable(graph.textureNames.size());
+
+    auto offset = header.textureTableOffset + sizeof(CookedString)*textureTable.size();
+
+    for (size_t i = 0; i < textureTable.size(); ++i)
+    {
+        textureTable[i].offset = offset;
+        textureTable[i].length = graph.textureNames[i].size();
+        offset += textureTable[i].length;
+    }
+
+    for (auto& node : graph.nodes)
+    {
+        offset = AlignOffset(offset);
+        node.vertexDataOffset = offset;
+        offset += node.numVertices * node.vertexStride;
+
+        offset = AlignOffset(offset);
+        node.indexDataOffset = offset;
+        offset += node.numIndices * sizeof(unsigned int);
+    }
+
+    header.fileSize = offset;
+
+    /* Write file */
+    std::ofstream file(cookedFilename, std::ios_base::out | std::ios_base::binary);
+    if (!file.good())
+        return false;
+
+    offset = 0;
+
+    WriteData(file, offset, &header, sizeof(header));
+    WriteData(file, offset, graph.nodes.data(), sizeof(CookedNode)*graph.nodes.size());
+    WriteData(file, offset, textureTable.data(), sizeof(CookedString)*textureTable.size());
+
+    for (const auto& name : graph.textureNames)
+        WriteData(file, offset, name.data(), name.size());
+
+    for (size_t i = 0; i < graph.nodes.size(); ++i)
+    {
+        const auto& node = graph.nodes[i];
+
+        WritePadding(file, offset);
+        WriteData(file, offset, graph.vertexData[i], node.numVertices * node.vertexStride);
+
+        WritePadding(file, offset);
+        WriteData(file, offset, graph.indexData[i], node.numIndices * sizeof(unsigned int));
+    }
+
+    return file.good();
+}
+
+
+} // /namespace CookedModelFile
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+
+// ========================
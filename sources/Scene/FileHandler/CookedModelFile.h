@@ -0,0 +1,101 @@
+/*
+ * Cooked model file header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_COOKED_MODEL_FILE_H__
+#define __FORK_COOKED_MODEL_FILE_H__
+
+
+#include "Scene/FileHandler/ModelReader.h"
+#include "Scene/FileHandler/ModelFileHandler.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+/**
+Cooked model file namespace. A cooked model file is a binary cache of an imported model,
+which stores the vertex- and index buffers in their final vertex format layout, together with the geometry hierarchy,
+the texture filenames and the bounding volumes. All records have a fixed size and are addressed by file offsets
+(the vertex and index data is 16 byte aligned), so the file could also be memory mapped and needs no parsing.
+*/
+namespace CookedModelFile
+{
+
+
+//! Cooked model cache key. A cooked model file is only used if its key matches the key of the source file.
+struct Key
+{
+    std::uint64_t sourceHash        = 0; //!< FNV-1a hash of the entire source file content.
+    std::uint64_t sourceSize        = 0; //!< Size (in bytes) of the source file.
+    std::uint64_t sourceTime        = 0; //!< Last modification time of the source file.
+    std::uint64_t dependencyHash    = 0; //!< FNV-1a hash of the texture search paths and the dependent files (e.g. the material library of an OBJ file).
+    std::uint32_t importFlags       = 0; //!< Model reading flags (see ModelReader::Flags), without the 'CookedCache' flag.
+};
+
+//! Returns the filename of the cooked model file for the specified source model filename.
+std::string CookedFilename(const std::string& filename);
+
+/**
+Computes the cache key for the specified source model file.
+\param[in] texPathDict Specifies the texture path dictionary, the model is read with. The texture filenames depend on its search paths.
+\return True on success, otherwise the source file could not be read.
+\remarks Files which are read together with the source file (e.g. the material library of an OBJ file) are part of the key,
+so that a modified material also invalidates the cooked model file.
+\remarks The source file is only hashed, if its size or modification time differs from the cooked model file.
+Otherwise the source hash is taken from the cooked model file, so an unchanged model is not read twice.
+*/
+bool ComputeKey(
+    const std::string& filename, const IO::PathDictionary& texPathDict, const ModelReader::Flags::DataType flags, Key& key
+);
+
+/**
+Reads the specified cooked model file.
+\return Shared pointer to the geometry graph, or null if the file does not exist,
+is invalid, or does not match the specified key (i.e. it is outdated).
+\param[in] texPathDict Specifies the texture path dictionary, the model is read with. The cooked model file is also outdated,
+if one of the textures, which failed when the file was written, can be found now (see WriteModel).
+\param[out] deferredResources Optional raw-pointer to the deferred resources. If this is non-null,
+no hardware buffers are created and the textures are requested asynchronously (see ModelFileHandler::ReadModelDeferred).
+\remarks By default the hardware buffers are created for all meshes and the textures are loaded with the active texture manager.
+*/
+GeometryPtr ReadModel(
+    const std::string& cookedFilename, const Key& key, const IO::PathDictionary& texPathDict,
+    ModelFileHandler::DeferredResources* deferredResources = nullptr
+);
+
+/**
+Writes the specified geometry graph into a cooked model file.
+\param[in] failedTextures Specifies the texture filenames (as referenced by the source file), which could not be found or loaded.
+These textures are missing in the geometry graph, so the model is read from its source file again, as soon as they can be found.
+\return True on success, otherwise the graph contains geometries which can not be cooked
+(only composition, textured, simple 3D and tangent-space mesh geometries are supported) or the file could not be written.
+*/
+bool WriteModel(
+    const std::string& cookedFilename, const Key& key, const Geometry& model,
+    const std::vector<std::string>& failedTextures = {}
+);
+
+
+} // /namespace CookedModelFile
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
@@ -8,6 +8,7 @@
 #include "Scene/FileHandler/ModelFileHandler.h"
 #include "Scene/Geometry/GeometryConverter.h"
 #include "CommonModelReader.h"
+#include "CookedModelFile.h"
 #include "IO/Core/Log.h"
 
 
@@ -21,6 +22,28 @@ namespace ModelFileHandler
 {
 
 
+/*
+ * DeferredResources structure
+ */
+
+bool DeferredResources::AreTexturesLoaded() const
+{
+    for (const auto& binding : textureBindings)
+    {
+        for (const auto& texture : binding.textures)
+        {
+            if (texture->IsPending())
+                return false;
+        }
+    }
+    return true;
+}
+
+
+/*
+ * Global functions
+ */
+
 static void FinalizeModel(GeometryPtr& model, const std::string& filename, const ModelReader::Flags::DataType flags)
 {
     if (model)
@@ -41,6 +64,25 @@ FORK_EXPORT GeometryPtr ReadModel(
     IO::Log::Message(ToStr("Load model: \"") + filename + ToStr("\""));
     IO::Log::ScopedIndent indent;
 
+    /* Try to read the model from its cooked model file */
+    CookedModelFile::Key cookedKey;
+
+    const auto useCookedCache = (
+        (flags & ModelReader::Flags::CookedCache) != 0 &&
+        CookedModelFile::ComputeKey(filename, texPathDict, flags, cookedKey)
+    );
+
+    if (useCookedCache)
+    {
+        auto model = CookedModelFile::ReadModel(CookedModelFile::CookedFilename(filename), cookedKey, texPathDict);
+        if (model)
+        {
+            IO::Log::Message("Read from cooked model file");
+            model->metaData.name = filename;
+            return model;
+        }
+    }
+
     /*
     Always read models with the common model reader,
     since Assimp supports all common model file formats.
@@ -50,9 +92,94 @@ FORK_EXPORT GeometryPtr ReadModel(
 
     FinalizeModel(model, filename, flags);
 
+    /* Write final model into its cooked model file for the next time */
+    if (useCookedCache && model)
+    {
+        if (!CookedModelFile::WriteModel(CookedModelFile::CookedFilename(filename), cookedKey, *model, modelReader.FailedTextures()))
+            IO::Log::Warning("Writing cooked model file failed");
+    }
+
     return model;
 }
 
+FORK_EXPORT GeometryPtr ReadModelDeferred(
+    const std::string& filename, const IO::PathDictionary& texPathDict,
+    const ModelReader::Flags::DataType flags, DeferredResources& resources)
+{
+    IO::Log::Message(ToStr("Load model (deferred): \"") + filename + ToStr("\""));
+
+    resources.filename      = filename;
+    resources.texPathDict   = texPathDict;
+    resources.flags         = flags;
+
+    /* Try to read the model from its cooked model file */
+    if ((flags & ModelReader::Flags::CookedCache) != 0)
+    {
+        CookedModelFile::Key cookedKey;
+        if (CookedModelFile::ComputeKey(filename, texPathDict, flags, cookedKey))
+        {
+            auto model = CookedModelFile::ReadModel(CookedModelFile::CookedFilename(filename), cookedKey, texPathDict, &resources);
+            if (model)
+            {
+                resources.isCooked = true;
+                model->metaData.name = filename;
+                return model;
+            }
+            resources.textureBindings.clear();
+        }
+    }
+
+    /* Read model without GPU resources */
+    CommonModelReader modelReader;
+    modelReader.DeferResources(&resources);
+
+    auto model = modelReader.ReadModel(filename, texPathDict, flags);
+    resources.failedTextures = modelReader.FailedTextures();
+
+    return model;
+}
+
+FORK_EXPORT void FinalizeDeferredModel(GeometryPtr& model, const DeferredResources& resources)
+{
+    if (!model)
+        return;
+
+    /*
+    Append all loaded textures (failed textures are skipped, like for the immediate texture loading),
+    and store the names of the failed textures, so that the cooked model file can retry them
+    */
+    auto failedTextures = resources.failedTextures;
+
+    for (const auto& binding : resources.textureBindings)
+    {
+        for (size_t i = 0; i < binding.textures.size(); ++i)
+        {
+            const auto& texture = binding.textures[i];
+            if (texture->IsReady())
+                binding.geometry->textures.push_back(texture->Get());
+            else if (texture->IsFailed() && i < binding.textureNames.size())
+                failedTextures.push_back(binding.textureNames[i]);
+        }
+    }
+
+    /* Cooked models are already finalized */
+    if (resources.isCooked)
+        return;
+
+    FinalizeModel(model, resources.filename, resources.flags);
+
+    /* Write final model into its cooked model file for the next time */
+    if ((resources.flags & ModelReader::Flags::CookedCache) != 0)
+    {
+        CookedModelFile::Key cookedKey;
+        if ( !CookedModelFile::ComputeKey(resources.filename, resources.texPathDict, resources.flags, cookedKey) ||
+             !CookedModelFile::WriteModel(CookedModelFile::CookedFilename(resources.filename), cookedKey, *model, failedTextures) )
+        {
+            IO::Log::Warning("Writing cooked model file failed");
+        }
+    }
+}
+
 FORK_EXPORT ModelReader::AnimatedModel ReadAnimatedModel(
     const std::string& filename, const IO::PathDictionary& texPathDict, const ModelReader::Flags::DataType flags)
 {
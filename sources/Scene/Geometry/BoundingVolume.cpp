@@ -36,7 +36,7 @@ void BoundingVolume::SetupBox(const Math::AABB3f& boundingBox)
     /* Update bounding sphere */
     auto halfBoxSize = box.Size()*0.5f;
     sphere.point = box.Center();
-    sphere.radius = std::sqrt(halfBoxSize.Max());
+    sphere.radius = halfBoxSize.Length();
 }
 
 void BoundingVolume::SetupSphere(const Math::Sphere<>& boundingSphere)
@@ -0,0 +1,64 @@
+/*
+ * Flat skeleton file
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Scene/Geometry/FlatSkeleton.h"
+
+#include <algorithm>
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+FlatSkeleton::FlatSkeleton(const Skeleton& skeleton)
+{
+    const auto numJoints = skeleton.rootJoint.HierarchySize();
+
+    joints_.reserve(numJoints);
+    parents_.reserve(numJoints);
+    originMatrices_.reserve(numJoints);
+    bindPose_.reserve(numJoints);
+
+    AddJoint(skeleton.rootJoint, FlatSkeleton::invalidIndex);
+}
+
+size_t FlatSkeleton::FindJoint(const Skeleton::Joint* joint) const
+{
+    auto it = std::find(joints_.begin(), joints_.end(), joint);
+    return it != joints_.end() ? static_cast<size_t>(it - joints_.begin()) : FlatSkeleton::invalidIndex;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void FlatSkeleton::AddJoint(const Skeleton::Joint& joint, size_t parent)
+{
+    /* Store this joint before its children (pre-order DFS) */
+    const auto index = joints_.size();
+
+    joints_.push_back(&joint);
+    parents_.push_back(parent);
+    originMatrices_.push_back(joint.GetOriginMatrix());
+    bindPose_.push_back(joint.transform);
+
+    for (const auto& child : joint.GetChildren())
+        AddJoint(*child, index);
+}
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+
+// ========================
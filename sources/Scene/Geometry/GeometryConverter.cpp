@@ -7,15 +7,28 @@
 
 #include "Scene/Geometry/GeometryConverter.h"
 #include "Scene/Geometry/Node/CompositionGeometry.h"
+#include "Scene/Geometry/Node/TexturedGeometry.h"
+#include "Scene/Geometry/Node/LODGeometry.h"
+#include "Scene/Geometry/Node/Simple3DMeshGeometry.h"
+#include "Scene/Geometry/Node/TangentSpaceMeshGeometry.h"
+#include "Scene/Geometry/Node/CommonMeshGeometry.h"
 #include "Core/Exception/IndexOutOfBoundsException.h"
 #include "Core/Exception/InvalidArgumentException.h"
+#include "Core/Exception/NullPointerException.h"
 #include "Math/Common/CoordinateSpace.h"
 #include "Math/Geometry/Triangle.h"
+#include "Core/Jobs/JobSystem.h"
 
 #include "Optimizer/GeometryTextureOptimizer.h"
 #include "Optimizer/GeometryCleanUpOptimizer.h"
+#include "Optimizer/GeometryVertexCacheOptimizer.h"
 
 #include <algorithm>
+#include <unordered_map>
+#include <cstdint>
+#include <cstring>
+#include <queue>
+#include <functional>
 
 
 namespace Fork
@@ -55,6 +68,33 @@ struct VectorRef
 };
 
 
+/**
+Vertex adjacency for smooth normal generation. All vertices with (nearly) the same position are welded into one group,
+and each group refers to all triangle corners which use one of its vertices.
+*/
+struct WeldedAdjacency
+{
+    //! Returns the range [begin, end) of corners (within the 'corners' list) which are adjacent to the specified vertex.
+    void GetCorners(size_t vertex, size_t& begin, size_t& end) const
+    {
+        const auto group = groups[vertex];
+        begin   = offsets[group];
+        end     = offsets[group + 1];
+    }
+
+    std::vector<unsigned int>   groups;     //!< Group index (i.e. index of the representative vertex) for each vertex.
+    std::vector<unsigned int>   offsets;    //!< Offsets into the corner list for each group (plus one end offset).
+    std::vector<unsigned int>   corners;    //!< Triangle corners (3 * triangle + corner) sorted by groups.
+};
+
+//! Face data of a triangle list for smooth normal generation.
+struct FaceData
+{
+    std::vector<Math::Vector3f> normals;    //!< Normalized face normal for each triangle.
+    std::vector<float>          angles;     //!< Angle (in radians) of each triangle corner.
+};
+
+
 /*
  * Global functions
  */
@@ -68,6 +108,196 @@ static unsigned int FetchIndexFromBuffer(
     return vertIndex;
 };
 
+static void ValidateIndexBuffer(const CommonIndexBuffer& indexBuffer, size_t numVertices, const char* functionName)
+{
+    for (size_t i = 0, n = indexBuffer.size() / 3 * 3; i < n; ++i)
+        FetchIndexFromBuffer(indexBuffer, numVertices, functionName, i);
+}
+
+/**
+Welds all vertices whose positions are closer than a small epsilon (relative to the mesh extent),
+with a spatial hash grid. The cell size is much larger than the epsilon,
+so that usually only the cell of a vertex itself must be searched.
+*/
+static std::vector<unsigned int> WeldVertexPositions(Video::AttributeConstIterator coordIterator)
+{
+    const auto numVertices = coordIterator.GetCount();
+
+    std::vector<unsigned int> groups(numVertices);
+
+    if (numVertices == 0)
+        return groups;
+
+    /* Determine weld epsilon and cell size */
+    Math::AABB3f boundingBox;
+    for (size_t i = 0; i < numVertices; ++i)
+        boundingBox.InsertPoint(coordIterator.Get<Math::Point3f>(i));
+
+    const auto extent = boundingBox.Size();
+    const auto epsilon = std::max(std::max(extent.width, extent.height), std::max(extent.depth, 1.0f)) * 1e-6f;
+    const auto epsilonSq = epsilon*epsilon;
+    const auto cellSize = epsilon * 16.0f;
+    const auto invCellSize = 1.0f / cellSize;
+
+    auto CellKey = [](std::int64_t x, std::int64_t y, std::int64_t z) -> std::uint64_t
+    {
+        return
+            ((static_cast<std::uint64_t>(x) & 0x1fffff)      ) |
+            ((static_cast<std::uint64_t>(y) & 0x1fffff) << 21) |
+            ((static_cast<std::uint64_t>(z) & 0x1fffff) << 42);
+    };
+
+    /* Each cell refers to a linked list of representative vertices */
+    static const unsigned int invalidIndex = ~0u;
+
+    std::unordered_map<std::uint64_t, unsigned int> cellHeads;
+    cellHeads.reserve(numVertices);
+
+    std::vector<unsigned int> next(numVertices, invalidIndex);
+
+    for (size_t i = 0; i < numVertices; ++i)
+    {
+        const auto& coord = coordIterator.Get<Math::Vector3f>(i);
+
+        /* Determine the cells which must be searched (only the neighbor cells close to the vertex) */
+        std::int64_t cell[3], cellMin[3], cellMax[3];
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const auto pos = coord[axis] * invCellSize;
+            const auto base = std::floor(pos);
+            const auto frac = (pos - base) * cellSize;
+
+            cell[axis]      = static_cast<std::int64_t>(base);
+            cellMin[axis]   = (frac < epsilon ? cell[axis] - 1 : cell[axis]);
+            cellMax[axis]   = (frac > cellSize - epsilon ? cell[axis] + 1 : cell[axis]);
+        }
+
+        /* Search representative vertex within the epsilon */
+        auto group = invalidIndex;
+
+        for (auto z = cellMin[2]; z <= cellMax[2] && group == invalidIndex; ++z)
+        {
+            for (auto y = cellMin[1]; y <= cellMax[1] && group == invalidIndex; ++y)
+            {
+                for (auto x = cellMin[0]; x <= cellMax[0] && group == invalidIndex; ++x)
+                {
+                    auto it = cellHeads.find(CellKey(x, y, z));
+                    if (it == cellHeads.end())
+                        continue;
+
+                    for (auto rep = it->second; rep != invalidIndex; rep = next[rep])
+                    {
+                        if (Math::DistanceSq(coord, coordIterator.Get<Math::Vector3f>(rep)) <= epsilonSq)
+                        {
+                            group = rep;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (group == invalidIndex)
+        {
+            /* Insert vertex as new representative into its cell */
+            auto& head = cellHeads.insert({ CellKey(cell[0], cell[1], cell[2]), invalidIndex }).first->second;
+            next[i] = head;
+            head = static_cast<unsigned int>(i);
+            group = static_cast<unsigned int>(i);
+        }
+
+        groups[i] = group;
+    }
+
+    return groups;
+}
+
+//! Builds the welded vertex adjacency (in a compressed sparse row layout).
+static void BuildWeldedAdjacency(
+    WeldedAdjacency& adjacency, Video::AttributeConstIterator coordIterator, const CommonIndexBuffer& indexBuffer)
+{
+    const auto numVertices = coordIterator.GetCount();
+    const auto numCorners = indexBuffer.size() / 3 * 3;
+
+    adjacency.groups = WeldVertexPositions(coordIterator);
+
+    /* Count corners per group */
+    adjacency.offsets.assign(numVertices + 1, 0);
+
+    for (size_t i = 0; i < numCorners; ++i)
+        ++adjacency.offsets[adjacency.groups[indexBuffer[i]] + 1];
+
+    for (size_t i = 0; i < numVertices; ++i)
+        adjacency.offsets[i + 1] += adjacency.offsets[i];
+
+    /* Fill corner list */
+    auto fillOffsets = adjacency.offsets;
+    adjacency.corners.resize(numCorners);
+
+    for (size_t i = 0; i < numCorners; ++i)
+        adjacency.corners[fillOffsets[adjacency.groups[indexBuffer[i]]]++] = static_cast<unsigned int>(i);
+}
+
+//! Computes the face normals and corner angles of all triangles in parallel.
+static void ComputeFaceData(
+    FaceData& faceData, Video::AttributeConstIterator coordIterator, const CommonIndexBuffer& indexBuffer)
+{
+    const auto numTriangles = indexBuffer.size() / 3;
+
+    faceData.normals.resize(numTriangles);
+    faceData.angles.resize(numTriangles * 3);
+
+    auto CornerAngle = [](const Math::Vector3f& a, const Math::Vector3f& b) -> float
+    {
+        const auto lenSq = a.LengthSq() * b.LengthSq();
+        if (lenSq <= 0.0f)
+            return 0.0f;
+        return std::acos(std::max(-1.0f, std::min(1.0f, Math::Dot(a, b) / std::sqrt(lenSq))));
+    };
+
+    Jobs::JobSystem::Instance()->ParallelForRange(
+        0, numTriangles,
+        [&](size_t begin, size_t end)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                const auto& coord0 = coordIterator.Get<Math::Vector3f>(indexBuffer[i*3    ]);
+                const auto& coord1 = coordIterator.Get<Math::Vector3f>(indexBuffer[i*3 + 1]);
+                const auto& coord2 = coordIterator.Get<Math::Vector3f>(indexBuffer[i*3 + 2]);
+
+                /* Compute face normal (degenerated triangles get a zero normal) */
+                auto normal = Math::Cross(coord1 - coord0, coord2 - coord0);
+                if (normal.LengthSq() > 0.0f)
+                    Normalize(normal);
+                faceData.normals[i] = normal;
+
+                /* Compute corner angles */
+                faceData.angles[i*3    ] = CornerAngle(coord1 - coord0, coord2 - coord0);
+                faceData.angles[i*3 + 1] = CornerAngle(coord2 - coord1, coord0 - coord1);
+                faceData.angles[i*3 + 2] = CornerAngle(coord0 - coord2, coord1 - coord2);
+            }
+        }
+    );
+}
+
+/**
+Returns true if the specified face is smoothed with the faces of the specified vertex,
+i.e. if the angle between the face normal and the normal of any face which uses the vertex is below the threshold.
+*/
+static bool IsFaceSmoothed(
+    const WeldedAdjacency& adjacency, const FaceData& faceData, const CommonIndexBuffer& indexBuffer,
+    size_t vertex, size_t begin, size_t end, const Math::Vector3f& faceNormal, float cosThreshold)
+{
+    for (auto i = begin; i < end; ++i)
+    {
+        const auto corner = adjacency.corners[i];
+        if (indexBuffer[corner] == vertex && Math::Dot(faceData.normals[corner / 3], faceNormal) >= cosThreshold)
+            return true;
+    }
+    return false;
+}
+
 FORK_EXPORT void GenerateNormalsFlat(
     Video::AttributeConstIterator coordIterator,
     Video::AttributeIterator normalIterator,
@@ -127,7 +357,60 @@ FORK_EXPORT void GenerateNormalsSmooth(
     const CommonIndexBuffer& indexBuffer,
     float angleThreshold)
 {
-    //todo...
+    /* Get number of vertices */
+    if (coordIterator.GetCount() != normalIterator.GetCount())
+    {
+        throw InvalidArgumentException(
+            __FUNCTION__, "coordIterator/normalIterator",
+            "Number of vertex coordinates and normals do not match"
+        );
+    }
+
+    const auto numVertices = coordIterator.GetCount();
+
+    ValidateIndexBuffer(indexBuffer, numVertices, __FUNCTION__);
+
+    /* Build welded vertex adjacency and face data */
+    WeldedAdjacency adjacency;
+    BuildWeldedAdjacency(adjacency, coordIterator, indexBuffer);
+
+    FaceData faceData;
+    ComputeFaceData(faceData, coordIterator, indexBuffer);
+
+    const auto useThreshold = (angleThreshold >= 0.0f);
+    const auto cosThreshold = std::cos(angleThreshold);
+
+    /* Average angle-weighted face normals for all vertices in parallel */
+    Jobs::JobSystem::Instance()->ParallelForRange(
+        0, numVertices,
+        [&](size_t first, size_t last)
+        {
+            for (auto v = first; v < last; ++v)
+            {
+                size_t begin = 0, end = 0;
+                adjacency.GetCorners(v, begin, end);
+
+                Math::Vector3f normal;
+                bool isReferenced = false;
+
+                for (auto i = begin; i < end; ++i)
+                {
+                    const auto corner = adjacency.corners[i];
+                    const auto& faceNormal = faceData.normals[corner / 3];
+
+                    if (indexBuffer[corner] == v)
+                        isReferenced = true;
+
+                    if (!useThreshold || IsFaceSmoothed(adjacency, faceData, indexBuffer, v, begin, end, faceNormal, cosThreshold))
+                        normal += faceNormal * faceData.angles[corner];
+                }
+
+                /* Only overwrite the normals of vertices which are used by any triangle themselves (not only by their welded vertices) */
+                if (isReferenced && normal.LengthSq() > 0.0f)
+                    normalIterator.Get<Math::Vector3f>(v) = normal.Normalize();
+            }
+        }
+    );
 }
 
 FORK_EXPORT void GenerateTangentSpaceFlat(
@@ -229,7 +512,1541 @@ FORK_EXPORT void GenerateTangentSpaceSmooth(
     float angleThreshold,
     bool ignoreNormals)
 {
-    //todo ...
+    /* Get number of vertices */
+    if ( coordIterator.GetCount() != texCoordIterator .GetCount() ||
+         coordIterator.GetCount() != tangentIterator  .GetCount() ||
+         coordIterator.GetCount() != bitangentIterator.GetCount() ||
+         coordIterator.GetCount() != normalIterator   .GetCount() )
+    {
+        throw InvalidArgumentException(
+            __FUNCTION__, "<Some Attribute Iterators>",
+            "Number of vertices in attribute iterators do not match"
+        );
+    }
+
+    const auto numVertices = coordIterator.GetCount();
+    const auto numTriangles = indexBuffer.size() / 3;
+
+    ValidateIndexBuffer(indexBuffer, numVertices, __FUNCTION__);
+
+    /* Build welded vertex adjacency and face data */
+    WeldedAdjacency adjacency;
+    BuildWeldedAdjacency(adjacency, coordIterator, indexBuffer);
+
+    FaceData faceData;
+    ComputeFaceData(faceData, coordIterator, indexBuffer);
+
+    /* Compute tangent space of all triangles in parallel */
+    std::vector<Math::Vector3f> faceTangents(numTriangles), faceBitangents(numTriangles);
+
+    Jobs::JobSystem::Instance()->ParallelForRange(
+        0, numTriangles,
+        [&](size_t begin, size_t end)
+        {
+            Math::Triangle3f triangleCoords;
+            Math::Triangle2f triangleTexCoords;
+
+            for (auto i = begin; i < end; ++i)
+            {
+                triangleCoords.a    = coordIterator     .Get<Math::Vector3f>(indexBuffer[i*3    ]);
+                triangleTexCoords.a = texCoordIterator  .Get<Math::Vector2f>(indexBuffer[i*3    ]);
+
+                triangleCoords.b    = coordIterator     .Get<Math::Vector3f>(indexBuffer[i*3 + 1]);
+                triangleTexCoords.b = texCoordIterator  .Get<Math::Vector2f>(indexBuffer[i*3 + 1]);
+
+                triangleCoords.c    = coordIterator     .Get<Math::Vector3f>(indexBuffer[i*3 + 2]);
+                triangleTexCoords.c = texCoordIterator  .Get<Math::Vector2f>(indexBuffer[i*3 + 2]);
+
+                auto tangentSpace = Math::ComputeTangentSpace(triangleCoords, triangleTexCoords);
+
+                faceTangents    [i] = tangentSpace.GetColumn(0);
+                faceBitangents  [i] = tangentSpace.GetColumn(1);
+            }
+        }
+    );
+
+    const auto useThreshold = (angleThreshold >= 0.0f);
+    const auto cosThreshold = std::cos(angleThreshold);
+
+    /* Average angle-weighted tangent spaces for all vertices in parallel */
+    Jobs::JobSystem::Instance()->ParallelForRange(
+        0, numVertices,
+        [&](size_t first, size_t last)
+        {
+            for (auto v = first; v < last; ++v)
+            {
+                size_t begin = 0, end = 0;
+                adjacency.GetCorners(v, begin, end);
+
+                const auto& texCoord = texCoordIterator.Get<Math::Vector2f>(v);
+
+                Math::Vector3f normal, tangent, bitangent;
+
+                for (auto i = begin; i < end; ++i)
+                {
+                    const auto corner = adjacency.corners[i];
+                    const auto face = corner / 3;
+                    const auto& faceNormal = faceData.normals[face];
+
+                    if (useThreshold && !IsFaceSmoothed(adjacency, faceData, indexBuffer, v, begin, end, faceNormal, cosThreshold))
+                        continue;
+
+                    const auto weight = faceData.angles[corner];
+
+                    normal += faceNormal * weight;
+
+                    /* Tangents are only averaged over faces with the same texture coordinates (not across UV seams) */
+                    const auto& faceTexCoord = texCoordIterator.Get<Math::Vector2f>(indexBuffer[corner]);
+                    if (faceTexCoord.x == texCoord.x && faceTexCoord.y == texCoord.y)
+                    {
+                        tangent     += faceTangents  [face] * weight;
+                        bitangent   += faceBitangents[face] * weight;
+                    }
+                }
+
+                if (normal.LengthSq() <= 0.0f)
+                    continue;
+
+                /* Store normal if enabled, otherwise use the previous normal */
+                if (!ignoreNormals)
+                {
+                    normal.Normalize();
+                    normalIterator.Get<Math::Vector3f>(v) = normal;
+                }
+                else
+                    normal = normalIterator.Get<Math::Vector3f>(v);
+
+                /* Orthogonalize tangent to the normal (Gram-Schmidt) */
+                tangent -= normal * Math::Dot(normal, tangent);
+
+                if (tangent.LengthSq() > 0.0f)
+                    tangentIterator.Get<Math::Vector3f>(v) = tangent.Normalize();
+                if (bitangent.LengthSq() > 0.0f)
+                    bitangentIterator.Get<Math::Vector3f>(v) = bitangent.Normalize();
+            }
+        }
+    );
+}
+
+//! Byte range of a vertex attribute.
+struct AttributeRange
+{
+    size_t offset;
+    size_t size;
+};
+
+/**
+Returns the byte ranges of all vertex format attributes (adjacent attributes are merged),
+which are compared when the vertices are welded.
+*/
+static std::vector<AttributeRange> VertexAttributeRanges(const Video::VertexFormat& vertexFormat, size_t vertexStride)
+{
+    std::vector<AttributeRange> ranges;
+
+    for (const auto& attrib : vertexFormat.GetAttributes())
+    {
+        const AttributeRange range { attrib.GetOffset(), attrib.Size() };
+
+        if (range.offset + range.size > vertexStride)
+            throw InvalidArgumentException(__FUNCTION__, "vertexFormat", "Vertex format does not fit into the vertex stride");
+
+        if (!ranges.empty() && ranges.back().offset + ranges.back().size == range.offset)
+            ranges.back().size += range.size;
+        else
+            ranges.push_back(range);
+    }
+
+    return ranges;
+}
+
+FORK_EXPORT size_t WeldVertices(
+    const Video::VertexFormat& vertexFormat,
+    void* vertices, size_t numVertices, size_t vertexStride,
+    CommonIndexBuffer& indexBuffer)
+{
+    /* Generate index buffer for non-indexed vertices */
+    if (indexBuffer.empty())
+    {
+        indexBuffer.resize(numVertices);
+        for (size_t i = 0; i < numVertices; ++i)
+            indexBuffer[i] = static_cast<unsigned int>(i);
+    }
+    else
+    {
+        for (size_t i = 0, n = indexBuffer.size(); i < n; ++i)
+            FetchIndexFromBuffer(indexBuffer, numVertices, __FUNCTION__, i);
+    }
+
+    const auto ranges = VertexAttributeRanges(vertexFormat, vertexStride);
+    auto data = reinterpret_cast<char*>(vertices);
+
+    auto HashVertex = [&](size_t vertexIndex) -> std::uint64_t
+    {
+        /* FNV-1a over all attribute bytes */
+        std::uint64_t hash = 14695981039346656037ull;
+        const auto vertex = data + vertexIndex*vertexStride;
+        for (const auto& range : ranges)
+        {
+            for (size_t i = 0; i < range.size; ++i)
+            {
+                hash ^= static_cast<unsigned char>(vertex[range.offset + i]);
+                hash *= 1099511628211ull;
+            }
+        }
+        return hash;
+    };
+
+    auto CompareVertices = [&](size_t lhsIndex, size_t rhsIndex) -> bool
+    {
+        const auto lhs = data + lhsIndex*vertexStride;
+        const auto rhs = data + rhsIndex*vertexStride;
+        for (const auto& range : ranges)
+        {
+            if (std::memcmp(lhs + range.offset, rhs + range.offset, range.size) != 0)
+                return false;
+        }
+        return true;
+    };
+
+    /* Open addressing hash table which stores the indices of the unique (already compacted) vertices */
+    const unsigned int invalidIndex = ~0u;
+
+    size_t tableSize = 16;
+    while (tableSize < numVertices*2)
+        tableSize <<= 1;
+
+    std::vector<unsigned int> table(tableSize, invalidIndex);
+    std::vector<unsigned int> remap(numVertices);
+
+    size_t numUniqueVertices = 0;
+
+    for (size_t i = 0; i < numVertices; ++i)
+    {
+        auto slot = static_cast<size_t>(HashVertex(i)) & (tableSize - 1);
+
+        while (table[slot] != invalidIndex && !CompareVertices(table[slot], i))
+            slot = (slot + 1) & (tableSize - 1);
+
+        if (table[slot] == invalidIndex)
+        {
+            /*
+            Move vertex to the end of the unique vertices.
+            This is always in front of (or equal to) the current vertex, so no unprocessed vertex is overwritten.
+            */
+            if (numUniqueVertices != i)
+                std::memcpy(data + numUniqueVertices*vertexStride, data + i*vertexStride, vertexStride);
+            table[slot] = static_cast<unsigned int>(numUniqueVertices++);
+        }
+
+        remap[i] = table[slot];
+    }
+
+    /* Remap index buffer */
+    for (auto& index : indexBuffer)
+        index = remap[index];
+
+    return numUniqueVertices;
+}
+
+/*
+Vertex scoring for Forsyth's algorithm (see "Linear-Speed Vertex Cache Optimisation", Tom Forsyth, 2006).
+*/
+static const size_t forsythCacheSize        = 32;
+static const size_t forsythMaxValence       = 32;
+static const float  forsythLastTriScore     = 0.75f;
+static const float  forsythCacheDecayPower  = 1.5f;
+static const float  forsythValenceScale     = 2.0f;
+static const float  forsythValencePower     = 0.5f;
+
+//! Score tables, to avoid the "std::pow" calls during optimization.
+struct ForsythScoreTables
+{
+    ForsythScoreTables()
+    {
+        for (size_t i = 0; i < forsythCacheSize; ++i)
+        {
+            if (i < 3)
+                cacheScore[i] = forsythLastTriScore;
+            else
+            {
+                const auto scaler = 1.0f / (forsythCacheSize - 3);
+                cacheScore[i] = std::pow(1.0f - (i - 3)*scaler, forsythCacheDecayPower);
+            }
+        }
+
+        valenceScore[0] = 0.0f;
+        for (size_t i = 1; i <= forsythMaxValence; ++i)
+            valenceScore[i] = forsythValenceScale * std::pow(static_cast<float>(i), -forsythValencePower);
+    }
+
+    float VertexScore(int cachePosition, unsigned int numActiveTriangles) const
+    {
+        /* Vertices without any remaining triangles are never used again */
+        if (numActiveTriangles == 0)
+            return -1.0f;
+
+        auto score = (cachePosition >= 0 ? cacheScore[cachePosition] : 0.0f);
+
+        /* Boost vertices with only a few remaining triangles */
+        if (numActiveTriangles <= forsythMaxValence)
+            score += valenceScore[numActiveTriangles];
+        else
+            score += forsythValenceScale * std::pow(static_cast<float>(numActiveTriangles), -forsythValencePower);
+
+        return score;
+    }
+
+    float cacheScore[forsythCacheSize];
+    float valenceScore[forsythMaxValence + 1];
+};
+
+static const ForsythScoreTables forsythScoreTables;
+
+FORK_EXPORT void OptimizeVertexCache(CommonIndexBuffer& indexBuffer, size_t numVertices)
+{
+    const auto numTriangles = indexBuffer.size() / 3;
+    if (numTriangles == 0)
+        return;
+
+    ValidateIndexBuffer(indexBuffer, numVertices, __FUNCTION__);
+
+    /* Build vertex-triangle adjacency (compressed rows) */
+    std::vector<unsigned int> numActiveTriangles(numVertices, 0);
+
+    for (size_t i = 0; i < numTriangles*3; ++i)
+        ++numActiveTriangles[indexBuffer[i]];
+
+    std::vector<unsigned int> offsets(numVertices + 1, 0);
+    for (size_t v = 0; v < numVertices; ++v)
+        offsets[v + 1] = offsets[v] + numActiveTriangles[v];
+
+    std::vector<unsigned int> adjacentTriangles(offsets.back());
+    {
+        std::vector<unsigned int> counters(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < numTriangles*3; ++i)
+            adjacentTriangles[counters[indexBuffer[i]]++] = static_cast<unsigned int>(i / 3);
+    }
+
+    /* Initialize scores */
+    std::vector<int> cachePositions(numVertices, -1);
+    std::vector<float> vertexScores(numVertices);
+
+    for (size_t v = 0; v < numVertices; ++v)
+        vertexScores[v] = forsythScoreTables.VertexScore(-1, numActiveTriangles[v]);
+
+    std::vector<bool> triangleAdded(numTriangles, false);
+
+    /* Emit triangles greedily */
+    CommonIndexBuffer optimizedIndices;
+    optimizedIndices.reserve(numTriangles*3);
+
+    std::vector<unsigned int> cache, nextCache;
+    cache.reserve(forsythCacheSize + 3);
+    nextCache.reserve(forsythCacheSize + 3);
+
+    const auto invalidTriangle = ~size_t(0);
+
+    size_t nextUnaddedTriangle = 0;
+    auto bestTriangle = invalidTriangle;
+
+    for (size_t n = 0; n < numTriangles; ++n)
+    {
+        /* If no candidate was found in the cache, continue with the next unused triangle */
+        if (bestTriangle == invalidTriangle)
+        {
+            while (triangleAdded[nextUnaddedTriangle])
+                ++nextUnaddedTriangle;
+            bestTriangle = nextUnaddedTriangle;
+        }
+
+        const unsigned int* tri = &indexBuffer[bestTriangle*3];
+
+        optimizedIndices.insert(optimizedIndices.end(), tri, tri + 3);
+        triangleAdded[bestTriangle] = true;
+
+        /* Remove triangle from the active triangle lists of its vertices */
+        for (int i = 0; i < 3; ++i)
+        {
+            const auto v = tri[i];
+            auto first = adjacentTriangles.begin() + offsets[v];
+            auto last = first + numActiveTriangles[v];
+            auto it = std::find(first, last, static_cast<unsigned int>(bestTriangle));
+            if (it != last)
+            {
+                std::swap(*it, *(last - 1));
+                --numActiveTriangles[v];
+            }
+        }
+
+        /* Update LRU cache: triangle vertices at front, followed by the previous entries */
+        nextCache.assign(tri, tri + 3);
+        for (auto v : cache)
+        {
+            if (v != tri[0] && v != tri[1] && v != tri[2])
+                nextCache.push_back(v);
+        }
+        std::swap(cache, nextCache);
+
+        /* Update vertex scores (including the vertices which have been pushed out of the cache) */
+        for (size_t i = 0; i < cache.size(); ++i)
+        {
+            const auto v = cache[i];
+            cachePositions[v] = (i < forsythCacheSize ? static_cast<int>(i) : -1);
+            vertexScores[v] = forsythScoreTables.VertexScore(cachePositions[v], numActiveTriangles[v]);
+        }
+
+        /* Update triangle scores of all cached vertices and find the best candidate */
+        bestTriangle = invalidTriangle;
+        auto bestScore = -1.0f;
+
+        for (auto v : cache)
+        {
+            for (auto i = offsets[v], end = offsets[v] + numActiveTriangles[v]; i < end; ++i)
+            {
+                const auto t = adjacentTriangles[i];
+                const auto score =
+                    vertexScores[indexBuffer[t*3    ]] +
+                    vertexScores[indexBuffer[t*3 + 1]] +
+                    vertexScores[indexBuffer[t*3 + 2]];
+
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    bestTriangle = t;
+                }
+            }
+        }
+
+        if (cache.size() > forsythCacheSize)
+            cache.resize(forsythCacheSize);
+    }
+
+    /* Keep remaining indices of an incomplete triangle */
+    optimizedIndices.insert(optimizedIndices.end(), indexBuffer.begin() + numTriangles*3, indexBuffer.end());
+
+    indexBuffer = std::move(optimizedIndices);
+}
+
+FORK_EXPORT size_t OptimizeVertexFetch(
+    void* vertices, size_t numVertices, size_t vertexStride, CommonIndexBuffer& indexBuffer)
+{
+    /* Assign new vertex indices in the order of their first occurrence */
+    const unsigned int invalidIndex = ~0u;
+    std::vector<unsigned int> remap(numVertices, invalidIndex);
+
+    unsigned int numReferencedVertices = 0;
+
+    for (size_t i = 0, n = indexBuffer.size(); i < n; ++i)
+    {
+        auto& index = indexBuffer[i];
+        const auto v = FetchIndexFromBuffer(indexBuffer, numVertices, __FUNCTION__, i);
+
+        if (remap[v] == invalidIndex)
+            remap[v] = numReferencedVertices++;
+
+        index = remap[v];
+    }
+
+    /* Reorder vertices */
+    auto data = reinterpret_cast<char*>(vertices);
+    const std::vector<char> sourceData(data, data + numVertices*vertexStride);
+
+    for (size_t v = 0; v < numVertices; ++v)
+    {
+        if (remap[v] != invalidIndex)
+            std::memcpy(data + remap[v]*vertexStride, sourceData.data() + v*vertexStride, vertexStride);
+    }
+
+    return numReferencedVertices;
+}
+
+FORK_EXPORT VertexCacheStatistics AnalyzeVertexCache(
+    const CommonIndexBuffer& indexBuffer, size_t numVertices, size_t cacheSize)
+{
+    VertexCacheStatistics stats;
+
+    stats.numTriangles  = indexBuffer.size() / 3;
+    stats.numVertices   = numVertices;
+
+    /*
+    Simulate FIFO cache with time stamps: a vertex is inside the cache,
+    if less than 'cacheSize' vertices have been pushed into the cache since this vertex was pushed.
+    */
+    std::vector<size_t> timeStamps(numVertices, 0);
+    size_t time = cacheSize + 1;
+
+    for (size_t i = 0, n = stats.numTriangles*3; i < n; ++i)
+    {
+        const auto v = FetchIndexFromBuffer(indexBuffer, numVertices, __FUNCTION__, i);
+
+        if (time - timeStamps[v] > cacheSize)
+        {
+            timeStamps[v] = time++;
+            ++stats.numTransformedVertices;
+        }
+    }
+
+    return stats;
+}
+
+/* --- Mesh clustering --- */
+
+//! Computes the bounding box and normal cone of the specified cluster.
+static void ComputeClusterBounds(
+    MeshGeometryAtlas::Partition& cluster, Video::AttributeConstIterator coordIterator,
+    const CommonIndexBuffer& indexBuffer, const std::vector<Math::Vector3f>& faceNormals)
+{
+    const auto firstTriangle = cluster.firstIndex / 3;
+    const auto numTriangles = cluster.numVertices / 3;
+
+    /* Compute bounding box and average normal */
+    Math::Vector3f coneAxis;
+
+    for (size_t i = 0; i < numTriangles; ++i)
+    {
+        const auto triangle = firstTriangle + i;
+
+        for (size_t j = 0; j < 3; ++j)
+            cluster.box.InsertPoint(coordIterator.Get<Math::Point3f>(indexBuffer[triangle*3 + j]));
+
+        coneAxis += faceNormals[triangle];
+    }
+
+    if (coneAxis.LengthSq() <= Math::epsilon)
+        return;
+
+    Normalize(coneAxis);
+
+    /* Determine the largest deviation of the face normals (degenerated triangles are ignored) */
+    auto minDot = 1.0f;
+
+    for (size_t i = 0; i < numTriangles; ++i)
+    {
+        const auto& normal = faceNormals[firstTriangle + i];
+        if (normal.LengthSq() > 0.0f)
+            minDot = std::min(minDot, Math::Dot(normal, coneAxis));
+    }
+
+    /* Clusters with a cone angle of more than ~84 degrees are not worth to be back-face culled */
+    if (minDot <= 0.1f)
+        return;
+
+    /* Move cone apex along the axis behind all triangle planes */
+    const auto center = cluster.box.Center();
+    auto maxOffset = 0.0f;
+
+    for (size_t i = 0; i < numTriangles; ++i)
+    {
+        const auto triangle = firstTriangle + i;
+        const auto& normal = faceNormals[triangle];
+
+        if (normal.LengthSq() > 0.0f)
+        {
+            const auto& coord = coordIterator.Get<Math::Point3f>(indexBuffer[triangle*3]);
+            maxOffset = std::max(maxOffset, Math::Dot(center - coord, normal) / Math::Dot(coneAxis, normal));
+        }
+    }
+
+    cluster.coneApex    = center - coneAxis * maxOffset;
+    cluster.coneAxis    = coneAxis;
+    cluster.coneCutoff  = std::sqrt(1.0f - minDot*minDot);
+}
+
+FORK_EXPORT void GenerateMeshClusters(
+    Video::AttributeConstIterator coordIterator,
+    CommonIndexBuffer& indexBuffer,
+    std::vector<MeshGeometryAtlas::Partition>& clusters,
+    size_t maxTrianglesPerCluster)
+{
+    if (maxTrianglesPerCluster == 0)
+        throw InvalidArgumentException(__FUNCTION__, "maxTrianglesPerCluster", "Maximal number of triangles per cluster must not be 0");
+
+    const auto numVertices = coordIterator.GetCount();
+    const auto numTriangles = indexBuffer.size() / 3;
+
+    ValidateIndexBuffer(indexBuffer, numVertices, __FUNCTION__);
+
+    clusters.clear();
+
+    if (numTriangles == 0)
+        return;
+
+    /* Build welded adjacency and face data */
+    WeldedAdjacency adjacency;
+    BuildWeldedAdjacency(adjacency, coordIterator, indexBuffer);
+
+    FaceData faceData;
+    ComputeFaceData(faceData, coordIterator, indexBuffer);
+
+    std::vector<Math::Point3f> faceCenters(numTriangles);
+
+    for (size_t i = 0; i < numTriangles; ++i)
+    {
+        faceCenters[i] = (
+            coordIterator.Get<Math::Point3f>(indexBuffer[i*3    ]) +
+            coordIterator.Get<Math::Point3f>(indexBuffer[i*3 + 1]) +
+            coordIterator.Get<Math::Point3f>(indexBuffer[i*3 + 2])
+        ) / 3.0f;
+    }
+
+    /* Grow clusters greedily over adjacent triangles */
+    static const unsigned int invalidIndex = ~0u;
+
+    std::vector<bool> isEmitted(numTriangles, false);
+    std::vector<unsigned int> candidateStamps(numTriangles, invalidIndex);
+    std::vector<unsigned int> groupStamps(numVertices, invalidIndex);
+    std::vector<unsigned int> candidates;
+
+    std::vector<unsigned int> triangleOrder;
+    triangleOrder.reserve(numTriangles);
+
+    CommonIndexBuffer clusteredIndices;
+    clusteredIndices.reserve(indexBuffer.size());
+
+    size_t seedTriangle = 0;
+
+    for (size_t numEmitted = 0; numEmitted < numTriangles;)
+    {
+        const auto clusterIndex = static_cast<unsigned int>(clusters.size());
+
+        MeshGeometryAtlas::Partition cluster;
+        cluster.firstIndex = static_cast<unsigned int>(clusteredIndices.size());
+
+        Math::Point3f centerSum;
+        size_t numClusterTriangles = 0;
+
+        candidates.clear();
+
+        while (numClusterTriangles < maxTrianglesPerCluster && numEmitted < numTriangles)
+        {
+            /* Find best candidate: fewest new vertices first, then closest to the cluster center */
+            const auto center = (numClusterTriangles > 0 ? centerSum / static_cast<float>(numClusterTriangles) : Math::Point3f());
+
+            auto bestTriangle = invalidIndex;
+            auto bestNewVertices = 4u;
+            auto bestDistance = 0.0f;
+
+            for (size_t i = 0; i < candidates.size();)
+            {
+                const auto triangle = candidates[i];
+
+                if (isEmitted[triangle])
+                {
+                    /* Remove emitted triangle from candidate list */
+                    candidates[i] = candidates.back();
+                    candidates.pop_back();
+                    continue;
+                }
+
+                auto numNewVertices = 0u;
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    if (groupStamps[adjacency.groups[indexBuffer[triangle*3 + j]]] != clusterIndex)
+                        ++numNewVertices;
+                }
+
+                const auto distance = Math::DistanceSq(faceCenters[triangle], center);
+
+                if (numNewVertices < bestNewVertices || (numNewVertices == bestNewVertices && distance < bestDistance))
+                {
+                    bestTriangle    = triangle;
+                    bestNewVertices = numNewVertices;
+                    bestDistance    = distance;
+                }
+
+                ++i;
+            }
+
+            /* Continue with the next triangle in input order, if there are no adjacent triangles left */
+            if (bestTriangle == invalidIndex)
+            {
+                while (isEmitted[seedTriangle])
+                    ++seedTriangle;
+                bestTriangle = static_cast<unsigned int>(seedTriangle);
+            }
+
+            /* Emit triangle */
+            isEmitted[bestTriangle] = true;
+            triangleOrder.push_back(bestTriangle);
+            ++numEmitted;
+            ++numClusterTriangles;
+
+            centerSum += faceCenters[bestTriangle];
+
+            for (size_t j = 0; j < 3; ++j)
+            {
+                const auto vertex = indexBuffer[bestTriangle*3 + j];
+                clusteredIndices.push_back(vertex);
+
+                /* Add adjacent triangles of the new vertices to the candidate list */
+                auto& groupStamp = groupStamps[adjacency.groups[vertex]];
+                if (groupStamp == clusterIndex)
+                    continue;
+
+                groupStamp = clusterIndex;
+
+                size_t begin, end;
+                adjacency.GetCorners(vertex, begin, end);
+
+                for (auto k = begin; k < end; ++k)
+                {
+                    const auto triangle = adjacency.corners[k] / 3;
+                    if (!isEmitted[triangle] && candidateStamps[triangle] != clusterIndex)
+                    {
+                        candidateStamps[triangle] = clusterIndex;
+                        candidates.push_back(triangle);
+                    }
+                }
+            }
+        }
+
+        cluster.numVertices = static_cast<unsigned int>(numClusterTriangles * 3);
+        clusters.push_back(cluster);
+    }
+
+    /* Keep remaining indices (of an incomplete triangle) at the end */
+    clusteredIndices.insert(clusteredIndices.end(), indexBuffer.begin() + numTriangles*3, indexBuffer.end());
+
+    indexBuffer.swap(clusteredIndices);
+
+    /* Compute cluster bounds in parallel (with the face normals in the new triangle order) */
+    std::vector<Math::Vector3f> faceNormals(numTriangles);
+
+    for (size_t i = 0; i < numTriangles; ++i)
+        faceNormals[i] = faceData.normals[triangleOrder[i]];
+
+    Jobs::JobSystem::Instance()->ParallelFor(
+        0, clusters.size(),
+        [&](size_t i)
+        {
+            ComputeClusterBounds(clusters[i], coordIterator, indexBuffer, faceNormals);
+        },
+        16
+    );
+}
+
+/* --- Mesh simplification --- */
+
+//! Symmetric 4x4 quadric matrix (with accumulated weight) for the quadric error metric.
+struct Quadric
+{
+    //! Adds the plane (n * p + d = 0) with the specified weight.
+    void AddPlane(const Math::Vector3f& n, float d, double weight)
+    {
+        const double x = n.x, y = n.y, z = n.z, w = d;
+        a00 += weight*x*x; a01 += weight*x*y; a02 += weight*x*z; a03 += weight*x*w;
+        a11 += weight*y*y; a12 += weight*y*z; a13 += weight*y*w;
+        a22 += weight*z*z; a23 += weight*z*w;
+        a33 += weight*w*w;
+        weightSum += weight;
+    }
+
+    void Add(const Quadric& other)
+    {
+        a00 += other.a00; a01 += other.a01; a02 += other.a02; a03 += other.a03;
+        a11 += other.a11; a12 += other.a12; a13 += other.a13;
+        a22 += other.a22; a23 += other.a23;
+        a33 += other.a33;
+        weightSum += other.weightSum;
+    }
+
+    //! Returns the weighted sum of squared distances between the point and all planes.
+    double Error(const Math::Vector3f& p) const
+    {
+        const double x = p.x, y = p.y, z = p.z;
+        return
+            a00*x*x + 2.0*a01*x*y + 2.0*a02*x*z + 2.0*a03*x +
+            a11*y*y + 2.0*a12*y*z + 2.0*a13*y +
+            a22*z*z + 2.0*a23*z +
+            a33;
+    }
+
+    double a00 = 0.0, a01 = 0.0, a02 = 0.0, a03 = 0.0;
+    double a11 = 0.0, a12 = 0.0, a13 = 0.0;
+    double a22 = 0.0, a23 = 0.0;
+    double a33 = 0.0;
+    double weightSum = 0.0;
+};
+
+//! Weight of the constraint planes at open borders (relative to the squared edge length).
+static const double simplifierBorderWeight = 10.0;
+
+//! Half-edge collapse candidate: group 'from' is collapsed onto group 'to'.
+struct EdgeCollapse
+{
+    inline bool operator > (const EdgeCollapse& other) const
+    {
+        return error > other.error;
+    }
+
+    double          error;
+    unsigned int    from;
+    unsigned int    to;
+    unsigned int    fromVersion;
+    unsigned int    toVersion;
+};
+
+/**
+Mesh simplifier with half-edge collapses on welded vertex groups.
+Each vertex group collapses onto a neighbor group, whereby each vertex of the group is mapped onto the vertex
+of the neighbor group with which it shares a triangle. This preserves the attribute seams.
+*/
+class MeshSimplifier
+{
+
+    public:
+
+        MeshSimplifier(Video::AttributeConstIterator coordIterator, const CommonIndexBuffer& indexBuffer) :
+            coordIterator_{ coordIterator }
+        {
+            const auto numVertices = coordIterator.GetCount();
+            const auto numIndices = indexBuffer.size() / 3 * 3;
+
+            ValidateIndexBuffer(indexBuffer, numVertices, "GeometryConverter::SimplifyMesh");
+
+            /* Weld vertex positions (the representative vertex of each group is its group index) */
+            groups_ = WeldVertexPositions(coordIterator);
+
+            /* Copy triangles and remove degenerated ones */
+            triangles_.assign(indexBuffer.begin(), indexBuffer.begin() + numIndices);
+            triangleAlive_.assign(numIndices / 3, true);
+            groupTriangles_.resize(numVertices);
+
+            for (size_t t = 0; t < triangleAlive_.size(); ++t)
+            {
+                const auto g0 = Group(t, 0), g1 = Group(t, 1), g2 = Group(t, 2);
+                if (g0 == g1 || g1 == g2 || g2 == g0)
+                    triangleAlive_[t] = false;
+                else
+                {
+                    for (int i = 0; i < 3; ++i)
+                        groupTriangles_[Group(t, i)].push_back(static_cast<unsigned int>(t));
+                    ++numTriangles_;
+                }
+            }
+
+            groupVersions_.assign(numVertices, 0);
+            groupRemoved_.assign(numVertices, false);
+
+            ComputeQuadrics();
+        }
+
+        //! Collapses edges until the number of triangles is less than or equal to the target.
+        void Simplify(size_t targetNumTriangles)
+        {
+            /*
+            Rejected candidates are only pushed again when their target group changes,
+            so repeat with all edges as long as any edge could be collapsed.
+            */
+            while (numTriangles_ > targetNumTriangles)
+            {
+                PushAllCandidates();
+
+                size_t numCollapses = 0;
+                std::vector<Edge> mapping;
+
+                /* Collapse edges with the smallest error first */
+                while (numTriangles_ > targetNumTriangles && !candidates_.empty())
+                {
+                    const auto collapse = candidates_.top();
+                    candidates_.pop();
+
+                    /* Skip candidates whose groups have been changed since they were pushed */
+                    if ( groupRemoved_[collapse.from] || groupRemoved_[collapse.to] ||
+                         groupVersions_[collapse.from] != collapse.fromVersion ||
+                         groupVersions_[collapse.to] != collapse.toVersion )
+                    {
+                        continue;
+                    }
+
+                    if (CanCollapse(collapse.from, collapse.to, mapping))
+                    {
+                        Collapse(collapse.from, collapse.to, mapping);
+                        maxError_ = std::max(maxError_, collapse.error);
+                        ++numCollapses;
+                    }
+                }
+
+                candidates_ = CandidateQueue();
+
+                if (numCollapses == 0)
+                    break;
+            }
+        }
+
+        //! Returns the remaining triangles.
+        void Output(CommonIndexBuffer& indexBuffer) const
+        {
+            indexBuffer.clear();
+            indexBuffer.reserve(numTriangles_*3);
+
+            for (size_t t = 0; t < triangleAlive_.size(); ++t)
+            {
+                if (triangleAlive_[t])
+                    indexBuffer.insert(indexBuffer.end(), triangles_.begin() + t*3, triangles_.begin() + t*3 + 3);
+            }
+        }
+
+        //! Returns the largest root-mean-square error of all collapses.
+        float GetError() const
+        {
+            return static_cast<float>(std::sqrt(std::max(0.0, maxError_)));
+        }
+
+    private:
+
+        typedef std::pair<unsigned int, unsigned int> Edge;
+        typedef std::priority_queue<EdgeCollapse, std::vector<EdgeCollapse>, std::greater<EdgeCollapse>> CandidateQueue;
+
+        inline unsigned int Group(size_t triangle, int corner) const
+        {
+            return groups_[triangles_[triangle*3 + corner]];
+        }
+
+        inline const Math::Vector3f& Position(unsigned int group) const
+        {
+            return coordIterator_.Get<Math::Vector3f>(group);
+        }
+
+        //! Returns the (non-normalized) normal of the triangle, optionally with a replaced position of one group.
+        Math::Vector3f TriangleNormal(size_t triangle, unsigned int group = ~0u, const Math::Vector3f* position = nullptr) const
+        {
+            Math::Vector3f p[3];
+            for (int i = 0; i < 3; ++i)
+            {
+                const auto g = Group(triangle, i);
+                p[i] = (g == group ? *position : Position(g));
+            }
+            return Math::Cross(p[1] - p[0], p[2] - p[0]);
+        }
+
+        void ComputeQuadrics()
+        {
+            quadrics_.resize(groups_.size());
+
+            /* Count triangles per edge, to find open borders and non-manifold edges */
+            std::vector<std::uint64_t> edgeKeys;
+            edgeKeys.reserve(numTriangles_*3);
+
+            auto EdgeKey = [](unsigned int a, unsigned int b) -> std::uint64_t
+            {
+                return (static_cast<std::uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+            };
+
+            for (size_t t = 0; t < triangleAlive_.size(); ++t)
+            {
+                if (triangleAlive_[t])
+                {
+                    for (int i = 0; i < 3; ++i)
+                        edgeKeys.push_back(EdgeKey(Group(t, i), Group(t, (i + 1) % 3)));
+                }
+            }
+
+            std::sort(edgeKeys.begin(), edgeKeys.end());
+
+            groupBorder_.assign(groups_.size(), false);
+            groupLocked_.assign(groups_.size(), false);
+
+            std::vector<std::uint64_t> borderEdges;
+
+            for (size_t i = 0; i < edgeKeys.size();)
+            {
+                size_t j = i + 1;
+                while (j < edgeKeys.size() && edgeKeys[j] == edgeKeys[i])
+                    ++j;
+
+                const auto a = static_cast<unsigned int>(edgeKeys[i] >> 32);
+                const auto b = static_cast<unsigned int>(edgeKeys[i] & 0xffffffff);
+
+                if (j - i == 1)
+                {
+                    groupBorder_[a] = groupBorder_[b] = true;
+                    borderEdges.push_back(edgeKeys[i]);
+                }
+                else if (j - i > 2)
+                    groupLocked_[a] = groupLocked_[b] = true;
+
+                i = j;
+            }
+
+            /* Accumulate area weighted triangle planes, and constraint planes perpendicular to the border edges */
+            for (size_t t = 0; t < triangleAlive_.size(); ++t)
+            {
+                if (!triangleAlive_[t])
+                    continue;
+
+                auto normal = TriangleNormal(t);
+                const auto doubleArea = normal.Length();
+                if (doubleArea <= 0.0f)
+                    continue;
+
+                normal /= doubleArea;
+
+                const auto& p0 = Position(Group(t, 0));
+                const auto distance = -Math::Dot(normal, p0);
+
+                for (int i = 0; i < 3; ++i)
+                    quadrics_[Group(t, i)].AddPlane(normal, distance, doubleArea*0.5);
+
+                for (int i = 0; i < 3; ++i)
+                {
+                    const auto a = Group(t, i), b = Group(t, (i + 1) % 3);
+                    if (!std::binary_search(borderEdges.begin(), borderEdges.end(), EdgeKey(a, b)))
+                        continue;
+
+                    const auto edge = Position(b) - Position(a);
+                    auto borderNormal = Math::Cross(edge, normal);
+                    const auto length = borderNormal.Length();
+
+                    if (length > 0.0f)
+                    {
+                        borderNormal /= length;
+                        const auto borderDistance = -Math::Dot(borderNormal, Position(a));
+                        const auto weight = static_cast<double>(length)*length*simplifierBorderWeight;
+                        quadrics_[a].AddPlane(borderNormal, borderDistance, weight);
+                        quadrics_[b].AddPlane(borderNormal, borderDistance, weight);
+                    }
+                }
+            }
+        }
+
+        //! Collects the neighbor groups of the specified group (sorted and unique).
+        void CollectNeighbors(unsigned int group, std::vector<unsigned int>& neighbors) const
+        {
+            neighbors.clear();
+            for (auto t : groupTriangles_[group])
+            {
+                if (!triangleAlive_[t])
+                    continue;
+                for (int i = 0; i < 3; ++i)
+                {
+                    const auto g = Group(t, i);
+                    if (g != group)
+                        neighbors.push_back(g);
+                }
+            }
+            std::sort(neighbors.begin(), neighbors.end());
+            neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+        }
+
+        void PushAllCandidates()
+        {
+            edges_.clear();
+
+            for (size_t t = 0; t < triangleAlive_.size(); ++t)
+            {
+                if (!triangleAlive_[t])
+                    continue;
+                for (int i = 0; i < 3; ++i)
+                {
+                    const auto a = Group(t, i), b = Group(t, (i + 1) % 3);
+                    edges_.push_back({ a, b });
+                    edges_.push_back({ b, a });
+                }
+            }
+
+            PushCandidates(edges_);
+        }
+
+        void PushCandidates(std::vector<Edge>& edges)
+        {
+            std::sort(edges.begin(), edges.end());
+            edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+            for (const auto& edge : edges)
+            {
+                const auto from = edge.first, to = edge.second;
+                if (groupLocked_[from])
+                    continue;
+
+                /* Error of the combined quadric at the target position (normalized by the combined weight) */
+                auto quadric = quadrics_[from];
+                quadric.Add(quadrics_[to]);
+
+                const auto error = (quadric.weightSum > 0.0 ? quadric.Error(Position(to)) / quadric.weightSum : 0.0);
+
+                candidates_.push({ error, from, to, groupVersions_[from], groupVersions_[to] });
+            }
+        }
+
+        /**
+        Returns true if the group 'from' can be collapsed onto the group 'to'.
+        \param[out] mapping Vertex mapping (from -> to) for all vertices of the group 'from'.
+        */
+        bool CanCollapse(unsigned int from, unsigned int to, std::vector<Edge>& mapping)
+        {
+            const auto invalidIndex = ~0u;
+
+            mapping.clear();
+            opposites_.clear();
+
+            size_t numSharedTriangles = 0;
+
+            /* Map each vertex onto the vertex of the target group, with which it shares a triangle */
+            for (auto t : groupTriangles_[from])
+            {
+                if (!triangleAlive_[t])
+                    continue;
+
+                auto vertexFrom = invalidIndex, vertexTo = invalidIndex, opposite = invalidIndex;
+
+                for (int i = 0; i < 3; ++i)
+                {
+                    const auto v = triangles_[t*3 + i];
+                    const auto g = groups_[v];
+                    if (g == from)
+                        vertexFrom = v;
+                    else if (g == to)
+                        vertexTo = v;
+                    else
+                        opposite = g;
+                }
+
+                if (vertexTo != invalidIndex)
+                {
+                    ++numSharedTriangles;
+                    opposites_.push_back(opposite);
+                }
+
+                auto it = std::find_if(
+                    mapping.begin(), mapping.end(),
+                    [vertexFrom](const Edge& entry) { return entry.first == vertexFrom; }
+                );
+
+                if (it == mapping.end())
+                    mapping.push_back({ vertexFrom, vertexTo });
+                else if (it->second == invalidIndex)
+                    it->second = vertexTo;
+                else if (vertexTo != invalidIndex && it->second != vertexTo)
+                    return false;
+            }
+
+            if (numSharedTriangles == 0)
+                return false;
+
+            /* Border groups may only be collapsed along the border */
+            if (groupBorder_[from] && numSharedTriangles != 1)
+                return false;
+
+            /* Each vertex must be mapped onto a different vertex (otherwise a seam would be removed) */
+            for (size_t i = 0; i < mapping.size(); ++i)
+            {
+                if (mapping[i].second == invalidIndex)
+                    return false;
+                for (size_t j = i + 1; j < mapping.size(); ++j)
+                {
+                    if (mapping[i].second == mapping[j].second)
+                        return false;
+                }
+            }
+
+            /* Link condition: all common neighbors must be opposite to the collapsed edge (keeps the mesh manifold) */
+            CollectNeighbors(from, neighborsFrom_);
+            CollectNeighbors(to, neighborsTo_);
+
+            for (auto g : neighborsFrom_)
+            {
+                if ( std::binary_search(neighborsTo_.begin(), neighborsTo_.end(), g) &&
+                     std::find(opposites_.begin(), opposites_.end(), g) == opposites_.end() )
+                {
+                    return false;
+                }
+            }
+
+            /* Reject collapses which flip a triangle */
+            const auto& targetPosition = Position(to);
+
+            for (auto t : groupTriangles_[from])
+            {
+                if (!triangleAlive_[t])
+                    continue;
+
+                if (Group(t, 0) == to || Group(t, 1) == to || Group(t, 2) == to)
+                    continue;
+
+                const auto oldNormal = TriangleNormal(t);
+                const auto newNormal = TriangleNormal(t, from, &targetPosition);
+
+                if (oldNormal.LengthSq() > 0.0f && Math::Dot(oldNormal, newNormal) <= 0.0f)
+                    return false;
+            }
+
+            return true;
+        }
+
+        void Collapse(unsigned int from, unsigned int to, const std::vector<Edge>& mapping)
+        {
+            /* Remap vertices of all triangles and remove the triangles of the collapsed edge */
+            for (auto t : groupTriangles_[from])
+            {
+                if (!triangleAlive_[t])
+                    continue;
+
+                bool shared = false;
+
+                for (int i = 0; i < 3; ++i)
+                {
+                    auto& v = triangles_[t*3 + i];
+                    if (groups_[v] == from)
+                    {
+                        for (const auto& entry : mapping)
+                        {
+                            if (entry.first == v)
+                            {
+                                v = entry.second;
+                                break;
+                            }
+                        }
+                    }
+                    else if (groups_[v] == to)
+                        shared = true;
+                }
+
+                if (shared)
+                {
+                    triangleAlive_[t] = false;
+                    --numTriangles_;
+                }
+                else
+                    groupTriangles_[to].push_back(t);
+            }
+
+            groupTriangles_[from].clear();
+            groupRemoved_[from] = true;
+
+            quadrics_[to].Add(quadrics_[from]);
+
+            /* Remove dead triangles from the target group */
+            auto& triangles = groupTriangles_[to];
+            triangles.erase(
+                std::remove_if(
+                    triangles.begin(), triangles.end(),
+                    [this](unsigned int t) { return !triangleAlive_[t]; }
+                ),
+                triangles.end()
+            );
+
+            /*
+            Invalidate all candidates of the target group (whose quadric has changed) and push them again.
+            The validity of all other candidates is checked when they are popped.
+            */
+            ++groupVersions_[to];
+
+            CollectNeighbors(to, neighborsTo_);
+            edges_.clear();
+
+            for (auto g : neighborsTo_)
+            {
+                edges_.push_back({ to, g });
+                edges_.push_back({ g, to });
+            }
+
+            PushCandidates(edges_);
+        }
+
+        Video::AttributeConstIterator       coordIterator_;
+
+        std::vector<unsigned int>           groups_;                //!< Group (representative vertex) of each vertex.
+        std::vector<std::vector<unsigned int>> groupTriangles_;     //!< Triangles of each group (may contain removed triangles).
+        std::vector<unsigned int>           groupVersions_;
+        std::vector<bool>                   groupRemoved_;
+        std::vector<bool>                   groupBorder_;
+        std::vector<bool>                   groupLocked_;
+        std::vector<Quadric>                quadrics_;
+
+        CommonIndexBuffer                   triangles_;
+        std::vector<bool>                   triangleAlive_;
+        size_t                              numTriangles_   = 0;
+
+        CandidateQueue                      candidates_;
+        std::vector<Edge>                   edges_;
+
+        double                              maxError_       = 0.0;
+
+        std::vector<unsigned int>           neighborsFrom_;
+        std::vector<unsigned int>           neighborsTo_;
+        std::vector<unsigned int>           opposites_;
+
+};
+
+FORK_EXPORT float SimplifyMesh(
+    Video::AttributeConstIterator coordIterator,
+    const CommonIndexBuffer& indexBuffer,
+    CommonIndexBuffer& simplifiedIndexBuffer,
+    size_t targetNumTriangles)
+{
+    MeshSimplifier simplifier(coordIterator, indexBuffer);
+
+    simplifier.Simplify(targetNumTriangles);
+    simplifier.Output(simplifiedIndexBuffer);
+
+    return simplifier.GetError();
+}
+
+/* --- Level-of-detail generation --- */
+
+LODDescription::LODDescription() :
+    triangleRatios{ 0.5f, 0.25f, 0.125f }
+{
+}
+
+//! Simplification job for a single mesh and level.
+struct LODMeshJob
+{
+    const Geometry*     mesh;
+    size_t              level;
+    float               triangleRatio;
+    CommonIndexBuffer   indices;
+    float               error;
+};
+
+static bool IsSimplifiableMesh(const Geometry* geometry)
+{
+    switch (geometry->Type())
+    {
+        case Geometry::Types::Simple3DMesh:
+        case Geometry::Types::TangentSpaceMesh:
+        case Geometry::Types::CommonMesh:
+        {
+            /* Non-indexed meshes are not simplified */
+            auto mesh = static_cast<const MeshGeometry*>(geometry);
+            return mesh->primitiveType == Video::GeometryPrimitives::Triangles && mesh->NumIndices() >= 3;
+        }
+        default:
+            return false;
+    }
+}
+
+//! Collects all unique simplifiable meshes of the specified geometry graph.
+static void CollectLODMeshes(const Geometry* geometry, std::vector<const Geometry*>& meshes)
+{
+    switch (geometry->Type())
+    {
+        case Geometry::Types::Composition:
+        {
+            for (const auto& subGeom : static_cast<const CompositionGeometry*>(geometry)->subGeometries)
+                CollectLODMeshes(subGeom.get(), meshes);
+        }
+        break;
+
+        case Geometry::Types::Textured:
+        {
+            auto texturedGeom = static_cast<const TexturedGeometry*>(geometry);
+            if (texturedGeom->actualGeometry)
+                CollectLODMeshes(texturedGeom->actualGeometry.get(), meshes);
+        }
+        break;
+
+        default:
+        {
+            if (IsSimplifiableMesh(geometry) && std::find(meshes.begin(), meshes.end(), geometry) == meshes.end())
+                meshes.push_back(geometry);
+        }
+        break;
+    }
+}
+
+template <class Geom> void SimplifyLODMesh(const Geom& mesh, LODMeshJob& job)
+{
+    const auto& vertices = mesh.vertices;
+    const auto& indices = mesh.indices;
+
+    const auto numTriangles = indices.size() / 3;
+    const auto targetNumTriangles = static_cast<size_t>(static_cast<float>(numTriangles) * job.triangleRatio);
+
+    job.error = SimplifyMesh(
+        Video::AttributeConstIterator(&vertices[0].coord, vertices.size(), sizeof(vertices[0])),
+        indices, job.indices, targetNumTriangles
+    );
+}
+
+static void SimplifyLODMesh(LODMeshJob& job)
+{
+    switch (job.mesh->Type())
+    {
+        case Geometry::Types::Simple3DMesh:
+            SimplifyLODMesh(*static_cast<const Simple3DMeshGeometry*>(job.mesh), job);
+            break;
+        case Geometry::Types::TangentSpaceMesh:
+            SimplifyLODMesh(*static_cast<const TangentSpaceMeshGeometry*>(job.mesh), job);
+            break;
+        case Geometry::Types::CommonMesh:
+            SimplifyLODMesh(*static_cast<const CommonMeshGeometry*>(job.mesh), job);
+            break;
+        default:
+            break;
+    }
+}
+
+//! Creates a copy of the specified mesh with the simplified indices and only the referenced vertices.
+template <class Geom> GeometryPtr CreateLODMesh(const Geom& source, const CommonIndexBuffer& indices)
+{
+    auto mesh = std::make_shared<Geom>();
+
+    mesh->metaData      = source.metaData;
+    mesh->primitiveType = source.primitiveType;
+    mesh->vertices      = source.vertices;
+    mesh->indices       = indices;
+
+    OptimizeVertexCache(mesh->indices, mesh->vertices.size());
+    mesh->vertices.resize(
+        OptimizeVertexFetch(mesh->vertices.data(), mesh->vertices.size(), sizeof(mesh->vertices[0]), mesh->indices)
+    );
+
+    mesh->ComputeBoundingVolume();
+
+    if (source.GetVertexBuffer())
+        mesh->SetupHardwareBuffer();
+
+    return mesh;
+}
+
+static GeometryPtr CreateLODMesh(const Geometry* source, const CommonIndexBuffer& indices)
+{
+    switch (source->Type())
+    {
+        case Geometry::Types::Simple3DMesh:
+            return CreateLODMesh(*static_cast<const Simple3DMeshGeometry*>(source), indices);
+        case Geometry::Types::TangentSpaceMesh:
+            return CreateLODMesh(*static_cast<const TangentSpaceMeshGeometry*>(source), indices);
+        case Geometry::Types::CommonMesh:
+            return CreateLODMesh(*static_cast<const CommonMeshGeometry*>(source), indices);
+        default:
+            return nullptr;
+    }
+}
+
+//! Creates a copy of the geometry graph, where each simplified mesh is replaced by its respective level.
+static GeometryPtr CreateLODGraph(
+    const GeometryPtr& geometry, const std::vector<const Geometry*>& meshes, const std::vector<GeometryPtr>& levelMeshes)
+{
+    switch (geometry->Type())
+    {
+        case Geometry::Types::Composition:
+        {
+            auto source = static_cast<const CompositionGeometry*>(geometry.get());
+            auto composition = std::make_shared<CompositionGeometry>();
+
+            composition->metaData = source->metaData;
+            for (const auto& subGeom : source->subGeometries)
+                composition->subGeometries.push_back(CreateLODGraph(subGeom, meshes, levelMeshes));
+
+            return composition;
+        }
+
+        case Geometry::Types::Textured:
+        {
+            auto source = static_cast<const TexturedGeometry*>(geometry.get());
+            auto texturedGeom = std::make_shared<TexturedGeometry>();
+
+            texturedGeom->metaData          = source->metaData;
+            texturedGeom->material          = source->material;
+            texturedGeom->shaderComposition = source->shaderComposition;
+            texturedGeom->textures          = source->textures;
+
+            if (source->actualGeometry)
+                texturedGeom->actualGeometry = CreateLODGraph(source->actualGeometry, meshes, levelMeshes);
+
+            return texturedGeom;
+        }
+
+        default:
+        {
+            auto it = std::find(meshes.begin(), meshes.end(), geometry.get());
+            if (it != meshes.end())
+                return levelMeshes[it - meshes.begin()];
+            return geometry;
+        }
+    }
+}
+
+FORK_EXPORT std::shared_ptr<LODGeometry> GenerateLODGeometry(const GeometryPtr& geometry, const LODDescription& desc)
+{
+    ASSERT_POINTER(geometry);
+
+    auto lodGeometry = std::make_shared<LODGeometry>();
+    lodGeometry->metaData = geometry->metaData;
+    lodGeometry->lodGeometries.push_back(geometry);
+
+    /* Collect meshes and create a simplification job for each mesh and level */
+    std::vector<const Geometry*> meshes;
+    CollectLODMeshes(geometry.get(), meshes);
+
+    const auto numLevels = desc.triangleRatios.size();
+
+    std::vector<LODMeshJob> jobs(meshes.size() * numLevels);
+
+    for (size_t level = 0; level < numLevels; ++level)
+    {
+        for (size_t i = 0; i < meshes.size(); ++i)
+        {
+            auto& job = jobs[level*meshes.size() + i];
+            job.mesh            = meshes[i];
+            job.level           = level;
+            job.triangleRatio   = Math::Saturate(desc.triangleRatios[level]);
+            job.error           = 0.0f;
+        }
+    }
+
+    /* Simplify all meshes and levels in parallel (each level is simplified from the original mesh) */
+    Jobs::JobSystem::Instance()->ParallelFor(
+        0, jobs.size(),
+        [&jobs](size_t i)
+        {
+            SimplifyLODMesh(jobs[i]);
+        },
+        1
+    );
+
+    /*
+    Derive switch distances from the geometric errors: an error 'e' (in object space) at distance 'd'
+    has a projected size of (e * screenHeight) / (2 * d * tan(fieldOfView/2)) pixels.
+    */
+    const auto projectionScale = desc.screenHeight / (2.0f * std::tan(desc.fieldOfView * 0.5f) * std::max(desc.pixelError, Math::epsilon));
+
+    size_t prevNumTriangles = 0;
+    for (auto mesh : meshes)
+        prevNumTriangles += static_cast<const MeshGeometry*>(mesh)->NumIndices() / 3;
+
+    float prevDistance = 0.0f;
+
+    for (size_t level = 0; level < numLevels; ++level)
+    {
+        /* Determine level error and number of triangles */
+        float levelError = 0.0f;
+        size_t numTriangles = 0;
+
+        for (size_t i = 0; i < meshes.size(); ++i)
+        {
+            const auto& job = jobs[level*meshes.size() + i];
+            levelError = std::max(levelError, job.error);
+            numTriangles += job.indices.size() / 3;
+        }
+
+        /* Omit levels which could not be simplified any further */
+        if (numTriangles >= prevNumTriangles)
+            continue;
+
+        prevNumTriangles = numTriangles;
+
+        /* Create level meshes and the level graph */
+        std::vector<GeometryPtr> levelMeshes(meshes.size());
+
+        for (size_t i = 0; i < meshes.size(); ++i)
+            levelMeshes[i] = CreateLODMesh(meshes[i], jobs[level*meshes.size() + i].indices);
+
+        auto levelGeometry = CreateLODGraph(geometry, meshes, levelMeshes);
+        levelGeometry->ComputeBoundingVolume();
+
+        prevDistance = std::max(prevDistance, levelError * projectionScale);
+
+        lodGeometry->lodGeometries.push_back(levelGeometry);
+        lodGeometry->lodDistances.push_back(prevDistance);
+    }
+
+    lodGeometry->ComputeBoundingVolume();
+
+    return lodGeometry;
 }
 
 FORK_EXPORT void OptimizeGeometryGraph(GeometryPtr& geometry)
@@ -238,6 +2055,7 @@ FORK_EXPORT void OptimizeGeometryGraph(GeometryPtr& geometry)
     {
         GeometryTextureOptimizer().OptimizeGeometryGraph(geometry);
         GeometryCleanUpOptimizer().OptimizeGeometryGraph(geometry);
+        GeometryVertexCacheOptimizer().OptimizeGeometryGraph(geometry);
     }
 }
 
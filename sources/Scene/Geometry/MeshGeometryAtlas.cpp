@@ -6,6 +6,10 @@
  */
 
 #include "Scene/Geometry/MeshGeometryAtlas.h"
+#include "Core/Exception/InvalidArgumentException.h"
+#include "Math/Collision/PlaneCollisions.h"
+
+#include <cmath>
 
 
 namespace Fork
@@ -20,6 +24,38 @@ MeshGeometryAtlas::MeshGeometryAtlas(const MeshGeometry& geometry) :
 {
 }
 
+bool MeshGeometryAtlas::IsPartitionVisible(
+    const Partition& partition, const ViewFrustum& frustum, const Math::Point3f& viewPosition)
+{
+    if (!partition.box.IsValid())
+        return true;
+
+    /* Test bounding box against the frustum planes */
+    const auto center = (partition.box.min + partition.box.max) * 0.5f;
+    const auto extent = (partition.box.max - partition.box.min) * 0.5f;
+
+    for (const auto& plane : frustum.planes)
+    {
+        const auto radius =
+            std::abs(plane.normal.x) * extent.x +
+            std::abs(plane.normal.y) * extent.y +
+            std::abs(plane.normal.z) * extent.z;
+
+        if (Math::ComputeDistanceToPlane(plane, center) + radius < 0.0f)
+            return false;
+    }
+
+    /* Test normal cone, i.e. whether all triangles are facing away from the viewer */
+    if (partition.coneCutoff < 1.0f)
+    {
+        const auto dir = partition.coneApex - viewPosition;
+        if (Math::Dot(dir, partition.coneAxis) >= partition.coneCutoff * dir.Length())
+            return false;
+    }
+
+    return true;
+}
+
 MeshGeometryAtlas::Partition MeshGeometryAtlas::RecordPartition()
 {
     /* Get previous partition */
@@ -35,6 +71,7 @@ MeshGeometryAtlas::Partition MeshGeometryAtlas::RecordPartition()
     {
         partition.numVertices = geometry_->NumIndices() - indexCounter_;
         partition.firstVertex = vertexCounter_;
+        partition.firstIndex = indexCounter_;
     }
     else
     {
@@ -52,6 +89,77 @@ MeshGeometryAtlas::Partition MeshGeometryAtlas::RecordPartition()
     return partition;
 }
 
+void MeshGeometryAtlas::RecordClusters(const std::vector<Partition>& clusters)
+{
+    /* Validate cluster ranges */
+    const auto numNewIndices = geometry_->NumIndices() - indexCounter_;
+
+    for (const auto& cluster : clusters)
+    {
+        if (cluster.firstIndex + cluster.numVertices > numNewIndices)
+            throw InvalidArgumentException(__FUNCTION__, "clusters", "Cluster range is out of the range of the new indices");
+    }
+
+    /* Add clusters as new partitions */
+    for (const auto& cluster : clusters)
+    {
+        auto partition = cluster;
+        {
+            partition.firstVertex += vertexCounter_;
+            partition.firstIndex += indexCounter_;
+        }
+        partitions_.push_back(partition);
+    }
+
+    /* Store new number of vertices and indices */
+    vertexCounter_ = geometry_->NumVertices();
+    indexCounter_ = geometry_->NumIndices();
+}
+
+size_t MeshGeometryAtlas::CullPartitions(
+    const ViewFrustum& frustum, const Math::Point3f& viewPosition, std::vector<Partition>& drawRanges) const
+{
+    const auto isIndexed = (geometry_->NumIndices() > 0);
+    const auto firstRange = drawRanges.size();
+
+    size_t numVisiblePartitions = 0;
+
+    for (const auto& partition : partitions_)
+    {
+        if (!IsPartitionVisible(partition, frustum, viewPosition))
+            continue;
+
+        ++numVisiblePartitions;
+
+        /* Merge partition into the previous draw range, if they are successive */
+        if (drawRanges.size() > firstRange)
+        {
+            auto& prevRange = drawRanges.back();
+
+            const auto isSuccessive = isIndexed ?
+                (prevRange.firstVertex == partition.firstVertex && prevRange.firstIndex + prevRange.numVertices == partition.firstIndex) :
+                (prevRange.firstVertex + prevRange.numVertices == partition.firstVertex);
+
+            if (isSuccessive)
+            {
+                prevRange.numVertices += partition.numVertices;
+                continue;
+            }
+        }
+
+        /* Add new draw range */
+        Partition drawRange;
+        {
+            drawRange.numVertices   = partition.numVertices;
+            drawRange.firstVertex   = partition.firstVertex;
+            drawRange.firstIndex    = partition.firstIndex;
+        }
+        drawRanges.push_back(drawRange);
+    }
+
+    return numVisiblePartitions;
+}
+
 
 } // /namespace Scene
 
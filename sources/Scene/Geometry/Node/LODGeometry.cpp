@@ -36,15 +36,31 @@ void LODGeometry::ComputeBoundingVolume()
 }
 
 Geometry* LODGeometry::SelectLOD(float distance) const
+{
+    return !lodGeometries.empty() ? lodGeometries[SelectLODIndex(distance)].get() : nullptr;
+}
+
+size_t LODGeometry::SelectLODIndex(float distance) const
 {
     if (lodGeometries.empty())
-        return nullptr;
+        return 0;
+
+    /* Select level by the switch distances */
+    if (!lodDistances.empty())
+    {
+        size_t index = 0;
+        while (index + 1 < lodGeometries.size() && index < lodDistances.size() && distance >= lodDistances[index])
+            ++index;
+        return index;
+    }
 
     /* Check if distance is out of range */
+    const size_t maxIndex = lodGeometries.size() - 1;
+
     if (distance <= minDistance_)
-        return lodGeometries.front().get();
+        return 0;
     if (distance >= maxDistance_)
-        return lodGeometries.back().get();
+        return maxIndex;
 
     /* Transform distance from [min .. max] to [0 .. 1] */
     distance = Math::TransformSaturate(distance, minDistance_, maxDistance_);
@@ -53,10 +69,7 @@ Geometry* LODGeometry::SelectLOD(float distance) const
     distance = std::pow(distance, threshold_);
 
     /* Get geometry index from transformed distance */
-    const size_t maxIndex = lodGeometries.size() - 1;
-    const size_t index = static_cast<size_t>(distance * maxIndex);
-
-    return lodGeometries[index].get();
+    return std::min(static_cast<size_t>(distance * maxIndex), maxIndex);
 }
 
 void LODGeometry::SetupRange(float minDistance, float maxDistance)
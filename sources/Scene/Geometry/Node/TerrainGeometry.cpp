@@ -29,16 +29,23 @@ Geometry::Types TerrainGeometry::Type() const
     return Geometry::Types::Terrain;
 }
 
-//!TODO! -> the bounding volume's transformation works differently for terrains!!!
 void TerrainGeometry::ComputeBoundingVolume()
 {
-    if (templateGeometry)
+    if (quadTree && quadTree->IsBuilt())
+        boundingVolume.SetupBox(quadTree->GetBoundingBox());
+    else if (templateGeometry)
     {
         templateGeometry->ComputeBoundingVolume();
         boundingVolume = templateGeometry->boundingVolume;
     }
 }
 
+void TerrainGeometry::SelectNodes(const ViewFrustum& frustum, const Math::Point3f& cameraPosition, std::vector<TerrainNodeSelection>& selection) const
+{
+    if (quadTree)
+        quadTree->Select(frustum, cameraPosition, selection);
+}
+
 
 } // /namespace Scene
 
@@ -0,0 +1,117 @@
+/*
+ * Geometry vertex cache optimizer file
+ * 
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GeometryVertexCacheOptimizer.h"
+#include "Scene/Geometry/Node/Simple3DMeshGeometry.h"
+#include "Scene/Geometry/Node/TangentSpaceMeshGeometry.h"
+#include "Scene/Geometry/Node/CommonMeshGeometry.h"
+#include "Core/StringModifier.h"
+#include "IO/Core/Log.h"
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+static void AccumulateStatistics(
+    GeometryConverter::VertexCacheStatistics& dest, const GeometryConverter::VertexCacheStatistics& source)
+{
+    dest.numTransformedVertices += source.numTransformedVertices;
+    dest.numTriangles           += source.numTriangles;
+    dest.numVertices            += source.numVertices;
+}
+
+void GeometryVertexCacheOptimizer::OptimizeGeometryGraph(GeometryPtr& geometry)
+{
+    optimizedGeometries_.clear();
+    statsBefore_ = GeometryConverter::VertexCacheStatistics();
+    statsAfter_ = GeometryConverter::VertexCacheStatistics();
+
+    geometry->Visit(this);
+
+    if (statsBefore_.numTriangles > 0)
+    {
+        IO::Log::Message(
+            "Vertex cache optimization: ACMR " + ToStr(statsBefore_.ACMR()) + " -> " + ToStr(statsAfter_.ACMR()) +
+            ", ATVR " + ToStr(statsBefore_.ATVR()) + " -> " + ToStr(statsAfter_.ATVR()) +
+            ", vertices " + ToStr(statsBefore_.numVertices) + " -> " + ToStr(statsAfter_.numVertices)
+        );
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GeometryVertexCacheOptimizer::VisitSimple3DMeshGeometry(Simple3DMeshGeometry* node)
+{
+    OptimizeMesh(node);
+}
+
+void GeometryVertexCacheOptimizer::VisitTangentSpaceMeshGeometry(TangentSpaceMeshGeometry* node)
+{
+    OptimizeMesh(node);
+}
+
+void GeometryVertexCacheOptimizer::VisitCommonMeshGeometry(CommonMeshGeometry* node)
+{
+    OptimizeMesh(node);
+}
+
+template <typename VtxT> void GeometryVertexCacheOptimizer::OptimizeMesh(BaseMeshGeometry<VtxT, unsigned int>* geometry)
+{
+    /* Only optimize non-empty triangle lists, and each shared geometry only once */
+    if ( geometry->primitiveType != Video::GeometryPrimitives::Triangles ||
+         geometry->vertices.empty() ||
+         !optimizedGeometries_.insert(geometry).second )
+    {
+        return;
+    }
+
+    auto& vertices = geometry->vertices;
+    auto& indices = geometry->indices;
+
+    /* Generate indices for non-indexed meshes */
+    if (indices.empty())
+    {
+        indices.resize(vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i)
+            indices[i] = static_cast<unsigned int>(i);
+    }
+
+    AccumulateStatistics(statsBefore_, GeometryConverter::AnalyzeVertexCache(indices, vertices.size()));
+
+    /* Weld identical vertices, then reorder triangles and vertices */
+    const auto numUniqueVertices = GeometryConverter::WeldVertices(
+        VtxT::Format(), vertices.data(), vertices.size(), sizeof(VtxT), indices
+    );
+
+    GeometryConverter::OptimizeVertexCache(indices, numUniqueVertices);
+
+    const auto numReferencedVertices = GeometryConverter::OptimizeVertexFetch(
+        vertices.data(), numUniqueVertices, sizeof(VtxT), indices
+    );
+    vertices.resize(numReferencedVertices);
+
+    AccumulateStatistics(statsAfter_, GeometryConverter::AnalyzeVertexCache(indices, vertices.size()));
+
+    /* Update hardware buffers, if they have already been created */
+    if (geometry->GetVertexBuffer())
+        geometry->SetupHardwareBuffer();
+}
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+
+// ========================
@@ -0,0 +1,67 @@
+/*
+ * Geometry vertex cache optimizer header
+ * 
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_GEOMETRY_VERTEX_CACHE_OPTIMIZER_H__
+#define __FORK_GEOMETRY_VERTEX_CACHE_OPTIMIZER_H__
+
+
+#include "GeometryOptimizer.h"
+#include "Scene/Geometry/GeometryConverter.h"
+#include "Scene/Geometry/Node/BaseMeshGeometry.h"
+
+#include <set>
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+/**
+Optimizes all triangle mesh geometries of a geometry node graph for the GPU vertex cache:
+identical vertices are welded, the triangles are reordered for the post-transform vertex cache,
+and the vertices are reordered for the pre-transform vertex fetch.
+The vertex cache statistics (ACMR and ATVR) before and after the optimization are written to the log.
+\see GeometryConverter::WeldVertices
+\see GeometryConverter::OptimizeVertexCache
+\see GeometryConverter::OptimizeVertexFetch
+*/
+class GeometryVertexCacheOptimizer : public GeometryOptimizer
+{
+    
+    public:
+
+        void OptimizeGeometryGraph(GeometryPtr& geometry) override;
+
+    private:
+        
+        void VisitSimple3DMeshGeometry      (Simple3DMeshGeometry*      node) override;
+        void VisitTangentSpaceMeshGeometry  (TangentSpaceMeshGeometry*  node) override;
+        void VisitCommonMeshGeometry        (CommonMeshGeometry*        node) override;
+
+        template <typename VtxT> void OptimizeMesh(BaseMeshGeometry<VtxT, unsigned int>* geometry);
+
+        std::set<const Geometry*>                   optimizedGeometries_;   //!< Geometries which are shared in the graph are only optimized once.
+
+        GeometryConverter::VertexCacheStatistics    statsBefore_;
+        GeometryConverter::VertexCacheStatistics    statsAfter_;
+
+};
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
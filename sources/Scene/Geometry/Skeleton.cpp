@@ -52,16 +52,42 @@ void Skeleton::Joint::DeleteChild(Joint* joint)
 
 void Skeleton::Joint::GlobalTransform(Math::Matrix4f& matrix) const
 {
-    if (GetParent())
-        GetParent()->GlobalTransform(matrix);
-    matrix *= transform.GetMatrix();
+    matrix *= CachedGlobalTransform();
 }
 
 Math::Matrix4f Skeleton::Joint::GlobalTransform() const
 {
-    Math::Matrix4f matrix;
-    GlobalTransform(matrix);
-    return matrix;
+    return CachedGlobalTransform();
+}
+
+const Math::Matrix4f& Skeleton::Joint::CachedGlobalTransform() const
+{
+    /* Make sure the parent's cache is up-to-date (only compares revisions, if nothing has changed) */
+    const GlobalTransformCache* parentCache = nullptr;
+
+    if (GetParent())
+    {
+        GetParent()->CachedGlobalTransform();
+        parentCache = &(GetParent()->globalTransformCache_);
+    }
+
+    /* Update cache of this joint if necessary */
+    if (globalTransformCache_.IsOutdated(transform, parentCache))
+        globalTransformCache_.Update(transform, parentCache);
+
+    return globalTransformCache_.GetMatrix();
+}
+
+void Skeleton::Joint::UpdateGlobalTransforms()
+{
+    /* Parent's cache is already up-to-date in a top-down pass */
+    auto parentCache = (GetParent() != nullptr ? &(GetParent()->globalTransformCache_) : nullptr);
+
+    if (globalTransformCache_.IsOutdated(transform, parentCache))
+        globalTransformCache_.Update(transform, parentCache);
+
+    for (auto& child : children_)
+        child->UpdateGlobalTransforms();
 }
 
 void Skeleton::Joint::FillMatrixBuffer(Math::Matrix4f* buffer, size_t numMatrices, bool isGlobal, bool isRelative) const
@@ -0,0 +1,333 @@
+/*
+ * Skeleton pose file
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Scene/Geometry/SkeletonPose.h"
+#include "Core/Exception/NullPointerException.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Core/StaticConfig.h"
+
+#if defined(FORK_ENABLE_SSE2)
+#   include <emmintrin.h>
+#endif
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+/* --- Internal functions --- */
+
+//! Returns the specified number of joints, rounded up to a multiple of 4.
+static size_t PaddedSize(size_t numJoints)
+{
+    return (numJoints + 3) & ~static_cast<size_t>(3);
+}
+
+/*
+Multiplies the two affine 4x4 matrices (out = a * b). The fourth row of both matrices must be { 0, 0, 0, 1 },
+and the output matrix must not be the same object as one of the input matrices.
+*/
+static void MulAffineMatrices(Math::Matrix4f& out, const Math::Matrix4f& a, const Math::Matrix4f& b)
+{
+    const auto pa = a.Ptr();
+    const auto pb = b.Ptr();
+    auto po = out.Ptr();
+
+    #if defined(FORK_ENABLE_SSE2)
+
+    const __m128 a0 = _mm_loadu_ps(pa     );
+    const __m128 a1 = _mm_loadu_ps(pa +  4);
+    const __m128 a2 = _mm_loadu_ps(pa +  8);
+    const __m128 a3 = _mm_loadu_ps(pa + 12);
+
+    /* Each column of 'out' is a linear combination of the columns of 'a' */
+    for (size_t c = 0; c < 4; ++c)
+    {
+        const auto col = pb + c*4;
+        __m128 result = _mm_mul_ps(a0, _mm_set1_ps(col[0]));
+        result = _mm_add_ps(result, _mm_mul_ps(a1, _mm_set1_ps(col[1])));
+        result = _mm_add_ps(result, _mm_mul_ps(a2, _mm_set1_ps(col[2])));
+        if (c == 3)
+            result = _mm_add_ps(result, a3);
+        _mm_storeu_ps(po + c*4, result);
+    }
+
+    #else
+
+    for (size_t c = 0; c < 4; ++c)
+    {
+        const auto col = pb + c*4;
+        for (size_t r = 0; r < 3; ++r)
+            po[c*4 + r] = pa[r]*col[0] + pa[4 + r]*col[1] + pa[8 + r]*col[2] + (c == 3 ? pa[12 + r] : 0.0f);
+        po[c*4 + 3] = (c == 3 ? 1.0f : 0.0f);
+    }
+
+    #endif
+}
+
+
+/*
+ * LocalTransforms structure
+ */
+
+void SkeletonPose::LocalTransforms::Resize(size_t numJoints)
+{
+    const auto paddedSize = PaddedSize(numJoints);
+
+    positionX.resize(paddedSize, 0.0f);
+    positionY.resize(paddedSize, 0.0f);
+    positionZ.resize(paddedSize, 0.0f);
+    rotationX.resize(paddedSize, 0.0f);
+    rotationY.resize(paddedSize, 0.0f);
+    rotationZ.resize(paddedSize, 0.0f);
+    rotationW.resize(paddedSize, 1.0f);
+    scaleX.resize(paddedSize, 1.0f);
+    scaleY.resize(paddedSize, 1.0f);
+    scaleZ.resize(paddedSize, 1.0f);
+}
+
+void SkeletonPose::LocalTransforms::SetTransform(size_t index, const Math::Transform3Df& transform)
+{
+    const auto& position = transform.GetPosition();
+    positionX[index] = position.x;
+    positionY[index] = position.y;
+    positionZ[index] = position.z;
+
+    const auto& rotation = transform.GetRotation();
+    rotationX[index] = rotation.x;
+    rotationY[index] = rotation.y;
+    rotationZ[index] = rotation.z;
+    rotationW[index] = rotation.w;
+
+    const auto& scale = transform.GetScale();
+    scaleX[index] = scale.x;
+    scaleY[index] = scale.y;
+    scaleZ[index] = scale.z;
+}
+
+Math::Transform3Df SkeletonPose::LocalTransforms::GetTransform(size_t index) const
+{
+    return Math::Transform3Df(
+        { positionX[index], positionY[index], positionZ[index] },
+        { rotationX[index], rotationY[index], rotationZ[index], rotationW[index] },
+        { scaleX[index], scaleY[index], scaleZ[index] }
+    );
+}
+
+
+/*
+ * SkeletonPose class
+ */
+
+SkeletonPose::SkeletonPose(const FlatSkeletonPtr& skeleton) :
+    skeleton_{ skeleton }
+{
+    ASSERT_POINTER(skeleton);
+
+    const auto numJoints = skeleton_->NumJoints();
+
+    /* Initialize all arrays (the padding entries have the identity transformation) */
+    localTransforms_.Resize(numJoints);
+
+    localMatrices_.resize(localTransforms_.Size());
+    modelMatrices_.resize(numJoints);
+    skinMatrices_.resize(numJoints);
+
+    ResetToBindPose();
+}
+
+void SkeletonPose::ResetToBindPose()
+{
+    const auto& bindPose = skeleton_->GetBindPose();
+    for (size_t i = 0; i < bindPose.size(); ++i)
+        SetLocalTransform(i, bindPose[i]);
+}
+
+void SkeletonPose::SetLocalTransform(size_t index, const Math::Transform3Df& transform)
+{
+    localTransforms_.SetTransform(index, transform);
+}
+
+Math::Transform3Df SkeletonPose::GetLocalTransform(size_t index) const
+{
+    return localTransforms_.GetTransform(index);
+}
+
+void SkeletonPose::UpdateMatrices()
+{
+    const auto numJoints = skeleton_->NumJoints();
+
+    /* Convert local transformations into local matrices */
+    for (size_t i = 0; i < numJoints; i += 4)
+        ConvertLocalTransforms(i);
+
+    /* Compute model- and skinning matrices (parents are always stored before their children) */
+    const auto& parents = skeleton_->GetParents();
+    const auto& originMatrices = skeleton_->GetOriginMatrices();
+
+    for (size_t i = 0; i < numJoints; ++i)
+    {
+        if (parents[i] != FlatSkeleton::invalidIndex)
+            MulAffineMatrices(modelMatrices_[i], modelMatrices_[parents[i]], localMatrices_[i]);
+        else
+            modelMatrices_[i] = localMatrices_[i];
+
+        MulAffineMatrices(skinMatrices_[i], modelMatrices_[i], originMatrices[i]);
+    }
+}
+
+void SkeletonPose::UpdateMatrices(const std::vector<SkeletonPose*>& poses)
+{
+    Jobs::JobSystem::Instance()->ParallelFor(
+        0, poses.size(),
+        [&poses](size_t i)
+        {
+            if (poses[i])
+                poses[i]->UpdateMatrices();
+        }
+    );
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+/*
+This is the SoA variant of "Math::ConvertQuaternionToMatrix" with additional translation and scaling
+(like Math::Transform3D::GetMatrix), for the four joints [first .. first + 3].
+*/
+void SkeletonPose::ConvertLocalTransforms(size_t first)
+{
+    const auto& local = localTransforms_;
+    auto matrices = &(localMatrices_[first]);
+
+    #if defined(FORK_ENABLE_SSE2)
+
+    const __m128 x = _mm_loadu_ps(&(local.rotationX[first]));
+    const __m128 y = _mm_loadu_ps(&(local.rotationY[first]));
+    const __m128 z = _mm_loadu_ps(&(local.rotationZ[first]));
+    const __m128 w = _mm_loadu_ps(&(local.rotationW[first]));
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+
+    /* Compute products of the quaternion components */
+    const __m128 x2 = _mm_mul_ps(x, two);
+    const __m128 y2 = _mm_mul_ps(y, two);
+    const __m128 z2 = _mm_mul_ps(z, two);
+
+    const __m128 xx = _mm_mul_ps(x, x2);
+    const __m128 yy = _mm_mul_ps(y, y2);
+    const __m128 zz = _mm_mul_ps(z, z2);
+    const __m128 xy = _mm_mul_ps(x, y2);
+    const __m128 xz = _mm_mul_ps(x, z2);
+    const __m128 yz = _mm_mul_ps(y, z2);
+    const __m128 wx = _mm_mul_ps(w, x2);
+    const __m128 wy = _mm_mul_ps(w, y2);
+    const __m128 wz = _mm_mul_ps(w, z2);
+
+    const __m128 sx = _mm_loadu_ps(&(local.scaleX[first]));
+    const __m128 sy = _mm_loadu_ps(&(local.scaleY[first]));
+    const __m128 sz = _mm_loadu_ps(&(local.scaleZ[first]));
+
+    /* Compute scaled rotation columns (each register holds one matrix entry of all four joints) */
+    __m128 c0x = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, yy), zz), sx);
+    __m128 c0y = _mm_mul_ps(_mm_add_ps(xy, wz), sx);
+    __m128 c0z = _mm_mul_ps(_mm_sub_ps(xz, wy), sx);
+    __m128 c0w = _mm_setzero_ps();
+
+    __m128 c1x = _mm_mul_ps(_mm_sub_ps(xy, wz), sy);
+    __m128 c1y = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, xx), zz), sy);
+    __m128 c1z = _mm_mul_ps(_mm_add_ps(yz, wx), sy);
+    __m128 c1w = _mm_setzero_ps();
+
+    __m128 c2x = _mm_mul_ps(_mm_add_ps(xz, wy), sz);
+    __m128 c2y = _mm_mul_ps(_mm_sub_ps(yz, wx), sz);
+    __m128 c2z = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, xx), yy), sz);
+    __m128 c2w = _mm_setzero_ps();
+
+    __m128 c3x = _mm_loadu_ps(&(local.positionX[first]));
+    __m128 c3y = _mm_loadu_ps(&(local.positionY[first]));
+    __m128 c3z = _mm_loadu_ps(&(local.positionZ[first]));
+    __m128 c3w = one;
+
+    /* Transpose from SoA to the column-major layout of each matrix */
+    _MM_TRANSPOSE4_PS(c0x, c0y, c0z, c0w);
+    _MM_TRANSPOSE4_PS(c1x, c1y, c1z, c1w);
+    _MM_TRANSPOSE4_PS(c2x, c2y, c2z, c2w);
+    _MM_TRANSPOSE4_PS(c3x, c3y, c3z, c3w);
+
+    const __m128 columns[4][4] =
+    {
+        { c0x, c1x, c2x, c3x },
+        { c0y, c1y, c2y, c3y },
+        { c0z, c1z, c2z, c3z },
+        { c0w, c1w, c2w, c3w }
+    };
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        auto m = matrices[i].Ptr();
+        _mm_storeu_ps(m     , columns[i][0]);
+        _mm_storeu_ps(m +  4, columns[i][1]);
+        _mm_storeu_ps(m +  8, columns[i][2]);
+        _mm_storeu_ps(m + 12, columns[i][3]);
+    }
+
+    #else
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const auto j = first + i;
+
+        const auto x = local.rotationX[j];
+        const auto y = local.rotationY[j];
+        const auto z = local.rotationZ[j];
+        const auto w = local.rotationW[j];
+
+        const auto sx = local.scaleX[j];
+        const auto sy = local.scaleY[j];
+        const auto sz = local.scaleZ[j];
+
+        auto& m = matrices[i];
+
+        m(0, 0) = (1.0f - 2.0f*y*y - 2.0f*z*z) * sx;
+        m(0, 1) = (       2.0f*x*y + 2.0f*z*w) * sx;
+        m(0, 2) = (       2.0f*x*z - 2.0f*y*w) * sx;
+        m(0, 3) = 0.0f;
+
+        m(1, 0) = (       2.0f*x*y - 2.0f*z*w) * sy;
+        m(1, 1) = (1.0f - 2.0f*x*x - 2.0f*z*z) * sy;
+        m(1, 2) = (       2.0f*z*y + 2.0f*x*w) * sy;
+        m(1, 3) = 0.0f;
+
+        m(2, 0) = (       2.0f*x*z + 2.0f*y*w) * sz;
+        m(2, 1) = (       2.0f*z*y - 2.0f*x*w) * sz;
+        m(2, 2) = (1.0f - 2.0f*x*x - 2.0f*y*y) * sz;
+        m(2, 3) = 0.0f;
+
+        m(3, 0) = local.positionX[j];
+        m(3, 1) = local.positionY[j];
+        m(3, 2) = local.positionZ[j];
+        m(3, 3) = 1.0f;
+    }
+
+    #endif
+}
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+
+// ========================
@@ -0,0 +1,350 @@
+/*
+ * Skin weights file
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Scene/Geometry/SkinWeights.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Core/StaticConfig.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(FORK_ENABLE_AVX)
+#   include <immintrin.h>
+#elif defined(FORK_ENABLE_SSE2)
+#   include <emmintrin.h>
+#endif
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+/* --- Internal functions --- */
+
+//! Number of vertices, which are processed by a single job.
+static const size_t vertexBlockSize = 1024;
+
+static void NormalizeVector(Math::Vector3f& vec)
+{
+    const auto len = std::sqrt(vec.x*vec.x + vec.y*vec.y + vec.z*vec.z);
+    if (len > 0.0f)
+    {
+        const auto invLen = 1.0f / len;
+        vec.x *= invLen;
+        vec.y *= invLen;
+        vec.z *= invLen;
+    }
+}
+
+
+/*
+ * SkinWeights class
+ */
+
+SkinWeights::SkinWeights(const FlatSkeleton& skeleton, size_t numVertices) :
+    numVertices_{ numVertices                },
+    numJoints_  { skeleton.NumJoints()       }
+{
+    numInfluences_.resize(numVertices, 0);
+
+    for (size_t k = 0; k < maxNumInfluences; ++k)
+    {
+        jointIndices_[k].resize(numVertices, 0);
+        weights_[k].resize(numVertices, 0.0f);
+    }
+
+    /* Insert all joint weights into the vertex slots (keep the largest weights, sorted in descending order) */
+    const auto& joints = skeleton.GetJoints();
+
+    for (size_t joint = 0; joint < joints.size(); ++joint)
+    {
+        for (const auto& vertexWeight : joints[joint]->weights)
+        {
+            const auto v = vertexWeight.index;
+
+            if (v >= numVertices)
+                throw InvalidArgumentException(__FUNCTION__, "numVertices", "Vertex weight refers to a vertex index out of range");
+
+            if (vertexWeight.weight <= 0.0f)
+                continue;
+
+            /* Find slot for the new weight */
+            auto slot = static_cast<size_t>(numInfluences_[v]);
+
+            if (slot == maxNumInfluences)
+            {
+                if (vertexWeight.weight <= weights_[maxNumInfluences - 1][v])
+                    continue;
+                --slot;
+            }
+            else
+                ++numInfluences_[v];
+
+            /* Move smaller weights down */
+            while (slot > 0 && weights_[slot - 1][v] < vertexWeight.weight)
+            {
+                jointIndices_[slot][v] = jointIndices_[slot - 1][v];
+                weights_[slot][v] = weights_[slot - 1][v];
+                --slot;
+            }
+
+            jointIndices_[slot][v] = static_cast<unsigned int>(joint);
+            weights_[slot][v] = vertexWeight.weight;
+        }
+    }
+
+    /* Normalize weights */
+    for (size_t v = 0; v < numVertices; ++v)
+    {
+        float sum = 0.0f;
+        for (size_t k = 0; k < numInfluences_[v]; ++k)
+            sum += weights_[k][v];
+
+        if (sum > 0.0f)
+        {
+            for (size_t k = 0; k < numInfluences_[v]; ++k)
+                weights_[k][v] /= sum;
+        }
+        else
+        {
+            /* Bind vertices without weights to the root joint */
+            numInfluences_[v]   = 1;
+            jointIndices_[0][v] = 0;
+            weights_[0][v]      = 1.0f;
+        }
+    }
+}
+
+void SkinWeights::Skin(
+    const std::vector<Math::Matrix4f>& skinMatrices,
+    const Video::AttributeConstIterator& srcPositions, const Video::AttributeConstIterator* srcNormals,
+    const Video::AttributeIterator& dstPositions, const Video::AttributeIterator* dstNormals,
+    BoundingVolume* boundingVolume) const
+{
+    /* Validate parameters before, since the jobs must not throw exceptions */
+    if (skinMatrices.size() < numJoints_)
+        throw InvalidArgumentException(__FUNCTION__, "skinMatrices", "Not enough skinning matrices for the joints of the skin weights");
+    if (srcPositions.GetCount() != numVertices_ || dstPositions.GetCount() != numVertices_)
+        throw InvalidArgumentException(__FUNCTION__, "srcPositions", "Number of vertex positions does not match the skin weights");
+    if ((srcNormals == nullptr) != (dstNormals == nullptr))
+        throw InvalidArgumentException(__FUNCTION__, "dstNormals", "Source and destination normals must either be both specified or both null");
+    if (srcNormals && (srcNormals->GetCount() != numVertices_ || dstNormals->GetCount() != numVertices_))
+        throw InvalidArgumentException(__FUNCTION__, "srcNormals", "Number of vertex normals does not match the skin weights");
+
+    if (numVertices_ == 0 || numJoints_ == 0)
+        return;
+
+    /* Skin all vertex blocks in parallel */
+    const auto numBlocks = (numVertices_ + vertexBlockSize - 1) / vertexBlockSize;
+    std::vector<Math::AABB3f> blockBoxes(numBlocks);
+
+    const auto matrices = skinMatrices.data();
+
+    Jobs::JobSystem::Instance()->ParallelFor(
+        0, numBlocks,
+        [&](size_t block)
+        {
+            const auto begin = block * vertexBlockSize;
+            const auto end = std::min(begin + vertexBlockSize, numVertices_);
+            SkinVertices(begin, end, matrices, srcPositions, srcNormals, dstPositions, dstNormals, blockBoxes[block]);
+        },
+        1
+    );
+
+    /* Merge bounding boxes of all blocks */
+    if (boundingVolume)
+    {
+        Math::AABB3f box;
+        for (const auto& blockBox : blockBoxes)
+            box.InsertBox(blockBox);
+
+        boundingVolume->box = box;
+        boundingVolume->sphere.point = box.Center();
+        boundingVolume->sphere.radius = (box.max - box.min).Length() * 0.5f;
+        boundingVolume->DetermineType();
+    }
+}
+
+void SkinWeights::Skin(
+    const SkeletonPose& pose,
+    const Video::AttributeConstIterator& srcPositions, const Video::AttributeConstIterator* srcNormals,
+    const Video::AttributeIterator& dstPositions, const Video::AttributeIterator* dstNormals,
+    BoundingVolume* boundingVolume) const
+{
+    Skin(pose.GetSkinMatrices(), srcPositions, srcNormals, dstPositions, dstNormals, boundingVolume);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+/*
+Skins the vertices [begin .. end). For each vertex the skinning matrices of its influences are blended first
+(with SIMD, one column per register, or two columns per register with AVX), then the position and normal
+are transformed by the blended matrix. This is faster than transforming the vertex by each matrix.
+*/
+void SkinWeights::SkinVertices(
+    size_t begin, size_t end, const Math::Matrix4f* skinMatrices,
+    const Video::AttributeConstIterator& srcPositions, const Video::AttributeConstIterator* srcNormals,
+    const Video::AttributeIterator& dstPositions, const Video::AttributeIterator* dstNormals,
+    Math::AABB3f& box) const
+{
+    #if defined(FORK_ENABLE_SSE2) || defined(FORK_ENABLE_AVX)
+
+    __m128 boxMin = _mm_set1_ps(std::numeric_limits<float>::max());
+    __m128 boxMax = _mm_set1_ps(std::numeric_limits<float>::lowest());
+
+    for (size_t v = begin; v < end; ++v)
+    {
+        const auto numInfluences = numInfluences_[v];
+
+        /* Blend skinning matrices */
+        #if defined(FORK_ENABLE_AVX)
+
+        const float* m = skinMatrices[jointIndices_[0][v]].Ptr();
+        __m256 w = _mm256_set1_ps(weights_[0][v]);
+
+        __m256 c01 = _mm256_mul_ps(_mm256_loadu_ps(m    ), w);
+        __m256 c23 = _mm256_mul_ps(_mm256_loadu_ps(m + 8), w);
+
+        for (size_t k = 1; k < numInfluences; ++k)
+        {
+            m = skinMatrices[jointIndices_[k][v]].Ptr();
+            w = _mm256_set1_ps(weights_[k][v]);
+            c01 = _mm256_add_ps(c01, _mm256_mul_ps(_mm256_loadu_ps(m    ), w));
+            c23 = _mm256_add_ps(c23, _mm256_mul_ps(_mm256_loadu_ps(m + 8), w));
+        }
+
+        const __m128 c0 = _mm256_castps256_ps128(c01);
+        const __m128 c1 = _mm256_extractf128_ps(c01, 1);
+        const __m128 c2 = _mm256_castps256_ps128(c23);
+        const __m128 c3 = _mm256_extractf128_ps(c23, 1);
+
+        #else
+
+        const float* m = skinMatrices[jointIndices_[0][v]].Ptr();
+        __m128 w = _mm_set1_ps(weights_[0][v]);
+
+        __m128 c0 = _mm_mul_ps(_mm_loadu_ps(m     ), w);
+        __m128 c1 = _mm_mul_ps(_mm_loadu_ps(m +  4), w);
+        __m128 c2 = _mm_mul_ps(_mm_loadu_ps(m +  8), w);
+        __m128 c3 = _mm_mul_ps(_mm_loadu_ps(m + 12), w);
+
+        for (size_t k = 1; k < numInfluences; ++k)
+        {
+            m = skinMatrices[jointIndices_[k][v]].Ptr();
+            w = _mm_set1_ps(weights_[k][v]);
+            c0 = _mm_add_ps(c0, _mm_mul_ps(_mm_loadu_ps(m     ), w));
+            c1 = _mm_add_ps(c1, _mm_mul_ps(_mm_loadu_ps(m +  4), w));
+            c2 = _mm_add_ps(c2, _mm_mul_ps(_mm_loadu_ps(m +  8), w));
+            c3 = _mm_add_ps(c3, _mm_mul_ps(_mm_loadu_ps(m + 12), w));
+        }
+
+        #endif
+
+        /* Transform position */
+        const auto& srcPos = srcPositions.Get<Math::Point3f>(v);
+
+        const __m128 pos = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(srcPos.x)), _mm_mul_ps(c1, _mm_set1_ps(srcPos.y))),
+            _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(srcPos.z)), c3)
+        );
+
+        boxMin = _mm_min_ps(boxMin, pos);
+        boxMax = _mm_max_ps(boxMax, pos);
+
+        float result[4];
+        _mm_storeu_ps(result, pos);
+        dstPositions.Get<Math::Point3f>(v) = Math::Point3f(result[0], result[1], result[2]);
+
+        /* Transform normal */
+        if (srcNormals)
+        {
+            const auto& srcNormal = srcNormals->Get<Math::Vector3f>(v);
+
+            const __m128 normal = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(srcNormal.x)), _mm_mul_ps(c1, _mm_set1_ps(srcNormal.y))),
+                _mm_mul_ps(c2, _mm_set1_ps(srcNormal.z))
+            );
+
+            _mm_storeu_ps(result, normal);
+            Math::Vector3f dstNormal(result[0], result[1], result[2]);
+            NormalizeVector(dstNormal);
+            dstNormals->Get<Math::Vector3f>(v) = dstNormal;
+        }
+    }
+
+    float minValues[4], maxValues[4];
+    _mm_storeu_ps(minValues, boxMin);
+    _mm_storeu_ps(maxValues, boxMax);
+
+    box.min = Math::Point3f(minValues[0], minValues[1], minValues[2]);
+    box.max = Math::Point3f(maxValues[0], maxValues[1], maxValues[2]);
+
+    #else
+
+    box.Invalidate();
+
+    for (size_t v = begin; v < end; ++v)
+    {
+        const auto numInfluences = numInfluences_[v];
+
+        /* Blend skinning matrices */
+        float c[16] = { 0 };
+
+        for (size_t k = 0; k < numInfluences; ++k)
+        {
+            const float* m = skinMatrices[jointIndices_[k][v]].Ptr();
+            const auto w = weights_[k][v];
+            for (size_t i = 0; i < 16; ++i)
+                c[i] += m[i] * w;
+        }
+
+        /* Transform position */
+        const auto& srcPos = srcPositions.Get<Math::Point3f>(v);
+
+        const Math::Point3f pos(
+            c[0]*srcPos.x + c[4]*srcPos.y + c[ 8]*srcPos.z + c[12],
+            c[1]*srcPos.x + c[5]*srcPos.y + c[ 9]*srcPos.z + c[13],
+            c[2]*srcPos.x + c[6]*srcPos.y + c[10]*srcPos.z + c[14]
+        );
+
+        box.InsertPoint(pos);
+        dstPositions.Get<Math::Point3f>(v) = pos;
+
+        /* Transform normal */
+        if (srcNormals)
+        {
+            const auto& srcNormal = srcNormals->Get<Math::Vector3f>(v);
+
+            Math::Vector3f dstNormal(
+                c[0]*srcNormal.x + c[4]*srcNormal.y + c[ 8]*srcNormal.z,
+                c[1]*srcNormal.x + c[5]*srcNormal.y + c[ 9]*srcNormal.z,
+                c[2]*srcNormal.x + c[6]*srcNormal.y + c[10]*srcNormal.z
+            );
+
+            NormalizeVector(dstNormal);
+            dstNormals->Get<Math::Vector3f>(v) = dstNormal;
+        }
+    }
+
+    #endif
+}
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+
+// ========================
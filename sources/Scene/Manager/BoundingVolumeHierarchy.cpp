@@ -0,0 +1,555 @@
+/*
+ * Bounding volume hierarchy file
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Scene/Manager/BoundingVolumeHierarchy.h"
+#include "Math/Collision/AABBCollisions.h"
+#include "Math/Collision/PlaneCollisions.h"
+#include "Core/Exception/InvalidArgumentException.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+/*
+ * Internal functions
+ */
+
+static Math::AABB3f MergeBoxes(const Math::AABB3f& a, const Math::AABB3f& b)
+{
+    return Math::AABB3f(
+        Math::Vector3f(std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)),
+        Math::Vector3f(std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z))
+    );
+}
+
+//! Returns the half surface area of the specified box (used as insertion cost).
+static float HalfSurfaceArea(const Math::AABB3f& box)
+{
+    const auto size = box.max - box.min;
+    return size.x*size.y + size.y*size.z + size.z*size.x;
+}
+
+static bool ContainsBox(const Math::AABB3f& outer, const Math::AABB3f& inner)
+{
+    return
+        outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+        outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+}
+
+static bool OverlapBoxes(const Math::AABB3f& a, const Math::AABB3f& b)
+{
+    return
+        a.min.x <= b.max.x && a.max.x >= b.min.x &&
+        a.min.y <= b.max.y && a.max.y >= b.min.y &&
+        a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+enum class FrustumRelations
+{
+    Outside,
+    Intersect,
+    Inside,
+};
+
+/*
+Classifies the box against all frustum planes whose bits are set in the plane mask.
+Planes, the box is completely in front of, are removed from the mask, since the boxes of all children are in front of them as well.
+*/
+static FrustumRelations ClassifyBox(const ViewFrustum& frustum, const Math::AABB3f& box, unsigned int& planeMask)
+{
+    const auto center = (box.min + box.max) * 0.5f;
+    const auto extent = (box.max - box.min) * 0.5f;
+
+    for (size_t i = 0; i < frustum.planes.size(); ++i)
+    {
+        const auto planeBit = (1u << i);
+        if ((planeMask & planeBit) == 0)
+            continue;
+
+        const auto& plane = frustum.planes[i];
+
+        const auto dist = Math::ComputeDistanceToPlane(plane, center);
+        const auto radius =
+            std::abs(plane.normal.x) * extent.x +
+            std::abs(plane.normal.y) * extent.y +
+            std::abs(plane.normal.z) * extent.z;
+
+        if (dist + radius < 0.0f)
+            return FrustumRelations::Outside;
+        if (dist - radius >= 0.0f)
+            planeMask &= ~planeBit;
+    }
+
+    return (planeMask == 0 ? FrustumRelations::Inside : FrustumRelations::Intersect);
+}
+
+
+/*
+ * BoundingVolumeHierarchy class
+ */
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(float margin) :
+    margin_{ margin }
+{
+}
+
+BoundingVolumeHierarchy::ProxyID BoundingVolumeHierarchy::InsertProxy(const Math::AABB3f& box, GeometryNode* node)
+{
+    const auto leaf = AllocateNode();
+
+    /* Setup leaf with fat box */
+    const Math::Vector3f margin(margin_);
+
+    auto& leafNode = nodes_[leaf];
+    {
+        leafNode.box        = Math::AABB3f(box.min - margin, box.max + margin);
+        leafNode.leafBox    = box;
+        leafNode.sceneNode  = node;
+        leafNode.height     = 0;
+    }
+    InsertLeaf(leaf);
+
+    ++numProxies_;
+
+    return leaf;
+}
+
+void BoundingVolumeHierarchy::RemoveProxy(ProxyID proxy)
+{
+    GetLeafNode(proxy);
+
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+
+    --numProxies_;
+}
+
+bool BoundingVolumeHierarchy::MoveProxy(ProxyID proxy, const Math::AABB3f& box)
+{
+    GetLeafNode(proxy);
+
+    auto& leafNode = nodes_[proxy];
+    leafNode.leafBox = box;
+
+    /* Only refit the leaf if the new box is still inside the fat box */
+    if (ContainsBox(leafNode.box, box))
+        return false;
+
+    /* Otherwise re-insert the leaf with a new fat box */
+    RemoveLeaf(proxy);
+
+    const Math::Vector3f margin(margin_);
+    nodes_[proxy].box = Math::AABB3f(box.min - margin, box.max + margin);
+
+    InsertLeaf(proxy);
+
+    return true;
+}
+
+void BoundingVolumeHierarchy::Clear()
+{
+    nodes_.clear();
+    root_       = invalidProxy;
+    freeList_   = invalidProxy;
+    numProxies_ = 0;
+}
+
+void BoundingVolumeHierarchy::QueryFrustum(const ViewFrustum& frustum, std::vector<GeometryNode*>& nodes) const
+{
+    if (root_ == invalidProxy)
+        return;
+
+    /* Each stack entry stores the planes its box still has to be tested against */
+    struct StackEntry
+    {
+        ProxyID         index;
+        unsigned int    planeMask;
+    };
+
+    std::vector<StackEntry> stack;
+    stack.reserve(64);
+    stack.push_back({ root_, (1u << frustum.planes.size()) - 1 });
+
+    while (!stack.empty())
+    {
+        auto entry = stack.back();
+        stack.pop_back();
+
+        const auto& node = nodes_[entry.index];
+
+        /* Subtrees which are completely inside the frustum are collected without further tests */
+        if (entry.planeMask != 0)
+        {
+            if (ClassifyBox(frustum, (node.IsLeaf() ? node.leafBox : node.box), entry.planeMask) == FrustumRelations::Outside)
+                continue;
+        }
+
+        if (node.IsLeaf())
+            nodes.push_back(node.sceneNode);
+        else
+        {
+            stack.push_back({ node.children[0], entry.planeMask });
+            stack.push_back({ node.children[1], entry.planeMask });
+        }
+    }
+}
+
+void BoundingVolumeHierarchy::QueryRay(const Math::Ray3f& ray, std::vector<RayHit>& hits, float maxDistance) const
+{
+    if (root_ == invalidProxy)
+        return;
+
+    std::vector<ProxyID> stack;
+    stack.push_back(root_);
+
+    while (!stack.empty())
+    {
+        const auto& node = nodes_[stack.back()];
+        stack.pop_back();
+
+        /* Test ray against tight box for leaves and against fat box for inner nodes */
+        float distance = 0.0f;
+        if ( !Math::ComputeIntersectionLerpWithAABB(node.IsLeaf() ? node.leafBox : node.box, ray, distance) ||
+             distance > maxDistance )
+        {
+            continue;
+        }
+
+        if (node.IsLeaf())
+            hits.push_back({ node.sceneNode, distance });
+        else
+        {
+            stack.push_back(node.children[0]);
+            stack.push_back(node.children[1]);
+        }
+    }
+
+    /* Sort hits by distance (nearest first) */
+    std::sort(
+        hits.begin(), hits.end(),
+        [](const RayHit& a, const RayHit& b)
+        {
+            return a.distance < b.distance;
+        }
+    );
+}
+
+void BoundingVolumeHierarchy::QueryOverlap(const Math::AABB3f& box, std::vector<GeometryNode*>& nodes) const
+{
+    if (root_ == invalidProxy)
+        return;
+
+    std::vector<ProxyID> stack;
+    stack.push_back(root_);
+
+    while (!stack.empty())
+    {
+        const auto& node = nodes_[stack.back()];
+        stack.pop_back();
+
+        if (node.IsLeaf())
+        {
+            if (OverlapBoxes(node.leafBox, box))
+                nodes.push_back(node.sceneNode);
+        }
+        else if (OverlapBoxes(node.box, box))
+        {
+            stack.push_back(node.children[0]);
+            stack.push_back(node.children[1]);
+        }
+    }
+}
+
+unsigned int BoundingVolumeHierarchy::Height() const
+{
+    return root_ != invalidProxy ? static_cast<unsigned int>(nodes_[root_].height + 1) : 0;
+}
+
+GeometryNode* BoundingVolumeHierarchy::GetProxyNode(ProxyID proxy) const
+{
+    return GetLeafNode(proxy).sceneNode;
+}
+
+const Math::AABB3f& BoundingVolumeHierarchy::GetProxyBox(ProxyID proxy) const
+{
+    return GetLeafNode(proxy).leafBox;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+BoundingVolumeHierarchy::ProxyID BoundingVolumeHierarchy::AllocateNode()
+{
+    if (freeList_ != invalidProxy)
+    {
+        /* Re-use node from free list */
+        const auto index = freeList_;
+        freeList_ = nodes_[index].parent;
+        nodes_[index] = Node();
+        return index;
+    }
+
+    /* Append new node */
+    nodes_.push_back(Node());
+    return static_cast<ProxyID>(nodes_.size() - 1);
+}
+
+void BoundingVolumeHierarchy::FreeNode(ProxyID index)
+{
+    auto& node = nodes_[index];
+    {
+        node.sceneNode  = nullptr;
+        node.parent     = freeList_;
+        node.height     = -1;
+    }
+    freeList_ = index;
+}
+
+void BoundingVolumeHierarchy::InsertLeaf(ProxyID leaf)
+{
+    if (root_ == invalidProxy)
+    {
+        root_ = leaf;
+        nodes_[leaf].parent = invalidProxy;
+        return;
+    }
+
+    /* Find the best sibling with the surface area heuristic */
+    const auto leafBox = nodes_[leaf].box;
+    auto index = root_;
+
+    while (!nodes_[index].IsLeaf())
+    {
+        const auto& node = nodes_[index];
+
+        const auto area         = HalfSurfaceArea(node.box);
+        const auto combinedArea = HalfSurfaceArea(MergeBoxes(node.box, leafBox));
+
+        /* Cost of creating a new parent for this node and the new leaf */
+        const auto cost = 2.0f * combinedArea;
+
+        /* Minimum cost of pushing the leaf further down the tree */
+        const auto inheritanceCost = 2.0f * (combinedArea - area);
+
+        float childCost[2];
+
+        for (int i = 0; i < 2; ++i)
+        {
+            const auto& child = nodes_[node.children[i]];
+            const auto mergedArea = HalfSurfaceArea(MergeBoxes(leafBox, child.box));
+
+            if (child.IsLeaf())
+                childCost[i] = mergedArea + inheritanceCost;
+            else
+                childCost[i] = (mergedArea - HalfSurfaceArea(child.box)) + inheritanceCost;
+        }
+
+        /* Descend according to the minimum cost */
+        if (cost < childCost[0] && cost < childCost[1])
+            break;
+
+        index = (childCost[0] < childCost[1] ? node.children[0] : node.children[1]);
+    }
+
+    const auto sibling = index;
+
+    /* Create new parent for the sibling and the new leaf */
+    const auto oldParent = nodes_[sibling].parent;
+    const auto newParent = AllocateNode();
+
+    auto& newParentNode = nodes_[newParent];
+    {
+        newParentNode.parent        = oldParent;
+        newParentNode.box           = MergeBoxes(leafBox, nodes_[sibling].box);
+        newParentNode.height        = nodes_[sibling].height + 1;
+        newParentNode.children[0]   = sibling;
+        newParentNode.children[1]   = leaf;
+    }
+
+    if (oldParent != invalidProxy)
+    {
+        auto& oldParentNode = nodes_[oldParent];
+        if (oldParentNode.children[0] == sibling)
+            oldParentNode.children[0] = newParent;
+        else
+            oldParentNode.children[1] = newParent;
+    }
+    else
+        root_ = newParent;
+
+    nodes_[sibling].parent  = newParent;
+    nodes_[leaf].parent     = newParent;
+
+    /* Walk back up the tree, fix heights and boxes, and rotate if necessary */
+    RefitAncestors(nodes_[leaf].parent);
+}
+
+void BoundingVolumeHierarchy::RemoveLeaf(ProxyID leaf)
+{
+    if (leaf == root_)
+    {
+        root_ = invalidProxy;
+        return;
+    }
+
+    const auto parent       = nodes_[leaf].parent;
+    const auto grandParent  = nodes_[parent].parent;
+    const auto sibling      = (nodes_[parent].children[0] == leaf ? nodes_[parent].children[1] : nodes_[parent].children[0]);
+
+    if (grandParent != invalidProxy)
+    {
+        /* Replace the parent by the sibling */
+        auto& grandParentNode = nodes_[grandParent];
+        if (grandParentNode.children[0] == parent)
+            grandParentNode.children[0] = sibling;
+        else
+            grandParentNode.children[1] = sibling;
+
+        nodes_[sibling].parent = grandParent;
+        FreeNode(parent);
+
+        RefitAncestors(grandParent);
+    }
+    else
+    {
+        root_ = sibling;
+        nodes_[sibling].parent = invalidProxy;
+        FreeNode(parent);
+    }
+}
+
+void BoundingVolumeHierarchy::RefitAncestors(ProxyID index)
+{
+    while (index != invalidProxy)
+    {
+        index = Balance(index);
+
+        auto& node = nodes_[index];
+
+        const auto& childA = nodes_[node.children[0]];
+        const auto& childB = nodes_[node.children[1]];
+
+        node.height = 1 + std::max(childA.height, childB.height);
+        node.box    = MergeBoxes(childA.box, childB.box);
+
+        index = node.parent;
+    }
+}
+
+/*
+Performs a left or right rotation if the node 'A' is imbalanced:
+
+        A
+       / \
+      B   C
+         / \
+        F   G
+
+If C is higher than B by more than one level, C becomes the new subtree root,
+A takes the place of C, and the higher child of C (F or G) stays with C.
+*/
+BoundingVolumeHierarchy::ProxyID BoundingVolumeHierarchy::Balance(ProxyID iA)
+{
+    auto& A = nodes_[iA];
+
+    if (A.IsLeaf())
+        return iA;
+
+    const auto iB = A.children[0];
+    const auto iC = A.children[1];
+
+    auto& B = nodes_[iB];
+    auto& C = nodes_[iC];
+
+    const auto balance = C.height - B.height;
+
+    /* Rotates the higher child 'iUp' up; 'iDown' is the lower child of 'A' */
+    auto RotateUp = [&](ProxyID iUp, int slotOfUp)
+    {
+        auto& up = nodes_[iUp];
+
+        const auto iF = up.children[0];
+        const auto iG = up.children[1];
+
+        auto& F = nodes_[iF];
+        auto& G = nodes_[iG];
+
+        /* Swap 'A' and the upper node */
+        up.children[0] = iA;
+        up.parent = A.parent;
+        A.parent = iUp;
+
+        if (up.parent != invalidProxy)
+        {
+            auto& upParent = nodes_[up.parent];
+            if (upParent.children[0] == iA)
+                upParent.children[0] = iUp;
+            else
+                upParent.children[1] = iUp;
+        }
+        else
+            root_ = iUp;
+
+        const auto& other = nodes_[A.children[1 - slotOfUp]];
+
+        /* Keep the higher grandchild with the upper node, move the lower one to 'A' */
+        if (F.height > G.height)
+        {
+            up.children[1] = iF;
+            A.children[slotOfUp] = iG;
+            G.parent = iA;
+            A.box = MergeBoxes(other.box, G.box);
+            up.box = MergeBoxes(A.box, F.box);
+            A.height = 1 + std::max(other.height, G.height);
+            up.height = 1 + std::max(A.height, F.height);
+        }
+        else
+        {
+            up.children[1] = iG;
+            A.children[slotOfUp] = iF;
+            F.parent = iA;
+            A.box = MergeBoxes(other.box, F.box);
+            up.box = MergeBoxes(A.box, G.box);
+            A.height = 1 + std::max(other.height, F.height);
+            up.height = 1 + std::max(A.height, G.height);
+        }
+
+        return iUp;
+    };
+
+    if (balance > 1)
+        return RotateUp(iC, 1);
+    if (balance < -1)
+        return RotateUp(iB, 0);
+
+    return iA;
+}
+
+const BoundingVolumeHierarchy::Node& BoundingVolumeHierarchy::GetLeafNode(ProxyID proxy) const
+{
+    if (proxy >= nodes_.size() || nodes_[proxy].height != 0)
+        throw InvalidArgumentException(__FUNCTION__, "proxy", "Invalid proxy ID");
+    return nodes_[proxy];
+}
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+
+// ========================
@@ -7,8 +7,19 @@
 
 #include "Scene/Manager/CullingManager.h"
 #include "Math/Common/Transform.h"
+#include "Math/Collision/PlaneCollisions.h"
+#include "Core/Exception/NullPointerException.h"
+#include "Core/StaticConfig.h"
 
 #include <array>
+#include <algorithm>
+#include <cmath>
+
+#if defined(FORK_ENABLE_AVX)
+#   include <immintrin.h>
+#elif defined(FORK_ENABLE_SSE2)
+#   include <emmintrin.h>
+#endif
 
 
 namespace Fork
@@ -44,8 +55,7 @@ bool CullingManager::IsBoundingVolumeInsideFrustum(const BoundingVolume& boundin
         case BoundingVolume::Types::Box:
             return IsBoundingBoxInsideFrustum(boundingVolume.box);
         case BoundingVolume::Types::Sphere:
-            //return IsBoundingSphereInsideFrustum(boundingVolume.sphere);
-            return IsBoundingBoxInsideFrustum(boundingVolume.box);
+            return IsBoundingSphereInsideFrustum(boundingVolume.sphere);
     }
     return !cullingEnabled;
 }
@@ -164,12 +174,234 @@ bool CullingManager::IsBoundingBoxInsideFrustum(const Math::AABB3f& boundingBox)
     return true;
 }
 
-//!TODO! -> this is incomplete!!!
 bool CullingManager::IsBoundingSphereInsideFrustum(const Math::Sphere<>& boundingSphere) const
 {
-    /* Make culling test with inverse view frustum (to support non-uniform scaled spheres) */
-    //return !cullingEnabled || viewFrustum_.IsSphereInside(boundingSphere);
-    return true;//!!!
+    if (!cullingEnabled)
+        return true;
+
+    /*
+    Transform sphere into world space. For non-uniform scaled world matrices,
+    the largest scale factor is used, so the test remains conservative.
+    */
+    const auto scale = worldMatrix_.GetScale();
+
+    Math::Sphere<> worldSphere(
+        boundingSphere.radius * std::max(std::abs(scale.x), std::max(std::abs(scale.y), std::abs(scale.z))),
+        worldMatrix_ * boundingSphere.point
+    );
+
+    return viewFrustum_.IsSphereInside(worldSphere);
+}
+
+void CullingManager::CullBoundingBoxes(const Math::AABB3f* boxes, size_t numBoxes, unsigned int* visibilityMask) const
+{
+    if (!numBoxes)
+        return;
+
+    ASSERT_POINTER(boxes);
+    ASSERT_POINTER(visibilityMask);
+
+    const size_t numWords = (numBoxes + 31) / 32;
+
+    if (!cullingEnabled)
+    {
+        /* Mark all boxes as visible */
+        std::fill(visibilityMask, visibilityMask + numWords, ~0u);
+        return;
+    }
+
+    std::fill(visibilityMask, visibilityMask + numWords, 0u);
+
+    const auto& planes = viewFrustum_.planes;
+
+    size_t i = 0;
+
+    #if defined(FORK_ENABLE_AVX)
+
+    /* Test 8 boxes at once against each plane */
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    for (; i + 8 <= numBoxes; i += 8)
+    {
+        const auto b = boxes + i;
+
+        const __m256 minX = _mm256_set_ps(b[7].min.x, b[6].min.x, b[5].min.x, b[4].min.x, b[3].min.x, b[2].min.x, b[1].min.x, b[0].min.x);
+        const __m256 minY = _mm256_set_ps(b[7].min.y, b[6].min.y, b[5].min.y, b[4].min.y, b[3].min.y, b[2].min.y, b[1].min.y, b[0].min.y);
+        const __m256 minZ = _mm256_set_ps(b[7].min.z, b[6].min.z, b[5].min.z, b[4].min.z, b[3].min.z, b[2].min.z, b[1].min.z, b[0].min.z);
+        const __m256 maxX = _mm256_set_ps(b[7].max.x, b[6].max.x, b[5].max.x, b[4].max.x, b[3].max.x, b[2].max.x, b[1].max.x, b[0].max.x);
+        const __m256 maxY = _mm256_set_ps(b[7].max.y, b[6].max.y, b[5].max.y, b[4].max.y, b[3].max.y, b[2].max.y, b[1].max.y, b[0].max.y);
+        const __m256 maxZ = _mm256_set_ps(b[7].max.z, b[6].max.z, b[5].max.z, b[4].max.z, b[3].max.z, b[2].max.z, b[1].max.z, b[0].max.z);
+
+        /* Compute box centers and extents */
+        const __m256 centerX = _mm256_mul_ps(_mm256_add_ps(minX, maxX), half);
+        const __m256 centerY = _mm256_mul_ps(_mm256_add_ps(minY, maxY), half);
+        const __m256 centerZ = _mm256_mul_ps(_mm256_add_ps(minZ, maxZ), half);
+        const __m256 extentX = _mm256_mul_ps(_mm256_sub_ps(maxX, minX), half);
+        const __m256 extentY = _mm256_mul_ps(_mm256_sub_ps(maxY, minY), half);
+        const __m256 extentZ = _mm256_mul_ps(_mm256_sub_ps(maxZ, minZ), half);
+
+        __m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+        for (const auto& plane : planes)
+        {
+            /* Signed distance of the box center: dot(n, c) - d */
+            __m256 dist = _mm256_mul_ps(_mm256_set1_ps(plane.normal.x), centerX);
+            dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_set1_ps(plane.normal.y), centerY));
+            dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_set1_ps(plane.normal.z), centerZ));
+            dist = _mm256_sub_ps(dist, _mm256_set1_ps(plane.distance));
+
+            /* Projected box extent onto the plane normal: dot(|n|, e) */
+            __m256 radius = _mm256_mul_ps(_mm256_set1_ps(std::abs(plane.normal.x)), extentX);
+            radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_set1_ps(std::abs(plane.normal.y)), extentY));
+            radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_set1_ps(std::abs(plane.normal.z)), extentZ));
+
+            /* Box is outside if even the "p-vertex" lies behind the plane */
+            visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(dist, radius), zero, _CMP_GE_OQ));
+        }
+
+        visibilityMask[i / 32] |= (static_cast<unsigned int>(_mm256_movemask_ps(visible)) << (i % 32));
+    }
+
+    #elif defined(FORK_ENABLE_SSE2)
+
+    /* Test 4 boxes at once against each plane */
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; i + 4 <= numBoxes; i += 4)
+    {
+        const auto b = boxes + i;
+
+        const __m128 minX = _mm_set_ps(b[3].min.x, b[2].min.x, b[1].min.x, b[0].min.x);
+        const __m128 minY = _mm_set_ps(b[3].min.y, b[2].min.y, b[1].min.y, b[0].min.y);
+        const __m128 minZ = _mm_set_ps(b[3].min.z, b[2].min.z, b[1].min.z, b[0].min.z);
+        const __m128 maxX = _mm_set_ps(b[3].max.x, b[2].max.x, b[1].max.x, b[0].max.x);
+        const __m128 maxY = _mm_set_ps(b[3].max.y, b[2].max.y, b[1].max.y, b[0].max.y);
+        const __m128 maxZ = _mm_set_ps(b[3].max.z, b[2].max.z, b[1].max.z, b[0].max.z);
+
+        /* Compute box centers and extents */
+        const __m128 centerX = _mm_mul_ps(_mm_add_ps(minX, maxX), half);
+        const __m128 centerY = _mm_mul_ps(_mm_add_ps(minY, maxY), half);
+        const __m128 centerZ = _mm_mul_ps(_mm_add_ps(minZ, maxZ), half);
+        const __m128 extentX = _mm_mul_ps(_mm_sub_ps(maxX, minX), half);
+        const __m128 extentY = _mm_mul_ps(_mm_sub_ps(maxY, minY), half);
+        const __m128 extentZ = _mm_mul_ps(_mm_sub_ps(maxZ, minZ), half);
+
+        __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        for (const auto& plane : planes)
+        {
+            /* Signed distance of the box center: dot(n, c) - d */
+            __m128 dist = _mm_mul_ps(_mm_set1_ps(plane.normal.x), centerX);
+            dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.normal.y), centerY));
+            dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.normal.z), centerZ));
+            dist = _mm_sub_ps(dist, _mm_set1_ps(plane.distance));
+
+            /* Projected box extent onto the plane normal: dot(|n|, e) */
+            __m128 radius = _mm_mul_ps(_mm_set1_ps(std::abs(plane.normal.x)), extentX);
+            radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(std::abs(plane.normal.y)), extentY));
+            radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(std::abs(plane.normal.z)), extentZ));
+
+            /* Box is outside if even the "p-vertex" lies behind the plane */
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(dist, radius), zero));
+        }
+
+        visibilityMask[i / 32] |= (static_cast<unsigned int>(_mm_movemask_ps(visible)) << (i % 32));
+    }
+
+    #endif
+
+    /* Test remaining boxes with scalar fallback */
+    for (; i < numBoxes; ++i)
+    {
+        const auto& box = boxes[i];
+
+        const auto center = (box.min + box.max) * 0.5f;
+        const auto extent = (box.max - box.min) * 0.5f;
+
+        bool visible = true;
+
+        for (const auto& plane : planes)
+        {
+            const auto dist = Math::ComputeDistanceToPlane(plane, center);
+            const auto radius =
+                std::abs(plane.normal.x) * extent.x +
+                std::abs(plane.normal.y) * extent.y +
+                std::abs(plane.normal.z) * extent.z;
+
+            if (dist + radius < 0.0f)
+            {
+                visible = false;
+                break;
+            }
+        }
+
+        if (visible)
+            visibilityMask[i / 32] |= (1u << (i % 32));
+    }
+}
+
+void CullingManager::CullBoundingSpheres(const Math::Sphere<>* spheres, size_t numSpheres, unsigned int* visibilityMask) const
+{
+    if (!numSpheres)
+        return;
+
+    ASSERT_POINTER(spheres);
+    ASSERT_POINTER(visibilityMask);
+
+    const size_t numWords = (numSpheres + 31) / 32;
+
+    if (!cullingEnabled)
+    {
+        /* Mark all spheres as visible */
+        std::fill(visibilityMask, visibilityMask + numWords, ~0u);
+        return;
+    }
+
+    std::fill(visibilityMask, visibilityMask + numWords, 0u);
+
+    const auto& planes = viewFrustum_.planes;
+
+    size_t i = 0;
+
+    #if defined(FORK_ENABLE_SSE2)
+
+    /* Test 4 spheres at once against each plane */
+    for (; i + 4 <= numSpheres; i += 4)
+    {
+        const auto s = spheres + i;
+
+        const __m128 centerX = _mm_set_ps(s[3].point.x, s[2].point.x, s[1].point.x, s[0].point.x);
+        const __m128 centerY = _mm_set_ps(s[3].point.y, s[2].point.y, s[1].point.y, s[0].point.y);
+        const __m128 centerZ = _mm_set_ps(s[3].point.z, s[2].point.z, s[1].point.z, s[0].point.z);
+        const __m128 negRadius = _mm_set_ps(-s[3].radius, -s[2].radius, -s[1].radius, -s[0].radius);
+
+        __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        for (const auto& plane : planes)
+        {
+            /* Signed distance of the sphere center: dot(n, c) - d */
+            __m128 dist = _mm_mul_ps(_mm_set1_ps(plane.normal.x), centerX);
+            dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.normal.y), centerY));
+            dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.normal.z), centerZ));
+            dist = _mm_sub_ps(dist, _mm_set1_ps(plane.distance));
+
+            /* Same test as in "ConvexHull::IsSphereInside" */
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(dist, negRadius));
+        }
+
+        visibilityMask[i / 32] |= (static_cast<unsigned int>(_mm_movemask_ps(visible)) << (i % 32));
+    }
+
+    #endif
+
+    /* Test remaining spheres with scalar fallback */
+    for (; i < numSpheres; ++i)
+    {
+        if (viewFrustum_.IsSphereInside(spheres[i]))
+            visibilityMask[i / 32] |= (1u << (i % 32));
+    }
 }
 
 
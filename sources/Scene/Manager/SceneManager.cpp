@@ -8,11 +8,19 @@
 #include "Scene/Manager/SceneManager.h"
 #include "Scene/FileHandler/ModelFileHandler.h"
 #include "Scene/Geometry/Node/Simple3DMeshGeometry.h"
+#include "Scene/Geometry/Node/TangentSpaceMeshGeometry.h"
+#include "Scene/Geometry/Node/CompositionGeometry.h"
+#include "Scene/Geometry/Node/TexturedGeometry.h"
 #include "Scene/Node/CameraNode.h"
 #include "Scene/Node/LightNode.h"
+#include "Video/RenderSystem/RenderSystem.h"
+#include "Math/Common/Transform.h"
+#include "Core/Jobs/JobSystem.h"
 #include "Core/STLHelper.h"
+#include "IO/Core/Log.h"
 
 #include <algorithm>
+#include <exception>
 
 
 namespace Fork
@@ -22,6 +30,64 @@ namespace Scene
 {
 
 
+/* === Internal functions === */
+
+//! Collects all meshes of the geometry graph, whose hardware buffers are created by the asynchronous loads.
+static void CollectMeshGeometries(Geometry* geometry, std::vector<Geometry*>& meshes)
+{
+    if (!geometry)
+        return;
+
+    switch (geometry->Type())
+    {
+        case Geometry::Types::Simple3DMesh:
+        case Geometry::Types::TangentSpaceMesh:
+            meshes.push_back(geometry);
+            break;
+
+        case Geometry::Types::Composition:
+            for (const auto& subGeometry : static_cast<CompositionGeometry*>(geometry)->subGeometries)
+                CollectMeshGeometries(subGeometry.get(), meshes);
+            break;
+
+        case Geometry::Types::Textured:
+            CollectMeshGeometries(static_cast<TexturedGeometry*>(geometry)->actualGeometry.get(), meshes);
+            break;
+
+        default:
+            break;
+    }
+}
+
+template <class Geom> size_t SetupMeshHardwareBuffer(Geometry* geometry)
+{
+    auto mesh = static_cast<Geom*>(geometry);
+
+    if (mesh->vertices.empty())
+        return 0;
+
+    mesh->EnsureHardwareBuffer();
+
+    return mesh->vertices.size()*sizeof(mesh->vertices[0]) + mesh->indices.size()*sizeof(mesh->indices[0]);
+}
+
+//! Creates the hardware buffer for the specified mesh and returns the number of uploaded bytes.
+static size_t SetupMeshHardwareBuffer(Geometry* geometry)
+{
+    switch (geometry->Type())
+    {
+        case Geometry::Types::Simple3DMesh:
+            return SetupMeshHardwareBuffer<Simple3DMeshGeometry>(geometry);
+        case Geometry::Types::TangentSpaceMesh:
+            return SetupMeshHardwareBuffer<TangentSpaceMeshGeometry>(geometry);
+        default:
+            return 0;
+    }
+}
+
+
+/* === Class implementation === */
+
 SceneManager::~SceneManager()
 {
 }
@@ -51,6 +117,79 @@ GeometryPtr SceneManager::LoadGeometry(const std::string& filename, const ModelR
     return CreateGeometryFromFile(filename, flags);
 }
 
+AsyncGeometryPtr SceneManager::LoadGeometryAsync(const std::string& filename, const ModelReader::Flags::DataType flags)
+{
+    if (flags == 0)
+    {
+        /* Check if model already exists */
+        auto geometry = geometries.Find(filename);
+        if (geometry)
+        {
+            auto handle = std::make_shared<AsyncGeometry>();
+            handle->Resolve(geometry);
+            return handle;
+        }
+
+        /* Check if model is already loading */
+        for (const auto& load : asyncLoads_)
+        {
+            if (load->flags == 0 && load->filename == filename)
+                return load->handle;
+        }
+    }
+
+    /* Create new asynchronous load */
+    auto load = std::make_shared<AsyncGeometryLoad>();
+    {
+        load->filename  = filename;
+        load->flags     = flags;
+        load->handle    = std::make_shared<AsyncGeometry>();
+    }
+    asyncLoads_.push_back(load);
+
+    /* Read model file on the job system (jobs must not throw exceptions) */
+    const auto texPathDict = texturePathDict;
+
+    Jobs::JobSystem::Instance()->Submit(
+        [load, texPathDict]()
+        {
+            try
+            {
+                load->model = ModelFileHandler::ReadModelDeferred(load->filename, texPathDict, load->flags, load->resources);
+            }
+            catch (const std::exception& err)
+            {
+                IO::Log::Error(err.what());
+                load->model = nullptr;
+            }
+        },
+        &load->counter
+    );
+
+    return load->handle;
+}
+
+size_t SceneManager::CommitAsyncLoads(size_t byteBudget)
+{
+    /* Commit decoded textures first, since the geometries are waiting for them */
+    auto renderSystem = Video::RenderSystem::Active();
+    if (renderSystem)
+        renderSystem->GetTextureManager()->CommitAsyncTextures(byteBudget);
+
+    /* Advance all asynchronous geometry loads */
+    size_t numUploadedBytes = 0;
+
+    for (auto it = asyncLoads_.begin(); it != asyncLoads_.end();)
+    {
+        if (CommitAsyncLoad(*it, byteBudget, numUploadedBytes))
+            it = asyncLoads_.erase(it);
+        else
+            ++it;
+    }
+
+    return asyncLoads_.size();
+}
+
 GeometryGenerator::GeometryTypePtr SceneManager::GenerateCube(const GeometryGenerator::CubeDescription& desc)
 {
     return GenerateBasicGeometry(GeometryGenerator::GenerateCube, desc, basicGeometryContainer.cube);
@@ -100,7 +239,12 @@ GeometryGenerator::GeometryTypePtr SceneManager::GenerateCapsule(const GeometryG
 
 GeometryNodePtr SceneManager::CreateGeometryNode()
 {
-    return AddSceneNode(std::make_shared<Scene::GeometryNode>());
+    auto sceneNode = AddSceneNode(std::make_shared<Scene::GeometryNode>());
+
+    /* Register node for the bounding volume hierarchy (the proxy is inserted on the next update) */
+    geometryNodeProxies_[sceneNode.get()] = { sceneNode.get(), BoundingVolumeHierarchy::invalidProxy };
+
+    return sceneNode;
 }
 
 GeometryNodePtr SceneManager::CreateGeometryNode(const GeometryPtr& geometry)
@@ -136,6 +280,15 @@ LightNodePtr SceneManager::CreateLightNode(const LightSourcePtr& lightSource)
 
 void SceneManager::ReleaseSceneNode(const SceneNode* sceneNode)
 {
+    /* Remove node from the bounding volume hierarchy */
+    auto it = geometryNodeProxies_.find(sceneNode);
+    if (it != geometryNodeProxies_.end())
+    {
+        if (it->second.proxy != BoundingVolumeHierarchy::invalidProxy)
+            boundingVolumeHierarchy_.RemoveProxy(it->second.proxy);
+        geometryNodeProxies_.erase(it);
+    }
+
     RemoveFromListIf(
         sceneNodes,
         [&sceneNode](const SceneNodePtr& entry)
@@ -148,6 +301,36 @@ void SceneManager::ReleaseSceneNode(const SceneNode* sceneNode)
 void SceneManager::ReleaseAllSceneNodes()
 {
     sceneNodes.clear();
+    geometryNodeProxies_.clear();
+    boundingVolumeHierarchy_.Clear();
+}
+
+/* --- Spatial functions --- */
+
+void SceneManager::UpdateBoundingVolumeHierarchy()
+{
+    for (auto& entry : geometryNodeProxies_)
+    {
+        auto& nodeProxy = entry.second;
+        const auto& geometry = nodeProxy.node->geometry;
+
+        if (geometry && geometry->boundingVolume.box.IsValid())
+        {
+            /* Transform bounding box into world space */
+            const auto box = Math::Transform(nodeProxy.node->CachedGlobalTransform(), geometry->boundingVolume.box);
+
+            if (nodeProxy.proxy == BoundingVolumeHierarchy::invalidProxy)
+                nodeProxy.proxy = boundingVolumeHierarchy_.InsertProxy(box, nodeProxy.node);
+            else
+                boundingVolumeHierarchy_.MoveProxy(nodeProxy.proxy, box);
+        }
+        else if (nodeProxy.proxy != BoundingVolumeHierarchy::invalidProxy)
+        {
+            /* Remove node without bounding box from the hierarchy */
+            boundingVolumeHierarchy_.RemoveProxy(nodeProxy.proxy);
+            nodeProxy.proxy = BoundingVolumeHierarchy::invalidProxy;
+        }
+    }
 }
 
 
@@ -175,6 +358,91 @@ GeometryGenerator::GeometryTypePtr SceneManager::GenerateBasicGeometry(GenProc g
     return meshGeometry;
 }
 
+bool SceneManager::CommitAsyncLoad(const AsyncGeometryLoadPtr& load, size_t byteBudget, size_t& numUploadedBytes)
+{
+    typedef AsyncGeometryLoad::States States;
+
+    /* Wait until the job of the current state is finished */
+    if (!load->counter.IsDone())
+        return false;
+
+    switch (load->state)
+    {
+        case States::Reading:
+        {
+            if (!load->model)
+            {
+                load->handle->Fail("Loading model \"" + load->filename + "\" failed");
+                return true;
+            }
+            load->state = States::LoadingTextures;
+        }
+        // no break: continue with the next state
+
+        case States::LoadingTextures:
+        {
+            if (!load->resources.AreTexturesLoaded())
+                return false;
+
+            /* Finalize model on the job system, since the geometry graph optimization can be expensive */
+            load->state = States::Finalizing;
+
+            Jobs::JobSystem::Instance()->Submit(
+                [load]()
+                {
+                    try
+                    {
+                        ModelFileHandler::FinalizeDeferredModel(load->model, load->resources);
+                    }
+                    catch (const std::exception& err)
+                    {
+                        IO::Log::Error(err.what());
+                    }
+                },
+                &load->counter
+            );
+        }
+        return false;
+
+        case States::Finalizing:
+        {
+            CollectMeshGeometries(load->model.get(), load->meshes);
+            load->state = States::Uploading;
+        }
+        // no break: continue with the next state
+
+        case States::Uploading:
+        {
+            /* Create the hardware buffers within the byte budget */
+            try
+            {
+                while (load->numUploadedMeshes < load->meshes.size())
+                {
+                    if (byteBudget > 0 && numUploadedBytes >= byteBudget)
+                        return false;
+                    numUploadedBytes += SetupMeshHardwareBuffer(load->meshes[load->numUploadedMeshes++]);
+                }
+            }
+            catch (const std::exception& err)
+            {
+                IO::Log::Error(err.what());
+                load->handle->Fail("Creating hardware buffers for model \"" + load->filename + "\" failed");
+                return true;
+            }
+
+            /* Share geometry like in "LoadGeometry" */
+            if (load->flags == 0)
+                geometries.hashMap[load->filename] = load->model;
+
+            load->meshes.clear();
+            load->handle->Resolve(load->model);
+        }
+        return true;
+    }
+
+    return true;
+}
+
 
 } // /namespace Scene
 
@@ -7,8 +7,13 @@
 
 #include "Scene/Manager/SceneNodeSorter.h"
 #include "Scene/Node/SceneNode.h"
+#include "Scene/Node/GeometryNode.h"
+#include "Scene/Geometry/Node/CompositionGeometry.h"
+#include "Scene/Geometry/Node/TexturedGeometry.h"
+#include "Video/Material/Material.h"
+#include "Core/Container/RadixSort.h"
 
-#include <algorithm>
+#include <cstdint>
 
 
 namespace Fork
@@ -21,52 +26,112 @@ namespace SceneNodeSorter
 {
 
 
-/* === Internal functions === */
-
-static Math::Matrix4f invCompareMatrix;
+/* === Internal structures === */
 
-static bool CompareSceneNodesLocalNearToFar(const SceneNodePtr& nodeA, const SceneNodePtr& nodeB)
+//! Sort entry with a precomputed 64-bit key and the index into the original scene node list.
+struct SortEntry
+{
+    std::uint64_t   key;
+    size_t          index;
+};
+
+/**
+Scene visitor to gather the render states of a scene node which are relevant for sorting.
+This is a local object for each sort call, so no mutable state is shared between threads.
+*/
+class SortStateVisitor : public SceneVisitor
 {
-    const auto posA = invCompareMatrix * nodeA->LocalTransform().GetPosition();
-    const auto posB = invCompareMatrix * nodeB->LocalTransform().GetPosition();
+    
+    public:
+        
+        void VisitGeometryNode(GeometryNode* node) override
+        {
+            shader = node->shaderComposition.get();
+            if (node->geometry)
+                node->geometry->Visit(this);
+        }
 
-    return posA < posB;
-}
+        void VisitCompositionGeometry(CompositionGeometry* node) override
+        {
+            for (const auto& subGeom : node->subGeometries)
+                subGeom->Visit(this);
+        }
 
-static bool CompareSceneNodesLocalFarToNear(const SceneNodePtr& nodeA, const SceneNodePtr& nodeB)
-{
-    const auto posA = invCompareMatrix * nodeA->LocalTransform().GetPosition();
-    const auto posB = invCompareMatrix * nodeB->LocalTransform().GetPosition();
+        void VisitTexturedGeometry(TexturedGeometry* node) override
+        {
+            if (node->shaderComposition)
+                shader = node->shaderComposition.get();
 
-    return posA > posB;
-}
+            for (const auto& tex : node->textures)
+                textureHash = HashPointer(textureHash, tex.get());
 
-static bool CompareSceneNodesLocalOpaqueToTransparent(const SceneNodePtr& nodeA, const SceneNodePtr& nodeB)
-{
-    //todo ...
-    return false;
-}
+            if (node->material && node->material->Color().a < 1.0f)
+                isTransparent = true;
+        }
 
-static bool CompareSceneNodesGlobalNearToFar(const SceneNodePtr& nodeA, const SceneNodePtr& nodeB)
-{
-    const auto posA = invCompareMatrix * nodeA->GlobalTransform().GetPosition();
-    const auto posB = invCompareMatrix * nodeB->GlobalTransform().GetPosition();
+        static std::uint32_t HashPointer(std::uint32_t hash, const void* ptr)
+        {
+            /* FNV-1a hash over the bytes of the pointer value */
+            auto value = reinterpret_cast<std::uintptr_t>(ptr);
+            for (size_t i = 0; i < sizeof(value); ++i)
+            {
+                hash ^= static_cast<std::uint32_t>(value & 0xff);
+                hash *= 16777619u;
+                value >>= 8;
+            }
+            return hash;
+        }
 
-    return posA < posB;
-}
+        const void*     shader          = nullptr;
+        std::uint32_t   textureHash     = 2166136261u;
+        bool            isTransparent   = false;
 
-static bool CompareSceneNodesGlobalFarToNear(const SceneNodePtr& nodeA, const SceneNodePtr& nodeB)
-{
-    const auto posA = invCompareMatrix * nodeA->GlobalTransform().GetPosition();
-    const auto posB = invCompareMatrix * nodeB->GlobalTransform().GetPosition();
+};
 
-    return posA > posB;
-}
 
-static bool CompareSceneNodesGlobalOpaqueToTransparent(const SceneNodePtr& nodeA, const SceneNodePtr& nodeB)
+/* === Internal functions === */
+
+/**
+Generates the sort key for the specified scene node. The key is composed as follows (from MSB to LSB):
+- 1 bit: Transparency (only for SortMethods::OpaqueToTransparent).
+- 32 bits: View depth (inverted for far-to-near ordering).
+- 31 bits: Render state hash (16 bits for the shader, 15 bits for the textures),
+  to group nodes with equal render states within the same depth.
+For opaque objects in SortMethods::OpaqueToTransparent, the depth is reduced to 16 bits (approximately 1% relative depth resolution),
+so that render states are grouped within these depth layers while the objects are still sorted (roughly) from near to far.
+*/
+static std::uint64_t GenerateSortKey(
+    SceneNode* node, const Math::Matrix4f& invCompareMatrix, const SortMethods method, bool isGlobal)
 {
-    //todo ...
-    return false;
+    /* Compute view depth */
+    const auto position = (isGlobal ? node->GlobalTransform().GetPosition() : node->LocalTransform().GetPosition());
+    const auto depth = FloatToOrderedBits((invCompareMatrix * position).z);
+
+    /* Gather render states */
+    SortStateVisitor visitor;
+    node->Visit(&visitor);
+
+    const auto shaderHash = SortStateVisitor::HashPointer(2166136261u, visitor.shader);
+    const auto stateHash = ((shaderHash & 0xffffu) << 15) | (visitor.textureHash & 0x7fffu);
+
+    /* Compose sort key */
+    std::uint64_t depthKey = depth;
+
+    switch (method)
+    {
+        case SortMethods::NearToFar:
+            break;
+        case SortMethods::FarToNear:
+            depthKey = ~depth;
+            break;
+        case SortMethods::OpaqueToTransparent:
+            if (visitor.isTransparent)
+                return (1ull << 63) | (static_cast<std::uint64_t>(~depth) << 31) | stateHash;
+            depthKey = (depth & 0xffff0000u);
+            break;
+    }
+
+    return (depthKey << 31) | stateHash;
 }
 
 
@@ -75,38 +140,34 @@ static bool CompareSceneNodesGlobalOpaqueToTransparent(const SceneNodePtr& nodeA
 FORK_EXPORT void SortSceneNodes(
     std::vector<SceneNodePtr>& sceneNodes, const Math::Transform3Df& compareTransform, const SortMethods method, bool isGlobal)
 {
+    if (sceneNodes.size() < 2)
+        return;
+
+    Math::Matrix4f invCompareMatrix;
     compareTransform.GetMatrix().Inverse(invCompareMatrix);
 
-    if (isGlobal)
-    {
-        switch (method)
-        {
-            case SortMethods::NearToFar:
-                std::sort(sceneNodes.begin(), sceneNodes.end(), CompareSceneNodesGlobalNearToFar);
-                break;
-            case SortMethods::FarToNear:
-                std::sort(sceneNodes.begin(), sceneNodes.end(), CompareSceneNodesGlobalFarToNear);
-                break;
-            case SortMethods::OpaqueToTransparent:
-                std::sort(sceneNodes.begin(), sceneNodes.end(), CompareSceneNodesGlobalOpaqueToTransparent);
-                break;
-        }
-    }
-    else
+    /* Compute sort key for each scene node only once */
+    const size_t numNodes = sceneNodes.size();
+
+    std::vector<SortEntry> entries(numNodes);
+
+    for (size_t i = 0; i < numNodes; ++i)
     {
-        switch (method)
-        {
-            case SortMethods::NearToFar:
-                std::sort(sceneNodes.begin(), sceneNodes.end(), CompareSceneNodesLocalNearToFar);
-                break;
-            case SortMethods::FarToNear:
-                std::sort(sceneNodes.begin(), sceneNodes.end(), CompareSceneNodesLocalFarToNear);
-                break;
-            case SortMethods::OpaqueToTransparent:
-                std::sort(sceneNodes.begin(), sceneNodes.end(), CompareSceneNodesLocalOpaqueToTransparent);
-                break;
-        }
+        entries[i].key = GenerateSortKey(sceneNodes[i].get(), invCompareMatrix, method, isGlobal);
+        entries[i].index = i;
     }
+
+    /* Sort keys in linear time */
+    std::vector<SortEntry> tempEntries;
+    RadixSortByKey(entries, tempEntries);
+
+    /* Re-arrange scene nodes */
+    std::vector<SceneNodePtr> sortedNodes(numNodes);
+
+    for (size_t i = 0; i < numNodes; ++i)
+        sortedNodes[i] = std::move(sceneNodes[entries[i].index]);
+
+    sceneNodes.swap(sortedNodes);
 }
 
 
@@ -118,4 +179,4 @@ FORK_EXPORT void SortSceneNodes(
 
 
 
-// ========================
\ No newline at end of file
+// ========================
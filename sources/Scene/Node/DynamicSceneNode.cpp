@@ -26,19 +26,36 @@ const Math::Matrix4f& DynamicSceneNode::LocalTransform() const
 
 void DynamicSceneNode::GlobalTransform(Math::Matrix4f& matrix) const
 {
-    if (GetParent())
-        GetParent()->GlobalTransform(matrix);
-    matrix *= transform.GetMatrix();
+    matrix *= CachedGlobalTransform();
 }
 
 Math::Matrix4f DynamicSceneNode::GlobalTransform() const
 {
     /*
-    Just return base function to support easy function access,
-    i.e. this will avoid that the client programmer needs to write:
+    Return the cached matrix directly, instead of multiplying it with an identity matrix,
+    this also avoids that the client programmer needs to write:
     "dynamicSceneNode->Scene::SceneNode::GlobalTransform()"
     */
-    return SceneNode::GlobalTransform();
+    return CachedGlobalTransform();
+}
+
+const Math::Matrix4f& DynamicSceneNode::CachedGlobalTransform() const
+{
+    /* Make sure the parent's cache is up-to-date (only compares revisions, if nothing has changed) */
+    const GlobalTransformCache* parentCache = nullptr;
+
+    auto parent = DynamicParent();
+    if (parent)
+    {
+        parent->CachedGlobalTransform();
+        parentCache = &(parent->globalTransformCache_);
+    }
+
+    /* Update cache of this node if necessary */
+    if (globalTransformCache_.IsOutdated(transform, parentCache))
+        globalTransformCache_.Update(transform, parentCache);
+
+    return globalTransformCache_.GetMatrix();
 }
 
 bool DynamicSceneNode::HasTransform() const
@@ -47,6 +64,36 @@ bool DynamicSceneNode::HasTransform() const
 }
 
 
+/*
+ * ======= Protected: =======
+ */
+
+void DynamicSceneNode::UpdateGlobalTransformCache()
+{
+    /* Parent's cache is already up-to-date in a top-down pass */
+    auto parent = DynamicParent();
+    auto parentCache = (parent != nullptr ? &(parent->globalTransformCache_) : nullptr);
+
+    if (globalTransformCache_.IsOutdated(transform, parentCache))
+        globalTransformCache_.Update(transform, parentCache);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+const DynamicSceneNode* DynamicSceneNode::DynamicParent() const
+{
+    /*
+    Only dynamic scene nodes have a transformation,
+    for all other scene nodes the global transformation chain ends here.
+    */
+    auto parent = GetParent();
+    return (parent != nullptr && parent->HasTransform()) ? static_cast<const DynamicSceneNode*>(parent) : nullptr;
+}
+
+
 } // /namespace Scene
 
 } // /namespace Fork
@@ -0,0 +1,82 @@
+/*
+ * Parallel scene visitor file
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Scene/Node/ParallelSceneVisitor.h"
+#include "Scene/Node/SceneNode.h"
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+ParallelSceneVisitor::ParallelSceneVisitor(Jobs::JobSystem* jobSystem, unsigned int splitDepth) :
+    jobSystem_  { jobSystem ? jobSystem : Jobs::JobSystem::Instance() },
+    splitDepth_ { splitDepth                                          }
+{
+}
+
+void ParallelSceneVisitor::VisitParallel(SceneNode* sceneGraph)
+{
+    if (sceneGraph)
+    {
+        root_ = sceneGraph;
+        sceneGraph->Visit(this);
+        root_ = nullptr;
+    }
+}
+
+
+/*
+ * ======= Protected: =======
+ */
+
+void ParallelSceneVisitor::VisitSceneNodeChildren(SceneNode* node)
+{
+    const auto& children = node->GetChildren();
+
+    if (children.size() > 1 && root_ && NodeDepth(node) < splitDepth_)
+    {
+        /* Visit independent child subtrees in parallel */
+        jobSystem_->ParallelFor(
+            0, children.size(),
+            [&](size_t i)
+            {
+                children[i]->Visit(this);
+            },
+            grainSize
+        );
+    }
+    else
+        DefaultSceneVisitor::VisitSceneNodeChildren(node);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+unsigned int ParallelSceneVisitor::NodeDepth(const SceneNode* node) const
+{
+    unsigned int depth = 0;
+
+    for (; node && node != root_; node = node->GetParent())
+        ++depth;
+
+    return depth;
+}
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+
+// ========================
@@ -6,6 +6,7 @@
  */
 
 #include "Scene/Node/SceneNode.h"
+#include "Core/Jobs/JobSystem.h"
 
 
 namespace Fork
@@ -44,6 +45,27 @@ Math::Matrix4f SceneNode::GlobalTransform() const
     return matrix;
 }
 
+void SceneNode::UpdateGlobalTransforms()
+{
+    /* Update this node first, then all children (top-down) */
+    UpdateGlobalTransformCache();
+    for (auto& child : children_)
+        child->UpdateGlobalTransforms();
+}
+
+void SceneNode::UpdateGlobalTransforms(Jobs::JobSystem& jobSystem)
+{
+    /* Update this node first, then the child subtrees in parallel (each subtree is independent) */
+    UpdateGlobalTransformCache();
+    jobSystem.ParallelFor(
+        0, children_.size(),
+        [this](size_t i)
+        {
+            children_[i]->UpdateGlobalTransforms();
+        }
+    );
+}
+
 bool SceneNode::HasTransform() const
 {
     return false;
@@ -108,6 +130,16 @@ void SceneNode::SetupParent(const SceneNodePtr& sceneNode, SceneNode* parent)
 }
 
 
+/*
+ * ======= Protected: =======
+ */
+
+void SceneNode::UpdateGlobalTransformCache()
+{
+    /* Dummy */
+}
+
+
 } // /namespace Scene
 
 } // /namespace Fork
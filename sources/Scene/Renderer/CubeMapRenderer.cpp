@@ -60,6 +60,15 @@ void CubeMapRenderer::RenderCubeMap(
     RenderCtx()->SetupProjectionMatrix(projection);
     sceneRenderer->cullingManager.SetupProjectionMatrix(projection);
 
+    /*
+    All cube map faces share the same LOD selection (same position and projection).
+    The projection viewport only determines the aspect ratio, so the face size must be passed explicitly.
+    */
+    ASSERT_POINTER(cubeFaces.xPositive);
+    sceneRenderer->lodSelector.SetupView(
+        this, sceneRenderer->globalCameraPosition, projection, cubeFaces.xPositive->GetSize().height
+    );
+
     /* Render cube map faces */
     RenderCubeMapFace(Video::TextureCube::Faces::XPositive, cubeFaces.xPositive, sceneRenderer, sceneGraph, cameraTransform, clearFlags);
     RenderCubeMapFace(Video::TextureCube::Faces::XNegative, cubeFaces.xNegative, sceneRenderer, sceneGraph, cameraTransform, clearFlags);
@@ -19,11 +19,35 @@ namespace Scene
 {
 
 
+/* --- Internal functions --- */
+
+//! Returns true if the specified node and all its parents (up to the scene graph root) are enabled.
+static bool IsNodeEnabledInGraph(const SceneNode* node, const SceneNode* sceneGraph)
+{
+    for (; node; node = node->GetParent())
+    {
+        if (node == sceneGraph)
+            return true;
+        if (!node->isEnabled)
+            return false;
+    }
+    /* Node is not attached to the scene graph root */
+    return (sceneGraph == nullptr);
+}
+
+
 void ForwardSceneRenderer::RenderScene(SceneNode* sceneGraph)
 {
     if (!sceneGraph)
         return;
 
+    /* Cull geometry nodes with the scene hierarchy (if available) */
+    if (sceneHierarchy)
+    {
+        RenderSceneHierarchy(*sceneHierarchy, sceneGraph);
+        return;
+    }
+
     prevShader_ = RenderCtx()->GetRenderState().shaderComposition;
 
     for (auto& child : sceneGraph->GetChildren())
@@ -31,12 +55,36 @@ void ForwardSceneRenderer::RenderScene(SceneNode* sceneGraph)
         if (child->isEnabled)
         {
             /* Store global position of the current scene node and visit the node */
-            globalSceneNodePosition = child->LocalTransform().GetPosition();
+            globalSceneNodePosition = child->GlobalTransform().GetPosition();
             child->Visit(this);
         }
     }
 }
 
+void ForwardSceneRenderer::RenderSceneHierarchy(const BoundingVolumeHierarchy& hierarchy, const SceneNode* sceneGraph)
+{
+    prevShader_ = RenderCtx()->GetRenderState().shaderComposition;
+
+    /* Collect all geometry nodes inside the view frustum */
+    visibleNodes_.clear();
+    hierarchy.QueryFrustum(cullingManager.GetViewFrustum(), visibleNodes_);
+
+    /* Render nodes with the same global transformations, the hierarchy has been built with */
+    useGlobalTransforms_ = true;
+
+    for (auto node : visibleNodes_)
+    {
+        if (IsNodeEnabledInGraph(node, sceneGraph))
+        {
+            /* Store global position of the current scene node and visit the node */
+            globalSceneNodePosition = node->CachedGlobalTransform().GetPosition();
+            node->Visit(this);
+        }
+    }
+
+    useGlobalTransforms_ = false;
+}
+
 void ForwardSceneRenderer::VisitGeometryNode(GeometryNode* node)
 {
     if (node->geometry)
@@ -44,7 +92,9 @@ void ForwardSceneRenderer::VisitGeometryNode(GeometryNode* node)
         auto renderContext = RenderCtx();
 
         /* Setup world matrix for current scene node */
-        SetupWorldMatrix(node->LocalTransform());
+        worldMatrix_ = (useGlobalTransforms_ ? node->CachedGlobalTransform() : node->LocalTransform());
+        SetupWorldMatrix(worldMatrix_);
+        geometryNode_ = node;
 
         if (cullingManager.IsBoundingVolumeInsideFrustum(node->geometry->boundingVolume))
         {
@@ -66,13 +116,13 @@ void ForwardSceneRenderer::VisitGeometryNode(GeometryNode* node)
 
 void ForwardSceneRenderer::VisitLODGeometry(LODGeometry* node)
 {
-    /*
-    Compute distance between camera and scene node
-    -> Then select detail level (LOD)
-    */
-    float distance = Math::Distance(globalCameraPosition, globalSceneNodePosition);
+    if (node->lodGeometries.empty() || !geometryNode_)
+        return;
+
+    /* Select detail level (LOD) by the projected size of the geometry node */
+    const auto level = lodSelector.SelectLevel(*node, geometryNode_, worldMatrix_);
 
-    auto geometry = node->SelectLOD(distance);
+    auto geometry = node->lodGeometries[level].get();
     if (geometry && cullingManager.IsBoundingVolumeInsideFrustum(geometry->boundingVolume))
         geometry->Visit(this);
 }
@@ -0,0 +1,105 @@
+/*
+ * Instance batcher file
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Scene/Renderer/InstanceBatcher.h"
+
+#include <algorithm>
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+void InstanceBatcher::Build(const RenderQueue& queue)
+{
+    Clear();
+
+    const auto numPackets = queue.NumPackets();
+    const auto maxInstances = std::max(1u, maxNumInstances);
+
+    for (size_t first = 0; first < numPackets;)
+    {
+        const auto& firstPacket = queue.GetPacket(first);
+
+        /* Find end of the group of packets, which can be batched with the first packet */
+        auto last = first + 1;
+
+        while (last < numPackets && last - first < maxInstances && CanBatch(firstPacket, queue.GetPacket(last)))
+            ++last;
+
+        const auto count = static_cast<unsigned int>(last - first);
+
+        if (count >= minNumInstances && count > 1)
+        {
+            /* Add instanced batch and pack world matrices */
+            InstanceBatch batch;
+            {
+                batch.firstPacket   = first;
+                batch.numInstances  = count;
+                batch.firstInstance = instanceMatrices_.size();
+            }
+            batches_.push_back(batch);
+
+            for (auto i = first; i < last; ++i)
+                instanceMatrices_.push_back(queue.GetPacket(i).worldMatrix);
+        }
+        else
+        {
+            /* Add single batches for each packet */
+            for (auto i = first; i < last; ++i)
+            {
+                InstanceBatch batch;
+                batch.firstPacket = i;
+                batches_.push_back(batch);
+            }
+        }
+
+        first = last;
+    }
+}
+
+void InstanceBatcher::Clear()
+{
+    batches_.clear();
+    instanceMatrices_.clear();
+}
+
+bool InstanceBatcher::CanBatch(const DrawPacket& lhs, const DrawPacket& rhs)
+{
+    if ( lhs.instancedShader == nullptr             ||
+         lhs.instancedShader != rhs.instancedShader ||
+         lhs.shader          != rhs.shader          ||
+         lhs.vertexBuffer    != rhs.vertexBuffer    ||
+         lhs.indexBuffer     != rhs.indexBuffer     ||
+         lhs.primitive       != rhs.primitive       ||
+         lhs.numVertices     != rhs.numVertices     ||
+         lhs.numIndices      != rhs.numIndices      ||
+         lhs.numTextures     != rhs.numTextures )
+    {
+        return false;
+    }
+
+    for (unsigned int layer = 0; layer < lhs.numTextures && layer < DrawPacket::maxNumTextures; ++layer)
+    {
+        if (lhs.textures[layer] != rhs.textures[layer])
+            return false;
+    }
+
+    return true;
+}
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+
+// ========================
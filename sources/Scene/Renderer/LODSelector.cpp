@@ -0,0 +1,248 @@
+/*
+ * LOD selector file
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Scene/Renderer/LODSelector.h"
+#include "Scene/Geometry/Node/LODGeometry.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Math/Core/MathConstants.h"
+
+#include <algorithm>
+#include <functional>
+#include <cmath>
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+static const size_t invalidLODLevel = ~size_t(0);
+
+void LODSelector::SetupView(const void* view, const Math::Point3f& cameraPosition, const Projection& projection, int screenHeight)
+{
+    /* Activate view and release the states which are no longer used */
+    ++setupCounter_;
+
+    activeView_ = &(views_[view]);
+    activeView_->lastSetup = setupCounter_;
+
+    ReleaseUnusedStates();
+
+    cameraPosition_ = cameraPosition;
+
+    /* Compute reference projection scale (in pixels per unit at distance 1) */
+    const auto referenceScale = referenceScreenHeight / (2.0f * std::tan(referenceFieldOfView * 0.5f));
+
+    if (screenHeight <= 0)
+        screenHeight = projection.GetViewport().size.height;
+
+    const auto viewHeight = static_cast<float>(std::max(1, screenHeight));
+
+    isOrtho_ = projection.GetOrtho();
+
+    if (isOrtho_)
+    {
+        /* Projection scale of an orthogonal projection is independent of the distance (in pixels per unit) */
+        const auto orthoHeight = std::max(Math::epsilon, projection.GetOrthoSize().height);
+        projectionScale_ = referenceScale / (viewHeight / orthoHeight);
+    }
+    else
+    {
+        const auto fov = std::max(Math::epsilon, projection.GetFOV());
+        projectionScale_ = referenceScale / (viewHeight / (2.0f * std::tan(fov * 0.5f)));
+    }
+}
+
+size_t LODSelector::SelectLevel(const LODGeometry& geometry, const void* instance, const Math::Matrix4f& worldMatrix)
+{
+    auto& state = FetchState(geometry, instance);
+    state.level = ComputeLevel(geometry, worldMatrix, state.level);
+    return state.level;
+}
+
+void LODSelector::SelectLevels(std::vector<LODRequest>& requests)
+{
+    /* Fetch all selection states first, since they are created on demand */
+    requestStates_.resize(requests.size());
+
+    for (size_t i = 0, n = requests.size(); i < n; ++i)
+    {
+        const auto& req = requests[i];
+        requestStates_[i] = &FetchState(*req.geometry, req.instance);
+    }
+
+    /* Compute levels in parallel (the states are only read here) */
+    Jobs::JobSystem::Instance()->ParallelFor(
+        0, requests.size(),
+        [&](size_t i)
+        {
+            auto& req = requests[i];
+            req.level = ComputeLevel(*req.geometry, req.worldMatrix, requestStates_[i]->level);
+        },
+        64
+    );
+
+    /* Store new selection states */
+    for (size_t i = 0, n = requests.size(); i < n; ++i)
+        requestStates_[i]->level = requests[i].level;
+}
+
+float LODSelector::ReferenceDistance(const LODGeometry& geometry, const Math::Matrix4f& worldMatrix) const
+{
+    /* Get maximal scaling of the instance, since the bounding sphere must enclose the scaled geometry */
+    const auto scale = worldMatrix.GetScale();
+    const auto maxScale = std::max(Math::epsilon, std::max(scale.x, std::max(scale.y, scale.z)));
+
+    if (isOrtho_)
+        return projectionScale_ / maxScale;
+
+    /* Compute distance to the bounding sphere center in world space */
+    const auto center = worldMatrix * geometry.boundingVolume.sphere.point;
+    const auto distance = Math::Distance(cameraPosition_, center);
+
+    /*
+    Projected radius is (radius * maxScale * currentScale / distance),
+    so the reference view has the same projected radius at (distance * referenceScale / (currentScale * maxScale))
+    */
+    return distance * projectionScale_ / maxScale;
+}
+
+void LODSelector::Clear()
+{
+    views_.clear();
+    activeView_ = nullptr;
+}
+
+void LODSelector::ReleaseView(const void* view)
+{
+    auto it = views_.find(view);
+    if (it != views_.end())
+    {
+        if (activeView_ == &(it->second))
+            activeView_ = nullptr;
+        views_.erase(it);
+    }
+}
+
+void LODSelector::ReleaseInstance(const void* instance)
+{
+    for (auto& view : views_)
+    {
+        auto& states = view.second.states;
+        for (auto it = states.begin(); it != states.end();)
+        {
+            if (it->first.instance == instance)
+                it = states.erase(it);
+            else
+                ++it;
+        }
+    }
+}
+
+size_t LODSelector::NumStates() const
+{
+    size_t num = 0;
+    for (const auto& view : views_)
+        num += view.second.states.size();
+    return num;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+size_t LODSelector::StateKeyHash::operator () (const StateKey& key) const
+{
+    const auto h0 = std::hash<const void*>()(key.geometry);
+    const auto h1 = std::hash<const void*>()(key.instance);
+    return h0 ^ (h1 + 0x9e3779b9 + (h0 << 6) + (h0 >> 2));
+}
+
+LODSelector::State& LODSelector::FetchState(const LODGeometry& geometry, const void* instance)
+{
+    /* Use default view if no view has been set up */
+    if (!activeView_)
+    {
+        activeView_ = &(views_[nullptr]);
+        activeView_->lastSetup = setupCounter_;
+    }
+
+    const StateKey key { &geometry, instance };
+    const State initialState { invalidLODLevel, setupCounter_ };
+
+    auto& state = activeView_->states.insert(std::make_pair(key, initialState)).first->second;
+    state.lastUsed = setupCounter_;
+
+    return state;
+}
+
+void LODSelector::ReleaseUnusedStates()
+{
+    if (maxStateAge == 0)
+        return;
+
+    /* Release all views which have not been set up for a while (the current view has just been set up) */
+    for (auto it = views_.begin(); it != views_.end();)
+    {
+        if (IsExpired(it->second.lastSetup))
+            it = views_.erase(it);
+        else
+            ++it;
+    }
+
+    /* Release the unused instance states of the current view (only once within the maximal age, to keep this cheap) */
+    auto& view = *activeView_;
+
+    if (IsExpired(view.lastRelease))
+    {
+        for (auto it = view.states.begin(); it != view.states.end();)
+        {
+            if (IsExpired(it->second.lastUsed))
+                it = view.states.erase(it);
+            else
+                ++it;
+        }
+        view.lastRelease = setupCounter_;
+    }
+}
+
+bool LODSelector::IsExpired(unsigned int setupCounter) const
+{
+    return setupCounter_ - setupCounter > maxStateAge;
+}
+
+size_t LODSelector::ComputeLevel(const LODGeometry& geometry, const Math::Matrix4f& worldMatrix, size_t prevLevel) const
+{
+    const auto distance = ReferenceDistance(geometry, worldMatrix);
+    const auto level = geometry.SelectLODIndex(distance);
+
+    if (prevLevel == invalidLODLevel || prevLevel == level)
+        return level;
+
+    /*
+    Only switch the level if the distance is outside the hysteresis band,
+    i.e. the distance must pass the switch distance by the factor (1 + hysteresis)
+    */
+    const auto bandScale = 1.0f + std::max(0.0f, hysteresis);
+
+    if (level > prevLevel)
+        return std::max(prevLevel, geometry.SelectLODIndex(distance / bandScale));
+    else
+        return std::min(prevLevel, geometry.SelectLODIndex(distance * bandScale));
+}
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+
+// ========================
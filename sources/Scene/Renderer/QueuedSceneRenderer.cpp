@@ -0,0 +1,217 @@
+/*
+ * Queued scene renderer file
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Scene/Renderer/QueuedSceneRenderer.h"
+#include "Video/RenderSystem/RenderSystem.h"
+#include "../Node/ImportNodes.h"
+#include "../Geometry/ImportGeometries.h"
+#include "../../Video/RenderSystem/RenderSysCtx.h"
+
+#include <algorithm>
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+void QueuedSceneRenderer::RenderScene(SceneNode* sceneGraph)
+{
+    if (!sceneGraph)
+        return;
+
+    auto renderContext = RenderCtx();
+
+    prevShader_ = renderContext->GetRenderState().shaderComposition;
+
+    /* Record draw packets of all visible geometries */
+    renderQueue_.Clear();
+
+    for (auto& child : sceneGraph->GetChildren())
+    {
+        if (child->isEnabled)
+        {
+            /* Store global position of the current scene node and visit the node */
+            globalSceneNodePosition = child->GlobalTransform().GetPosition();
+            child->Visit(this);
+        }
+    }
+
+    ResolveLODRequests();
+
+    /* Sort and submit draw packets (packets without shader use the previously bound shader) */
+    renderQueue_.Sort();
+    renderQueue_.defaultShader = prevShader_;
+
+    if (enableInstancing)
+    {
+        if (!instanceTexture_)
+            CreateInstanceTexture();
+
+        /* Submit draw packets grouped into instance batches */
+        instanceBatcher_.Build(renderQueue_);
+
+        RenderQueue::RenderContextDispatcher dispatcher(renderContext, instanceTexture_.get());
+        renderQueue_.Submit(dispatcher, instanceBatcher_, profilerModel);
+    }
+    else
+    {
+        RenderQueue::RenderContextDispatcher dispatcher(renderContext);
+        renderQueue_.Submit(dispatcher, profilerModel);
+    }
+}
+
+void QueuedSceneRenderer::VisitGeometryNode(GeometryNode* node)
+{
+    if (node->geometry)
+    {
+        /* Setup world matrix for current scene node (only for culling) */
+        packet_.worldMatrix = node->LocalTransform();
+        cullingManager.SetupWorldMatrix(packet_.worldMatrix);
+        geometryNode_ = node;
+
+        if (cullingManager.IsBoundingVolumeInsideFrustum(node->geometry->boundingVolume))
+        {
+            /* Setup initial packet state */
+            packet_.shader          = (node->shaderComposition ? node->shaderComposition.get() : prevShader_);
+            packet_.instancedShader = node->instancedShaderComposition.get();
+            packet_.numTextures     = 0;
+            packet_.depth           = Math::Distance(globalCameraPosition, globalSceneNodePosition);
+
+            node->geometry->Visit(this);
+        }
+    }
+}
+
+void QueuedSceneRenderer::VisitLODGeometry(LODGeometry* node)
+{
+    if (node->lodGeometries.empty() || !geometryNode_)
+        return;
+
+    /* Defer the LOD selection, to select the levels of all LOD geometries in a single pass */
+    LODRequest request;
+    {
+        request.geometry    = node;
+        request.instance    = geometryNode_;
+        request.worldMatrix = packet_.worldMatrix;
+    }
+    lodRequests_.push_back(request);
+    lodPackets_.push_back(packet_);
+}
+
+void QueuedSceneRenderer::VisitCompositionGeometry(CompositionGeometry* node)
+{
+    for (const auto& subGeom : node->subGeometries)
+    {
+        if (cullingManager.IsBoundingVolumeInsideFrustum(subGeom->boundingVolume))
+            subGeom->Visit(this);
+    }
+}
+
+void QueuedSceneRenderer::VisitTexturedGeometry(TexturedGeometry* node)
+{
+    if (node->actualGeometry && cullingManager.IsBoundingVolumeInsideFrustum(node->actualGeometry->boundingVolume))
+    {
+        /* Store previous texture state, since textured geometries can be nested */
+        const auto prevNumTextures = packet_.numTextures;
+        const Video::Texture* prevTextures[DrawPacket::maxNumTextures];
+        std::copy(packet_.textures, packet_.textures + prevNumTextures, prevTextures);
+
+        /* Setup textures for the actual geometry (the layers of the parent geometries are kept) */
+        const auto numTextures = std::min(node->textures.size(), size_t(DrawPacket::maxNumTextures));
+
+        for (size_t l = 0; l < numTextures; ++l)
+            packet_.textures[l] = node->textures[l].get();
+
+        packet_.numTextures = std::max(prevNumTextures, static_cast<unsigned int>(numTextures));
+
+        node->actualGeometry->Visit(this);
+
+        /* Restore previous texture state */
+        std::copy(prevTextures, prevTextures + prevNumTextures, packet_.textures);
+        packet_.numTextures = prevNumTextures;
+    }
+}
+
+void QueuedSceneRenderer::VisitSimple3DMeshGeometry(Simple3DMeshGeometry* node)
+{
+    PushMeshGeometry(*node);
+}
+
+void QueuedSceneRenderer::VisitTangentSpaceMeshGeometry(TangentSpaceMeshGeometry* node)
+{
+    PushMeshGeometry(*node);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void QueuedSceneRenderer::CreateInstanceTexture()
+{
+    static const int instanceTexSize = 256;
+
+    instanceTexture_ = RenderSys()->CreateTexture2D(
+        Video::TextureFormats::RGBA32Float, { instanceTexSize, instanceTexSize }
+    );
+
+    /* Store maximal number of instances (4 texels per world matrix) */
+    instanceBatcher_.maxNumInstances = instanceTexSize*instanceTexSize/4;
+}
+
+void QueuedSceneRenderer::PushMeshGeometry(const MeshGeometry& geometry)
+{
+    packet_.vertexBuffer    = geometry.GetVertexBuffer();
+    packet_.indexBuffer     = geometry.GetIndexBuffer();
+    packet_.primitive       = geometry.primitiveType;
+    packet_.numVertices     = static_cast<unsigned int>(geometry.NumVertices());
+    packet_.numIndices      = static_cast<unsigned int>(geometry.NumIndices());
+
+    renderQueue_.Push(packet_);
+}
+
+void QueuedSceneRenderer::ResolveLODRequests()
+{
+    /* Repeat until no more requests are deferred, since the selected geometries can contain further LOD geometries */
+    while (!lodRequests_.empty())
+    {
+        pendingLODRequests_.swap(lodRequests_);
+        pendingLODPackets_.swap(lodPackets_);
+
+        lodRequests_.clear();
+        lodPackets_.clear();
+
+        /* Select levels of all LOD geometries */
+        lodSelector.SelectLevels(pendingLODRequests_);
+
+        /* Visit selected geometries with the packet state of the respective LOD geometry */
+        for (size_t i = 0, n = pendingLODRequests_.size(); i < n; ++i)
+        {
+            const auto& request = pendingLODRequests_[i];
+
+            packet_ = pendingLODPackets_[i];
+            geometryNode_ = static_cast<const GeometryNode*>(request.instance);
+            cullingManager.SetupWorldMatrix(packet_.worldMatrix);
+
+            auto geometry = request.geometry->lodGeometries[request.level].get();
+            if (geometry && cullingManager.IsBoundingVolumeInsideFrustum(geometry->boundingVolume))
+                geometry->Visit(this);
+        }
+    }
+}
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+
+// ========================
@@ -0,0 +1,352 @@
+/*
+ * Render queue file
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Scene/Renderer/RenderQueue.h"
+#include "Scene/Renderer/InstanceBatcher.h"
+#include "Core/Container/RadixSort.h"
+#include "Core/Exception/NullPointerException.h"
+#include "Core/Exception/InvalidStateException.h"
+#include "Video/RenderSystem/RenderSystem.h"
+#include "Video/RenderSystem/RenderContext.h"
+#include "Video/RenderSystem/RendererProfilerModel.h"
+#include "Video/RenderSystem/Shader/ShaderComposition.h"
+#include "../../Video/RenderSystem/RenderSysCtx.h"
+
+#include <algorithm>
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+/* --- Render context dispatcher --- */
+
+RenderQueue::RenderContextDispatcher::RenderContextDispatcher(
+    Video::RenderContext* renderContext, Video::Texture2D* instanceTexture, unsigned int instanceTextureLayer) :
+        renderContext_          { renderContext        },
+        instanceTexture_        { instanceTexture      },
+        instanceTextureLayer_   { instanceTextureLayer }
+{
+    ASSERT_POINTER(renderContext);
+}
+RenderQueue::RenderContextDispatcher::~RenderContextDispatcher()
+{
+    if (isInstanceTextureBound_)
+        renderContext_->UnbindTexture(instanceTexture_, instanceTextureLayer_);
+}
+
+void RenderQueue::RenderContextDispatcher::BindShader(const Video::ShaderComposition* shaderComposition)
+{
+    renderContext_->BindShader(shaderComposition);
+}
+
+void RenderQueue::RenderContextDispatcher::BindTexture(const Video::Texture* texture, unsigned int layer)
+{
+    renderContext_->BindTexture(texture, layer);
+}
+
+void RenderQueue::RenderContextDispatcher::UnbindTexture(const Video::Texture* texture, unsigned int layer)
+{
+    renderContext_->UnbindTexture(texture, layer);
+}
+
+void RenderQueue::RenderContextDispatcher::BindVertexBuffer(Video::VertexBuffer* vertexBuffer)
+{
+    renderContext_->BindVertexBuffer(vertexBuffer);
+}
+
+void RenderQueue::RenderContextDispatcher::BindIndexBuffer(Video::IndexBuffer* indexBuffer)
+{
+    renderContext_->BindIndexBuffer(indexBuffer);
+}
+
+void RenderQueue::RenderContextDispatcher::SetupDrawMode(const Video::GeometryPrimitives primitive)
+{
+    renderContext_->SetupDrawMode(primitive);
+}
+
+void RenderQueue::RenderContextDispatcher::SetupWorldMatrix(
+    const Math::Matrix4f& worldMatrix, const Video::ShaderComposition* shaderComposition)
+{
+    renderContext_->SetupWorldMatrix(worldMatrix);
+    if (shaderComposition)
+        shaderComposition->PostUpdateConstantBuffer(renderContext_);
+}
+
+void RenderQueue::RenderContextDispatcher::SetupInstanceData(
+    const Math::Matrix4f* worldMatrices, unsigned int numInstances, const Video::ShaderComposition* shaderComposition)
+{
+    if (!instanceTexture_)
+        throw InvalidStateException(__FUNCTION__, "Instance texture has not been specified");
+
+    /* Copy world matrices into staging buffer with complete texture rows (4 texels per matrix) */
+    const auto texSize = instanceTexture_->GetSize();
+    const auto matricesPerRow = static_cast<unsigned int>(std::max(1, texSize.width / 4));
+    const auto numRows = (numInstances + matricesPerRow - 1) / matricesPerRow;
+
+    instanceMatrices_.resize(numRows * matricesPerRow);
+    std::copy(worldMatrices, worldMatrices + numInstances, instanceMatrices_.begin());
+
+    /* Update instance texture */
+    RenderSys()->WriteSubTexture(
+        instanceTexture_, { 0, 0 }, { static_cast<int>(matricesPerRow * 4), static_cast<int>(numRows) }, 0,
+        Video::ImageColorFormats::RGBA, Video::RendererDataTypes::Float, instanceMatrices_.data()
+    );
+
+    if (!isInstanceTextureBound_)
+    {
+        renderContext_->BindTexture(instanceTexture_, instanceTextureLayer_);
+        isInstanceTextureBound_ = true;
+    }
+
+    /* Update shader constant buffers (the world matrix is only the identity) */
+    SetupWorldMatrix(Math::Matrix4f(), shaderComposition);
+}
+
+void RenderQueue::RenderContextDispatcher::Draw(unsigned int numVertices)
+{
+    renderContext_->Draw(numVertices);
+}
+
+void RenderQueue::RenderContextDispatcher::DrawIndexed(unsigned int numIndices)
+{
+    renderContext_->DrawIndexed(numIndices);
+}
+
+void RenderQueue::RenderContextDispatcher::DrawInstanced(unsigned int numVertices, unsigned int numInstances)
+{
+    renderContext_->DrawInstanced(numVertices, 0, numInstances);
+}
+
+void RenderQueue::RenderContextDispatcher::DrawInstancedIndexed(unsigned int numIndices, unsigned int numInstances)
+{
+    renderContext_->DrawInstancedIndexed(numIndices, numInstances);
+}
+
+
+/* --- Render queue --- */
+
+void RenderQueue::Push(const DrawPacket& packet)
+{
+    if (packet.vertexBuffer)
+    {
+        auto packetCopy = arena_.New<DrawPacket>(packet);
+        entries_.push_back({ SortKey(*packetCopy), packetCopy });
+    }
+}
+
+void RenderQueue::Sort()
+{
+    RadixSortByKey(entries_, tempEntries_);
+}
+
+void RenderQueue::Submit(CommandDispatcher& dispatcher, Video::RendererProfilerModel* profilerModel) const
+{
+    BindingState state;
+
+    for (const auto& entry : entries_)
+    {
+        const auto& packet = *entry.packet;
+
+        BindStates(packet, (packet.shader ? packet.shader : defaultShader), state, dispatcher, profilerModel);
+
+        /* Draw geometry */
+        dispatcher.SetupWorldMatrix(packet.worldMatrix, state.shader);
+
+        if (packet.indexBuffer)
+            dispatcher.DrawIndexed(packet.numIndices);
+        else
+            dispatcher.Draw(packet.numVertices);
+    }
+
+    UnbindStates(state, dispatcher);
+}
+
+void RenderQueue::Submit(
+    CommandDispatcher& dispatcher, const InstanceBatcher& batcher, Video::RendererProfilerModel* profilerModel) const
+{
+    BindingState state;
+
+    const auto& instanceMatrices = batcher.GetInstanceMatrices();
+
+    for (const auto& batch : batcher.GetBatches())
+    {
+        const auto& packet = *entries_[batch.firstPacket].packet;
+
+        if (batch.numInstances > 1)
+        {
+            BindStates(packet, packet.instancedShader, state, dispatcher, profilerModel);
+
+            /* Draw all instances with a single draw call */
+            dispatcher.SetupInstanceData(&instanceMatrices[batch.firstInstance], batch.numInstances, state.shader);
+
+            if (packet.indexBuffer)
+                dispatcher.DrawInstancedIndexed(packet.numIndices, batch.numInstances);
+            else
+                dispatcher.DrawInstanced(packet.numVertices, batch.numInstances);
+
+            if (profilerModel)
+                profilerModel->RecordBatchedDrawCalls(batch.numInstances - 1);
+        }
+        else
+        {
+            BindStates(packet, (packet.shader ? packet.shader : defaultShader), state, dispatcher, profilerModel);
+
+            /* Draw geometry */
+            dispatcher.SetupWorldMatrix(packet.worldMatrix, state.shader);
+
+            if (packet.indexBuffer)
+                dispatcher.DrawIndexed(packet.numIndices);
+            else
+                dispatcher.Draw(packet.numVertices);
+        }
+    }
+
+    UnbindStates(state, dispatcher);
+}
+
+void RenderQueue::Clear()
+{
+    entries_.clear();
+    arena_.Reset();
+
+    shaderIDs_.clear();
+    textureSetIDs_.clear();
+    vertexBufferIDs_.clear();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+unsigned int RenderQueue::StateID(std::unordered_map<std::uint64_t, unsigned int>& stateIDs, std::uint64_t state)
+{
+    auto it = stateIDs.find(state);
+    if (it != stateIDs.end())
+        return it->second;
+
+    const auto id = static_cast<unsigned int>(stateIDs.size());
+    stateIDs[state] = id;
+    return id;
+}
+
+void RenderQueue::BindStates(
+    const DrawPacket& packet, const Video::ShaderComposition* shader, BindingState& state,
+    CommandDispatcher& dispatcher, Video::RendererProfilerModel* profilerModel)
+{
+    auto RecordSkippedBinding = [profilerModel]()
+    {
+        if (profilerModel)
+            profilerModel->RecordSkippedBinding();
+    };
+
+    /* Bind shader */
+    if (shader)
+    {
+        if (shader != state.shader)
+        {
+            dispatcher.BindShader(shader);
+            state.shader = shader;
+        }
+        else
+            RecordSkippedBinding();
+    }
+
+    /* Bind textures and unbind the layers which are no longer used */
+    const auto numTextures = static_cast<unsigned int>(
+        packet.numTextures < DrawPacket::maxNumTextures ? packet.numTextures : DrawPacket::maxNumTextures
+    );
+
+    for (unsigned int layer = 0; layer < numTextures; ++layer)
+    {
+        if (layer >= state.numTextures || packet.textures[layer] != state.textures[layer])
+        {
+            dispatcher.BindTexture(packet.textures[layer], layer);
+            state.textures[layer] = packet.textures[layer];
+        }
+        else
+            RecordSkippedBinding();
+    }
+
+    for (auto layer = numTextures; layer < state.numTextures; ++layer)
+        dispatcher.UnbindTexture(state.textures[layer], layer);
+
+    state.numTextures = numTextures;
+
+    /* Bind geometry buffers */
+    if (!state.isPrimitiveBound || packet.primitive != state.primitive)
+    {
+        dispatcher.SetupDrawMode(packet.primitive);
+        state.primitive = packet.primitive;
+        state.isPrimitiveBound = true;
+    }
+
+    if (packet.vertexBuffer != state.vertexBuffer)
+    {
+        dispatcher.BindVertexBuffer(packet.vertexBuffer);
+        state.vertexBuffer = packet.vertexBuffer;
+    }
+    else
+        RecordSkippedBinding();
+
+    if (packet.indexBuffer)
+    {
+        if (packet.indexBuffer != state.indexBuffer)
+        {
+            dispatcher.BindIndexBuffer(packet.indexBuffer);
+            state.indexBuffer = packet.indexBuffer;
+        }
+        else
+            RecordSkippedBinding();
+    }
+}
+
+void RenderQueue::UnbindStates(BindingState& state, CommandDispatcher& dispatcher)
+{
+    for (unsigned int layer = 0; layer < state.numTextures; ++layer)
+        dispatcher.UnbindTexture(state.textures[layer], layer);
+    state.numTextures = 0;
+}
+
+std::uint64_t RenderQueue::SortKey(const DrawPacket& packet)
+{
+    /* Hash texture set (FNV-1a over the texture pointers) */
+    std::uint64_t textureSet = 14695981039346656037ull;
+
+    for (unsigned int layer = 0; layer < packet.numTextures && layer < DrawPacket::maxNumTextures; ++layer)
+    {
+        textureSet ^= static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(packet.textures[layer]));
+        textureSet *= 1099511628211ull;
+    }
+
+    /* Get dense state IDs */
+    const std::uint64_t shaderID        = StateID(shaderIDs_,       reinterpret_cast<std::uintptr_t>(packet.shader));
+    const std::uint64_t textureSetID    = StateID(textureSetIDs_,   textureSet);
+    const std::uint64_t vertexBufferID  = StateID(vertexBufferIDs_, reinterpret_cast<std::uintptr_t>(packet.vertexBuffer));
+
+    /* Build sort key: [ shader:16 | texture set:16 | vertex buffer:16 | depth:16 ] */
+    const std::uint64_t depth = (FloatToOrderedBits(packet.depth) >> 16);
+
+    return
+        ((shaderID          & 0xffff) << 48) |
+        ((textureSetID      & 0xffff) << 32) |
+        ((vertexBufferID    & 0xffff) << 16) |
+        depth;
+}
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+
+// ========================
@@ -32,6 +32,9 @@ void SceneRenderer::SetupView(const CameraNode& camera)
     /* Setup projection and view to culling manager */
     cullingManager.SetupProjectionMatrix(camera.projection);
     cullingManager.SetupViewMatrix(camera.GetViewMatrix());
+
+    /* Setup camera as current view to LOD selector */
+    lodSelector.SetupView(&camera, globalCameraPosition, camera.projection);
 }
 
 void SceneRenderer::RenderSceneFromCamera(SceneNode* sceneGraph, const CameraNode& camera)
@@ -95,7 +95,7 @@ void SimpleSceneRenderer::ConvertLightNodesToConstantBuffer(
             continue;
         
         /* Convert light source into constant buffer data */
-        auto nodeTransform = lightNode->GlobalTransform();
+        const auto& nodeTransform = lightNode->CachedGlobalTransform();
 
         lightBuffer->positionAndType = Math::Vector4f(
             nodeTransform.GetPosition(),
@@ -0,0 +1,403 @@
+/*
+ * Terrain quad-tree file
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Scene/Terrain/TerrainQuadTree.h"
+#include "Core/Exception/InvalidArgumentException.h"
+#include "Core/Exception/IndexOutOfBoundsException.h"
+#include "Math/Collision/PlaneCollisions.h"
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+/*
+ * Internal functions
+ */
+
+enum class FrustumRelations
+{
+    Outside,
+    Intersect,
+    Inside,
+};
+
+static FrustumRelations ClassifyBox(const ViewFrustum& frustum, const Math::AABB3f& box)
+{
+    const auto center = (box.min + box.max) * 0.5f;
+    const auto extent = (box.max - box.min) * 0.5f;
+
+    auto relation = FrustumRelations::Inside;
+
+    for (const auto& plane : frustum.planes)
+    {
+        const auto dist = Math::ComputeDistanceToPlane(plane, center);
+        const auto radius =
+            std::abs(plane.normal.x) * extent.x +
+            std::abs(plane.normal.y) * extent.y +
+            std::abs(plane.normal.z) * extent.z;
+
+        if (dist + radius < 0.0f)
+            return FrustumRelations::Outside;
+        if (dist - radius < 0.0f)
+            relation = FrustumRelations::Intersect;
+    }
+
+    return relation;
+}
+
+//! Returns true if the box intersects the sphere with the specified center and radius.
+static bool OverlapBoxSphere(const Math::AABB3f& box, const Math::Point3f& center, float radius)
+{
+    float sqrDist = 0.0f;
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        if (center[i] < box.min[i])
+            sqrDist += (box.min[i] - center[i])*(box.min[i] - center[i]);
+        else if (center[i] > box.max[i])
+            sqrDist += (center[i] - box.max[i])*(center[i] - box.max[i]);
+    }
+
+    return sqrDist <= radius*radius;
+}
+
+static unsigned int NumNodesForSamples(unsigned int numSamples, unsigned int nodeSize)
+{
+    /* The last sample is only a border sample, so (numSamples - 1) cells must be covered */
+    return std::max(1u, (numSamples - 1 + nodeSize - 1) / nodeSize);
+}
+
+
+/*
+ * TerrainQuadTree class
+ */
+
+void TerrainQuadTree::Build(TerrainTileCache& tileCache, const Description& desc)
+{
+    if (desc.leafNodeSize == 0)
+        throw InvalidArgumentException(__FUNCTION__, "desc.leafNodeSize", "Leaf node size must not be 0");
+    if (desc.numLODLevels == 0 || desc.numLODLevels > 24)
+        throw InvalidArgumentException(__FUNCTION__, "desc.numLODLevels", "Number of LOD levels must be in the range [1 .. 24]");
+    if (desc.detailDistance <= 0.0f)
+        throw InvalidArgumentException(__FUNCTION__, "desc.detailDistance", "Detail distance must be greater than 0");
+    if (desc.lodDistanceRatio < 2.0f)
+        throw InvalidArgumentException(__FUNCTION__, "desc.lodDistanceRatio", "LOD distance ratio must be at least 2");
+
+    numSamples_ = tileCache.NumSamples();
+
+    if (numSamples_.width < 2 || numSamples_.height < 2)
+        throw InvalidArgumentException(__FUNCTION__, "tileCache", "Height field must have at least 2x2 samples");
+
+    desc_ = desc;
+    levels_.clear();
+    levels_.resize(desc.numLODLevels);
+
+    /* Setup level sizes and LOD ranges */
+    const NodeBounds emptyBounds { std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest() };
+
+    const auto morphStartRatio = std::max(0.0f, std::min(desc.morphStartRatio, 0.99f));
+
+    float prevRange = 0.0f, range = desc.detailDistance;
+
+    for (unsigned int i = 0; i < desc.numLODLevels; ++i)
+    {
+        auto& level = levels_[i];
+
+        level.nodeSize          = desc.leafNodeSize << i;
+        level.numNodes.width    = NumNodesForSamples(numSamples_.width, level.nodeSize);
+        level.numNodes.height   = NumNodesForSamples(numSamples_.height, level.nodeSize);
+        level.nodes.assign(level.numNodes.Area(), emptyBounds);
+
+        level.range             = range;
+        level.morphStart        = prevRange + (range - prevRange) * morphStartRatio;
+
+        prevRange = range;
+        range *= desc.lodDistanceRatio;
+    }
+
+    /* Stream all height tiles through the cache once and compute the leaf node bounds */
+    auto& leafLevel = levels_.front();
+
+    const auto tileSize = tileCache.TileSize();
+    const auto leafSize = desc.leafNodeSize;
+
+    const Math::Size2ui numTiles
+    {
+        (numSamples_.width + tileSize - 1) / tileSize,
+        (numSamples_.height + tileSize - 1) / tileSize
+    };
+
+    auto UpdateLeaf = [&](unsigned int x, unsigned int z, float height)
+    {
+        if (x < leafLevel.numNodes.width && z < leafLevel.numNodes.height)
+        {
+            auto& bounds = leafLevel.nodes[z*leafLevel.numNodes.width + x];
+            bounds.minHeight = std::min(bounds.minHeight, height);
+            bounds.maxHeight = std::max(bounds.maxHeight, height);
+        }
+    };
+
+    for (unsigned int tz = 0; tz < numTiles.height; ++tz)
+    {
+        for (unsigned int tx = 0; tx < numTiles.width; ++tx)
+        {
+            const auto heights = tileCache.FetchTile({ tx, tz });
+
+            const auto firstX = tx*tileSize, lastX = std::min(firstX + tileSize, numSamples_.width);
+            const auto firstZ = tz*tileSize, lastZ = std::min(firstZ + tileSize, numSamples_.height);
+
+            for (auto z = firstZ; z < lastZ; ++z)
+            {
+                const auto row = heights + (z - firstZ)*tileSize;
+
+                /* Samples on a node border belong to both adjacent nodes */
+                const auto nz = z / leafSize;
+                const bool isBorderZ = (z % leafSize == 0 && z > 0);
+
+                for (auto x = firstX; x < lastX; ++x)
+                {
+                    const auto height = row[x - firstX];
+
+                    const auto nx = x / leafSize;
+                    const bool isBorderX = (x % leafSize == 0 && x > 0);
+
+                    UpdateLeaf(nx, nz, height);
+
+                    if (isBorderX)
+                        UpdateLeaf(nx - 1, nz, height);
+                    if (isBorderZ)
+                    {
+                        UpdateLeaf(nx, nz - 1, height);
+                        if (isBorderX)
+                            UpdateLeaf(nx - 1, nz - 1, height);
+                    }
+                }
+            }
+        }
+    }
+
+    /* Compute bounds of the upper levels from their child nodes */
+    for (size_t i = 1; i < levels_.size(); ++i)
+    {
+        const auto& childLevel = levels_[i - 1];
+        auto& level = levels_[i];
+
+        for (unsigned int z = 0; z < childLevel.numNodes.height; ++z)
+        {
+            for (unsigned int x = 0; x < childLevel.numNodes.width; ++x)
+            {
+                const auto& childBounds = childLevel.nodes[z*childLevel.numNodes.width + x];
+                auto& bounds = level.nodes[(z/2)*level.numNodes.width + (x/2)];
+
+                bounds.minHeight = std::min(bounds.minHeight, childBounds.minHeight);
+                bounds.maxHeight = std::max(bounds.maxHeight, childBounds.maxHeight);
+            }
+        }
+    }
+
+    /* Compute bounding box of the entire terrain */
+    const auto& rootLevel = levels_.back();
+
+    boundingBox_.Invalidate();
+
+    for (unsigned int z = 0; z < rootLevel.numNodes.height; ++z)
+    {
+        for (unsigned int x = 0; x < rootLevel.numNodes.width; ++x)
+        {
+            const auto box = NodeBox(NumLODLevels() - 1, x, z);
+            boundingBox_.InsertPoint(box.min);
+            boundingBox_.InsertPoint(box.max);
+        }
+    }
+}
+
+void TerrainQuadTree::Select(const ViewFrustum& frustum, const Math::Point3f& cameraPosition, std::vector<TerrainNodeSelection>& selection) const
+{
+    if (levels_.empty())
+        return;
+
+    /* Traverse all root nodes (the terrain can be larger than a single root node) */
+    const auto rootLevel = NumLODLevels() - 1;
+    const auto& numRootNodes = levels_.back().numNodes;
+
+    for (unsigned int z = 0; z < numRootNodes.height; ++z)
+    {
+        for (unsigned int x = 0; x < numRootNodes.width; ++x)
+            SelectNode(frustum, cameraPosition, selection, rootLevel, x, z, false);
+    }
+}
+
+float TerrainQuadTree::MorphFactor(unsigned int lodLevel, float distance) const
+{
+    if (lodLevel >= levels_.size())
+        return 0.0f;
+
+    const auto& level = levels_[lodLevel];
+
+    const auto morphRange = level.range - level.morphStart;
+    if (morphRange <= 0.0f)
+        return 0.0f;
+
+    return std::max(0.0f, std::min((distance - level.morphStart) / morphRange, 1.0f));
+}
+
+Math::Point2f TerrainQuadTree::MorphVertex(const Math::Point2f& gridPos, unsigned int gridSize, float morphFactor)
+{
+    if (gridSize == 0)
+        return gridPos;
+
+    /*
+    Move every odd vertex towards its even neighbor:
+    frac(gridPos * gridSize / 2) is 0.5 for odd and 0 for even vertices
+    */
+    const auto halfSize = static_cast<float>(gridSize) * 0.5f;
+    const auto invHalfSize = 1.0f / halfSize;
+
+    auto Morph = [&](float pos)
+    {
+        const auto scaled = pos * halfSize;
+        const auto frac = scaled - std::floor(scaled);
+        return pos - frac * invHalfSize * morphFactor;
+    };
+
+    return { Morph(gridPos.x), Morph(gridPos.y) };
+}
+
+const TerrainQuadTree::NodeBounds& TerrainQuadTree::GetNodeBounds(unsigned int lodLevel, unsigned int x, unsigned int z) const
+{
+    if (lodLevel >= levels_.size())
+        throw IndexOutOfBoundsException(__FUNCTION__, lodLevel);
+
+    const auto& level = levels_[lodLevel];
+
+    if (x >= level.numNodes.width)
+        throw IndexOutOfBoundsException(__FUNCTION__, x);
+    if (z >= level.numNodes.height)
+        throw IndexOutOfBoundsException(__FUNCTION__, z);
+
+    return level.nodes[z*level.numNodes.width + x];
+}
+
+Math::AABB3f TerrainQuadTree::NodeBox(unsigned int lodLevel, unsigned int x, unsigned int z) const
+{
+    const auto& bounds = GetNodeBounds(lodLevel, x, z);
+    const auto nodeSize = levels_[lodLevel].nodeSize;
+
+    /* Clamp node area to the last sample */
+    const auto x0 = static_cast<float>(x*nodeSize);
+    const auto z0 = static_cast<float>(z*nodeSize);
+    const auto x1 = static_cast<float>(std::min((x + 1)*nodeSize, numSamples_.width - 1));
+    const auto z1 = static_cast<float>(std::min((z + 1)*nodeSize, numSamples_.height - 1));
+
+    const auto& scale = desc_.scale;
+
+    Math::AABB3f box(
+        { x0 * scale.x, bounds.minHeight * scale.y, z0 * scale.z },
+        { x1 * scale.x, bounds.maxHeight * scale.y, z1 * scale.z }
+    );
+
+    return box.Repair();
+}
+
+Math::Size2ui TerrainQuadTree::NumNodes(unsigned int lodLevel) const
+{
+    return lodLevel < levels_.size() ? levels_[lodLevel].numNodes : Math::Size2ui();
+}
+
+float TerrainQuadTree::LODRange(unsigned int lodLevel) const
+{
+    return lodLevel < levels_.size() ? levels_[lodLevel].range : 0.0f;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool TerrainQuadTree::SelectNode(
+    const ViewFrustum& frustum, const Math::Point3f& cameraPosition, std::vector<TerrainNodeSelection>& selection,
+    unsigned int lodLevel, unsigned int x, unsigned int z, bool isInsideFrustum) const
+{
+    const auto box = NodeBox(lodLevel, x, z);
+
+    /* Check if the node is within its LOD range (otherwise the parent node must cover this area) */
+    if (!OverlapBoxSphere(box, cameraPosition, levels_[lodLevel].range))
+        return false;
+
+    /* Check if the node is inside the view frustum (the child nodes of an inside node are also inside) */
+    if (!isInsideFrustum)
+    {
+        const auto relation = ClassifyBox(frustum, box);
+        if (relation == FrustumRelations::Outside)
+            return true;
+        isInsideFrustum = (relation == FrustumRelations::Inside);
+    }
+
+    /* Select the entire node, if it is a leaf or if it is not within the range of the next higher level-of-detail */
+    if (lodLevel == 0 || !OverlapBoxSphere(box, cameraPosition, levels_[lodLevel - 1].range))
+    {
+        AddSelection(selection, box, lodLevel, x, z, 0xF);
+        return true;
+    }
+
+    /* Select child nodes, and cover the remaining quadrants with this node */
+    const auto& childNumNodes = levels_[lodLevel - 1].numNodes;
+    unsigned int quadrantMask = 0;
+
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        const auto childX = x*2 + (i & 1);
+        const auto childZ = z*2 + (i >> 1);
+
+        if (childX < childNumNodes.width && childZ < childNumNodes.height)
+        {
+            if (!SelectNode(frustum, cameraPosition, selection, lodLevel - 1, childX, childZ, isInsideFrustum))
+                quadrantMask |= (1u << i);
+        }
+    }
+
+    if (quadrantMask != 0)
+        AddSelection(selection, box, lodLevel, x, z, quadrantMask);
+
+    return true;
+}
+
+void TerrainQuadTree::AddSelection(
+    std::vector<TerrainNodeSelection>& selection, const Math::AABB3f& box,
+    unsigned int lodLevel, unsigned int x, unsigned int z, unsigned int quadrantMask) const
+{
+    const auto& level = levels_[lodLevel];
+
+    TerrainNodeSelection node;
+    {
+        node.box            = box;
+        node.origin         = { x*level.nodeSize, z*level.nodeSize };
+        node.size           = level.nodeSize;
+        node.lodLevel       = lodLevel;
+        node.quadrantMask   = quadrantMask;
+        node.morphStart     = level.morphStart;
+        node.morphEnd       = level.range;
+    }
+    selection.push_back(node);
+}
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+
+// ========================
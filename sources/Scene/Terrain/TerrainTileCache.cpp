@@ -0,0 +1,130 @@
+/*
+ * Terrain tile cache file
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Scene/Terrain/TerrainTileCache.h"
+#include "Core/Exception/NullPointerException.h"
+
+#include <algorithm>
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+TerrainTileCache::TerrainTileCache(const TerrainTileSourcePtr& source, size_t memoryBudget) :
+    source_{ source }
+{
+    ASSERT_POINTER(source);
+
+    tileSize_   = source_->TileSize();
+    numSamples_ = source_->NumSamples();
+
+    SetMemoryBudget(memoryBudget);
+}
+
+const float* TerrainTileCache::FetchTile(const Math::Point2ui& tile)
+{
+    const auto key = (static_cast<TileKey>(tile.y) << 32) | tile.x;
+
+    /* Successive fetches of the same tile are very common (e.g. when sampling heights row by row) */
+    if (key == lastKey_)
+        return lastHeights_;
+
+    auto it = tiles_.find(key);
+
+    if (it != tiles_.end())
+    {
+        /* Move tile to the front of the LRU list */
+        lruList_.splice(lruList_.begin(), lruList_, it->second.lruEntry);
+    }
+    else
+    {
+        /* Make room for the new tile and load it into the buffer of the last evicted tile */
+        EvictTiles(maxNumTiles_ - 1);
+
+        source_->LoadTile(tile, evictedHeights_);
+        ++numLoadedTiles_;
+
+        lruList_.push_front(key);
+
+        it = tiles_.insert(std::make_pair(key, Tile())).first;
+        it->second.heights.swap(evictedHeights_);
+        it->second.lruEntry = lruList_.begin();
+    }
+
+    lastKey_        = key;
+    lastHeights_    = it->second.heights.data();
+
+    return lastHeights_;
+}
+
+float TerrainTileCache::SampleHeight(unsigned int x, unsigned int z)
+{
+    if (numSamples_.width == 0 || numSamples_.height == 0)
+        return 0.0f;
+
+    x = std::min(x, numSamples_.width - 1);
+    z = std::min(z, numSamples_.height - 1);
+
+    const auto heights = FetchTile({ x / tileSize_, z / tileSize_ });
+
+    return heights[(z % tileSize_) * tileSize_ + (x % tileSize_)];
+}
+
+void TerrainTileCache::Clear()
+{
+    EvictTiles(0);
+}
+
+void TerrainTileCache::SetMemoryBudget(size_t memoryBudget)
+{
+    memoryBudget_ = memoryBudget;
+
+    const auto tileMemory = std::max(size_t(1), static_cast<size_t>(tileSize_)*tileSize_*sizeof(float));
+    maxNumTiles_ = std::max(size_t(1), memoryBudget_ / tileMemory);
+
+    EvictTiles(maxNumTiles_);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void TerrainTileCache::EvictTiles(size_t maxNumTiles)
+{
+    while (tiles_.size() > maxNumTiles)
+    {
+        /* Remove least recently used tile, but keep its buffer for the next tile */
+        const auto key = lruList_.back();
+        lruList_.pop_back();
+
+        auto it = tiles_.find(key);
+        evictedHeights_.swap(it->second.heights);
+        tiles_.erase(it);
+
+        ++numEvictedTiles_;
+
+        if (key == lastKey_)
+        {
+            lastKey_        = ~0ull;
+            lastHeights_    = nullptr;
+        }
+    }
+}
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+
+// ========================
@@ -0,0 +1,177 @@
+/*
+ * Terrain tile source file
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Scene/Terrain/TerrainTileSource.h"
+#include "Core/Exception/InvalidArgumentException.h"
+#include "Core/Exception/IndexOutOfBoundsException.h"
+#include "IO/FileSystem/FileOpenException.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+
+namespace Fork
+{
+
+namespace Scene
+{
+
+
+/*
+ * TerrainTileSource class
+ */
+
+TerrainTileSource::~TerrainTileSource()
+{
+}
+
+Math::Size2ui TerrainTileSource::NumSamples() const
+{
+    const auto numTiles = NumTiles();
+    return { numTiles.width * TileSize(), numTiles.height * TileSize() };
+}
+
+
+/*
+ * TerrainTileFile class
+ */
+
+static const char tileFileMagic[4] = { 'F', 'T', 'H', 'T' };
+
+struct TileFileHeader
+{
+    char            magic[4];
+    std::uint32_t   tileSize;
+    std::uint32_t   numTilesX;
+    std::uint32_t   numTilesZ;
+    std::uint32_t   numSamplesX;
+    std::uint32_t   numSamplesZ;
+};
+
+TerrainTileFile::TerrainTileFile(const std::string& filename) :
+    stream_     { filename, std::ios_base::in | std::ios_base::binary },
+    filename_   { filename                                            }
+{
+    if (!stream_.good())
+        throw FileOpenException(filename, "Opening terrain tile file failed");
+
+    /* Read and validate header */
+    TileFileHeader header;
+    stream_.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    if ( !stream_.good() || std::memcmp(header.magic, tileFileMagic, 4) != 0 || header.tileSize == 0 ||
+         header.numSamplesX > header.numTilesX*header.tileSize || header.numSamplesZ > header.numTilesZ*header.tileSize )
+    {
+        throw FileOpenException(filename, "Invalid terrain tile file header");
+    }
+
+    tileSize_   = header.tileSize;
+    numTiles_   = { header.numTilesX, header.numTilesZ };
+    numSamples_ = { header.numSamplesX, header.numSamplesZ };
+}
+
+unsigned int TerrainTileFile::TileSize() const
+{
+    return tileSize_;
+}
+
+Math::Size2ui TerrainTileFile::NumTiles() const
+{
+    return numTiles_;
+}
+
+Math::Size2ui TerrainTileFile::NumSamples() const
+{
+    return numSamples_;
+}
+
+void TerrainTileFile::LoadTile(const Math::Point2ui& tile, std::vector<float>& heights)
+{
+    if (tile.x >= numTiles_.width)
+        throw IndexOutOfBoundsException(__FUNCTION__, tile.x);
+    if (tile.y >= numTiles_.height)
+        throw IndexOutOfBoundsException(__FUNCTION__, tile.y);
+
+    /* Seek to the tile and read all heights at once */
+    const size_t numHeights = tileSize_*tileSize_;
+    const auto tileIndex = static_cast<std::streamoff>(tile.y) * numTiles_.width + tile.x;
+
+    heights.resize(numHeights);
+
+    stream_.clear();
+    stream_.seekg(static_cast<std::streamoff>(sizeof(TileFileHeader)) + tileIndex * static_cast<std::streamoff>(numHeights * sizeof(float)));
+    stream_.read(reinterpret_cast<char*>(heights.data()), numHeights * sizeof(float));
+
+    if (!stream_.good())
+        throw FileOpenException(filename_, "Reading terrain tile (" + ToStr(tile.x) + ", " + ToStr(tile.y) + ") failed");
+}
+
+void TerrainTileFile::WriteTiles(const std::string& filename, const Video::ImageFloat& heightField, unsigned int tileSize)
+{
+    if (tileSize == 0)
+        throw InvalidArgumentException(__FUNCTION__, "tileSize", "Tile size must not be 0");
+
+    const auto width    = static_cast<unsigned int>(heightField.GetSize().width);
+    const auto height   = static_cast<unsigned int>(heightField.GetSize().height);
+
+    if (width == 0 || height == 0)
+        throw InvalidArgumentException(__FUNCTION__, "heightField", "Height field must not be empty");
+
+    std::ofstream stream(filename, std::ios_base::out | std::ios_base::binary);
+    if (!stream.good())
+        throw FileOpenException(filename, "Creating terrain tile file failed");
+
+    /* Write header */
+    TileFileHeader header;
+    {
+        std::memcpy(header.magic, tileFileMagic, 4);
+        header.tileSize     = tileSize;
+        header.numTilesX    = (width + tileSize - 1) / tileSize;
+        header.numTilesZ    = (height + tileSize - 1) / tileSize;
+        header.numSamplesX  = width;
+        header.numSamplesZ  = height;
+    }
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    /* Write tiles (border samples are repeated to fill the last tiles) */
+    const auto components = heightField.NumColorComponents();
+    const auto buffer = heightField.RawBuffer();
+
+    std::vector<float> heights(tileSize*tileSize);
+
+    for (unsigned int ty = 0; ty < header.numTilesZ; ++ty)
+    {
+        for (unsigned int tx = 0; tx < header.numTilesX; ++tx)
+        {
+            for (unsigned int y = 0; y < tileSize; ++y)
+            {
+                const auto sy = std::min(ty*tileSize + y, height - 1);
+
+                for (unsigned int x = 0; x < tileSize; ++x)
+                {
+                    const auto sx = std::min(tx*tileSize + x, width - 1);
+                    heights[y*tileSize + x] = buffer[(static_cast<size_t>(sy)*width + sx)*components];
+                }
+            }
+
+            stream.write(reinterpret_cast<const char*>(heights.data()), heights.size() * sizeof(float));
+        }
+    }
+
+    if (!stream.good())
+        throw FileOpenException(filename, "Writing terrain tile file failed");
+}
+
+
+} // /namespace Scene
+
+} // /namespace Fork
+
+
+
+// ========================
@@ -29,10 +29,12 @@ static const char* profilerInfoTexts[] =
     "Frame Rate:",
     "Draw Calls:",
     "Rendered Triangles:",
+    "Batched Draw Calls:",
     "Render Target Bindings:",
     "Texture Bindings:",
     "Buffer Bindings:",
     "Shader Bindings:",
+    "Skipped Bindings:",
     "Texture Creations:",
     "Texture Updates:",
     "Buffer Creations:",
@@ -87,11 +89,13 @@ FORK_EXPORT void DrawInfo(
 
     AddProfilerInfo(profilerInfoTexts[++i]); // <-- Draw calls
     AddProfilerInfo(profilerInfoTexts[++i]); // <-- Rendered triangles
+    AddProfilerInfo(profilerInfoTexts[++i]); // <-- Batched draw calls
     IncTextPosY();
     AddProfilerInfo(profilerInfoTexts[++i]); // <-- Render target bindings
     AddProfilerInfo(profilerInfoTexts[++i]); // <-- Texture bindings
     AddProfilerInfo(profilerInfoTexts[++i]); // <-- Buffer bindings
     AddProfilerInfo(profilerInfoTexts[++i]); // <-- Shader bindings
+    AddProfilerInfo(profilerInfoTexts[++i]); // <-- Skipped bindings
     IncTextPosY();
     AddProfilerInfo(profilerInfoTexts[++i]); // <-- Texture creations
     AddProfilerInfo(profilerInfoTexts[++i]); // <-- Texture updates
@@ -113,11 +117,13 @@ FORK_EXPORT void DrawInfo(
 
     AddProfilerInfo(ToStr(profilerModel.NumDrawCalls            ()));
     AddProfilerInfo(ToStr(profilerModel.NumRenderedTriangles    ()));
+    AddProfilerInfo(ToStr(profilerModel.NumBatchedDrawCalls     ()));
     IncTextPosY();
     AddProfilerInfo(ToStr(profilerModel.NumRenderTargetBindings ()));
     AddProfilerInfo(ToStr(profilerModel.NumTextureBindings      ()));
     AddProfilerInfo(ToStr(profilerModel.NumBufferBindings       ()));
     AddProfilerInfo(ToStr(profilerModel.NumShaderBindings       ()));
+    AddProfilerInfo(ToStr(profilerModel.NumSkippedBindings      ()));
     IncTextPosY();
     AddProfilerInfo(ToStr(profilerModel.NumTextureCreations     ()));
     AddProfilerInfo(ToStr(profilerModel.NumTextureUpdates       ()));
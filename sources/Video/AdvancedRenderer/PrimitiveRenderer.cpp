@@ -629,27 +629,32 @@ TextureFontPtr PrimitiveRenderer::CreateTextureFont(const Font::Description& fon
     }
 
     /* Add font to vertex-buffer atlas */
+    const auto prevAtlasSize = fontDrawing_.vertexDataAtlas.Size();
+
     font->partition_ = fontDrawing_.vertexDataAtlas.Add(
         font.get(),
         vertexDataPartition.data(),
         vertexDataPartition.size()*sizeof(FontGlyphVertices)
     );
 
-    UpdateFontVertexBufferAtlas();
+    /* Only update the new partition, if it was placed into a free range of the atlas */
+    if (fontDrawing_.vertexDataAtlas.Size() > prevAtlasSize)
+        UpdateFontVertexBufferAtlas();
+    else
+        UpdateFontVertexBufferAtlas(font->partition_);
 
     return font;
 }
 
 void PrimitiveRenderer::ReleaseTextureFont(TextureFontPtr& font)
 {
-    /* Remove font from the vertex-buffer atlas */
+    /*
+    Remove font from the vertex-buffer atlas.
+    The atlas uses a free list, so the partitions of all other fonts remain unchanged
+    and the hardware buffer does not need to be updated.
+    */
     fontDrawing_.vertexDataAtlas.Remove(font.get());
     font = nullptr;
-
-    //!TODO! -> update partitions for all TextureFont objects!!!
-
-    /* Update vertex-buffer atlas */
-    UpdateFontVertexBufferAtlas();
 }
 
 void PrimitiveRenderer::DrawText2D(
@@ -753,6 +758,17 @@ void PrimitiveRenderer::UpdateFontVertexBufferAtlas()
     );
 }
 
+void PrimitiveRenderer::UpdateFontVertexBufferAtlas(const TextureFont::PartitionContianerType::Partition& partition)
+{
+    /* Update only the specified range of the font vertex buffer atlas */
+    renderSystem_->WriteSubBuffer(
+        fontDrawing_.vertexBufferAtlas.get(),
+        reinterpret_cast<const char*>(fontDrawing_.vertexDataAtlas.GetRawBuffer()) + partition.GetOffset(),
+        partition.GetSize(),
+        partition.GetOffset()
+    );
+}
+
 void PrimitiveRenderer::BeginDrawingText(const TextureFont* font)
 {
     auto renderContext = RenderCtx();
@@ -6,8 +6,11 @@
  */
 
 #include "CommonImageReader.h"
+#include "ImageFileSource.h"
 #include "IO/Core/Log.h"
 
+#include <limits>
+
 #define STB_IMAGE_IMPLEMENTATION
 #include "../../Plugins/STB/stb_image.h"
 
@@ -19,6 +22,10 @@ namespace Video
 {
 
 
+/*
+ * Internal functions
+ */
+
 static ImageColorFormats GetColorFormatByComponents(int components)
 {
     switch (components)
@@ -35,21 +42,23 @@ static ImageColorFormats GetColorFormatByComponents(int components)
     return ImageColorFormats::Gray;
 }
 
-ImageUBytePtr CommonImageReader::ReadImage(const std::string& filename)
+/*
+Creates the image object, which takes over the ownership of the STBI image buffer, i.e. the image data is not copied.
+Returns null if the image data is invalid.
+*/
+template <class ImageType> std::shared_ptr<ImageType> AdoptImageData(
+    typename ImageType::value_type* imageData, int width, int height, int components)
 {
-    /* Load image using the STBI library */
-    int width = 0, height = 0, components = 0;
-    unsigned char* imageData = stbi_load(filename.c_str(), &width, &height, &components, 0);
+    if (!imageData)
+        return nullptr;
 
-    if (!imageData || width <= 0 || height <= 0 || components < 1 || components > 4)
-    {
-        IO::Log::Error("Loading image file \"" + filename + "\" failed");
+    /* Release STBI image data with the image buffer */
+    typename ImageType::BufferType buffer(imageData, stbi_image_free);
+
+    if (width <= 0 || height <= 0 || components < 1 || components > 4)
         return nullptr;
-    }
 
     /* Create image object */
-    const auto colorFormat = GetColorFormatByComponents(components);
-
     const Math::Size3st imageSize
     {
         static_cast<size_t>(width),
@@ -57,18 +66,65 @@ ImageUBytePtr CommonImageReader::ReadImage(const std::string& filename)
         1u
     };
 
-    auto image = std::make_shared<ImageUByte>(imageSize, colorFormat);
-
-    /* Copy image data */
-    const size_t imageDataSize = width*height*components;
-    std::copy(imageData, imageData + imageDataSize, image->RawBuffer());
+    return std::make_shared<ImageType>(imageSize, GetColorFormatByComponents(components), buffer);
+}
 
-    /* Release STBI image data */
-    stbi_image_free(imageData);
+static ImageUBytePtr CheckImage(const ImageUBytePtr& image, const std::string& name)
+{
+    if (!image)
+        IO::Log::Error("Loading image file \"" + name + "\" failed");
+    return image;
+}
 
+static ImageFloatPtr CheckImage(const ImageFloatPtr& image, const std::string& name)
+{
+    if (!image)
+        IO::Log::Error("Loading HDR image file \"" + name + "\" failed");
     return image;
 }
 
+static bool CheckMemorySize(size_t size, const std::string& name)
+{
+    if (size > static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        IO::Log::Error("Image file \"" + name + "\" is too large");
+        return false;
+    }
+    return true;
+}
+
+/* --- STBI callbacks to read directly from a file --- */
+
+static int STBIReadCallback(void* user, char* data, int size)
+{
+    return static_cast<int>(reinterpret_cast<ImageFileSource*>(user)->Read(data, static_cast<size_t>(size)));
+}
+
+static void STBISkipCallback(void* user, int offset)
+{
+    reinterpret_cast<ImageFileSource*>(user)->Skip(offset);
+}
+
+static int STBIEOFCallback(void* user)
+{
+    return reinterpret_cast<ImageFileSource*>(user)->IsEOF() ? 1 : 0;
+}
+
+static const stbi_io_callbacks stbiFileCallbacks { STBIReadCallback, STBISkipCallback, STBIEOFCallback };
+
+
+/*
+ * CommonImageReader class
+ */
+
+ImageUBytePtr CommonImageReader::ReadImage(const std::string& filename)
+{
+    /* Load image using the STBI library */
+    int width = 0, height = 0, components = 0;
+    auto imageData = stbi_load(filename.c_str(), &width, &height, &components, 0);
+    return CheckImage(AdoptImageData<ImageUByte>(imageData, width, height, components), filename);
+}
+
 ImageFloatPtr CommonImageReader::ReadImageHDR(const std::string& filename, float gamma, float scale)
 {
     /* Setup HDR reading settings */
@@ -77,34 +133,63 @@ ImageFloatPtr CommonImageReader::ReadImageHDR(const std::string& filename, float
 
     /* Load image using the STBI library */
     int width = 0, height = 0, components = 0;
-    float* imageData = stbi_loadf(filename.c_str(), &width, &height, &components, 0);
+    auto imageData = stbi_loadf(filename.c_str(), &width, &height, &components, 0);
+    return CheckImage(AdoptImageData<ImageFloat>(imageData, width, height, components), filename);
+}
 
-    if (!imageData || width <= 0 || height <= 0 || components < 1 || components > 4)
-    {
-        IO::Log::Error(ToStr("Loading HDR image file \"") + filename + ToStr("\" failed"));
+ImageUBytePtr CommonImageReader::ReadImageFromMemory(const void* data, size_t size, const std::string& name)
+{
+    if (!CheckMemorySize(size, name))
         return nullptr;
-    }
 
-    /* Create image object */
-    const auto colorFormat = GetColorFormatByComponents(components);
+    /* Load image from memory using the STBI library */
+    int width = 0, height = 0, components = 0;
+    auto imageData = stbi_load_from_memory(
+        reinterpret_cast<const stbi_uc*>(data), static_cast<int>(size), &width, &height, &components, 0
+    );
+    return CheckImage(AdoptImageData<ImageUByte>(imageData, width, height, components), name);
+}
 
-    const Math::Size3st imageSize
-    {
-        static_cast<size_t>(width),
-        static_cast<size_t>(height),
-        1u
-    };
+ImageFloatPtr CommonImageReader::ReadImageHDRFromMemory(
+    const void* data, size_t size, const std::string& name, float gamma, float scale)
+{
+    if (!CheckMemorySize(size, name))
+        return nullptr;
 
-    auto image = std::make_shared<ImageFloat>(imageSize, colorFormat);
+    /* Setup HDR reading settings */
+    stbi_hdr_to_ldr_gamma(gamma);
+    stbi_hdr_to_ldr_scale(scale);
 
-    /* Copy image data */
-    const size_t imageDataSize = width*height*components;
-    std::copy(imageData, imageData + imageDataSize, image->RawBuffer());
+    /* Load image from memory using the STBI library */
+    int width = 0, height = 0, components = 0;
+    auto imageData = stbi_loadf_from_memory(
+        reinterpret_cast<const stbi_uc*>(data), static_cast<int>(size), &width, &height, &components, 0
+    );
+    return CheckImage(AdoptImageData<ImageFloat>(imageData, width, height, components), name);
+}
 
-    /* Release STBI image data */
-    stbi_image_free(imageData);
+ImageUBytePtr CommonImageReader::ReadImage(IO::File& file, const std::string& name)
+{
+    /* Load image with the STBI library, which reads from the file through callbacks */
+    ImageFileSource source(file);
 
-    return image;
+    int width = 0, height = 0, components = 0;
+    auto imageData = stbi_load_from_callbacks(&stbiFileCallbacks, &source, &width, &height, &components, 0);
+    return CheckImage(AdoptImageData<ImageUByte>(imageData, width, height, components), name);
+}
+
+ImageFloatPtr CommonImageReader::ReadImageHDR(IO::File& file, const std::string& name, float gamma, float scale)
+{
+    /* Setup HDR reading settings */
+    stbi_hdr_to_ldr_gamma(gamma);
+    stbi_hdr_to_ldr_scale(scale);
+
+    /* Load image with the STBI library, which reads from the file through callbacks */
+    ImageFileSource source(file);
+
+    int width = 0, height = 0, components = 0;
+    auto imageData = stbi_loadf_from_callbacks(&stbiFileCallbacks, &source, &width, &height, &components, 0);
+    return CheckImage(AdoptImageData<ImageFloat>(imageData, width, height, components), name);
 }
 
 
@@ -10,6 +10,7 @@
 #include "IO/Core/MagicNumber.h"
 
 #include <fstream>
+#include <algorithm>
 
 
 namespace Fork
@@ -23,18 +24,8 @@ namespace Video
 Magic numbers has been taken from:
 http://en.wikipedia.org/wiki/List_of_file_signatures
 */
-FORK_EXPORT ImageFileFormats DetectFileFormat(const std::string& filename)
+static ImageFileFormats DetectFileFormat(const IO::MagicNumber& magicNumber, const std::string& filename)
 {
-    /* Open file for reading */
-    std::ifstream file(filename);
-
-    if (!file.good())
-        return ImageFileFormats::__Unknown__;
-
-    /* Read magic number */
-    IO::MagicNumber magicNumber;
-    file.read(magicNumber.charSet, 4);
-
     /* Compare magic number to detect image file format */
     static const unsigned short magicNumberBMP = 0x4d42;
     static const unsigned short magicNumberJPG = 0xd8ff;
@@ -64,6 +55,33 @@ FORK_EXPORT ImageFileFormats DetectFileFormat(const std::string& filename)
     return ImageFileFormats::__Unknown__;
 }
 
+FORK_EXPORT ImageFileFormats DetectFileFormat(const std::string& filename)
+{
+    /* Open file for reading */
+    std::ifstream file(filename);
+
+    if (!file.good())
+        return ImageFileFormats::__Unknown__;
+
+    /* Read magic number */
+    IO::MagicNumber magicNumber;
+    file.read(magicNumber.charSet, 4);
+
+    return DetectFileFormat(magicNumber, filename);
+}
+
+FORK_EXPORT ImageFileFormats DetectFileFormat(const void* data, size_t size, const std::string& filename)
+{
+    if (!data || size < 4)
+        return ImageFileFormats::__Unknown__;
+
+    /* Copy magic number from the file content */
+    IO::MagicNumber magicNumber;
+    std::copy(reinterpret_cast<const char*>(data), reinterpret_cast<const char*>(data) + 4, magicNumber.charSet);
+
+    return DetectFileFormat(magicNumber, filename);
+}
+
 
 } // /namespace Video
 
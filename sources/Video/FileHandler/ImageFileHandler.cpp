@@ -25,13 +25,11 @@ namespace ImageFileHandler
 {
 
 
-FORK_EXPORT ImageUBytePtr ReadImage(const std::string& filename)
+/* --- Internal functions --- */
+
+static std::unique_ptr<ImageReader> CreateImageReader(const ImageFileFormats fileFormat)
 {
     /* Choose image reader by file format */
-    auto fileFormat = Video::DetectFileFormat(filename);
-
-    std::unique_ptr<ImageReader> imageReader;
-
     switch (fileFormat)
     {
         case ImageFileFormats::JPG:
@@ -39,17 +37,32 @@ FORK_EXPORT ImageUBytePtr ReadImage(const std::string& filename)
             Use a separated image reader onyl for JPEGs,
             -> to support baseline and progressive JPEG images.
             */
-            imageReader = std::make_unique<JPEGImageReader>();
-            break;
+            return std::make_unique<JPEGImageReader>();
 
         default:
             /* Use common image reader for default types */
-            imageReader = std::make_unique<CommonImageReader>();
-            break;
+            return std::make_unique<CommonImageReader>();
     }
+}
 
-    /* Read image data */
-    return imageReader != nullptr ? imageReader->ReadImage(filename) : nullptr;
+static ImageFileFormats DetectFileFormat(IO::File& file, const std::string& name)
+{
+    /* Peek the magic number and restore the file position */
+    char magicNumber[4] = { 0 };
+
+    const auto pos = file.Pos();
+    file.ReadBuffer(magicNumber, 4);
+    file.SeekPos(static_cast<std::streampos>(pos));
+
+    return Video::DetectFileFormat(magicNumber, sizeof(magicNumber), name);
+}
+
+/* --- Global functions --- */
+
+FORK_EXPORT ImageUBytePtr ReadImage(const std::string& filename)
+{
+    auto imageReader = CreateImageReader(Video::DetectFileFormat(filename));
+    return imageReader->ReadImage(filename);
 }
 
 FORK_EXPORT ImageFloatPtr ReadImageHDR(const std::string& filename, float gamma, float scale)
@@ -58,6 +71,30 @@ FORK_EXPORT ImageFloatPtr ReadImageHDR(const std::string& filename, float gamma,
     return imageReader.ReadImageHDR(filename, gamma, scale);
 }
 
+FORK_EXPORT ImageUBytePtr ReadImageFromMemory(const void* data, size_t size, const std::string& name)
+{
+    auto imageReader = CreateImageReader(Video::DetectFileFormat(data, size, name));
+    return imageReader->ReadImageFromMemory(data, size, name);
+}
+
+FORK_EXPORT ImageFloatPtr ReadImageHDRFromMemory(const void* data, size_t size, const std::string& name, float gamma, float scale)
+{
+    CommonImageReader imageReader;
+    return imageReader.ReadImageHDRFromMemory(data, size, name, gamma, scale);
+}
+
+FORK_EXPORT ImageUBytePtr ReadImage(IO::File& file, const std::string& name)
+{
+    auto imageReader = CreateImageReader(DetectFileFormat(file, name));
+    return imageReader->ReadImage(file, name);
+}
+
+FORK_EXPORT ImageFloatPtr ReadImageHDR(IO::File& file, const std::string& name, float gamma, float scale)
+{
+    CommonImageReader imageReader;
+    return imageReader.ReadImageHDR(file, name, gamma, scale);
+}
+
 FORK_EXPORT bool WriteImage(
     const ImageUBytePtr& image, const std::string& filename, const ImageFileFormats format)
 {
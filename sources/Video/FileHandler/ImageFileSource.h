@@ -0,0 +1,100 @@
+/*
+ * Image file source header
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __FORK_IMAGE_FILE_SOURCE_H__
+#define __FORK_IMAGE_FILE_SOURCE_H__
+
+
+#include "IO/FileSystem/File.h"
+
+#include <algorithm>
+
+
+namespace Fork
+{
+
+namespace Video
+{
+
+
+/**
+Bounded read stream for the image decoders, which read directly from a file (physical or virtual)
+instead of reading the entire file content into a temporary buffer first.
+The stream starts at the current file position and knows the number of remaining bytes,
+since the file interface does not report the number of bytes, which have actually been read.
+*/
+class ImageFileSource
+{
+
+    public:
+
+        ImageFileSource(IO::File& file) :
+            file_{ file }
+        {
+            /* Determine number of remaining bytes */
+            const auto pos = file_.Pos();
+            file_.SeekPos(0, IO::File::SeekDirections::End);
+            const auto end = file_.Pos();
+            file_.SeekPos(static_cast<std::streampos>(pos));
+
+            remaining_ = (end > pos ? end - pos : 0);
+        }
+
+        ImageFileSource(const ImageFileSource&) = delete;
+        ImageFileSource& operator = (const ImageFileSource&) = delete;
+
+        //! Reads at most 'size' bytes into the specified buffer and returns the number of bytes, which have been read.
+        size_t Read(void* buffer, size_t size)
+        {
+            size = std::min(size, remaining_);
+            if (size > 0)
+            {
+                file_.ReadBuffer(buffer, size);
+                remaining_ -= size;
+            }
+            return size;
+        }
+
+        //! Skips the specified number of bytes. If 'offset' is negative, the previous bytes are read again.
+        void Skip(long long offset)
+        {
+            if (offset > 0)
+                offset = std::min(offset, static_cast<long long>(remaining_));
+            file_.SeekPos(static_cast<std::streamoff>(offset), IO::File::SeekDirections::Current);
+            remaining_ = static_cast<size_t>(static_cast<long long>(remaining_) - offset);
+        }
+
+        //! Returns true if the end of the file has been reached.
+        inline bool IsEOF() const
+        {
+            return remaining_ == 0;
+        }
+
+        //! Returns the number of remaining bytes.
+        inline size_t Remaining() const
+        {
+            return remaining_;
+        }
+
+    private:
+
+        IO::File&   file_;
+        size_t      remaining_ = 0;
+
+};
+
+
+} // /namespace Video
+
+} // /namespace Fork
+
+
+#endif
+
+
+
+// ========================
@@ -6,12 +6,12 @@
  */
 
 #include "JPEGImageReader.h"
+#include "ImageFileSource.h"
 #include "IO/Core/Log.h"
-#include "IO/FileSystem/FileStreamHelper.h"
+#include "IO/FileSystem/PhysicalFile.h"
 #include "../../Plugins/jpeglib/jpeglib.h"
 
 #include <vector>
-#include <fstream>
 
 
 namespace Fork
@@ -21,6 +21,10 @@ namespace Video
 {
 
 
+/*
+ * Internal functions
+ */
+
 static ImageUBytePtr DecompressJPEG(jpeg_decompress_struct& info)
 {
     /* Start the decompression */
@@ -41,10 +45,11 @@ static ImageUBytePtr DecompressJPEG(jpeg_decompress_struct& info)
 
     const ImageColorFormats imageFormat = ChooseImageFormat(info.num_components);
 
-    /* Create image object */
+    /* Create image object (the buffer is entirely overwritten by the scanlines, so it is not filled) */
     auto image = std::make_shared<ImageUByte>(
         ImageUByte::SizeType(info.image_width, info.image_height, 1),
-        imageFormat
+        imageFormat,
+        false
     );
 
     /* Store pointers to each scanline in the image buffer */
@@ -77,23 +82,71 @@ static ImageUBytePtr DecompressJPEG(jpeg_decompress_struct& info)
     return image;
 }
 
-ImageUBytePtr JPEGImageReader::ReadImage(const std::string& filename)
+/* --- JPEG source manager to read directly from a file --- */
+
+struct JPEGFileSourceManager
 {
-    /* Open file for reading */
-    std::ifstream file(filename, std::ios::binary);
+    jpeg_source_mgr     pub;            //!< Public fields (must be the first member).
+    ImageFileSource*    source;
+    JOCTET              buffer[4096];
+};
+
+static void JPEGInitSource(j_decompress_ptr info)
+{
+    // dummy
+}
 
-    if (!file.good())
+static boolean JPEGFillInputBuffer(j_decompress_ptr info)
+{
+    auto srcMngr = reinterpret_cast<JPEGFileSourceManager*>(info->src);
+
+    auto numBytes = srcMngr->source->Read(srcMngr->buffer, sizeof(srcMngr->buffer));
+
+    if (numBytes == 0)
     {
-        IO::Log::Error("Loading image file \"" + filename + "\" failed");
-        return nullptr;
+        /* Insert a fake EOI marker (like the standard source managers of the JPEG library) */
+        srcMngr->buffer[0] = static_cast<JOCTET>(0xFF);
+        srcMngr->buffer[1] = static_cast<JOCTET>(JPEG_EOI);
+        numBytes = 2;
     }
 
-    /* Read complete file into a buffer */
-    const auto fileSize = static_cast<unsigned int>(IO::QueryFileSize(file));
+    srcMngr->pub.next_input_byte = srcMngr->buffer;
+    srcMngr->pub.bytes_in_buffer = numBytes;
+
+    return TRUE;
+}
+
+static void JPEGSkipInputData(j_decompress_ptr info, long numBytes)
+{
+    auto& pub = info->src;
+
+    if (numBytes <= 0)
+        return;
 
-    std::vector<unsigned char> buffer(fileSize);
-    file.read(reinterpret_cast<char*>(buffer.data()), fileSize);
+    /* Skip buffered data first, then skip the rest in the file */
+    const auto numBuffered = static_cast<long>(pub->bytes_in_buffer);
 
+    if (numBytes <= numBuffered)
+    {
+        pub->next_input_byte += numBytes;
+        pub->bytes_in_buffer -= static_cast<size_t>(numBytes);
+    }
+    else
+    {
+        reinterpret_cast<JPEGFileSourceManager*>(pub)->source->Skip(numBytes - numBuffered);
+        pub->next_input_byte = nullptr;
+        pub->bytes_in_buffer = 0;
+    }
+}
+
+static void JPEGTermSource(j_decompress_ptr info)
+{
+    // dummy
+}
+
+//! Decompresses the JPEG image with the source manager, which has been setup by the specified callback.
+template <typename SetupSourceProc> ImageUBytePtr DecompressJPEG(SetupSourceProc setupSource)
+{
     /* Initialize JPEG lib */
     jpeg_decompress_struct info;
     jpeg_error_mgr jerr;
@@ -102,7 +155,7 @@ ImageUBytePtr JPEGImageReader::ReadImage(const std::string& filename)
     jpeg_create_decompress(&info);
 
     /* Decompress the JPEG image data */
-    jpeg_mem_src(&info, buffer.data(), fileSize);
+    setupSource(info);
 
     auto image = DecompressJPEG(info);
 
@@ -111,12 +164,92 @@ ImageUBytePtr JPEGImageReader::ReadImage(const std::string& filename)
     return image;
 }
 
+
+/*
+ * JPEGImageReader class
+ */
+
+ImageUBytePtr JPEGImageReader::ReadImage(const std::string& filename)
+{
+    /* Open file for reading */
+    IO::PhysicalFile file(filename, IO::File::OpenFlags::Read);
+
+    if (!file.IsOpen())
+    {
+        IO::Log::Error("Loading image file \"" + filename + "\" failed");
+        return nullptr;
+    }
+
+    /* Decode image directly from the file (without reading the entire file into a buffer first) */
+    return ReadImage(file, filename);
+}
+
 ImageFloatPtr JPEGImageReader::ReadImageHDR(const std::string& filename, float gamma, float scale)
 {
     IO::Log::Error("HDR image not supported for JPEG images");
     return nullptr;
 }
 
+ImageUBytePtr JPEGImageReader::ReadImageFromMemory(const void* data, size_t size, const std::string& name)
+{
+    if (!data || size == 0)
+    {
+        IO::Log::Error("Loading image file \"" + name + "\" failed");
+        return nullptr;
+    }
+
+    return DecompressJPEG(
+        [&](jpeg_decompress_struct& info)
+        {
+            /* The memory source manager does not modify the buffer */
+            jpeg_mem_src(&info, reinterpret_cast<unsigned char*>(const_cast<void*>(data)), static_cast<unsigned long>(size));
+        }
+    );
+}
+
+ImageFloatPtr JPEGImageReader::ReadImageHDRFromMemory(
+    const void* data, size_t size, const std::string& name, float gamma, float scale)
+{
+    return ReadImageHDR(name, gamma, scale);
+}
+
+ImageUBytePtr JPEGImageReader::ReadImage(IO::File& file, const std::string& name)
+{
+    ImageFileSource source(file);
+
+    if (source.IsEOF())
+    {
+        IO::Log::Error("Loading image file \"" + name + "\" failed");
+        return nullptr;
+    }
+
+    return DecompressJPEG(
+        [&](jpeg_decompress_struct& info)
+        {
+            /* Setup source manager, which reads the file in small chunks */
+            auto srcMngr = reinterpret_cast<JPEGFileSourceManager*>(
+                (*info.mem->alloc_small)(reinterpret_cast<j_common_ptr>(&info), JPOOL_PERMANENT, sizeof(JPEGFileSourceManager))
+            );
+
+            srcMngr->pub.init_source        = JPEGInitSource;
+            srcMngr->pub.fill_input_buffer  = JPEGFillInputBuffer;
+            srcMngr->pub.skip_input_data    = JPEGSkipInputData;
+            srcMngr->pub.resync_to_restart  = jpeg_resync_to_restart;
+            srcMngr->pub.term_source        = JPEGTermSource;
+            srcMngr->pub.next_input_byte    = nullptr;
+            srcMngr->pub.bytes_in_buffer    = 0;
+            srcMngr->source                 = &source;
+
+            info.src = &(srcMngr->pub);
+        }
+    );
+}
+
+ImageFloatPtr JPEGImageReader::ReadImageHDR(IO::File& file, const std::string& name, float gamma, float scale)
+{
+    return ReadImageHDR(name, gamma, scale);
+}
+
 
 } // /namespace Video
 
@@ -27,6 +27,12 @@ class JPEGImageReader : public ImageReader
         ImageUBytePtr ReadImage(const std::string& filename);
         ImageFloatPtr ReadImageHDR(const std::string& filename, float gamma = 2.2f, float scale = 1.0f);
 
+        ImageUBytePtr ReadImageFromMemory(const void* data, size_t size, const std::string& name);
+        ImageFloatPtr ReadImageHDRFromMemory(const void* data, size_t size, const std::string& name, float gamma = 2.2f, float scale = 1.0f);
+
+        ImageUBytePtr ReadImage(IO::File& file, const std::string& name);
+        ImageFloatPtr ReadImageHDR(IO::File& file, const std::string& name, float gamma = 2.2f, float scale = 1.0f);
+
 };
 
 
@@ -0,0 +1,735 @@
+/*
+ * Image converter file
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Video/Image/ImageConverter.h"
+#include "Core/Jobs/JobSystem.h"
+
+#include <vector>
+#include <cstring>
+
+#if defined(FORK_ENABLE_AVX) || defined(FORK_ENABLE_AVX2)
+#   include <immintrin.h>
+#elif defined(FORK_ENABLE_SSE2)
+#   include <emmintrin.h>
+#endif
+
+
+namespace Fork
+{
+
+namespace Video
+{
+
+namespace ImageConverter
+{
+
+
+/* --- Internal structures --- */
+
+//! Sample of a linear interpolation between two pixels of a scanline (or between two scanlines).
+struct LinearSample
+{
+    size_t          index0  = 0;    //!< Element index of the first pixel (or scanline).
+    size_t          index1  = 0;    //!< Element index of the second pixel (or scanline).
+    float           weight  = 0.0f; //!< Interpolation weight of the second pixel in the range [0, 1].
+    unsigned int    weight8 = 0;    //!< Interpolation weight of the second pixel in 8-bit fixed-point, i.e. in the range [0, 256].
+};
+
+/* --- Internal functions --- */
+
+/*
+Minimal number of elements (color components), which are processed by a single job.
+Smaller images are converted directly on the calling thread.
+*/
+static const size_t minBandSize = 256*1024;
+
+/*
+Calls the specified function for the range [0, numItems) either directly,
+or in parallel bands (see Jobs::JobSystem::ParallelForRange) if the image is large enough.
+'itemSize' specifies the number of elements of each item (e.g. the number of color components of a scanline).
+The function must have the following interface: void func(size_t begin, size_t end).
+*/
+template <class Function> static void ForEachBand(size_t numItems, size_t itemSize, Function func)
+{
+    const auto bandSize = std::max(size_t(1), minBandSize / std::max(size_t(1), itemSize));
+
+    if (numItems <= bandSize)
+        func(0, numItems);
+    else
+        Jobs::JobSystem::Instance()->ParallelForRange(0, numItems, func, bandSize);
+}
+
+static bool IsColorFormatBGR(const ImageColorFormats format)
+{
+    return format == ImageColorFormats::BGR || format == ImageColorFormats::BGRA;
+}
+
+static bool IsColorFormatRGB(const ImageColorFormats format)
+{
+    return format == ImageColorFormats::RGB || format == ImageColorFormats::RGBA || IsColorFormatBGR(format);
+}
+
+static int Load32(const unsigned char* src)
+{
+    int value;
+    std::memcpy(&value, src, 4);
+    return value;
+}
+
+static void Store32(unsigned char* dst, int value)
+{
+    std::memcpy(dst, &value, 4);
+}
+
+static void ComputeLinearSamples(size_t srcSize, size_t destSize, size_t stride, std::vector<LinearSample>& samples)
+{
+    /* Use the same sample positions as the scalar implementation (between the pixel centers) */
+    const float scale = static_cast<float>(srcSize) / destSize;
+
+    samples.resize(destSize);
+
+    for (size_t i = 0; i < destSize; ++i)
+    {
+        const float f = std::max(0.0f, (i + 0.5f)*scale - 0.5f);
+        const size_t i0 = std::min(static_cast<size_t>(f), srcSize - 1);
+        const size_t i1 = std::min(i0 + 1, srcSize - 1);
+
+        auto& sample = samples[i];
+        {
+            sample.index0   = i0*stride;
+            sample.index1   = i1*stride;
+            sample.weight   = std::min(f - i0, 1.0f);
+            sample.weight8  = static_cast<unsigned int>(sample.weight*256.0f + 0.5f);
+        }
+    }
+}
+
+#if defined(FORK_ENABLE_SSE2)
+
+//! Swaps the red and blue components of four packed RGBA8 colors.
+static __m128i SwapRB(__m128i v)
+{
+    const __m128i maskGA    = _mm_set1_epi32(static_cast<int>(0xff00ff00u));
+    const __m128i maskByte  = _mm_set1_epi32(0x000000ff);
+
+    return _mm_or_si128(
+        _mm_and_si128(v, maskGA),
+        _mm_or_si128(
+            _mm_slli_epi32(_mm_and_si128(v, maskByte), 16),
+            _mm_and_si128(_mm_srli_epi32(v, 16), maskByte)
+        )
+    );
+}
+
+#endif
+
+#if defined(FORK_ENABLE_AVX2)
+
+//! Swaps the red and blue components of eight packed RGBA8 colors.
+static __m256i SwapRB(__m256i v)
+{
+    const __m256i maskGA    = _mm256_set1_epi32(static_cast<int>(0xff00ff00u));
+    const __m256i maskByte  = _mm256_set1_epi32(0x000000ff);
+
+    return _mm256_or_si256(
+        _mm256_and_si256(v, maskGA),
+        _mm256_or_si256(
+            _mm256_slli_epi32(_mm256_and_si256(v, maskByte), 16),
+            _mm256_and_si256(_mm256_srli_epi32(v, 16), maskByte)
+        )
+    );
+}
+
+#endif
+
+/* --- Scanline swapping --- */
+
+static void SwapMemory(unsigned char* a, unsigned char* b, size_t size)
+{
+    size_t i = 0;
+
+    #if defined(FORK_ENABLE_AVX)
+
+    for (; i + 32 <= size; i += 32)
+    {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i), vb);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(b + i), va);
+    }
+
+    #elif defined(FORK_ENABLE_SSE2)
+
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(a + i), vb);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(b + i), va);
+    }
+
+    #endif
+
+    for (; i < size; ++i)
+        std::swap(a[i], b[i]);
+}
+
+static void FlipScanlines(unsigned char* imageBuffer, const SizeType& size, size_t pitchWidth, size_t elementSize)
+{
+    const size_t halfHeight     = size.height/2;
+    const size_t pitchBytes     = pitchWidth*elementSize;
+    const size_t pitchHeight    = pitchBytes*size.height;
+
+    /* Swap each pair of scanlines (of all slices) */
+    ForEachBand(
+        size.depth*halfHeight, pitchWidth,
+        [&](size_t begin, size_t end)
+        {
+            for (; begin < end; ++begin)
+            {
+                const auto z = begin / halfHeight;
+                const auto y = begin % halfHeight;
+
+                auto slice = imageBuffer + z*pitchHeight;
+                SwapMemory(slice + y*pitchBytes, slice + (size.height - y - 1)*pitchBytes, pitchBytes);
+            }
+        }
+    );
+}
+
+/* --- Color format conversion --- */
+
+static void ExpandRGBToRGBA(const unsigned char* src, unsigned char* dst, size_t numPixels, bool swapRGB, unsigned char alpha)
+{
+    size_t i = 0;
+
+    const int alphaBits = static_cast<int>(static_cast<unsigned int>(alpha) << 24);
+
+    #if defined(FORK_ENABLE_AVX2)
+
+    /*
+    Move the 24 bytes of eight RGB colors into the lower 12 bytes of each 128-bit lane,
+    then expand each lane to four RGBA colors (the loads read 8 bytes beyond the eighth color).
+    */
+    const __m256i permutation   = _mm256_setr_epi32(0, 1, 2, 0, 3, 4, 5, 0);
+    const __m256i shuffle       = (
+        swapRGB ?
+            _mm256_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1, 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1) :
+            _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1)
+    );
+    const __m256i alphaMask8    = _mm256_set1_epi32(alphaBits);
+
+    for (; i + 11 <= numPixels; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i*3));
+        v = _mm256_permutevar8x32_epi32(v, permutation);
+        v = _mm256_shuffle_epi8(v, shuffle);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i*4), _mm256_or_si256(v, alphaMask8));
+    }
+
+    #endif
+
+    #if defined(FORK_ENABLE_SSE2)
+
+    /* Load each RGB color as 32-bit value (the last load reads 1 byte beyond the fourth color) */
+    const __m128i colorMask = _mm_set1_epi32(0x00ffffff);
+    const __m128i alphaMask = _mm_set1_epi32(alphaBits);
+
+    for (; i + 5 <= numPixels; i += 4)
+    {
+        const auto s = src + i*3;
+
+        __m128i v = _mm_and_si128(_mm_setr_epi32(Load32(s), Load32(s + 3), Load32(s + 6), Load32(s + 9)), colorMask);
+
+        if (swapRGB)
+            v = SwapRB(v);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i*4), _mm_or_si128(v, alphaMask));
+    }
+
+    #endif
+
+    /* Convert remaining colors */
+    const size_t r = (swapRGB ? 2 : 0);
+
+    for (; i < numPixels; ++i)
+    {
+        const auto s = src + i*3;
+        auto d = dst + i*4;
+
+        d[0] = s[r];
+        d[1] = s[1];
+        d[2] = s[2 - r];
+        d[3] = alpha;
+    }
+}
+
+static void SwizzleRGBA(const unsigned char* src, unsigned char* dst, size_t numPixels)
+{
+    size_t i = 0;
+
+    #if defined(FORK_ENABLE_AVX2)
+
+    for (; i + 8 <= numPixels; i += 8)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i*4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i*4), SwapRB(v));
+    }
+
+    #endif
+
+    #if defined(FORK_ENABLE_SSE2)
+
+    for (; i + 4 <= numPixels; i += 4)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i*4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i*4), SwapRB(v));
+    }
+
+    #endif
+
+    /* Convert remaining colors */
+    for (; i < numPixels; ++i)
+    {
+        const auto s = src + i*4;
+        auto d = dst + i*4;
+
+        const auto red = s[0];
+        d[0] = s[2];
+        d[1] = s[1];
+        d[2] = red;
+        d[3] = s[3];
+    }
+}
+
+static void ExpandRGBToRGBA(const float* src, float* dst, size_t numPixels, bool swapRGB, float alpha)
+{
+    size_t i = 0;
+
+    #if defined(FORK_ENABLE_SSE2)
+
+    /* Load each RGB color as 4D vector (the load reads 1 component of the next color, so skip the last color) */
+    const __m128 alphaVec = _mm_set1_ps(alpha);
+
+    for (; i + 1 < numPixels; ++i)
+    {
+        const __m128 v = _mm_loadu_ps(src + i*3);
+
+        const __m128 color = (
+            swapRGB ?
+                _mm_shuffle_ps(v, _mm_unpacklo_ps(v, alphaVec), _MM_SHUFFLE(1, 0, 1, 2)) :
+                _mm_shuffle_ps(v, _mm_unpackhi_ps(v, alphaVec), _MM_SHUFFLE(1, 0, 1, 0))
+        );
+
+        _mm_storeu_ps(dst + i*4, color);
+    }
+
+    #endif
+
+    /* Convert remaining colors */
+    const size_t r = (swapRGB ? 2 : 0);
+
+    for (; i < numPixels; ++i)
+    {
+        const auto s = src + i*3;
+        auto d = dst + i*4;
+
+        d[0] = s[r];
+        d[1] = s[1];
+        d[2] = s[2 - r];
+        d[3] = alpha;
+    }
+}
+
+static void SwizzleRGBA(const float* src, float* dst, size_t numPixels)
+{
+    size_t i = 0;
+
+    #if defined(FORK_ENABLE_AVX)
+
+    for (; i + 2 <= numPixels; i += 2)
+    {
+        const __m256 v = _mm256_loadu_ps(src + i*4);
+        _mm256_storeu_ps(dst + i*4, _mm256_permute_ps(v, _MM_SHUFFLE(3, 0, 1, 2)));
+    }
+
+    #elif defined(FORK_ENABLE_SSE2)
+
+    for (; i < numPixels; ++i)
+    {
+        const __m128 v = _mm_loadu_ps(src + i*4);
+        _mm_storeu_ps(dst + i*4, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 1, 2)));
+    }
+
+    #endif
+
+    /* Convert remaining colors */
+    for (; i < numPixels; ++i)
+    {
+        const auto s = src + i*4;
+        auto d = dst + i*4;
+
+        const auto red = s[0];
+        d[0] = s[2];
+        d[1] = s[1];
+        d[2] = red;
+        d[3] = s[3];
+    }
+}
+
+/*
+Converts the image format with the accelerated kernels (RGB/BGR -> RGBA/BGRA, RGBA <-> BGRA).
+Returns false if the conversion is not supported by the accelerated kernels.
+*/
+template <typename T> static bool ConvertImageFormatAccelerated(
+    const T* srcBuffer, const ImageColorFormats srcFormat,
+    T* destBuffer, const ImageColorFormats destFormat,
+    size_t numPixels, const T& defaultAlpha)
+{
+    if (!IsColorFormatRGB(srcFormat) || !IsColorFormatRGB(destFormat))
+        return false;
+
+    const auto compSrc  = NumColorComponents(srcFormat);
+    const auto compDest = NumColorComponents(destFormat);
+    const bool swapRGB  = (IsColorFormatBGR(srcFormat) != IsColorFormatBGR(destFormat));
+
+    if (compDest != 4 || (compSrc == 4 && !swapRGB))
+        return false;
+
+    const auto alpha = defaultAlpha;
+
+    ForEachBand(
+        numPixels, compDest,
+        [&](size_t begin, size_t end)
+        {
+            if (compSrc == 3)
+                ExpandRGBToRGBA(srcBuffer + begin*3, destBuffer + begin*4, end - begin, swapRGB, alpha);
+            else
+                SwizzleRGBA(srcBuffer + begin*4, destBuffer + begin*4, end - begin);
+        }
+    );
+
+    return true;
+}
+
+/* --- Linear image resizing --- */
+
+//! Interpolates between the two scanlines 'a' and 'b'.
+static void LerpScanlines(const unsigned char* a, const unsigned char* b, unsigned char* dst, size_t size, const LinearSample& sample)
+{
+    const auto w1 = sample.weight8;
+    const auto w0 = 256 - w1;
+
+    if (w1 == 0)
+    {
+        std::copy(a, a + size, dst);
+        return;
+    }
+
+    size_t i = 0;
+
+    #if defined(FORK_ENABLE_AVX2)
+
+    {
+        const __m256i zero      = _mm256_setzero_si256();
+        const __m256i round     = _mm256_set1_epi16(128);
+        const __m256i weight0   = _mm256_set1_epi16(static_cast<short>(w0));
+        const __m256i weight1   = _mm256_set1_epi16(static_cast<short>(w1));
+
+        for (; i + 32 <= size; i += 32)
+        {
+            const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+
+            /* Compute (a*w0 + b*w1 + 128) / 256 with 16-bit integers (unpack and pack work per 128-bit lane, so the order is kept) */
+            __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(va, zero), weight0), _mm256_mullo_epi16(_mm256_unpacklo_epi8(vb, zero), weight1));
+            __m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(va, zero), weight0), _mm256_mullo_epi16(_mm256_unpackhi_epi8(vb, zero), weight1));
+
+            lo = _mm256_srli_epi16(_mm256_add_epi16(lo, round), 8);
+            hi = _mm256_srli_epi16(_mm256_add_epi16(hi, round), 8);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packus_epi16(lo, hi));
+        }
+    }
+
+    #endif
+
+    #if defined(FORK_ENABLE_SSE2)
+
+    {
+        const __m128i zero      = _mm_setzero_si128();
+        const __m128i round     = _mm_set1_epi16(128);
+        const __m128i weight0   = _mm_set1_epi16(static_cast<short>(w0));
+        const __m128i weight1   = _mm_set1_epi16(static_cast<short>(w1));
+
+        for (; i + 16 <= size; i += 16)
+        {
+            const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+
+            /* Compute (a*w0 + b*w1 + 128) / 256 with 16-bit integers */
+            __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(va, zero), weight0), _mm_mullo_epi16(_mm_unpacklo_epi8(vb, zero), weight1));
+            __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(va, zero), weight0), _mm_mullo_epi16(_mm_unpackhi_epi8(vb, zero), weight1));
+
+            lo = _mm_srli_epi16(_mm_add_epi16(lo, round), 8);
+            hi = _mm_srli_epi16(_mm_add_epi16(hi, round), 8);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+        }
+    }
+
+    #endif
+
+    for (; i < size; ++i)
+        dst[i] = static_cast<unsigned char>((a[i]*w0 + b[i]*w1 + 128) >> 8);
+}
+
+//! Interpolates between the two scanlines 'a' and 'b'.
+static void LerpScanlines(const float* a, const float* b, float* dst, size_t size, const LinearSample& sample)
+{
+    const auto t = sample.weight;
+
+    if (t == 0.0f)
+    {
+        std::copy(a, a + size, dst);
+        return;
+    }
+
+    size_t i = 0;
+
+    #if defined(FORK_ENABLE_AVX)
+
+    {
+        const __m256 weight = _mm256_set1_ps(t);
+
+        for (; i + 8 <= size; i += 8)
+        {
+            const __m256 va = _mm256_loadu_ps(a + i);
+            const __m256 vb = _mm256_loadu_ps(b + i);
+            _mm256_storeu_ps(dst + i, _mm256_add_ps(va, _mm256_mul_ps(_mm256_sub_ps(vb, va), weight)));
+        }
+    }
+
+    #endif
+
+    #if defined(FORK_ENABLE_SSE2)
+
+    {
+        const __m128 weight = _mm_set1_ps(t);
+
+        for (; i + 4 <= size; i += 4)
+        {
+            const __m128 va = _mm_loadu_ps(a + i);
+            const __m128 vb = _mm_loadu_ps(b + i);
+            _mm_storeu_ps(dst + i, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), weight)));
+        }
+    }
+
+    #endif
+
+    for (; i < size; ++i)
+        dst[i] = a[i] + (b[i] - a[i])*t;
+}
+
+//! Interpolates the colors of the specified scanline into the destination scanline.
+static void LerpColors(const unsigned char* src, unsigned char* dst, const std::vector<LinearSample>& samples, size_t components)
+{
+    #if defined(FORK_ENABLE_SSE2)
+
+    if (components == 4)
+    {
+        const __m128i zero  = _mm_setzero_si128();
+        const __m128i round = _mm_set1_epi16(128);
+
+        for (const auto& sample : samples)
+        {
+            const __m128i c0 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(Load32(src + sample.index0)), zero);
+            const __m128i c1 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(Load32(src + sample.index1)), zero);
+
+            const __m128i weight0 = _mm_set1_epi16(static_cast<short>(256 - sample.weight8));
+            const __m128i weight1 = _mm_set1_epi16(static_cast<short>(sample.weight8));
+
+            __m128i v = _mm_add_epi16(_mm_mullo_epi16(c0, weight0), _mm_mullo_epi16(c1, weight1));
+            v = _mm_srli_epi16(_mm_add_epi16(v, round), 8);
+
+            Store32(dst, _mm_cvtsi128_si32(_mm_packus_epi16(v, v)));
+            dst += 4;
+        }
+        return;
+    }
+
+    #endif
+
+    for (const auto& sample : samples)
+    {
+        const auto w1 = sample.weight8;
+        const auto w0 = 256 - w1;
+
+        for (size_t c = 0; c < components; ++c)
+            *dst++ = static_cast<unsigned char>((src[sample.index0 + c]*w0 + src[sample.index1 + c]*w1 + 128) >> 8);
+    }
+}
+
+//! Interpolates the colors of the specified scanline into the destination scanline.
+static void LerpColors(const float* src, float* dst, const std::vector<LinearSample>& samples, size_t components)
+{
+    #if defined(FORK_ENABLE_SSE2)
+
+    if (components == 4)
+    {
+        for (const auto& sample : samples)
+        {
+            const __m128 c0 = _mm_loadu_ps(src + sample.index0);
+            const __m128 c1 = _mm_loadu_ps(src + sample.index1);
+            _mm_storeu_ps(dst, _mm_add_ps(c0, _mm_mul_ps(_mm_sub_ps(c1, c0), _mm_set1_ps(sample.weight))));
+            dst += 4;
+        }
+        return;
+    }
+
+    #endif
+
+    for (const auto& sample : samples)
+    {
+        for (size_t c = 0; c < components; ++c)
+        {
+            const auto a = src[sample.index0 + c];
+            const auto b = src[sample.index1 + c];
+            *dst++ = a + (b - a)*sample.weight;
+        }
+    }
+}
+
+/*
+Resizes the image in two passes for each destination scanline:
+first the two source scanlines are interpolated into a temporary scanline (vertical pass),
+then the colors of the temporary scanline are interpolated (horizontal pass).
+*/
+template <typename T> static void ResizeImageLinearAccelerated(
+    const T* srcImageBuffer, const SizeType& srcSize,
+    T* destImageBuffer, const SizeType& destSize,
+    size_t components)
+{
+    /* Check parameter validity */
+    ASSERT_POINTER(srcImageBuffer);
+    ASSERT_POINTER(destImageBuffer);
+
+    if (components < 1 || components > 4)
+        throw ImageConversionException(__FUNCTION__, srcSize, components);
+
+    if (srcSize.Volume() == 0 || destSize.Volume() == 0)
+        return;
+
+    const size_t pitchSrcWidth  = srcSize.width*components;
+    const size_t pitchSrcHeight = pitchSrcWidth*srcSize.height;
+    const size_t pitchDestWidth = destSize.width*components;
+
+    /* Compute interpolation samples for all columns and scanlines */
+    std::vector<LinearSample> samplesX, samplesY;
+
+    ComputeLinearSamples(srcSize.width, destSize.width, components, samplesX);
+    ComputeLinearSamples(srcSize.height, destSize.height, pitchSrcWidth, samplesY);
+
+    /* Resize each scanline (of all slices) */
+    ForEachBand(
+        destSize.depth*destSize.height, pitchDestWidth,
+        [&](size_t begin, size_t end)
+        {
+            std::vector<T> scanline(pitchSrcWidth);
+
+            for (; begin < end; ++begin)
+            {
+                const auto z = begin / destSize.height;
+                const auto y = begin % destSize.height;
+
+                const auto srcSlice = srcImageBuffer + ( z * srcSize.depth / destSize.depth ) * pitchSrcHeight;
+                const auto& sample = samplesY[y];
+
+                LerpScanlines(srcSlice + sample.index0, srcSlice + sample.index1, scanline.data(), pitchSrcWidth, sample);
+                LerpColors(scanline.data(), destImageBuffer + begin*pitchDestWidth, samplesX, components);
+            }
+        }
+    );
+}
+
+
+/* --- Global functions --- */
+
+template <> FORK_EXPORT void FlipImageY<unsigned char>(unsigned char* imageBuffer, const SizeType& size, size_t components)
+{
+    /* Check parameter validity */
+    ASSERT_POINTER(imageBuffer);
+
+    if (components < 1 || components > 4)
+        throw ImageConversionException(__FUNCTION__, size, components);
+
+    FlipScanlines(imageBuffer, size, size.width*components, sizeof(unsigned char));
+}
+
+template <> FORK_EXPORT void FlipImageY<float>(float* imageBuffer, const SizeType& size, size_t components)
+{
+    /* Check parameter validity */
+    ASSERT_POINTER(imageBuffer);
+
+    if (components < 1 || components > 4)
+        throw ImageConversionException(__FUNCTION__, size, components);
+
+    FlipScanlines(reinterpret_cast<unsigned char*>(imageBuffer), size, size.width*components, sizeof(float));
+}
+
+template <> FORK_EXPORT void ResizeImageLinear<unsigned char>(
+    const unsigned char* srcImageBuffer, const SizeType& srcSize,
+    unsigned char* destImageBuffer, const SizeType& destSize,
+    size_t components)
+{
+    ResizeImageLinearAccelerated(srcImageBuffer, srcSize, destImageBuffer, destSize, components);
+}
+
+template <> FORK_EXPORT void ResizeImageLinear<float>(
+    const float* srcImageBuffer, const SizeType& srcSize,
+    float* destImageBuffer, const SizeType& destSize,
+    size_t components)
+{
+    ResizeImageLinearAccelerated(srcImageBuffer, srcSize, destImageBuffer, destSize, components);
+}
+
+template <> FORK_EXPORT void ConvertImageFormat<unsigned char>(
+    const unsigned char* srcBuffer, const ImageColorFormats srcFormat,
+    unsigned char* destBuffer, const ImageColorFormats destFormat,
+    size_t numPixels, const unsigned char& defaultAlpha)
+{
+    /* Validate parameters */
+    ASSERT_POINTER(srcBuffer);
+    ASSERT_POINTER(destBuffer);
+
+    if (!ConvertImageFormatAccelerated(srcBuffer, srcFormat, destBuffer, destFormat, numPixels, defaultAlpha))
+        Scalar::ConvertImageFormat(srcBuffer, srcFormat, destBuffer, destFormat, numPixels, defaultAlpha);
+}
+
+template <> FORK_EXPORT void ConvertImageFormat<float>(
+    const float* srcBuffer, const ImageColorFormats srcFormat,
+    float* destBuffer, const ImageColorFormats destFormat,
+    size_t numPixels, const float& defaultAlpha)
+{
+    /* Validate parameters */
+    ASSERT_POINTER(srcBuffer);
+    ASSERT_POINTER(destBuffer);
+
+    if (!ConvertImageFormatAccelerated(srcBuffer, srcFormat, destBuffer, destFormat, numPixels, defaultAlpha))
+        Scalar::ConvertImageFormat(srcBuffer, srcFormat, destBuffer, destFormat, numPixels, defaultAlpha);
+}
+
+
+} // /namespace ImageConverter
+
+} // /namespace Video
+
+} // /namespace Fork
+
+
+
+// ========================
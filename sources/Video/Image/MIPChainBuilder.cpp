@@ -0,0 +1,502 @@
+/*
+ * MIP chain builder file
+ *
+ * This file is part of the "ForkENGINE" (Copyright (c) 2014 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Video/Image/MIPChainBuilder.h"
+#include "Core/Exception/InvalidArgumentException.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Math/Core/MathConstants.h"
+
+#include <cmath>
+#include <algorithm>
+
+
+namespace Fork
+{
+
+namespace Video
+{
+
+namespace MIPChainBuilder
+{
+
+
+typedef Math::Size3st SizeType;
+
+/* --- Internal structures --- */
+
+//! Filter weights for all destination pixels of one dimension.
+struct FilterKernel
+{
+    struct Range
+    {
+        size_t first = 0;   //!< Index of the first tap.
+        size_t count = 0;   //!< Number of taps.
+    };
+
+    std::vector<Range>  ranges;     //!< Tap range for each destination pixel.
+    std::vector<size_t> indices;    //!< Source pixel index of each tap.
+    std::vector<float>  weights;    //!< Normalized weight of each tap.
+};
+
+//! Intermediate MIP level with floating-point color components in linear space.
+struct LinearImage
+{
+    SizeType            size;
+    size_t              components = 0;
+    std::vector<float>  buffer;
+};
+
+typedef std::shared_ptr<LinearImage> LinearImagePtr;
+
+/* --- Internal functions --- */
+
+//! Minimal number of elements (color components), which are filtered by a single job.
+static const size_t minBandSize = 64*1024;
+
+/*
+Calls the specified function for the rows [0, numRows) either directly,
+or in parallel row bands (see Jobs::JobSystem::ParallelForRange) if the image is large enough.
+*/
+template <class Function> static void ForEachRowBand(size_t numRows, size_t rowSize, Function func)
+{
+    const auto bandSize = std::max(size_t(1), minBandSize / std::max(size_t(1), rowSize));
+
+    if (numRows <= bandSize)
+        func(0, numRows);
+    else
+        Jobs::JobSystem::Instance()->ParallelForRange(0, numRows, func, bandSize);
+}
+
+static float Sinc(float x)
+{
+    if (std::abs(x) < 1.0e-5f)
+        return 1.0f;
+    x *= Math::pi;
+    return std::sin(x) / x;
+}
+
+//! Returns the modified Bessel function of the first kind of order zero.
+static float BesselI0(float x)
+{
+    float sum = 1.0f, term = 1.0f;
+
+    for (int k = 1; k < 32 && term > sum*1.0e-7f; ++k)
+    {
+        const float t = x / (2.0f*k);
+        term *= t*t;
+        sum += term;
+    }
+
+    return sum;
+}
+
+static float FilterRadius(const Filters filter)
+{
+    return (filter == Filters::Box ? 0.5f : 3.0f);
+}
+
+static float FilterWeight(const Filters filter, float x)
+{
+    static const float kaiserAlpha = 4.0f;
+
+    const float radius = FilterRadius(filter);
+
+    x = std::abs(x);
+    if (x > radius)
+        return 0.0f;
+
+    switch (filter)
+    {
+        case Filters::Box:
+            return 1.0f;
+
+        case Filters::Kaiser:
+        {
+            const float t = x / radius;
+            return Sinc(x) * BesselI0(kaiserAlpha*std::sqrt(1.0f - t*t)) / BesselI0(kaiserAlpha);
+        }
+
+        case Filters::Lanczos:
+            return Sinc(x) * Sinc(x / radius);
+    }
+
+    return 0.0f;
+}
+
+static void BuildFilterKernel(size_t srcSize, size_t destSize, const Description& desc, FilterKernel& kernel)
+{
+    kernel.ranges.resize(destSize);
+    kernel.indices.clear();
+    kernel.weights.clear();
+
+    if (srcSize == destSize)
+    {
+        /* Use identity kernel (e.g. for the width of a 1xN image) */
+        for (size_t i = 0; i < destSize; ++i)
+        {
+            kernel.ranges[i].first = i;
+            kernel.ranges[i].count = 1;
+            kernel.indices.push_back(i);
+            kernel.weights.push_back(1.0f);
+        }
+        return;
+    }
+
+    /* Stretch the filter by the scale factor, so that it covers the source pixels of each destination pixel */
+    const float scale   = static_cast<float>(srcSize) / destSize;
+    const float support = FilterRadius(desc.filter)*scale;
+    const auto  size    = static_cast<long long>(srcSize);
+
+    for (size_t i = 0; i < destSize; ++i)
+    {
+        const float center  = (i + 0.5f)*scale;
+        const auto  first   = static_cast<long long>(std::floor(center - support));
+        const auto  last    = static_cast<long long>(std::ceil(center + support));
+
+        auto& range = kernel.ranges[i];
+        range.first = kernel.weights.size();
+
+        float sum = 0.0f;
+
+        for (auto j = first; j <= last; ++j)
+        {
+            const float weight = FilterWeight(desc.filter, (j + 0.5f - center) / scale);
+            if (weight == 0.0f)
+                continue;
+
+            /* Map source index into the image (wrap around or clamp to edge) */
+            const auto index = (desc.wrap ? ((j % size) + size) % size : std::max(0ll, std::min(j, size - 1)));
+
+            kernel.indices.push_back(static_cast<size_t>(index));
+            kernel.weights.push_back(weight);
+            sum += weight;
+        }
+
+        range.count = kernel.weights.size() - range.first;
+
+        /* Normalize weights */
+        if (sum != 0.0f)
+        {
+            for (size_t k = range.first; k < kernel.weights.size(); ++k)
+                kernel.weights[k] /= sum;
+        }
+    }
+}
+
+static float SRGBToLinear(float value)
+{
+    return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+static float LinearToSRGB(float value)
+{
+    value = std::max(0.0f, value);
+    return value <= 0.0031308f ? value * 12.92f : 1.055f*std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+static float ToUnitValue(unsigned char value)
+{
+    return static_cast<float>(value) / 255.0f;
+}
+
+static float ToUnitValue(float value)
+{
+    return value;
+}
+
+static void FromUnitValue(float value, unsigned char& result)
+{
+    result = static_cast<unsigned char>(std::max(0.0f, std::min(value, 1.0f))*255.0f + 0.5f);
+}
+
+static void FromUnitValue(float value, float& result)
+{
+    result = value;
+}
+
+//! Returns the index of the alpha component, or the number of components if the format has no alpha channel.
+static size_t AlphaComponentIndex(const ImageColorFormats format)
+{
+    switch (format)
+    {
+        case ImageColorFormats::GrayAlpha:
+            return 1;
+        case ImageColorFormats::RGBA:
+        case ImageColorFormats::BGRA:
+            return 3;
+        default:
+            return NumColorComponents(format);
+    }
+}
+
+template <typename T> static LinearImagePtr ToLinearImage(const Image<T>& image, const Description& desc, size_t alphaIndex)
+{
+    auto linearImage = std::make_shared<LinearImage>();
+
+    linearImage->size       = image.GetSize();
+    linearImage->components = image.NumColorComponents();
+    linearImage->buffer.resize(image.NumElements());
+
+    const auto components = linearImage->components;
+    const auto src = image.RawBuffer();
+    auto dst = linearImage->buffer.data();
+
+    for (size_t i = 0, n = image.NumElements(); i < n; ++i)
+    {
+        const auto value = ToUnitValue(src[i]);
+        dst[i] = (desc.sRGB && i % components != alphaIndex ? SRGBToLinear(value) : value);
+    }
+
+    return linearImage;
+}
+
+//! Downsamples the specified image with the separable filter (first horizontal, then vertical).
+static LinearImagePtr Downsample(const LinearImage& src, const SizeType& destSize, const Description& desc)
+{
+    const auto components   = src.components;
+    const auto& srcSize     = src.size;
+
+    FilterKernel kernelX, kernelY;
+
+    BuildFilterKernel(srcSize.width, destSize.width, desc, kernelX);
+    BuildFilterKernel(srcSize.height, destSize.height, desc, kernelY);
+
+    const size_t pitchSrc   = srcSize.width*components;
+    const size_t pitchDest  = destSize.width*components;
+
+    /* Horizontal pass: filter each source scanline */
+    std::vector<float> scanlines(pitchDest*srcSize.height*srcSize.depth);
+
+    ForEachRowBand(
+        srcSize.depth*srcSize.height, pitchDest,
+        [&](size_t begin, size_t end)
+        {
+            for (; begin < end; ++begin)
+            {
+                const auto srcRow = src.buffer.data() + begin*pitchSrc;
+                auto dstRow = scanlines.data() + begin*pitchDest;
+
+                for (const auto& range : kernelX.ranges)
+                {
+                    float color[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+                    for (size_t k = range.first; k < range.first + range.count; ++k)
+                    {
+                        const auto pixel = srcRow + kernelX.indices[k]*components;
+                        const auto weight = kernelX.weights[k];
+
+                        for (size_t c = 0; c < components; ++c)
+                            color[c] += pixel[c]*weight;
+                    }
+
+                    for (size_t c = 0; c < components; ++c)
+                        *dstRow++ = color[c];
+                }
+            }
+        }
+    );
+
+    /* Vertical pass: filter the scanlines of the horizontal pass */
+    auto dest = std::make_shared<LinearImage>();
+
+    dest->size          = destSize;
+    dest->components    = components;
+    dest->buffer.resize(pitchDest*destSize.height*destSize.depth, 0.0f);
+
+    ForEachRowBand(
+        destSize.depth*destSize.height, pitchDest,
+        [&](size_t begin, size_t end)
+        {
+            for (; begin < end; ++begin)
+            {
+                const auto z = begin / destSize.height;
+                const auto y = begin % destSize.height;
+
+                const auto& range = kernelY.ranges[y];
+                auto dstRow = dest->buffer.data() + begin*pitchDest;
+
+                for (size_t k = range.first; k < range.first + range.count; ++k)
+                {
+                    const auto srcRow = scanlines.data() + (z*srcSize.height + kernelY.indices[k])*pitchDest;
+                    const auto weight = kernelY.weights[k];
+
+                    for (size_t i = 0; i < pitchDest; ++i)
+                        dstRow[i] += srcRow[i]*weight;
+                }
+            }
+        }
+    );
+
+    return dest;
+}
+
+//! Returns the fraction of pixels, which pass the alpha test with the specified reference value.
+static float AlphaCoverage(const LinearImage& image, size_t alphaIndex, float alphaReference)
+{
+    const auto components = image.components;
+    const auto numPixels = image.buffer.size() / components;
+
+    if (numPixels == 0)
+        return 0.0f;
+
+    size_t numCovered = 0;
+
+    for (size_t i = alphaIndex; i < image.buffer.size(); i += components)
+    {
+        if (image.buffer[i] > alphaReference)
+            ++numCovered;
+    }
+
+    return static_cast<float>(numCovered) / numPixels;
+}
+
+/*
+Returns the alpha scale factor, so that the specified image has the same alpha coverage as the original image.
+A binary search for the alpha reference value, which results in the desired coverage, is used for this.
+*/
+static float AlphaCoverageScale(const LinearImage& image, size_t alphaIndex, float alphaReference, float coverage)
+{
+    float lower = 0.0f, upper = 1.0f, reference = alphaReference;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        reference = (lower + upper)*0.5f;
+
+        if (AlphaCoverage(image, alphaIndex, reference) > coverage)
+            lower = reference;
+        else
+            upper = reference;
+    }
+
+    return alphaReference / std::max(reference, 1.0e-4f);
+}
+
+//! Converts the specified intermediate MIP level into its final format.
+template <typename T> static void EncodeLevel(
+    const LinearImage& src, Image<T>& dest, const Description& desc, size_t alphaIndex, float coverage)
+{
+    const auto components   = src.components;
+    const bool hasAlpha     = (alphaIndex < components);
+    const float alphaScale  = (
+        desc.preserveAlphaCoverage && hasAlpha ?
+            AlphaCoverageScale(src, alphaIndex, desc.alphaReference, coverage) :
+            1.0f
+    );
+
+    auto dst = dest.RawBuffer();
+
+    for (size_t i = 0, n = src.buffer.size(); i < n; ++i)
+    {
+        auto value = src.buffer[i];
+
+        if (i % components == alphaIndex)
+        {
+            if (alphaScale != 1.0f)
+                value = std::min(value*alphaScale, 1.0f);
+        }
+        else if (desc.sRGB)
+            value = LinearToSRGB(value);
+
+        FromUnitValue(value, dst[i]);
+    }
+}
+
+template <typename T> static std::vector<std::shared_ptr<Image<T>>> BuildMIPChainPrimary(const Image<T>& image, const Description& desc)
+{
+    const auto format = image.GetFormat();
+
+    if (format < ImageColorFormats::Gray || format > ImageColorFormats::BGRA)
+        throw InvalidArgumentException(__FUNCTION__, "image", "Invalid color format for MIP chain generation");
+
+    std::vector<std::shared_ptr<Image<T>>> mipChain;
+
+    if (image.NumPixels() == 0)
+        return mipChain;
+
+    /* Determine number of MIP levels */
+    const auto& size = image.GetSize();
+
+    size_t numLevels = 1;
+    for (auto maxSize = std::max(size.width, size.height); maxSize > 1; maxSize /= 2)
+        ++numLevels;
+
+    if (desc.maxNumLevels > 0)
+        numLevels = std::min(numLevels, desc.maxNumLevels);
+
+    mipChain.reserve(numLevels);
+    mipChain.push_back(image.Copy());
+
+    if (numLevels == 1)
+        return mipChain;
+
+    /* Convert source image into linear space */
+    const auto alphaIndex = AlphaComponentIndex(format);
+
+    auto level = ToLinearImage(image, desc, alphaIndex);
+
+    const float coverage = (
+        desc.preserveAlphaCoverage && alphaIndex < level->components ?
+            AlphaCoverage(*level, alphaIndex, desc.alphaReference) :
+            0.0f
+    );
+
+    /* Filter each MIP level from its previous level */
+    auto jobSystem = Jobs::JobSystem::Instance();
+    Jobs::JobCounter encodeCounter;
+
+    for (size_t i = 1; i < numLevels; ++i)
+    {
+        const SizeType levelSize
+        {
+            std::max(size_t(1), level->size.width  / 2),
+            std::max(size_t(1), level->size.height / 2),
+            level->size.depth
+        };
+
+        level = Downsample(*level, levelSize, desc);
+
+        auto levelImage = std::make_shared<Image<T>>(levelSize, format, false);
+        mipChain.push_back(levelImage);
+
+        /* Convert this level into its final format, while the next level is being filtered */
+        jobSystem->Submit(
+            [level, levelImage, &desc, alphaIndex, coverage]()
+            {
+                EncodeLevel(*level, *levelImage, desc, alphaIndex, coverage);
+            },
+            &encodeCounter
+        );
+    }
+
+    jobSystem->Wait(encodeCounter);
+
+    return mipChain;
+}
+
+
+/* --- Global functions --- */
+
+FORK_EXPORT MIPChainUByte BuildMIPChain(const ImageUByte& image, const Description& desc)
+{
+    return BuildMIPChainPrimary(image, desc);
+}
+
+FORK_EXPORT MIPChainFloat BuildMIPChain(const ImageFloat& image, const Description& desc)
+{
+    return BuildMIPChainPrimary(image, desc);
+}
+
+
+} // /namespace MIPChainBuilder
+
+} // /namespace Video
+
+} // /namespace Fork
+
+
+
+// ========================
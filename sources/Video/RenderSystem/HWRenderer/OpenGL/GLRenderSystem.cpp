@@ -314,6 +314,8 @@ TextureCubePtr GLRenderSystem::CreateTextureCube()
 
 static void InitGLTextureFilterAndUnbind(GLenum target)
 {
+    /* Reset the MIP level range, which might have been limited by a previous MIP chain */
+    glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, 1000);
     glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glBindTexture(target, 0);
 }
@@ -406,6 +408,77 @@ void GLRenderSystem::WriteTexture(
     InitGLTextureFilterAndUnbind(target);
 }
 
+void GLRenderSystem::WriteTexture(
+    Texture2D* texture,
+    const TextureFormats textureFormat, const Texture2D::SizeType& textureSize, unsigned int arraySize,
+    const ImageColorFormats imageFormat, const RendererDataTypes imageDataType, const void* imageData,
+    unsigned int mipLevel)
+{
+    if (mipLevel == 0)
+    {
+        WriteTexture(texture, textureFormat, textureSize, arraySize, imageFormat, imageDataType, imageData);
+        return;
+    }
+
+    ValidateImageDataType(imageDataType);
+
+    /* Get GL texture */
+    auto textureGL = CAST_TO_GL_OBJECT(Texture2D, texture);
+
+    /* Allocate and write the specified MIP level only */
+    const auto target = textureGL->GetTarget();
+    const auto level = static_cast<GLint>(mipLevel);
+
+    glBindTexture(target, textureGL->GetTextureID());
+
+    if (texture->HasArray())
+    {
+        FLUSH_GL_ERROR;
+
+        /* Write image data to the MIP level of the entire 2D texture array */
+        glTexImage3D(
+            target,                                     // Texture target
+            level,                                      // Write to the specified MIP layer
+            GLParamMapper::Map(textureFormat, true),    // Internal hardware format
+            textureSize.width,                          // MIP level width
+            textureSize.height,                         // MIP level height
+            static_cast<int>(texture->GetArraySize()),  // 2D array size
+            0,                                          // No border
+            GLParamMapper::Map(imageFormat, false),     // Image color format
+            GLParamMapper::Map(imageDataType),          // Image data type
+            imageData                                   // Image buffer
+        );
+
+        SHOW_GL_ERROR("WriteTexture(2D)/glTexImage3D");
+    }
+    else
+    {
+        FLUSH_GL_ERROR;
+
+        /* Write image data to the MIP level of the 2D texture */
+        glTexImage2D(
+            target,                                     // Texture target
+            level,                                      // Write to the specified MIP layer
+            GLParamMapper::Map(textureFormat, true),    // Internal hardware format
+            textureSize.width,                          // MIP level width
+            textureSize.height,                         // MIP level height
+            0,                                          // No border
+            GLParamMapper::Map(imageFormat, false),     // Image color format
+            GLParamMapper::Map(imageDataType),          // Image data type
+            imageData                                   // Image buffer
+        );
+
+        SHOW_GL_ERROR("WriteTexture(2D)/glTexImage2D");
+    }
+
+    /* Limit the texture to the levels written so far, so it is always MIP-map complete */
+    glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, level);
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glBindTexture(target, 0);
+
+    ChangeTextureMIPState(texture, true);
+}
+
 void GLRenderSystem::WriteSubTexture(
     Texture2D* texture,
     const Texture2D::PositionType& position, const Texture2D::SizeType& size, unsigned int arrayIndex,
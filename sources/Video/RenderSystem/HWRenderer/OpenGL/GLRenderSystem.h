@@ -122,6 +122,12 @@ class GLRenderSystem : public RenderSystem
             const TextureFormats textureFormat, const Texture2D::SizeType& textureSize, unsigned int arraySize,
             const ImageColorFormats imageFormat, const RendererDataTypes imageDataType, const void* imageData
         ) override;
+        void WriteTexture(
+            Texture2D* texture,
+            const TextureFormats textureFormat, const Texture2D::SizeType& textureSize, unsigned int arraySize,
+            const ImageColorFormats imageFormat, const RendererDataTypes imageDataType, const void* imageData,
+            unsigned int mipLevel
+        ) override;
         void WriteSubTexture(
             Texture2D* texture,
             const Texture2D::PositionType& position, const Texture2D::SizeType& size, unsigned int arrayIndex,
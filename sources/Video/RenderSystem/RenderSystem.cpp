@@ -23,6 +23,56 @@ namespace Video
 {
 
 
+/* --- Internal functions --- */
+
+template <typename T> static void WriteTextureMIPChain(
+    RenderSystem& renderSystem, Texture2D* texture,
+    const std::vector<std::shared_ptr<Image<T>>>& mipChain, const RendererDataTypes dataType)
+{
+    ASSERT_POINTER(texture);
+
+    if (mipChain.empty() || !mipChain.front())
+        throw InvalidArgumentException(__FUNCTION__, "mipChain", "MIP chain must not be empty");
+
+    /* Write first MIP level */
+    const auto& baseImage = *mipChain.front();
+    const auto imageFormat = baseImage.GetFormat();
+
+    renderSystem.WriteTexture(
+        texture,
+        ChooseTextureFormat(imageFormat, dataType),
+        baseImage.GetSize().Sz2().template Cast<int>(),
+        0,
+        imageFormat,
+        dataType,
+        baseImage.RawBuffer()
+    );
+
+    if (mipChain.size() == 1)
+        return;
+
+    /* Allocate and write the remaining MIP levels (no MIP-maps are generated) */
+    for (size_t i = 1; i < mipChain.size(); ++i)
+    {
+        const auto& image = mipChain[i];
+
+        if (!image || image->GetFormat() != imageFormat)
+            throw InvalidArgumentException(__FUNCTION__, "mipChain", "All MIP levels must have the same color format");
+
+        renderSystem.WriteTexture(
+            texture,
+            texture->GetFormat(),
+            image->GetSize().Sz2().template Cast<int>(),
+            0,
+            imageFormat,
+            dataType,
+            image->RawBuffer(),
+            static_cast<unsigned int>(i)
+        );
+    }
+}
+
+
 RenderSystem* RenderSystem::activeRenderSystem_ = nullptr;
 
 RenderSystem::RenderSystem()
@@ -202,6 +252,32 @@ void RenderSystem::WriteTexture(Texture2D* texture, const ImageUByte& image)
     );
 }
 
+void RenderSystem::WriteTexture(
+    Texture2D* texture,
+    const TextureFormats textureFormat, const Texture2D::SizeType& textureSize, unsigned int arraySize,
+    const ImageColorFormats imageFormat, const RendererDataTypes imageDataType, const void* imageData,
+    unsigned int mipLevel)
+{
+    if (mipLevel == 0)
+        WriteTexture(texture, textureFormat, textureSize, arraySize, imageFormat, imageDataType, imageData);
+    else
+    {
+        ASSERT_POINTER(texture);
+        WriteSubTexture(texture, {}, textureSize, 0, imageFormat, imageDataType, imageData, mipLevel);
+        ChangeTextureMIPState(texture, true);
+    }
+}
+
+void RenderSystem::WriteTexture(Texture2D* texture, const MIPChainUByte& mipChain)
+{
+    WriteTextureMIPChain(*this, texture, mipChain, RendererDataTypes::UByte);
+}
+
+void RenderSystem::WriteTexture(Texture2D* texture, const MIPChainFloat& mipChain)
+{
+    WriteTextureMIPChain(*this, texture, mipChain, RendererDataTypes::Float);
+}
+
 void RenderSystem::WriteTexture(
     Texture3D* texture, const TextureFormats textureFormat, const Texture3D::SizeType& textureSize)
 {
@@ -302,6 +378,11 @@ void RenderSystem::ChangeTextureFormat(Texture* texture, TextureFormats format)
     texture->format = format;
 }
 
+void RenderSystem::ChangeTextureMIPState(Texture* texture, bool hasMIPMaps)
+{
+    texture->hasMIPMaps = hasMIPMaps;
+}
+
 void RenderSystem::CreateDefaultResources(const ContextDescription& contextDesc)
 {
     /* Create default rasterizer state */
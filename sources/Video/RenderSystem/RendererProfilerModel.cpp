@@ -19,11 +19,13 @@ void RendererProfilerModel::Reset()
 {
     drawCallCounter_            = 0;
     renderedTriangleCounter_    = 0;
+    batchedDrawCallCounter_     = 0;
 
     renderTargetBindingCounter_ = 0;
     textureBindingCounter_      = 0;
     bufferBindingCounter_       = 0;
     shaderBindingCounter_       = 0;
+    skippedBindingCounter_      = 0;
 
     textureCreationCounter_     = 0;
     textureUpdateCounter_       = 0;
@@ -9,12 +9,15 @@
 #include "Video/RenderSystem/RenderSystem.h"
 #include "Video/RenderSystem/RenderContext.h"
 #include "Video/FileHandler/ImageFileHandler.h"
+#include "IO/FileSystem/PhysicalFile.h"
 #include "Core/Exception/NullPointerException.h"
 #include "Core/STLHelper.h"
+#include "Core/Jobs/JobSystem.h"
 #include "IO/Core/Log.h"
 #include "../RenderSysCtx.h"
 
 #include <algorithm>
+#include <exception>
 
 
 namespace Fork
@@ -26,6 +29,27 @@ namespace Video
 
 /* === Internal functions === */
 
+/*
+Reads the image through the file interface of the image file handler,
+i.e. the file content is streamed directly into the decoder without a temporary copy.
+*/
+static ImageUBytePtr ReadTextureImage(const std::string& filename)
+{
+    IO::PhysicalFile file;
+    if (!file.Open(filename, IO::File::OpenFlags::Read))
+        return nullptr;
+    return ImageFileHandler::ReadImage(file, filename);
+}
+
+//! Reads the HDR image through the file interface of the image file handler. \see ReadTextureImage
+static ImageFloatPtr ReadTextureImageHDR(const std::string& filename)
+{
+    IO::PhysicalFile file;
+    if (!file.Open(filename, IO::File::OpenFlags::Read))
+        return nullptr;
+    return ImageFileHandler::ReadImageHDR(file, filename);
+}
+
 static void FilterMaxImageSize(const Math::Size3st& imageSize, Math::Size3st& maxImageSize, bool& mustResize)
 {
     if (maxImageSize.width > 0 && maxImageSize.height > 0 && imageSize != maxImageSize)
@@ -56,73 +80,55 @@ template <class ImageContainer> void ResizeAllImages(ImageContainer& images, con
 }
 
 
-/* --- Texture2D Array --- */
+/* --- Texture2D --- */
 
-Texture2DPtr TextureManager::CreateTexture2DFromFile(const std::string& filename, bool hasHDR)
+TextureManager::~TextureManager()
 {
-    /* Get active render system and render context */
-    auto renderSystem = RenderSys();
-    auto renderContext = RenderCtx();
+    /* Wait until all decode jobs are finished, since they refer to this texture manager */
+    std::vector<AsyncTexture2DRequestPtr> requests;
+
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex_);
+        for (const auto& it : pendingTextures_)
+            requests.push_back(it.second);
+    }
+
+    for (const auto& request : requests)
+    {
+        if (!request->decodeCounter.IsDone())
+            Jobs::JobSystem::Instance()->Wait(request->decodeCounter);
+    }
+}
 
+Texture2DPtr TextureManager::CreateTexture2DFromFile(const std::string& filename, bool hasHDR)
+{
     /* Print information */
     IO::Log::Message("Load texture: \"" + filename + "\"");
     IO::Log::ScopedIndent indent;
 
-    /* Create texture */
-    Video::Texture2DPtr texture;
+    ImageUBytePtr image;
+    ImageFloatPtr imageHDR;
 
     if (hasHDR)
     {
         /* Read HDR image from file */
-        auto image = ImageFileHandler::ReadImageHDR(filename);
-
-        if (image)
-        {
-            /* Adjust image format alignment (RGB -> RGBA, BGR -> BGRA) */
-            image->AdjustFormatAlignment();
-
-            /* Create and initialize texture */
-            texture = renderSystem->CreateTexture2D();
+        imageHDR = ReadTextureImageHDR(filename);
 
-            //!TODO! -> WriteTexture(texture.get(), *image); !!!!!!
-            renderSystem->WriteTexture(
-                texture.get(),
-                ChooseTextureFormat(image->GetFormat(), Video::RendererDataTypes::Float),
-                image->GetSize().Sz2().Cast<int>(), 0,
-                image->GetFormat(), Video::RendererDataTypes::Float, image->RawBuffer()
-            );
-        }
+        /* Adjust image format alignment (RGB -> RGBA, BGR -> BGRA) */
+        if (imageHDR)
+            imageHDR->AdjustFormatAlignment();
     }
     else
     {
         /* Read image from file */
-        auto image = ImageFileHandler::ReadImage(filename);
+        image = ReadTextureImage(filename);
 
+        /* Adjust image format alignment (RGB -> RGBA, BGR -> BGRA) */
         if (image)
-        {
-            /* Adjust image format alignment (RGB -> RGBA, BGR -> BGRA) */
             image->AdjustFormatAlignment();
-
-            /* Create and initialize texture */
-            texture = renderSystem->CreateTexture2D();
-            renderSystem->WriteTexture(texture.get(), *image);
-        }
-    }
-
-    if (texture)
-    {
-        texture->metaData.name = filename;
-
-        renderContext->GenerateMIPMaps(texture.get());
-
-        /* Notify all event handlers about the created texture */
-        for (const auto& eventHandler : eventHandlers_)
-            eventHandler->OnTexture2DCreated(texture);
-
-        return AddTexture(texture);
     }
 
-    return nullptr;
+    return CreateTexture2DFromImage(filename, image, imageHDR);
 }
 
 /* --- Texture2D Array --- */
@@ -155,7 +161,7 @@ Texture2DPtr TextureManager::CreateTexture2DArrayFromFiles(const std::vector<std
             IO::Log::ScopedIndent indent;
 
             /* Read HDR image from file */
-            auto image = ImageFileHandler::ReadImageHDR(filename);
+            auto image = ReadTextureImageHDR(filename);
             images.push_back(image);
 
             if (image)
@@ -210,7 +216,7 @@ Texture2DPtr TextureManager::CreateTexture2DArrayFromFiles(const std::vector<std
             IO::Log::ScopedIndent indent;
 
             /* Read image from file */
-            auto image = ImageFileHandler::ReadImage(filename);
+            auto image = ReadTextureImage(filename);
             images.push_back(image);
 
             if (image)
@@ -299,7 +305,7 @@ TextureCubePtr TextureManager::CreateTextureCubeFromFiles(const Math::Cuboid<std
             IO::Log::ScopedIndent indent;
 
             /* Read HDR image from file */
-            auto image = ImageFileHandler::ReadImageHDR(filename);
+            auto image = ReadTextureImageHDR(filename);
             images.push_back(image);
 
             if (image)
@@ -354,7 +360,7 @@ TextureCubePtr TextureManager::CreateTextureCubeFromFiles(const Math::Cuboid<std
             IO::Log::ScopedIndent indent;
 
             /* Read image from file */
-            auto image = ImageFileHandler::ReadImage(filename);
+            auto image = ReadTextureImage(filename);
             images.push_back(image);
 
             if (image)
@@ -404,15 +410,43 @@ TextureCubePtr TextureManager::CreateTextureCubeFromFiles(const Math::Cuboid<std
 
 Texture2DPtr TextureManager::LoadTexture2D(const std::string& filename, bool hasHDR)
 {
-    /* Check if texture already exists */
-    auto texture = loaded2DTextures_.Find(filename);
-    if (texture)
-        return texture;
+    /* Check if texture already exists or is already pending */
+    AsyncTexture2DRequestPtr pendingRequest;
+
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex_);
+
+        auto texture = loaded2DTextures_.Find(filename);
+        if (texture)
+            return texture;
+
+        auto it = pendingTextures_.find(filename);
+        if (it != pendingTextures_.end())
+            pendingRequest = it->second;
+    }
+
+    if (pendingRequest)
+    {
+        /* Finish the pending request, instead of decoding the same image a second time (only its own decode job is awaited) */
+        if (!pendingRequest->decodeCounter.IsDone())
+            Jobs::JobSystem::Instance()->Wait(pendingRequest->decodeCounter);
+
+        {
+            std::lock_guard<std::mutex> lock(asyncMutex_);
+
+            auto it = std::find(decodedTextures_.begin(), decodedTextures_.end(), pendingRequest);
+            if (it != decodedTextures_.end())
+                decodedTextures_.erase(it);
+        }
+
+        return CommitAsyncTexture(pendingRequest);
+    }
 
     /* Otherwise load texture from file */
-    texture = CreateTexture2DFromFile(filename);
+    auto texture = CreateTexture2DFromFile(filename);
     if (texture)
     {
+        std::lock_guard<std::mutex> lock(asyncMutex_);
         loaded2DTextures_.hashMap[filename] = texture;
         return texture;
     }
@@ -420,10 +454,92 @@ Texture2DPtr TextureManager::LoadTexture2D(const std::string& filename, bool has
     return nullptr;
 }
 
+AsyncTexture2DPtr TextureManager::LoadTexture2DAsync(const std::string& filename, bool hasHDR)
+{
+    AsyncTexture2DRequestPtr request;
+
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex_);
+
+        /* Check if texture already exists */
+        auto texture = loaded2DTextures_.Find(filename);
+        if (texture)
+        {
+            auto handle = std::make_shared<AsyncTexture2D>();
+            handle->Resolve(texture);
+            return handle;
+        }
+
+        /* Check if texture is already pending */
+        auto it = pendingTextures_.find(filename);
+        if (it != pendingTextures_.end())
+            return it->second->handle;
+
+        /* Create new request */
+        request = std::make_shared<AsyncTexture2DRequest>();
+        {
+            request->filename   = filename;
+            request->hasHDR     = hasHDR;
+            request->handle     = std::make_shared<AsyncTexture2D>();
+        }
+        pendingTextures_[filename] = request;
+    }
+
+    /* Read and decode the image on the job system */
+    Jobs::JobSystem::Instance()->Submit(
+        [this, request]()
+        {
+            DecodeAsyncTexture(request);
+        },
+        &(request->decodeCounter)
+    );
+
+    return request->handle;
+}
+
+size_t TextureManager::CommitAsyncTextures(size_t byteBudget)
+{
+    size_t numCommittedBytes = 0;
+
+    while (byteBudget == 0 || numCommittedBytes < byteBudget)
+    {
+        /* Take next decoded request */
+        AsyncTexture2DRequestPtr request;
+        {
+            std::lock_guard<std::mutex> lock(asyncMutex_);
+
+            if (decodedTextures_.empty())
+                break;
+
+            request = decodedTextures_.front();
+            decodedTextures_.pop_front();
+        }
+
+        /* Create texture on the render thread */
+        if (request->image)
+            numCommittedBytes += request->image->BufferSize();
+        else if (request->imageHDR)
+            numCommittedBytes += request->imageHDR->BufferSize();
+
+        CommitAsyncTexture(request);
+    }
+
+    return NumPendingAsyncTextures();
+}
+
+size_t TextureManager::NumPendingAsyncTextures() const
+{
+    std::lock_guard<std::mutex> lock(asyncMutex_);
+    return pendingTextures_.size();
+}
+
 void TextureManager::ReleaseTexture(const Texture* texture)
 {
     /* Remove texture from hash map */
-    loaded2DTextures_.Remove(texture);
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex_);
+        loaded2DTextures_.Remove(texture);
+    }
 
     /* Remove texture from list */
     for (auto it = textures_.begin(); it != textures_.end(); ++it)
@@ -438,7 +554,10 @@ void TextureManager::ReleaseTexture(const Texture* texture)
 
 void TextureManager::ReleaseAllTextures()
 {
-    loaded2DTextures_.hashMap.clear();
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex_);
+        loaded2DTextures_.hashMap.clear();
+    }
     textures_.clear();
 }
 
@@ -454,6 +573,121 @@ void TextureManager::RemoveEventHandler(const EventHandlerPtr& eventHandler)
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+Texture2DPtr TextureManager::CreateTexture2DFromImage(
+    const std::string& filename, const ImageUBytePtr& image, const ImageFloatPtr& imageHDR)
+{
+    /* Get active render system and render context */
+    auto renderSystem = RenderSys();
+    auto renderContext = RenderCtx();
+
+    /* Create texture */
+    Video::Texture2DPtr texture;
+
+    if (imageHDR)
+    {
+        /* Create and initialize texture */
+        texture = renderSystem->CreateTexture2D();
+
+        //!TODO! -> WriteTexture(texture.get(), *image); !!!!!!
+        renderSystem->WriteTexture(
+            texture.get(),
+            ChooseTextureFormat(imageHDR->GetFormat(), Video::RendererDataTypes::Float),
+            imageHDR->GetSize().Sz2().Cast<int>(), 0,
+            imageHDR->GetFormat(), Video::RendererDataTypes::Float, imageHDR->RawBuffer()
+        );
+    }
+    else if (image)
+    {
+        /* Create and initialize texture */
+        texture = renderSystem->CreateTexture2D();
+        renderSystem->WriteTexture(texture.get(), *image);
+    }
+
+    if (texture)
+    {
+        texture->metaData.name = filename;
+
+        renderContext->GenerateMIPMaps(texture.get());
+
+        /* Notify all event handlers about the created texture */
+        for (const auto& eventHandler : eventHandlers_)
+            eventHandler->OnTexture2DCreated(texture);
+
+        return AddTexture(texture);
+    }
+
+    return nullptr;
+}
+
+Texture2DPtr TextureManager::CommitAsyncTexture(const AsyncTexture2DRequestPtr& request)
+{
+    Texture2DPtr texture;
+
+    if (request->image || request->imageHDR)
+    {
+        IO::Log::Message("Commit texture: \"" + request->filename + "\"");
+        IO::Log::ScopedIndent indent;
+
+        texture = CreateTexture2DFromImage(request->filename, request->image, request->imageHDR);
+    }
+
+    /* Release image memory before the request is finished */
+    request->image.reset();
+    request->imageHDR.reset();
+
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex_);
+
+        if (texture)
+            loaded2DTextures_.hashMap[request->filename] = texture;
+
+        pendingTextures_.erase(request->filename);
+    }
+
+    /* Resolve texture handle */
+    if (texture)
+        request->handle->Resolve(texture);
+    else
+        request->handle->Fail("Loading texture \"" + request->filename + "\" failed");
+
+    return texture;
+}
+
+void TextureManager::DecodeAsyncTexture(const AsyncTexture2DRequestPtr& request)
+{
+    /* Read and decode image (jobs must not throw exceptions) */
+    try
+    {
+        if (request->hasHDR)
+        {
+            request->imageHDR = ReadTextureImageHDR(request->filename);
+            if (request->imageHDR)
+                request->imageHDR->AdjustFormatAlignment();
+        }
+        else
+        {
+            request->image = ReadTextureImage(request->filename);
+            if (request->image)
+                request->image->AdjustFormatAlignment();
+        }
+    }
+    catch (const std::exception& err)
+    {
+        IO::Log::Error(err.what());
+        request->image.reset();
+        request->imageHDR.reset();
+    }
+
+    /* Queue request for the commit on the render thread (also failed requests to resolve their handles) */
+    std::lock_guard<std::mutex> lock(asyncMutex_);
+    decodedTextures_.push_back(request);
+}
+
+
 } // /namespace Video
 
 } // /namespace Fork
@@ -0,0 +1,311 @@
+// ForkENGINE: AnimationMixer Test
+// 17/10/2026
+
+#include "../TestUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace Fork;
+
+typedef Scene::Skeleton::Joint Joint;
+
+static Math::Transform3Df RandomTransform()
+{
+    Math::Transform3Df transform;
+    transform.SetPosition({ Random(), Random() + 1.0f, Random() });
+    transform.SetRotation(Math::Quaternionf(Random(), Random(), Random()));
+    transform.SetScale({ 1.0f + Random()*0.2f, 1.0f + Random()*0.2f, 1.0f + Random()*0.2f });
+    return transform;
+}
+
+//! Generates a clip with constant random transformations for all joints (two identical keyframes per joint).
+static Anim::SkeletalAnimationPtr GenerateClip(
+    const Scene::SkeletonPtr& skeleton, const Scene::FlatSkeleton& flatSkeleton,
+    const std::vector<Joint*>& joints, std::vector<Math::Transform3Df>& transforms)
+{
+    auto anim = std::make_shared<Anim::SkeletalAnimation>(skeleton);
+
+    transforms.resize(flatSkeleton.NumJoints());
+
+    for (auto joint : joints)
+    {
+        const auto transform = RandomTransform();
+        transforms[flatSkeleton.FindJoint(joint)] = transform;
+
+        Anim::SkeletalAnimation::KeyframeJoint keyJoint(joint);
+        keyJoint.keyframeSequence.AddTransform(0, transform);
+        keyJoint.keyframeSequence.AddTransform(1, transform);
+        keyJoint.keyframeSequence.BuildKeyframes();
+        anim->keyframeJoints.push_back(keyJoint);
+    }
+
+    anim->SetupJointIndices(flatSkeleton);
+
+    anim->playback.frame        = 0;
+    anim->playback.nextFrame    = 1;
+    anim->playback.interpolator = 0.0;
+
+    return anim;
+}
+
+/* --- Reference implementation with the math types (one joint at a time) --- */
+
+//! Returns the Hamilton product a * b.
+static Math::Quaternionf MulQuaternions(const Math::Quaternionf& a, const Math::Quaternionf& b)
+{
+    return Math::Quaternionf(
+        a.w*b.x + a.x*b.w + a.y*b.z - a.z*b.y,
+        a.w*b.y - a.x*b.z + a.y*b.w + a.z*b.x,
+        a.w*b.z + a.x*b.y - a.y*b.x + a.z*b.w,
+        a.w*b.w - a.x*b.x - a.y*b.y - a.z*b.z
+    );
+}
+
+static Math::Quaternionf NLerpQuaternions(const Math::Quaternionf& a, Math::Quaternionf b, float t)
+{
+    if (a.x*b.x + a.y*b.y + a.z*b.z + a.w*b.w < 0.0f)
+        b = Math::Quaternionf(-b.x, -b.y, -b.z, -b.w);
+
+    Math::Quaternionf result(
+        a.x + (b.x - a.x)*t,
+        a.y + (b.y - a.y)*t,
+        a.z + (b.z - a.z)*t,
+        a.w + (b.w - a.w)*t
+    );
+
+    return result.Normalize();
+}
+
+static Math::Transform3Df ReferenceBlend(const Math::Transform3Df& a, const Math::Transform3Df& b, float t)
+{
+    return Math::Transform3Df(
+        a.GetPosition() + (b.GetPosition() - a.GetPosition())*t,
+        NLerpQuaternions(a.GetRotation(), b.GetRotation(), t),
+        a.GetScale() + (b.GetScale() - a.GetScale())*t
+    );
+}
+
+static Math::Transform3Df ReferenceAdditive(
+    const Math::Transform3Df& base, const Math::Transform3Df& additive, const Math::Transform3Df& reference, float t)
+{
+    const auto& r = reference.GetRotation();
+    const auto delta = MulQuaternions(Math::Quaternionf(-r.x, -r.y, -r.z, r.w), additive.GetRotation());
+
+    const auto relScale = additive.GetScale() / reference.GetScale();
+
+    return Math::Transform3Df(
+        base.GetPosition() + (additive.GetPosition() - reference.GetPosition())*t,
+        MulQuaternions(base.GetRotation(), NLerpQuaternions(Math::Quaternionf(0, 0, 0, 1), delta, t)).Normalize(),
+        base.GetScale() * (Math::Vector3f(1.0f) + (relScale - Math::Vector3f(1.0f))*t)
+    );
+}
+
+//! Returns the maximal difference between the transformations (rotations are compared independently of their sign).
+static float PoseDifference(const Scene::SkeletonPose& pose, const std::vector<Math::Transform3Df>& reference)
+{
+    float maxDiff = 0.0f;
+
+    for (size_t i = 0; i < pose.NumJoints(); ++i)
+    {
+        const auto a = pose.GetLocalTransform(i);
+        const auto& b = reference[i];
+
+        const auto& qa = a.GetRotation();
+        const auto& qb = b.GetRotation();
+        const auto sign = (qa.x*qb.x + qa.y*qb.y + qa.z*qb.z + qa.w*qb.w < 0.0f ? -1.0f : 1.0f);
+
+        maxDiff = std::max(maxDiff, (a.GetPosition() - b.GetPosition()).Length());
+        maxDiff = std::max(maxDiff, Math::Vector4f(qa.x - qb.x*sign, qa.y - qb.y*sign, qa.z - qb.z*sign, qa.w - qb.w*sign).Length());
+        maxDiff = std::max(maxDiff, (a.GetScale() - b.GetScale()).Length());
+    }
+
+    return maxDiff;
+}
+
+static void LogResult(const std::string& name, float maxDiff)
+{
+    IO::Log::Message(name + ": max. difference = " + ToStr(maxDiff) + (maxDiff < 0.0001f ? " (passed)" : " (FAILED)"));
+}
+
+int main()
+{
+    IO::Log::AddDefaultEventHandler();
+
+    #if 1//!ANIMATION MIXER TEST!
+    {
+
+    const size_t numJoints = 64;
+    const size_t numCharacters = 500;
+    const size_t numFrames = 10;
+
+    auto timer = Platform::Timer::Create();
+
+    /* Create skeleton and flat skeleton */
+    auto skeleton = std::make_shared<Scene::Skeleton>();
+
+    std::vector<Joint*> joints;
+    GenerateJoints(skeleton->rootJoint, 0, numJoints, joints);
+    skeleton->rootJoint.UpdateOriginMatrix();
+
+    auto flatSkeleton = std::make_shared<Scene::FlatSkeleton>(*skeleton);
+    const auto& bindPose = flatSkeleton->GetBindPose();
+
+    /* Create clips */
+    std::vector<Math::Transform3Df> walkPose, runPose, wavePose, breathPose;
+
+    auto walkAnim   = GenerateClip(skeleton, *flatSkeleton, joints, walkPose);
+    auto runAnim    = GenerateClip(skeleton, *flatSkeleton, joints, runPose);
+    auto waveAnim   = GenerateClip(skeleton, *flatSkeleton, joints, wavePose);
+    auto breathAnim = GenerateClip(skeleton, *flatSkeleton, joints, breathPose);
+
+    /*
+    Build blend graph:
+    locomotion = blend(walk, run, 0.3)
+    upperBody  = blend(locomotion, wave, 0.8, mask of the first child joint)
+    output     = additive(upperBody, breath, 0.5)
+    */
+    Anim::AnimationMixer mixer(flatSkeleton);
+
+    auto walk   = mixer.AddClipNode(walkAnim.get());
+    auto run    = mixer.AddClipNode(runAnim.get());
+    auto wave   = mixer.AddClipNode(waveAnim.get());
+    auto breath = mixer.AddClipNode(breathAnim.get());
+
+    const auto spineJoint = flatSkeleton->FindJoint(joints[1]);
+    const auto mask = Anim::AnimationMixer::MakeJointMask(*flatSkeleton, spineJoint);
+
+    auto locomotion = mixer.AddBlendNode(walk, run, 0.3f);
+    auto upperBody  = mixer.AddBlendNode(locomotion, wave, 0.8f, mask);
+    auto output     = mixer.AddAdditiveNode(upperBody, breath, 0.5f);
+
+    /* Compare the mixer output with the reference poses */
+    Scene::SkeletonPose pose(flatSkeleton);
+    std::vector<Math::Transform3Df> reference(flatSkeleton->NumJoints());
+
+    mixer.SetOutputNode(locomotion);
+    mixer.Evaluate(pose);
+    for (size_t i = 0; i < reference.size(); ++i)
+        reference[i] = ReferenceBlend(walkPose[i], runPose[i], 0.3f);
+    LogResult("Blend", PoseDifference(pose, reference));
+
+    mixer.SetOutputNode(upperBody);
+    mixer.Evaluate(pose);
+    for (size_t i = 0; i < reference.size(); ++i)
+        reference[i] = ReferenceBlend(ReferenceBlend(walkPose[i], runPose[i], 0.3f), wavePose[i], 0.8f*mask[i]);
+    LogResult("Masked blend", PoseDifference(pose, reference));
+
+    mixer.SetOutputNode(output);
+    mixer.Evaluate(pose);
+    for (size_t i = 0; i < reference.size(); ++i)
+        reference[i] = ReferenceAdditive(reference[i], breathPose[i], bindPose[i], 0.5f);
+    LogResult("Additive layer", PoseDifference(pose, reference));
+
+    /* Cross-fade from walking to running */
+    mixer.SetWeight(upperBody, 0.0f);
+    mixer.SetWeight(output, 0.0f);
+    mixer.FadeWeight(locomotion, 1.0f, 0.5);
+    mixer.Update(0.175);
+    mixer.Evaluate(pose);
+    for (size_t i = 0; i < reference.size(); ++i)
+        reference[i] = ReferenceBlend(walkPose[i], runPose[i], 0.545f);
+    LogResult("Cross-fade (t = 0.175 s)", PoseDifference(pose, reference));
+
+    mixer.Update(0.5);
+    mixer.Evaluate(pose);
+    LogResult("Cross-fade (finished)", (mixer.IsFading(locomotion) ? 1.0f : PoseDifference(pose, runPose)));
+
+    /* Clip with a joint group and an overriding playback: only the joints of the group are animated */
+    std::vector<Math::Transform3Df> groupPose;
+    auto groupAnim = GenerateClip(skeleton, *flatSkeleton, joints, groupPose);
+
+    Anim::SkeletalAnimation::JointGroup upperGroup;
+    upperGroup.keyframeJoints.assign(groupAnim->keyframeJoints.begin(), groupAnim->keyframeJoints.begin() + numJoints/2);
+
+    groupAnim->jointGroups.push_back(upperGroup);
+    groupAnim->animateJointGroup = true;
+
+    const auto groupPlayback = groupAnim->playback;
+
+    Anim::AnimationMixer groupMixer(flatSkeleton);
+    groupMixer.SetOutputNode(groupMixer.AddClipNode(groupAnim.get(), &groupPlayback));
+    groupMixer.Evaluate(pose);
+
+    reference = bindPose;
+    for (size_t i = 0; i < numJoints/2; ++i)
+    {
+        const auto index = flatSkeleton->FindJoint(joints[i]);
+        reference[index] = groupPose[index];
+    }
+    LogResult("Joint group with playback", PoseDifference(pose, reference));
+
+    /* Benchmark crowd evaluation */
+    mixer.SetWeight(locomotion, 0.3f);
+    mixer.SetWeight(upperBody, 0.8f);
+    mixer.SetWeight(output, 0.5f);
+
+    std::vector<std::unique_ptr<Anim::AnimationMixer>> mixers;
+    std::vector<Scene::SkeletonPosePtr> poses;
+    std::vector<Anim::AnimationMixer*> mixerPtrs;
+    std::vector<Scene::SkeletonPose*> posePtrs;
+
+    for (size_t i = 0; i < numCharacters; ++i)
+    {
+        mixers.push_back(std::unique_ptr<Anim::AnimationMixer>(new Anim::AnimationMixer(flatSkeleton)));
+
+        auto& m = *mixers.back();
+        auto a = m.AddClipNode(walkAnim.get());
+        auto b = m.AddClipNode(runAnim.get());
+        auto c = m.AddClipNode(waveAnim.get());
+        auto d = m.AddClipNode(breathAnim.get());
+        m.AddAdditiveNode(m.AddBlendNode(m.AddBlendNode(a, b, 0.3f), c, 0.8f, mask), d, 0.5f);
+
+        poses.push_back(std::make_shared<Scene::SkeletonPose>(flatSkeleton));
+        mixerPtrs.push_back(mixers.back().get());
+        posePtrs.push_back(poses.back().get());
+    }
+
+    /* First evaluation fills the pose buffer pools */
+    Anim::AnimationMixer::EvaluatePoses(mixerPtrs, posePtrs);
+    const auto numPoseBuffers = mixers.front()->NumPoseBuffers();
+
+    auto serialTime = Measure(
+        *timer,
+        [&]()
+        {
+            for (size_t frame = 0; frame < numFrames; ++frame)
+            {
+                for (size_t i = 0; i < numCharacters; ++i)
+                {
+                    mixerPtrs[i]->Evaluate(*posePtrs[i]);
+                    posePtrs[i]->UpdateMatrices();
+                }
+            }
+        }
+    );
+
+    auto parallelTime = Measure(
+        *timer,
+        [&]()
+        {
+            for (size_t frame = 0; frame < numFrames; ++frame)
+                Anim::AnimationMixer::EvaluatePoses(mixerPtrs, posePtrs);
+        }
+    );
+
+    IO::Log::Message(
+        ToStr(numCharacters) + " characters with 4 clips (per frame): serial = " + ToStr(serialTime / numFrames, 2) +
+        " ms, parallel = " + ToStr(parallelTime / numFrames, 2) + " ms, pose buffers per mixer = " + ToStr(numPoseBuffers) +
+        (mixers.front()->NumPoseBuffers() == numPoseBuffers ? " (constant)" : " (GROWING)")
+    );
+
+    }
+    #endif
+
+    IO::Console::Wait();
+
+    return 0;
+}
@@ -0,0 +1,195 @@
+// ForkENGINE: BoundingVolumeHierarchy Test
+// 17/10/2026
+
+#include "../TestUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace Fork;
+
+//! Returns a random box inside a flat world of the specified extent (like objects on a terrain) with an edge length in the range [0.5, 3.5].
+static Math::AABB3f RandomBox(float extent)
+{
+    const Math::Point3f center { Random()*extent, Random()*10.0f, Random()*extent };
+    const Math::Vector3f halfSize { Random()*0.75f + 1.0f, Random()*0.75f + 1.0f, Random()*0.75f + 1.0f };
+    return { center - halfSize, center + halfSize };
+}
+
+//! Sets up the culling manager with a camera at the specified position and rotation.
+static void SetupCamera(Scene::CullingManager& cullingManager, const Math::Point3f& position, const Math::Quaternionf& rotation)
+{
+    Scene::Projection projection;
+    projection.SetViewport({ {}, { 1024, 768 } });
+    projection.SetPlanes(0.1f, 150.0f);
+
+    Math::Transform3Df cameraTransform;
+    cameraTransform.SetPosition(position);
+    cameraTransform.SetRotation(rotation);
+
+    Math::Matrix4f viewMatrix;
+    cameraTransform.GetMatrix().Inverse(viewMatrix);
+
+    cullingManager.SetupProjectionMatrix(projection);
+    cullingManager.SetupViewMatrix(viewMatrix);
+}
+
+int main()
+{
+    IO::Log::AddDefaultEventHandler();
+
+    #if 1//!BOUNDING VOLUME HIERARCHY TEST!
+    {
+
+    const size_t numNodes = 20000;
+
+    std::vector<Scene::GeometryNode> nodes(numNodes);
+    std::vector<Math::AABB3f> boxes(numNodes);
+    std::vector<Scene::BoundingVolumeHierarchy::ProxyID> proxies(numNodes, Scene::BoundingVolumeHierarchy::invalidProxy);
+
+    Scene::BoundingVolumeHierarchy hierarchy;
+
+    std::vector<unsigned int> visibilityMask((numNodes + 31) / 32);
+
+    //! Culls all boxes at once and collects the nodes of the visible boxes which are still in the hierarchy.
+    auto CullBruteForce = [&](const Scene::CullingManager& cullingManager, std::vector<Scene::GeometryNode*>& visibleNodes)
+    {
+        cullingManager.CullBoundingBoxes(boxes.data(), numNodes, visibilityMask.data());
+
+        for (size_t i = 0; i < numNodes; ++i)
+        {
+            if (proxies[i] != Scene::BoundingVolumeHierarchy::invalidProxy && (visibilityMask[i / 32] & (1u << (i % 32))) != 0)
+                visibleNodes.push_back(&nodes[i]);
+        }
+    };
+
+    //! Compares the frustum query of the hierarchy with brute-force culling of all remaining boxes.
+    auto CompareFrustumQuery = [&](const std::string& desc, const Scene::CullingManager& cullingManager)
+    {
+        std::vector<Scene::GeometryNode*> hierarchyNodes, bruteForceNodes;
+
+        hierarchy.QueryFrustum(cullingManager.GetViewFrustum(), hierarchyNodes);
+        CullBruteForce(cullingManager, bruteForceNodes);
+
+        std::sort(hierarchyNodes.begin(), hierarchyNodes.end());
+        std::sort(bruteForceNodes.begin(), bruteForceNodes.end());
+
+        IO::Log::Message(
+            desc + ": " + ToStr(hierarchyNodes.size()) + " of " + ToStr(hierarchy.NumProxies()) + " nodes visible, brute-force = " +
+            ToStr(bruteForceNodes.size()) + (hierarchyNodes == bruteForceNodes ? " (passed)" : " (FAILED)")
+        );
+    };
+
+    Scene::CullingManager cullingManager;
+    SetupCamera(cullingManager, { 0.0f, 0.0f, -400.0f }, Math::Quaternionf());
+
+    /* Insert all proxies */
+    for (size_t i = 0; i < numNodes; ++i)
+    {
+        boxes[i] = RandomBox(500.0f);
+        proxies[i] = hierarchy.InsertProxy(boxes[i], &nodes[i]);
+    }
+
+    IO::Log::Message(
+        "Inserted " + ToStr(hierarchy.NumProxies()) + " proxies, height = " + ToStr(hierarchy.Height()) +
+        (hierarchy.NumProxies() == numNodes && hierarchy.Height() <= 2*static_cast<unsigned int>(std::log2(numNodes)) ? " (passed)" : " (FAILED)")
+    );
+
+    CompareFrustumQuery("After insertion", cullingManager);
+
+    /* Remove every third proxy */
+    for (size_t i = 0; i < numNodes; i += 3)
+    {
+        hierarchy.RemoveProxy(proxies[i]);
+        proxies[i] = Scene::BoundingVolumeHierarchy::invalidProxy;
+    }
+
+    IO::Log::Message(
+        "Removed every third proxy, " + ToStr(hierarchy.NumProxies()) + " remaining, height = " + ToStr(hierarchy.Height()) +
+        (hierarchy.NumProxies() == numNodes - (numNodes + 2)/3 ? " (passed)" : " (FAILED)")
+    );
+
+    CompareFrustumQuery("After removal", cullingManager);
+
+    /* Move the remaining proxies: small moves stay inside their fat boxes (refit), large moves re-insert the proxies */
+    size_t numRefits = 0, numSmallReinserts = 0, numReinserts = 0;
+
+    for (size_t i = 0; i < numNodes; ++i)
+    {
+        if (proxies[i] == Scene::BoundingVolumeHierarchy::invalidProxy)
+            continue;
+
+        if (i % 2 == 0)
+        {
+            const Math::Vector3f offset { Random()*0.05f, Random()*0.05f, Random()*0.05f };
+            boxes[i] = { boxes[i].min + offset, boxes[i].max + offset };
+            if (hierarchy.MoveProxy(proxies[i], boxes[i]))
+                ++numSmallReinserts;
+            else
+                ++numRefits;
+        }
+        else
+        {
+            boxes[i] = RandomBox(500.0f);
+            if (hierarchy.MoveProxy(proxies[i], boxes[i]))
+                ++numReinserts;
+        }
+    }
+
+    IO::Log::Message(
+        "Moved proxies: " + ToStr(numRefits) + " refits, " + ToStr(numReinserts) + " re-insertions, height = " + ToStr(hierarchy.Height()) +
+        (numSmallReinserts == 0 ? " (passed)" : " (FAILED)")
+    );
+
+    CompareFrustumQuery("After moving", cullingManager);
+
+    /* Query several views and compare the timings */
+    auto timer = Platform::Timer::Create();
+
+    std::vector<Scene::GeometryNode*> visibleNodes;
+    double hierarchyTime = 0.0, bruteForceTime = 0.0;
+
+    for (int view = 0; view < 8; ++view)
+    {
+        const auto angle = static_cast<float>(view) * Math::pi * 0.25f;
+
+        SetupCamera(
+            cullingManager,
+            { std::sin(angle)*250.0f, 0.0f, std::cos(angle)*250.0f },
+            Math::Quaternionf(Math::Vector3f(0.0f, angle + Math::pi, 0.0f))
+        );
+
+        CompareFrustumQuery("View " + ToStr(view), cullingManager);
+
+        hierarchyTime += Measure(
+            *timer,
+            [&]()
+            {
+                visibleNodes.clear();
+                hierarchy.QueryFrustum(cullingManager.GetViewFrustum(), visibleNodes);
+            }
+        );
+
+        bruteForceTime += Measure(
+            *timer,
+            [&]()
+            {
+                visibleNodes.clear();
+                CullBruteForce(cullingManager, visibleNodes);
+            }
+        );
+    }
+
+    IO::Log::Message(
+        "Frustum culling of " + ToStr(hierarchy.NumProxies()) + " nodes (8 views): hierarchy = " + ToStr(hierarchyTime, 2) +
+        " ms, brute-force = " + ToStr(bruteForceTime, 2) + " ms"
+    );
+
+    }
+    #endif
+
+    IO::Console::Wait();
+
+    return 0;
+}
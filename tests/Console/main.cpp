@@ -106,6 +106,86 @@ int main()
 
     #endif
 
+    #if 1//!IDENTITY FACTORY TEST!
+    {
+
+    const size_t numIDs = 1000000;
+
+    auto idFactory = std::make_shared<IdentityFactory>();
+    auto timer = Platform::Timer::Create();
+
+    std::vector<std::unique_ptr<Identifiable>> objects(numIDs);
+
+    {
+        IO::ScopedLogTimer logTimer(*timer, "Generate " + ToStr(numIDs) + " IDs: ");
+        for (auto& obj : objects)
+            obj = std::unique_ptr<Identifiable>(new Identifiable(idFactory));
+    }
+
+    const auto staleID = objects.front()->GetID();
+
+    {
+        IO::ScopedLogTimer logTimer(*timer, "Release " + ToStr(numIDs) + " IDs: ");
+        for (auto& obj : objects)
+            obj.reset();
+    }
+
+    {
+        IO::ScopedLogTimer logTimer(*timer, "Recycle " + ToStr(numIDs) + " IDs: ");
+        for (auto& obj : objects)
+            obj = std::unique_ptr<Identifiable>(new Identifiable(idFactory));
+    }
+
+    IO::Log::Message("Active IDs: " + ToStr(idFactory->NumActiveIDs()));
+    IO::Log::Message("Stale ID detected: " + std::string(idFactory->IsAlive(staleID) ? "no" : "yes"));
+
+    }
+    #endif
+
+    #if 1//!JOB SYSTEM TEST!
+    {
+
+    const size_t numElements = 10000000;
+
+    Jobs::JobSystem jobSystem;
+    auto timer = Platform::Timer::Create();
+
+    std::vector<float> elements(numElements, 1.0f);
+
+    {
+        IO::ScopedLogTimer logTimer(*timer, "Sequential loop (" + ToStr(numElements) + " elements): ");
+        for (auto& x : elements)
+            x = std::sqrt(x * 2.0f + 1.0f);
+    }
+
+    {
+        IO::ScopedLogTimer logTimer(*timer, "Parallel loop (" + ToStr(jobSystem.NumWorkers()) + " workers): ");
+        jobSystem.ParallelFor(
+            0, numElements,
+            [&elements](size_t i)
+            {
+                elements[i] = std::sqrt(elements[i] * 2.0f + 1.0f);
+            }
+        );
+    }
+
+    /* Job "C" depends on the jobs "A" and "B" */
+    Jobs::JobCounter counterAB, counterC;
+
+    std::atomic<int> numFinished { 0 };
+    int numFinishedBeforeC = 0;
+
+    jobSystem.Submit([&]() { ++numFinished; }, &counterAB);
+    jobSystem.Submit([&]() { ++numFinished; }, &counterAB);
+    jobSystem.Submit([&]() { numFinishedBeforeC = numFinished; }, &counterC, &counterAB);
+
+    jobSystem.Wait(counterC);
+
+    IO::Log::Message("Jobs finished before dependent job: " + ToStr(numFinishedBeforeC) + " (expected 2)");
+
+    }
+    #endif
+
     // Common math tests
     Matrix2f m2;
     Matrix3f m3;
@@ -196,6 +276,39 @@ int main()
         IO::Log::Error(err.what());
     }
 
+    try
+    {
+        IO::Log::Message("Partition Container Test");
+
+        PartitionContainer<int> container(PartitionContainer<int>::AllocationModes::FreeList);
+
+        const std::string strA = "Hello", strB = "Partition", strC = "World";
+
+        container.Add(1, strA.c_str(), strA.size());
+        container.Add(2, strB.c_str(), strB.size());
+        container.Add(3, strC.c_str(), strC.size());
+
+        container.Remove(2);
+        container.Add(4, strA.c_str(), strA.size());
+        container.Resize(1, 8);
+
+        IO::Log::Message("Size = " + ToStr(container.Size()) + ", FreeSize = " + ToStr(container.FreeSize()));
+
+        for (const auto& relocation : container.Defragment())
+        {
+            IO::Log::Message(
+                "Moved partition " + ToStr(relocation.key) + " from " + ToStr(relocation.oldOffset) +
+                " to " + ToStr(relocation.newOffset) + " (" + ToStr(relocation.size) + " bytes)"
+            );
+        }
+
+        IO::Log::Message("Size after defragmentation = " + ToStr(container.Size()));
+    }
+    catch (const std::exception& err)
+    {
+        IO::Log::Error(err.what());
+    }
+
     try
     {
         throw IndexOutOfBoundsException(__FUNCTION__, 5);
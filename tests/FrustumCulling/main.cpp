@@ -0,0 +1,180 @@
+// ForkENGINE: FrustumCulling Test
+// 17/10/2026
+
+#include "../TestUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace Fork;
+
+//! Sets up the culling manager with a camera at the specified position and rotation.
+static void SetupCamera(Scene::CullingManager& cullingManager, const Math::Point3f& position, const Math::Quaternionf& rotation)
+{
+    Scene::Projection projection;
+    projection.SetViewport({ {}, { 1024, 768 } });
+    projection.SetPlanes(0.1f, 150.0f);
+
+    Math::Transform3Df cameraTransform;
+    cameraTransform.SetPosition(position);
+    cameraTransform.SetRotation(rotation);
+
+    Math::Matrix4f viewMatrix;
+    cameraTransform.GetMatrix().Inverse(viewMatrix);
+
+    cullingManager.SetupProjectionMatrix(projection);
+    cullingManager.SetupViewMatrix(viewMatrix);
+    cullingManager.SetupWorldMatrix(Math::Matrix4f());
+}
+
+//! Returns the smallest distance (in world units) between the "p-vertex" of the box and a frustum plane.
+static float BorderDistance(const Scene::ViewFrustum& frustum, const Math::AABB3f& box)
+{
+    const auto center = (box.min + box.max) * 0.5f;
+    const auto extent = (box.max - box.min) * 0.5f;
+
+    float minDist = std::numeric_limits<float>::max();
+
+    for (const auto& plane : frustum.planes)
+    {
+        const auto radius =
+            std::abs(plane.normal.x) * extent.x +
+            std::abs(plane.normal.y) * extent.y +
+            std::abs(plane.normal.z) * extent.z;
+        minDist = std::min(minDist, std::abs(Math::ComputeDistanceToPlane(plane, center) + radius));
+    }
+
+    return minDist;
+}
+
+static bool IsVisible(const std::vector<unsigned int>& visibilityMask, size_t index)
+{
+    return (visibilityMask[index / 32] & (1u << (index % 32))) != 0;
+}
+
+int main()
+{
+    IO::Log::AddDefaultEventHandler();
+
+    #if 1//!FRUSTUM CULLING TEST!
+    {
+
+    const size_t numObjects = 50000;
+
+    /* Generate random boxes and spheres in a flat world (like objects on a terrain) */
+    std::vector<Math::AABB3f> boxes(numObjects);
+    std::vector<Math::Sphere<>> spheres(numObjects);
+
+    for (size_t i = 0; i < numObjects; ++i)
+    {
+        const Math::Point3f center { Random()*250.0f, Random()*10.0f, Random()*250.0f };
+        const Math::Vector3f halfSize { Random()*0.75f + 1.0f, Random()*0.75f + 1.0f, Random()*0.75f + 1.0f };
+
+        boxes[i] = { center - halfSize, center + halfSize };
+        spheres[i] = Math::Sphere<>(halfSize.Length(), center);
+    }
+
+    std::vector<unsigned int> visibilityMask((numObjects + 31) / 32);
+    std::vector<char> scalarVisibility(numObjects);
+
+    Scene::CullingManager cullingManager;
+
+    auto timer = Platform::Timer::Create();
+    double scalarBoxTime = 0.0, batchedBoxTime = 0.0, scalarSphereTime = 0.0, batchedSphereTime = 0.0;
+
+    for (int view = 0; view < 8; ++view)
+    {
+        const auto angle = static_cast<float>(view) * Math::pi * 0.25f;
+
+        SetupCamera(
+            cullingManager,
+            { std::sin(angle)*100.0f, 0.0f, std::cos(angle)*100.0f },
+            Math::Quaternionf(Math::Vector3f(0.0f, angle + Math::pi, 0.0f))
+        );
+
+        /* Compare batched box culling with the scalar box test */
+        scalarBoxTime += Measure(
+            *timer,
+            [&]()
+            {
+                for (size_t i = 0; i < numObjects; ++i)
+                    scalarVisibility[i] = cullingManager.IsBoundingBoxInsideFrustum(boxes[i]);
+            }
+        );
+
+        batchedBoxTime += Measure(*timer, [&]() { cullingManager.CullBoundingBoxes(boxes.data(), numObjects, visibilityMask.data()); });
+
+        /*
+        The scalar box test works in clip-space, the batched test with the world-space planes,
+        so only boxes which touch a frustum plane may be classified differently due to rounding
+        (the clip-space depth is less precise, i.e. up to a few hundredths of a unit at the far plane).
+        */
+        size_t numVisible = 0, numMismatches = 0, numBorderMismatches = 0;
+
+        for (size_t i = 0; i < numObjects; ++i)
+        {
+            if (scalarVisibility[i])
+                ++numVisible;
+            if ((scalarVisibility[i] != 0) != IsVisible(visibilityMask, i))
+            {
+                ++numMismatches;
+                if (BorderDistance(cullingManager.GetViewFrustum(), boxes[i]) < 0.05f)
+                    ++numBorderMismatches;
+            }
+        }
+
+        IO::Log::Message(
+            "View " + ToStr(view) + ": " + ToStr(numVisible) + " of " + ToStr(numObjects) + " boxes visible, " +
+            ToStr(numMismatches) + " mismatches (" + ToStr(numBorderMismatches) + " at a frustum plane)" +
+            (numMismatches == numBorderMismatches ? " (passed)" : " (FAILED)")
+        );
+
+        /* Compare batched sphere culling with the scalar sphere test */
+        scalarSphereTime += Measure(
+            *timer,
+            [&]()
+            {
+                for (size_t i = 0; i < numObjects; ++i)
+                    scalarVisibility[i] = cullingManager.IsBoundingSphereInsideFrustum(spheres[i]);
+            }
+        );
+
+        batchedSphereTime += Measure(*timer, [&]() { cullingManager.CullBoundingSpheres(spheres.data(), numObjects, visibilityMask.data()); });
+
+        numVisible = 0;
+        numMismatches = 0;
+
+        for (size_t i = 0; i < numObjects; ++i)
+        {
+            if (scalarVisibility[i])
+                ++numVisible;
+            if ((scalarVisibility[i] != 0) != IsVisible(visibilityMask, i))
+                ++numMismatches;
+        }
+
+        IO::Log::Message(
+            "View " + ToStr(view) + ": " + ToStr(numVisible) + " of " + ToStr(numObjects) + " spheres visible, " +
+            ToStr(numMismatches) + " mismatches" + (numMismatches == 0 ? " (passed)" : " (FAILED)")
+        );
+    }
+
+    IO::Log::Blank();
+
+    IO::Log::Message(
+        "Culling of " + ToStr(numObjects) + " boxes (8 views): scalar = " + ToStr(scalarBoxTime, 2) +
+        " ms, batched = " + ToStr(batchedBoxTime, 2) + " ms"
+    );
+    IO::Log::Message(
+        "Culling of " + ToStr(numObjects) + " spheres (8 views): scalar = " + ToStr(scalarSphereTime, 2) +
+        " ms, batched = " + ToStr(batchedSphereTime, 2) + " ms"
+    );
+
+    }
+    #endif
+
+    IO::Console::Wait();
+
+    return 0;
+}
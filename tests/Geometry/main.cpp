@@ -0,0 +1,379 @@
+// ForkENGINE: Geometry Test
+// 17/10/2026
+
+#include <fengine/core.h>
+#include <fengine/scene.h>
+#include <fengine/using.h>
+
+#include <random>
+#include <algorithm>
+
+using namespace Fork;
+
+/*
+Generates a wavy grid mesh, where each quad has its own four vertices
+(like imported CAD meshes with split vertices).
+*/
+static void GenerateSplitGrid(
+    std::vector<Video::TangentSpaceVertex>& vertices, CommonIndexBuffer& indices, unsigned int gridSize)
+{
+    vertices.clear();
+    indices.clear();
+
+    vertices.reserve(gridSize*gridSize*4);
+    indices.reserve(gridSize*gridSize*6);
+
+    auto Height = [](float x, float z)
+    {
+        return std::sin(x*0.05f) * std::cos(z*0.05f) * 5.0f;
+    };
+
+    auto AddVertex = [&](float x, float z, float u, float v)
+    {
+        Video::TangentSpaceVertex vertex;
+        {
+            vertex.coord    = { x, Height(x, z), z };
+            vertex.texCoord = { u, v };
+        }
+        vertices.push_back(vertex);
+    };
+
+    for (unsigned int y = 0; y < gridSize; ++y)
+    {
+        for (unsigned int x = 0; x < gridSize; ++x)
+        {
+            const auto base = static_cast<unsigned int>(vertices.size());
+            const auto fx = static_cast<float>(x), fz = static_cast<float>(y);
+
+            AddVertex(fx       , fz       , 0, 0);
+            AddVertex(fx + 1.0f, fz       , 1, 0);
+            AddVertex(fx + 1.0f, fz + 1.0f, 1, 1);
+            AddVertex(fx       , fz + 1.0f, 0, 1);
+
+            indices.insert(indices.end(), { base, base + 2, base + 1, base, base + 3, base + 2 });
+        }
+    }
+}
+
+//! Returns true if the specified point is inside the specified box.
+static bool IsPointInsideBox(const Math::AABB3f& box, const Math::Point3f& point)
+{
+    return
+        point.x >= box.min.x && point.y >= box.min.y && point.z >= box.min.z &&
+        point.x <= box.max.x && point.y <= box.max.y && point.z <= box.max.z;
+}
+
+//! Returns the number of triangles of all meshes in the specified geometry graph.
+static size_t CountTriangles(const Scene::Geometry* geometry)
+{
+    if (auto composition = dynamic_cast<const Scene::CompositionGeometry*>(geometry))
+    {
+        size_t numTriangles = 0;
+        for (const auto& subGeom : composition->subGeometries)
+            numTriangles += CountTriangles(subGeom.get());
+        return numTriangles;
+    }
+    if (auto texturedGeom = dynamic_cast<const Scene::TexturedGeometry*>(geometry))
+        return CountTriangles(texturedGeom->actualGeometry.get());
+    if (auto mesh = dynamic_cast<const Scene::MeshGeometry*>(geometry))
+        return mesh->NumIndices() / 3;
+    return 0;
+}
+
+int main()
+{
+    IO::Log::AddDefaultEventHandler();
+
+    #if 1//!SMOOTH NORMALS BENCHMARK!
+    {
+
+    const unsigned int gridSize = 1000;
+
+    auto timer = Platform::Timer::Create();
+
+    std::vector<Video::TangentSpaceVertex> vertices;
+    CommonIndexBuffer indices;
+
+    GenerateSplitGrid(vertices, indices, gridSize);
+
+    IO::Log::Message("Mesh with " + ToStr(indices.size() / 3) + " triangles and " + ToStr(vertices.size()) + " vertices:");
+    IO::Log::ScopedIndent indent;
+
+    const auto numVertices = vertices.size();
+    const auto stride = sizeof(Video::TangentSpaceVertex);
+
+    {
+        IO::ScopedLogTimer logTimer(*timer, "GenerateNormalsFlat: ");
+        Scene::GeometryConverter::GenerateNormalsFlat(
+            Video::AttributeConstIterator(&vertices[0].coord, numVertices, stride),
+            Video::AttributeIterator(&vertices[0].normal, numVertices, stride),
+            indices
+        );
+    }
+    {
+        IO::ScopedLogTimer logTimer(*timer, "GenerateNormalsSmooth: ");
+        Scene::GeometryConverter::GenerateNormalsSmooth(
+            Video::AttributeConstIterator(&vertices[0].coord, numVertices, stride),
+            Video::AttributeIterator(&vertices[0].normal, numVertices, stride),
+            indices
+        );
+    }
+
+    /* Split vertices at the same position must have the same normal after welding */
+    const auto& vertexA = vertices[2];
+    const auto& vertexB = vertices[(gridSize + 1)*4];
+
+    IO::Log::Message("Welded normal difference: " + ToStr(Math::Distance(vertexA.normal, vertexB.normal)) + " (expected 0)");
+
+    {
+        IO::ScopedLogTimer logTimer(*timer, "GenerateTangentSpaceSmooth (45 degrees threshold): ");
+        Scene::GeometryConverter::GenerateTangentSpaceSmooth(
+            Video::AttributeConstIterator(&vertices[0].coord, numVertices, stride),
+            Video::AttributeConstIterator(&vertices[0].texCoord, numVertices, stride),
+            Video::AttributeIterator(&vertices[0].tangent, numVertices, stride),
+            Video::AttributeIterator(&vertices[0].bitangent, numVertices, stride),
+            Video::AttributeIterator(&vertices[0].normal, numVertices, stride),
+            indices,
+            Math::pi*0.25f
+        );
+    }
+
+    }
+    #endif
+
+    #if 1//!VERTEX CACHE OPTIMIZER TEST!
+    {
+
+    const unsigned int gridSize = 300;
+
+    auto timer = Platform::Timer::Create();
+
+    /* Generate split grid with continuous texture coordinates, so that all split vertices can be welded */
+    auto mesh = std::make_shared<Scene::TangentSpaceMeshGeometry>();
+
+    GenerateSplitGrid(mesh->vertices, mesh->indices, gridSize);
+
+    for (auto& vertex : mesh->vertices)
+        vertex.texCoord = { vertex.coord.x / gridSize, vertex.coord.z / gridSize };
+
+    /* Shuffle triangles (like a cache-hostile index order of an imported mesh) */
+    std::vector<size_t> triangles(mesh->indices.size() / 3);
+    for (size_t i = 0; i < triangles.size(); ++i)
+        triangles[i] = i;
+
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937());
+
+    CommonIndexBuffer shuffledIndices;
+    for (auto tri : triangles)
+        shuffledIndices.insert(shuffledIndices.end(), mesh->indices.begin() + tri*3, mesh->indices.begin() + tri*3 + 3);
+
+    mesh->indices = shuffledIndices;
+
+    IO::Log::Message("Mesh with " + ToStr(mesh->indices.size() / 3) + " triangles and " + ToStr(mesh->vertices.size()) + " vertices:");
+    IO::Log::ScopedIndent indent;
+
+    const auto statsBefore = Scene::GeometryConverter::AnalyzeVertexCache(mesh->indices, mesh->vertices.size());
+
+    /* Optimize geometry graph (no hardware buffers are created, so no GPU is required) */
+    Scene::GeometryPtr geometry = mesh;
+    {
+        IO::ScopedLogTimer logTimer(*timer, "OptimizeGeometryGraph: ");
+        Scene::GeometryConverter::OptimizeGeometryGraph(geometry);
+    }
+
+    const auto statsAfter = Scene::GeometryConverter::AnalyzeVertexCache(mesh->indices, mesh->vertices.size());
+
+    IO::Log::Message("Vertices: " + ToStr(mesh->vertices.size()) + " (expected " + ToStr((gridSize + 1)*(gridSize + 1)) + ")");
+    IO::Log::Message("ACMR: " + ToStr(statsBefore.ACMR()) + " -> " + ToStr(statsAfter.ACMR()) + " (expected less than 0.8)");
+    IO::Log::Message("ATVR: " + ToStr(statsBefore.ATVR()) + " -> " + ToStr(statsAfter.ATVR()));
+
+    }
+    #endif
+
+    #if 1//!LOD GENERATION TEST!
+    {
+
+    auto timer = Platform::Timer::Create();
+
+    /* Generate a composition of two textured spheres */
+    auto composition = std::make_shared<Scene::CompositionGeometry>();
+
+    for (int i = 0; i < 2; ++i)
+    {
+        auto sphere = std::make_shared<Scene::Simple3DMeshGeometry>();
+        Scene::GeometryGenerator::GenerateUVSphere(*sphere, Scene::GeometryGenerator::UVSphereDescription(1.0f + i, 128));
+
+        auto texturedGeom = std::make_shared<Scene::TexturedGeometry>();
+        texturedGeom->actualGeometry = sphere;
+
+        composition->subGeometries.push_back(texturedGeom);
+    }
+
+    Scene::GeometryPtr geometry = composition;
+    Scene::GeometryConverter::OptimizeGeometryGraph(geometry);
+
+    std::shared_ptr<Scene::LODGeometry> lodGeometry;
+    {
+        IO::ScopedLogTimer logTimer(*timer, "GenerateLODGeometry: ");
+        lodGeometry = Scene::GeometryConverter::GenerateLODGeometry(geometry);
+    }
+
+    /* Count triangles of each level */
+    IO::Log::ScopedIndent indent;
+
+    for (size_t level = 0; level < lodGeometry->lodGeometries.size(); ++level)
+    {
+        const auto numTriangles = CountTriangles(lodGeometry->lodGeometries[level].get());
+
+        const auto distance = (level > 0 ? lodGeometry->lodDistances[level - 1] : 0.0f);
+
+        IO::Log::Message("Level " + ToStr(level) + ": " + ToStr(numTriangles) + " triangles, from distance " + ToStr(distance));
+    }
+
+    IO::Log::Message("Levels: " + ToStr(lodGeometry->lodGeometries.size()) + " (expected 4)");
+
+    }
+    #endif
+
+    #if 1//!MESH CLUSTER TEST!
+    {
+
+    auto timer = Platform::Timer::Create();
+
+    /* Generate a dense sphere (like a large architectural mesh) */
+    auto mesh = std::make_shared<Scene::Simple3DMeshGeometry>();
+    Scene::GeometryGenerator::GenerateUVSphere(*mesh, Scene::GeometryGenerator::UVSphereDescription(10.0f, 256));
+
+    Scene::GeometryPtr geometry = mesh;
+    Scene::GeometryConverter::OptimizeGeometryGraph(geometry);
+
+    const auto numVertices = mesh->vertices.size();
+    const auto numTriangles = mesh->indices.size() / 3;
+
+    auto sortedIndicesBefore = mesh->indices;
+    std::sort(sortedIndicesBefore.begin(), sortedIndicesBefore.end());
+
+    std::vector<Scene::MeshGeometryAtlas::Partition> clusters;
+    {
+        IO::ScopedLogTimer logTimer(*timer, "GenerateMeshClusters: ");
+        Scene::GeometryConverter::GenerateMeshClusters(
+            Video::AttributeConstIterator(&mesh->vertices[0].coord, numVertices, sizeof(Video::Simple3DVertex)),
+            mesh->indices, clusters
+        );
+    }
+
+    IO::Log::Message("Mesh with " + ToStr(numTriangles) + " triangles in " + ToStr(clusters.size()) + " clusters:");
+    IO::Log::ScopedIndent indent;
+
+    /* Validate clusters: all triangles must be kept, and each cluster must bound its triangles */
+    auto sortedIndicesAfter = mesh->indices;
+    std::sort(sortedIndicesAfter.begin(), sortedIndicesAfter.end());
+
+    size_t numClusterErrors = 0, numConeClusters = 0, nextIndex = 0;
+
+    for (const auto& cluster : clusters)
+    {
+        if (cluster.firstIndex != nextIndex || cluster.numVertices > 128*3)
+            ++numClusterErrors;
+
+        nextIndex = cluster.firstIndex + cluster.numVertices;
+
+        if (cluster.coneCutoff < 1.0f)
+            ++numConeClusters;
+
+        for (auto i = cluster.firstIndex; i < nextIndex; i += 3)
+        {
+            const auto& coord0 = mesh->vertices[mesh->indices[i    ]].coord;
+            const auto& coord1 = mesh->vertices[mesh->indices[i + 1]].coord;
+            const auto& coord2 = mesh->vertices[mesh->indices[i + 2]].coord;
+
+            for (const auto& coord : { coord0, coord1, coord2 })
+            {
+                if (!IsPointInsideBox(cluster.box, coord))
+                    ++numClusterErrors;
+            }
+
+            /* Each triangle must be back-facing from any point in front of the cone apex */
+            auto normal = Math::Cross(coord1 - coord0, coord2 - coord0);
+            if (cluster.coneCutoff < 1.0f && normal.LengthSq() > 0.0f)
+            {
+                Math::Normalize(normal);
+                if (Math::Dot(normal, cluster.coneAxis) < std::sqrt(1.0f - cluster.coneCutoff*cluster.coneCutoff) - 1e-4f)
+                    ++numClusterErrors;
+            }
+        }
+    }
+
+    if (nextIndex != mesh->indices.size() || sortedIndicesBefore != sortedIndicesAfter)
+        ++numClusterErrors;
+
+    IO::Log::Message("Cluster errors: " + ToStr(numClusterErrors) + " (expected 0)");
+    IO::Log::Message("Clusters with normal cone: " + ToStr(numConeClusters) + " of " + ToStr(clusters.size()));
+
+    /* Record clusters in the mesh atlas and cull them from outside of the sphere */
+    Scene::MeshGeometryAtlas atlas(*mesh);
+    atlas.RecordClusters(clusters);
+
+    Scene::Projection projection;
+    projection.SetViewport({ {}, { 1024, 768 } });
+    projection.SetPlanes(0.1f, 1000.0f);
+
+    auto CullClusters = [&](const Math::Point3f& viewPosition, size_t& numVisibleTriangles, size_t& numFrontFacesCulled)
+    {
+        Math::Matrix4f viewMatrix;
+        viewMatrix.SetPosition(-viewPosition);
+
+        const Scene::ViewFrustum frustum(projection.GetMatrixLH() * viewMatrix);
+
+        std::vector<Scene::MeshGeometryAtlas::Partition> drawRanges;
+        atlas.CullPartitions(frustum, viewPosition, drawRanges);
+
+        numVisibleTriangles = 0;
+        for (const auto& range : drawRanges)
+            numVisibleTriangles += range.numVertices / 3;
+
+        /* No front-facing triangle must be culled by the normal cones */
+        numFrontFacesCulled = 0;
+
+        for (const auto& cluster : atlas.GetPartitions())
+        {
+            if (cluster.coneCutoff >= 1.0f)
+                continue;
+
+            /* Only consider the cone test (with an unbounded box, the frustum test always passes) */
+            auto unboundedCluster = cluster;
+            unboundedCluster.box.Invalidate();
+            unboundedCluster.box.InsertPoint({ -1e6f, -1e6f, -1e6f });
+            unboundedCluster.box.InsertPoint({ 1e6f, 1e6f, 1e6f });
+
+            if (Scene::MeshGeometryAtlas::IsPartitionVisible(unboundedCluster, frustum, viewPosition))
+                continue;
+
+            for (auto i = cluster.firstIndex; i < cluster.firstIndex + cluster.numVertices; i += 3)
+            {
+                const auto& coord0 = mesh->vertices[mesh->indices[i    ]].coord;
+                const auto& coord1 = mesh->vertices[mesh->indices[i + 1]].coord;
+                const auto& coord2 = mesh->vertices[mesh->indices[i + 2]].coord;
+
+                if (Math::Dot(Math::Cross(coord1 - coord0, coord2 - coord0), viewPosition - coord0) > 0.0f)
+                    ++numFrontFacesCulled;
+            }
+        }
+    };
+
+    size_t numVisibleTriangles = 0, numFrontFacesCulled = 0;
+
+    CullClusters({ 0, 0, -30 }, numVisibleTriangles, numFrontFacesCulled);
+    IO::Log::Message("Visible triangles in front of the sphere: " + ToStr(numVisibleTriangles) + " of " + ToStr(numTriangles) + " (expected less than half)");
+    IO::Log::Message("Culled front faces: " + ToStr(numFrontFacesCulled) + " (expected 0)");
+
+    CullClusters({ 0, 0, 30 }, numVisibleTriangles, numFrontFacesCulled);
+    IO::Log::Message("Visible triangles behind the sphere: " + ToStr(numVisibleTriangles) + " (expected 0)");
+
+    }
+    #endif
+
+    IO::Console::Wait();
+
+    return 0;
+}
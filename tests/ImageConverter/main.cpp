@@ -0,0 +1,99 @@
+// ForkENGINE: ImageConverter Test
+// 17/10/2026
+
+#include "../TestUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace Fork;
+
+typedef Video::ImageConverter::SizeType SizeType;
+
+//! Returns a buffer with pseudo random color components.
+template <typename T> static std::vector<T> RandomBuffer(size_t size, T maxValue)
+{
+    std::vector<T> buffer(size);
+    for (auto& value : buffer)
+        value = static_cast<T>((std::rand() % 256) * maxValue / 255);
+    return buffer;
+}
+
+//! Returns the maximal difference between the two buffers.
+template <typename T> static double MaxDifference(const std::vector<T>& a, const std::vector<T>& b)
+{
+    double diff = 0.0;
+    for (size_t i = 0; i < a.size(); ++i)
+        diff = std::max(diff, std::abs(static_cast<double>(a[i]) - static_cast<double>(b[i])));
+    return diff;
+}
+
+//! Compares the scalar and accelerated image converter functions on a 4K image.
+template <typename T> static void Benchmark(Platform::Timer& timer, const std::string& typeName, T maxValue)
+{
+    using namespace Video;
+
+    const SizeType size { 3840, 2160, 1 };
+    const SizeType halfSize { 1920, 1080, 1 };
+    const auto numPixels = size.Volume();
+
+    auto rgbImage = RandomBuffer<T>(numPixels*3, maxValue);
+    std::vector<T> scalarImage(numPixels*4), simdImage(numPixels*4);
+
+    auto Report = [&](const std::string& name, double scalarTime, double simdTime, double diff)
+    {
+        IO::Log::Message(
+            typeName + " " + name + ": scalar = " + ToStr(scalarTime, 2) + " ms, SIMD = " + ToStr(simdTime, 2) +
+            " ms, speedup = " + ToStr(scalarTime / std::max(simdTime, 0.001), 2) + ", max. difference = " + ToStr(diff)
+        );
+    };
+
+    /* RGB to RGBA expansion */
+    auto scalarTime = Measure(timer, [&]() { ImageConverter::Scalar::ConvertImageFormat(rgbImage.data(), ImageColorFormats::RGB, scalarImage.data(), ImageColorFormats::RGBA, numPixels); });
+    auto simdTime = Measure(timer, [&]() { ImageConverter::ConvertImageFormat(rgbImage.data(), ImageColorFormats::RGB, simdImage.data(), ImageColorFormats::RGBA, numPixels); });
+    Report("RGB -> RGBA", scalarTime, simdTime, MaxDifference(scalarImage, simdImage));
+
+    /* RGBA to BGRA swizzle */
+    auto rgbaImage = scalarImage;
+
+    scalarTime = Measure(timer, [&]() { ImageConverter::Scalar::ConvertImageFormat(rgbaImage.data(), ImageColorFormats::RGBA, scalarImage.data(), ImageColorFormats::BGRA, numPixels); });
+    simdTime = Measure(timer, [&]() { ImageConverter::ConvertImageFormat(rgbaImage.data(), ImageColorFormats::RGBA, simdImage.data(), ImageColorFormats::BGRA, numPixels); });
+    Report("RGBA -> BGRA", scalarTime, simdTime, MaxDifference(scalarImage, simdImage));
+
+    /* Vertical flip */
+    scalarTime = Measure(timer, [&]() { ImageConverter::Scalar::FlipImageY(scalarImage.data(), size, 4); });
+    simdTime = Measure(timer, [&]() { ImageConverter::FlipImageY(simdImage.data(), size, 4); });
+    Report("Flip Y", scalarTime, simdTime, MaxDifference(scalarImage, simdImage));
+
+    /* Bilinear resize to the half size */
+    std::vector<T> scalarHalfImage(halfSize.Volume()*4), simdHalfImage(halfSize.Volume()*4);
+
+    scalarTime = Measure(timer, [&]() { ImageConverter::Scalar::ResizeImageLinear(rgbaImage.data(), size, scalarHalfImage.data(), halfSize, 4); });
+    simdTime = Measure(timer, [&]() { ImageConverter::ResizeImageLinear(rgbaImage.data(), size, simdHalfImage.data(), halfSize, 4); });
+    Report("Resize Linear", scalarTime, simdTime, MaxDifference(scalarHalfImage, simdHalfImage));
+}
+
+int main()
+{
+    IO::Log::AddDefaultEventHandler();
+
+    #if 1//!IMAGE CONVERTER BENCHMARK!
+    {
+
+    auto timer = Platform::Timer::Create();
+
+    IO::Log::Message("Benchmark image converter on 3840 x 2160 images (expected max. difference: 0, or up to 2 for the unsigned char resize)");
+    IO::Log::Blank();
+
+    Benchmark<unsigned char>(*timer, "UByte", 255);
+    Benchmark<float>(*timer, "Float", 1.0f);
+
+    }
+    #endif
+
+    IO::Console::Wait();
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+// ForkENGINE: ImageReader Test
+// 17/10/2026
+
+#include "../TestUtils.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace Fork;
+
+typedef Video::ImageUByte::SizeType SizeType;
+
+//! Reads the entire file content into memory.
+static std::vector<char> ReadFileContent(const std::string& filename)
+{
+    std::ifstream file(filename, std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
+
+    std::vector<char> content(static_cast<size_t>(file.tellg()));
+
+    file.seekg(0);
+    file.read(content.data(), static_cast<std::streamsize>(content.size()));
+
+    return content;
+}
+
+//! Returns true if both images have the same size, format and image data.
+static bool CompareImages(const Video::ImageUBytePtr& a, const Video::ImageUBytePtr& b)
+{
+    return
+        a && b &&
+        a->GetSize() == b->GetSize() &&
+        a->GetFormat() == b->GetFormat() &&
+        std::equal(a->RawBuffer(), a->RawBuffer() + a->NumElements(), b->RawBuffer());
+}
+
+int main()
+{
+    IO::Log::AddDefaultEventHandler();
+
+    #if 1//!IMAGE READER TEST!
+    {
+
+    using namespace Video;
+
+    /* Generate a test image with a gradient and some noise (so that the PNG compression has to work) */
+    auto sourceImage = std::make_shared<ImageUByte>(SizeType(512, 512, 1), ImageColorFormats::RGBA);
+
+    for (size_t y = 0; y < 512; ++y)
+    {
+        for (size_t x = 0; x < 512; ++x)
+        {
+            auto pixel = sourceImage->RawBuffer() + (y*512 + x)*4;
+            pixel[0] = static_cast<unsigned char>(x / 2);
+            pixel[1] = static_cast<unsigned char>(y / 2);
+            pixel[2] = static_cast<unsigned char>(std::rand() % 256);
+            pixel[3] = 255;
+        }
+    }
+
+    const struct
+    {
+        ImageFileFormats    format;
+        std::string         filename;
+    }
+    imageFiles[] =
+    {
+        { ImageFileFormats::PNG, "ImageReaderTest.png" },
+        { ImageFileFormats::BMP, "ImageReaderTest.bmp" },
+        { ImageFileFormats::TGA, "ImageReaderTest.tga" },
+    };
+
+    auto timer = Platform::Timer::Create();
+
+    for (const auto& imageFile : imageFiles)
+    {
+        if (!ImageFileHandler::WriteImage(sourceImage, imageFile.filename, imageFile.format))
+        {
+            IO::Log::Error("Writing image \"" + imageFile.filename + "\" failed (FAILED)");
+            continue;
+        }
+
+        /* Decode the image from its filename, from memory and from the file interface */
+        ImageUBytePtr filenameImage, memoryImage, fileImage;
+
+        const auto filenameTime = Measure(*timer, [&]() { filenameImage = ImageFileHandler::ReadImage(imageFile.filename); });
+
+        const auto content = ReadFileContent(imageFile.filename);
+        const auto memoryTime = Measure(
+            *timer,
+            [&]()
+            {
+                memoryImage = ImageFileHandler::ReadImageFromMemory(content.data(), content.size(), imageFile.filename);
+            }
+        );
+
+        const auto fileTime = Measure(
+            *timer,
+            [&]()
+            {
+                IO::PhysicalFile file(imageFile.filename, IO::File::OpenFlags::Read);
+                fileImage = ImageFileHandler::ReadImage(file, imageFile.filename);
+            }
+        );
+
+        const auto memoryEqual = CompareImages(filenameImage, memoryImage);
+        const auto fileEqual = CompareImages(filenameImage, fileImage);
+
+        IO::Log::Message(
+            "\"" + imageFile.filename + "\" (" + ToStr(content.size()) + " bytes): memory " +
+            (memoryEqual ? "matches" : "DIFFERS") + ", file interface " + (fileEqual ? "matches" : "DIFFERS") +
+            (memoryEqual && fileEqual ? " (passed)" : " (FAILED)")
+        );
+        IO::Log::Message(
+            "Decoding time: filename = " + ToStr(filenameTime, 2) + " ms, memory = " + ToStr(memoryTime, 2) +
+            " ms, file interface = " + ToStr(fileTime, 2) + " ms"
+        );
+    }
+
+    IO::Log::Blank();
+
+    /* Invalid image content must fail without crashing */
+    const char invalidContent[] = "\x89PNG but not an image";
+    const auto invalidImage = ImageFileHandler::ReadImageFromMemory(invalidContent, sizeof(invalidContent), "Invalid.png");
+
+    IO::Log::Message(std::string("Invalid image content rejected") + (!invalidImage ? " (passed)" : " (FAILED)"));
+
+    }
+    #endif
+
+    IO::Console::Wait();
+
+    return 0;
+}
@@ -0,0 +1,204 @@
+// ForkENGINE: KeyframeCompression Test
+// 17/10/2026
+
+#include "../TestUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace Fork;
+
+//! Returns small pseudo random noise in the range [-amplitude .. amplitude], similar to motion capture jitter.
+static float Noise(float amplitude)
+{
+    return (static_cast<float>(std::rand() % 2001) / 1000.0f - 1.0f) * amplitude;
+}
+
+//! Generates a synthetic motion capture clip with one key per frame and track.
+static void GenerateClip(std::vector<Anim::KeyframeSequence>& joints, size_t numFrames)
+{
+    for (size_t i = 0; i < joints.size(); ++i)
+    {
+        auto& seq = joints[i];
+        const auto phase = static_cast<float>(i) * 0.37f;
+
+        for (size_t frame = 0; frame < numFrames; ++frame)
+        {
+            const auto t = static_cast<float>(frame) / 30.0f + phase;
+
+            Math::Transform3Df transform;
+
+            /* Only the root joint moves around, the other joints have (nearly) constant offsets */
+            if (i == 0)
+                transform.SetPosition({ std::sin(t*0.2f)*5.0f, 1.0f + std::sin(t*4.0f)*0.05f, t*1.5f });
+            else
+                transform.SetPosition({ 0.0f, 0.25f + Noise(0.00001f), 0.0f });
+
+            transform.SetRotation(
+                Math::Quaternionf(
+                    std::sin(t*1.3f)*0.6f + Noise(0.0002f),
+                    std::sin(t*0.7f)*0.3f + Noise(0.0002f),
+                    std::cos(t*0.9f)*0.2f
+                )
+            );
+
+            seq.AddTransform(frame, transform);
+        }
+    }
+}
+
+//! Returns the rotation angle (in radians) between the two quaternions (using the chord length, which is more precise for small angles).
+static float RotationError(const Math::Quaternionf& a, const Math::Quaternionf& b)
+{
+    const auto sign = (a.x*b.x + a.y*b.y + a.z*b.z + a.w*b.w < 0.0f ? -1.0f : 1.0f);
+    const Math::Vector4f diff { a.x - b.x*sign, a.y - b.y*sign, a.z - b.z*sign, a.w - b.w*sign };
+    return 4.0f * std::asin(std::min(1.0f, diff.Length() * 0.5f));
+}
+
+//! Returns the memory usage (in bytes) of all keyframe buffers the specified sequence retains.
+static size_t MemoryUsage(const Anim::KeyframeSequence& seq)
+{
+    return
+        seq.positionKeyframes.capacity() * sizeof(Anim::KeyframeSequence::VectorKeyframe) +
+        seq.rotationKeyframes.capacity() * sizeof(Anim::KeyframeSequence::QuaternionKeyframe) +
+        seq.scaleKeyframes.capacity() * sizeof(Anim::KeyframeSequence::VectorKeyframe) +
+        seq.GetKeyframes().capacity() * sizeof(Math::Transform3Df) +
+        seq.GetCompressedKeyframes().MemoryUsage();
+}
+
+//! Compares the dense and compressed keyframe sequences of a long motion capture clip.
+static void Benchmark(Platform::Timer& timer, size_t numJoints, size_t numFrames)
+{
+    IO::Log::Message(
+        "Clip with " + ToStr(numJoints) + " joints and " + ToStr(numFrames) + " frames (" +
+        ToStr(numFrames / 30 / 60) + " min at 30 Hz)"
+    );
+    IO::Log::ScopedIndent indent;
+
+    std::vector<Anim::KeyframeSequence> denseJoints(numJoints);
+    GenerateClip(denseJoints, numFrames);
+
+    auto compressedJoints = denseJoints;
+
+    /* Build dense and compressed keyframes */
+    auto denseTime = Measure(timer, [&]() { for (auto& seq : denseJoints) { seq.BuildKeyframes(); } });
+
+    Anim::CompressedKeyframeSequence::Description desc;
+    desc.positionTolerance  = 0.0005f;
+    desc.rotationTolerance  = 0.001f;
+    desc.scaleTolerance     = 0.0005f;
+
+    auto compressedTime = Measure(timer, [&]() { for (auto& seq : compressedJoints) { seq.CompressKeyframes(desc); } });
+
+    /* Report memory per clip */
+    size_t denseMemory = 0, compressedMemory = 0, numKeys = 0;
+
+    for (size_t i = 0; i < numJoints; ++i)
+    {
+        denseMemory += MemoryUsage(denseJoints[i]);
+        compressedMemory += MemoryUsage(compressedJoints[i]);
+        numKeys += compressedJoints[i].GetCompressedKeyframes().NumKeys();
+    }
+
+    IO::Log::Message("Build: dense = " + ToStr(denseTime, 2) + " ms, compressed = " + ToStr(compressedTime, 2) + " ms");
+    IO::Log::Message(
+        "Memory: dense = " + ToStr(denseMemory / 1024) + " KB, compressed = " + ToStr(compressedMemory / 1024) +
+        " KB (" + ToStr(numKeys) + " of " + ToStr(numJoints*numFrames*3) + " keys), ratio = " +
+        ToStr(static_cast<double>(denseMemory) / std::max(compressedMemory, size_t(1)), 1) + " : 1"
+    );
+
+    /* Measure maximal error against the dense keyframes */
+    float maxPositionError = 0.0f, maxRotationError = 0.0f;
+
+    for (size_t i = 0; i < numJoints; ++i)
+    {
+        Math::Transform3Df denseTransform, compressedTransform;
+
+        for (size_t frame = 0; frame + 1 < numFrames; ++frame)
+        {
+            denseJoints[i].Interpolate(denseTransform, frame, frame + 1, 0.5f);
+            compressedJoints[i].Interpolate(compressedTransform, frame, frame + 1, 0.5f);
+
+            maxPositionError = std::max(maxPositionError, (denseTransform.GetPosition() - compressedTransform.GetPosition()).Length());
+            maxRotationError = std::max(maxRotationError, RotationError(denseTransform.GetRotation(), compressedTransform.GetRotation()));
+        }
+    }
+
+    IO::Log::Message("Max. error: position = " + ToStr(maxPositionError) + ", rotation = " + ToStr(maxRotationError) + " rad");
+
+    /* Measure sampling throughput (all joints at every frame) */
+    Math::Transform3Df transform;
+    const auto numSamples = static_cast<double>(numJoints * (numFrames - 1));
+
+    auto SamplesPerSecond = [numSamples](double time)
+    {
+        return ToStr(numSamples / std::max(time, 0.001) / 1000.0, 2) + " M/s";
+    };
+
+    denseTime = Measure(
+        timer,
+        [&]()
+        {
+            for (const auto& seq : denseJoints)
+            {
+                for (size_t frame = 0; frame + 1 < numFrames; ++frame)
+                    seq.Interpolate(transform, frame, frame + 1, 0.3f);
+            }
+        }
+    );
+
+    compressedTime = Measure(
+        timer,
+        [&]()
+        {
+            for (const auto& seq : compressedJoints)
+            {
+                for (size_t frame = 0; frame + 1 < numFrames; ++frame)
+                    seq.Interpolate(transform, frame, frame + 1, 0.3f);
+            }
+        }
+    );
+
+    auto cursorTime = Measure(
+        timer,
+        [&]()
+        {
+            for (const auto& seq : compressedJoints)
+            {
+                Anim::CompressedKeyframeSequence::Cursor cursor;
+                for (size_t frame = 0; frame + 1 < numFrames; ++frame)
+                    seq.GetCompressedKeyframes().Sample(transform, static_cast<float>(frame) + 0.3f, cursor);
+            }
+        }
+    );
+
+    IO::Log::Message(
+        "Sampling: dense = " + SamplesPerSecond(denseTime) + ", compressed (binary search) = " + SamplesPerSecond(compressedTime) +
+        ", compressed (cursor) = " + SamplesPerSecond(cursorTime)
+    );
+}
+
+int main()
+{
+    IO::Log::AddDefaultEventHandler();
+
+    #if 1//!KEYFRAME COMPRESSION BENCHMARK!
+    {
+
+    auto timer = Platform::Timer::Create();
+
+    IO::Log::Message("Benchmark dense and compressed keyframe sequences");
+    IO::Log::Blank();
+
+    Benchmark(*timer, 60, 30*60*2);
+    Benchmark(*timer, 120, 30*60*5);
+
+    }
+    #endif
+
+    IO::Console::Wait();
+
+    return 0;
+}
@@ -0,0 +1,193 @@
+// ForkENGINE: MIPChain Test
+// 17/10/2026
+
+#include "../TestUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+using namespace Fork;
+
+typedef Video::MIPChainBuilder::Filters Filters;
+typedef Video::ImageUByte::SizeType SizeType;
+
+static std::string FilterName(const Filters filter)
+{
+    switch (filter)
+    {
+        case Filters::Box:      return "Box";
+        case Filters::Kaiser:   return "Kaiser";
+        case Filters::Lanczos:  return "Lanczos";
+    }
+    return "";
+}
+
+//! Returns the fraction of pixels, which pass the alpha test with the specified reference value.
+static float AlphaCoverage(const Video::ImageUByte& image, float alphaReference)
+{
+    const auto numPixels = image.NumPixels();
+    const auto buffer = image.RawBuffer();
+
+    size_t numCovered = 0;
+
+    for (size_t i = 0; i < numPixels; ++i)
+    {
+        if (static_cast<float>(buffer[i*4 + 3]) / 255.0f > alphaReference)
+            ++numCovered;
+    }
+
+    return static_cast<float>(numCovered) / numPixels;
+}
+
+int main()
+{
+    IO::Log::AddDefaultEventHandler();
+
+    #if 1//!MIP CHAIN TEST!
+    {
+
+    using namespace Video;
+
+    const Filters filters[] = { Filters::Box, Filters::Kaiser, Filters::Lanczos };
+
+    /* Check the chain sizes and that a constant image remains constant with each filter */
+    ImageUByte constantImage(SizeType(512, 128, 1), ImageColorFormats::RGBA);
+
+    for (size_t i = 0, n = constantImage.NumPixels()*4; i < n; ++i)
+        constantImage.RawBuffer()[i] = static_cast<unsigned char>(i % 4 == 3 ? 200 : 60 + (i % 4)*40);
+
+    for (auto filter : filters)
+    {
+        MIPChainBuilder::Description desc;
+        desc.filter = filter;
+
+        auto mipChain = MIPChainBuilder::BuildMIPChain(constantImage, desc);
+
+        bool sizesValid = (mipChain.size() == 10 && mipChain.back()->GetSize() == SizeType(1, 1, 1));
+        int maxDiff = 0;
+
+        for (size_t level = 1; level < mipChain.size(); ++level)
+        {
+            const auto& image = *mipChain[level];
+            const auto& prevSize = mipChain[level - 1]->GetSize();
+
+            if (image.GetSize() != SizeType(std::max(size_t(1), prevSize.width/2), std::max(size_t(1), prevSize.height/2), 1))
+                sizesValid = false;
+
+            for (size_t i = 0, n = image.NumPixels()*4; i < n; ++i)
+                maxDiff = std::max(maxDiff, std::abs(static_cast<int>(image.RawBuffer()[i]) - static_cast<int>(constantImage.RawBuffer()[i % 4])));
+        }
+
+        IO::Log::Message(
+            FilterName(filter) + ": " + ToStr(mipChain.size()) + " MIP levels" + (sizesValid ? "" : " (INVALID SIZES)") +
+            ", max. difference on a constant image = " + ToStr(maxDiff) + (maxDiff <= 1 ? " (passed)" : " (FAILED)")
+        );
+    }
+
+    IO::Log::Blank();
+
+    /* Downsample a black/white checkerboard, which must average to 0.5 in linear space (away from the clamped borders) */
+    ImageUByte checkerImage(SizeType(256, 256, 1), ImageColorFormats::RGBA);
+
+    for (size_t y = 0; y < 256; ++y)
+    {
+        for (size_t x = 0; x < 256; ++x)
+        {
+            auto pixel = checkerImage.RawBuffer() + (y*256 + x)*4;
+            pixel[0] = pixel[1] = pixel[2] = static_cast<unsigned char>((x + y) % 2 == 0 ? 255 : 0);
+            pixel[3] = 255;
+        }
+    }
+
+    for (auto filter : filters)
+    {
+        MIPChainBuilder::Description desc;
+        desc.filter = filter;
+        desc.maxNumLevels = 2;
+
+        const size_t centerPixel = (64*128 + 64)*4;
+
+        const auto linearValue = static_cast<int>(MIPChainBuilder::BuildMIPChain(checkerImage, desc)[1]->RawBuffer()[centerPixel]);
+
+        desc.sRGB = true;
+        const auto sRGBValue = static_cast<int>(MIPChainBuilder::BuildMIPChain(checkerImage, desc)[1]->RawBuffer()[centerPixel]);
+
+        IO::Log::Message(
+            FilterName(filter) + " checkerboard: linear = " + ToStr(linearValue) + " (expected 128), sRGB = " + ToStr(sRGBValue) + " (expected 188)" +
+            (std::abs(linearValue - 128) <= 1 && std::abs(sRGBValue - 188) <= 1 ? " (passed)" : " (FAILED)")
+        );
+    }
+
+    IO::Log::Blank();
+
+    /* Downsample a cutout texture (30% opaque pixels) with and without the alpha coverage correction */
+    ImageUByte cutoutImage(SizeType(256, 256, 1), ImageColorFormats::RGBA);
+
+    for (size_t i = 0, n = cutoutImage.NumPixels(); i < n; ++i)
+    {
+        auto pixel = cutoutImage.RawBuffer() + i*4;
+        pixel[0] = static_cast<unsigned char>(std::rand() % 256);
+        pixel[1] = static_cast<unsigned char>(std::rand() % 256);
+        pixel[2] = static_cast<unsigned char>(std::rand() % 256);
+        pixel[3] = static_cast<unsigned char>(std::rand() % 100 < 30 ? 255 : 0);
+    }
+
+    const auto baseCoverage = AlphaCoverage(cutoutImage, 0.5f);
+
+    for (int preserve = 0; preserve < 2; ++preserve)
+    {
+        MIPChainBuilder::Description desc;
+        desc.preserveAlphaCoverage = (preserve != 0);
+
+        auto mipChain = MIPChainBuilder::BuildMIPChain(cutoutImage, desc);
+
+        /* Ignore the last levels, which have too few pixels to match the coverage */
+        float maxDeviation = 0.0f;
+
+        for (size_t level = 1; level + 3 < mipChain.size(); ++level)
+            maxDeviation = std::max(maxDeviation, std::abs(AlphaCoverage(*mipChain[level], 0.5f) - baseCoverage));
+
+        IO::Log::Message(
+            std::string(preserve ? "With" : "Without") + " alpha coverage correction: base coverage = " + ToStr(baseCoverage, 3) +
+            ", max. deviation up to 16x16 = " + ToStr(maxDeviation, 3) +
+            (preserve ? (maxDeviation < 0.05f ? " (passed)" : " (FAILED)") : "")
+        );
+    }
+
+    IO::Log::Blank();
+
+    /* Benchmark the MIP chain of a 2048 x 2048 texture */
+    auto timer = Platform::Timer::Create();
+
+    ImageUByte largeImage(SizeType(2048, 2048, 1), ImageColorFormats::RGBA);
+
+    for (size_t i = 0, n = largeImage.NumPixels()*4; i < n; ++i)
+        largeImage.RawBuffer()[i] = static_cast<unsigned char>(std::rand() % 256);
+
+    for (auto filter : filters)
+    {
+        MIPChainBuilder::Description desc;
+        desc.filter = filter;
+
+        auto time = Measure(*timer, [&]() { MIPChainBuilder::BuildMIPChain(largeImage, desc); });
+
+        desc.sRGB = true;
+        desc.preserveAlphaCoverage = true;
+
+        auto sRGBCoverageTime = Measure(*timer, [&]() { MIPChainBuilder::BuildMIPChain(largeImage, desc); });
+
+        IO::Log::Message(
+            FilterName(filter) + " MIP chain of 2048 x 2048 RGBA image: " + ToStr(time, 2) +
+            " ms, with sRGB and alpha coverage = " + ToStr(sRGBCoverageTime, 2) + " ms"
+        );
+    }
+
+    }
+    #endif
+
+    IO::Console::Wait();
+
+    return 0;
+}
@@ -0,0 +1,235 @@
+// ForkENGINE: MorphTarget Test
+// 17/10/2026
+
+#include "../TestUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace Fork;
+
+//! Generates a UV sphere as stand-in for a head mesh.
+static void GenerateHeadMesh(Scene::Simple3DMeshGeometry& mesh, size_t rings, size_t segments)
+{
+    const float pi = 3.14159265f;
+
+    for (size_t r = 0; r <= rings; ++r)
+    {
+        const auto theta = static_cast<float>(r) / rings * pi;
+
+        for (size_t s = 0; s <= segments; ++s)
+        {
+            const auto phi = static_cast<float>(s) / segments * pi * 2.0f;
+            const Math::Vector3f normal { std::sin(theta)*std::cos(phi), std::cos(theta), std::sin(theta)*std::sin(phi) };
+            mesh.AddVertex(Video::Simple3DVertex(normal * 0.1f, normal, { static_cast<float>(s) / segments, static_cast<float>(r) / rings }));
+        }
+    }
+}
+
+/*
+Generates a sparse morph target for a local region of the head (like a facial blend shape).
+The dense deltas (one for each vertex) are returned for the reference implementation.
+*/
+static void GenerateTarget(
+    Anim::MorphTargetAnimation& anim, const Scene::Simple3DMeshGeometry& mesh, size_t index,
+    std::vector<Math::Vector3f>& densePositionDeltas, std::vector<Math::Vector3f>& denseNormalDeltas)
+{
+    const auto numVertices = mesh.vertices.size();
+
+    Math::Vector3f center { Random(), Random(), Random() };
+    center.Normalize();
+
+    std::vector<unsigned int> indices;
+    std::vector<Math::Vector3f> positionDeltas, normalDeltas;
+
+    densePositionDeltas.assign(numVertices, Math::Vector3f());
+    denseNormalDeltas.assign(numVertices, Math::Vector3f());
+
+    for (size_t i = 0; i < numVertices; ++i)
+    {
+        const auto& normal = mesh.vertices[i].normal;
+        const auto dist = (normal - center).Length();
+
+        if (dist < 0.35f)
+        {
+            const auto falloff = 1.0f - dist / 0.35f;
+            const auto positionDelta = normal * (falloff * 0.01f);
+            const auto normalDelta = Math::Vector3f(center.x - normal.x, center.y - normal.y, center.z - normal.z) * (falloff * 0.2f);
+
+            indices.push_back(static_cast<unsigned int>(i));
+            positionDeltas.push_back(positionDelta);
+            normalDeltas.push_back(normalDelta);
+
+            densePositionDeltas[i] = positionDelta;
+            denseNormalDeltas[i] = normalDelta;
+        }
+    }
+
+    anim.AddTarget("Target" + ToStr(index), indices, positionDeltas, normalDeltas);
+}
+
+int main()
+{
+    IO::Log::AddDefaultEventHandler();
+
+    #if 1//!MORPH TARGET TEST!
+    {
+
+    const size_t numTargets = 50;
+    const size_t numKeyframes = 61;
+    const size_t numFrames = 60;
+    const double frameTime = 1.0/60.0;
+
+    auto timer = Platform::Timer::Create();
+
+    /* Create head mesh and morph targets */
+    Scene::Simple3DMeshGeometry mesh;
+    GenerateHeadMesh(mesh, 96, 128);
+
+    const auto numVertices = mesh.vertices.size();
+    const auto baseVertices = mesh.vertices;
+
+    Anim::MorphTargetAnimation anim;
+    anim.SetupVertexStream(mesh);
+
+    std::vector<std::vector<Math::Vector3f>> densePositionDeltas(numTargets), denseNormalDeltas(numTargets);
+    size_t numDeltas = 0;
+
+    for (size_t i = 0; i < numTargets; ++i)
+    {
+        GenerateTarget(anim, mesh, i, densePositionDeltas[i], denseNormalDeltas[i]);
+        numDeltas += anim.GetTarget(i).GetIndices().size();
+
+        /* Generate weight keyframes, most targets are inactive most of the time (like facial expressions) */
+        auto& keyframes = anim.GetTarget(i).weightKeyframes;
+        const auto phase = Random() * 3.0f;
+
+        for (size_t frame = 0; frame < numKeyframes; ++frame)
+            keyframes.push_back(std::max(0.0f, std::sin(phase + static_cast<float>(frame) * 0.3f) - 0.5f) * 2.0f);
+    }
+
+    IO::Log::Message(
+        "Head mesh with " + ToStr(numVertices) + " vertices and " + ToStr(numTargets) + " morph targets (" +
+        ToStr(numDeltas / numTargets) + " deltas per target on average)"
+    );
+
+    /* Compare sparse morph targets with the dense reference */
+    anim.playback.Play(0, numKeyframes - 1, 6.0);
+
+    std::vector<Math::Vector3f> referencePositions(numVertices), referenceNormals(numVertices);
+
+    auto ComputeReference = [&]()
+    {
+        for (size_t v = 0; v < numVertices; ++v)
+        {
+            auto position = baseVertices[v].coord;
+            auto normal = baseVertices[v].normal;
+
+            for (size_t i = 0; i < numTargets; ++i)
+            {
+                const auto weight = anim.GetTarget(i).weight;
+                position += densePositionDeltas[i][v] * weight;
+                normal += denseNormalDeltas[i][v] * weight;
+            }
+
+            referencePositions[v] = position;
+            referenceNormals[v] = normal.Normalize();
+        }
+    };
+
+    float maxDiff = 0.0f;
+    size_t numActiveTargets = 0, numDirtyVertices = 0;
+
+    for (size_t frame = 0; frame < numFrames; ++frame)
+    {
+        anim.Update(frameTime);
+        ComputeReference();
+
+        for (size_t v = 0; v < numVertices; ++v)
+        {
+            maxDiff = std::max(maxDiff, (mesh.vertices[v].coord - referencePositions[v]).Length());
+            maxDiff = std::max(maxDiff, (mesh.vertices[v].normal - referenceNormals[v]).Length());
+        }
+
+        for (size_t i = 0; i < numTargets; ++i)
+        {
+            if (anim.GetTarget(i).weight != 0.0f)
+                ++numActiveTargets;
+        }
+
+        for (const auto& range : anim.GetDirtyRanges())
+            numDirtyVertices += range.count;
+    }
+
+    IO::Log::Message(
+        "Max. difference to dense reference = " + ToStr(maxDiff) + (maxDiff < 0.0001f ? " (passed)" : " (FAILED)")
+    );
+    IO::Log::Message(
+        "Active targets per frame = " + ToStr(static_cast<double>(numActiveTargets) / numFrames, 1) + " of " + ToStr(numTargets) +
+        ", re-uploaded vertices per frame = " + ToStr(static_cast<double>(numDirtyVertices) / numFrames, 0) + " of " + ToStr(numVertices)
+    );
+
+    /* Applying the same weights again must not modify any vertex, and the bounding volume must fit the morphed mesh */
+    const bool unchangedApplied = anim.Apply();
+
+    const auto morphedBox = mesh.boundingVolume.box;
+    mesh.ComputeBoundingVolume();
+
+    const auto boxDiff = std::max((morphedBox.min - mesh.boundingVolume.box.min).Length(), (morphedBox.max - mesh.boundingVolume.box.max).Length());
+
+    IO::Log::Message(
+        "Unchanged weights: vertices modified = " + std::string(unchangedApplied ? "yes" : "no") +
+        ", bounding box difference = " + ToStr(boxDiff) + (!unchangedApplied && boxDiff < 0.0001f ? " (passed)" : " (FAILED)")
+    );
+
+    /* Benchmark one second of animation at 60 Hz */
+    anim.playback.Play(0, numKeyframes - 1, 6.0);
+
+    auto sparseTime = Measure(
+        *timer,
+        [&]()
+        {
+            for (size_t frame = 0; frame < numFrames; ++frame)
+                anim.Update(frameTime);
+        }
+    );
+
+    auto denseTime = Measure(
+        *timer,
+        [&]()
+        {
+            for (size_t frame = 0; frame < numFrames; ++frame)
+                ComputeReference();
+        }
+    );
+
+    IO::Log::Message(
+        "Per frame: sparse morph targets = " + ToStr(sparseTime / numFrames, 3) + " ms, dense reference = " +
+        ToStr(denseTime / numFrames, 3) + " ms (frame budget at 60 Hz = " + ToStr(frameTime * 1000.0, 2) + " ms)"
+    );
+
+    /* Clear all targets, which must reset the vertex stream to the base mesh */
+    anim.ClearTargets();
+
+    float baseDiff = 0.0f;
+
+    for (size_t v = 0; v < numVertices; ++v)
+    {
+        baseDiff = std::max(baseDiff, (mesh.vertices[v].coord - baseVertices[v].coord).Length());
+        baseDiff = std::max(baseDiff, (mesh.vertices[v].normal - baseVertices[v].normal).Length());
+    }
+
+    IO::Log::Message(
+        "After clearing the targets: max. difference to base mesh = " + ToStr(baseDiff) +
+        ", reset ranges = " + ToStr(anim.GetDirtyRanges().size()) + (baseDiff < 0.0001f ? " (passed)" : " (FAILED)")
+    );
+
+    }
+    #endif
+
+    IO::Console::Wait();
+
+    return 0;
+}
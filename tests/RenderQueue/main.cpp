@@ -0,0 +1,428 @@
+// ForkENGINE: Render Queue Test
+// 17/10/2026
+
+#include <fengine/core.h>
+#include <fengine/scene.h>
+#include <fengine/video.h>
+#include <fengine/using.h>
+
+#include <random>
+#include <set>
+#include <tuple>
+
+using namespace Fork;
+
+/*
+Command dispatcher which only counts the commands, and validates that the bound states
+match the draw packets. The resource pointers are never dereferenced, so no GPU is required.
+*/
+class CountingDispatcher : public Scene::RenderQueue::CommandDispatcher
+{
+
+    public:
+
+        void BindShader(const Video::ShaderComposition* shaderComposition) override
+        {
+            shader = shaderComposition;
+            profilerModel.RecordShaderBinding();
+        }
+        void BindTexture(const Video::Texture* texture, unsigned int layer) override
+        {
+            textures[layer] = texture;
+            profilerModel.RecordTextureBinding();
+        }
+        void UnbindTexture(const Video::Texture* texture, unsigned int layer) override
+        {
+            textures[layer] = nullptr;
+        }
+        void BindVertexBuffer(Video::VertexBuffer* buffer) override
+        {
+            vertexBuffer = buffer;
+            profilerModel.RecordBufferBinding();
+        }
+        void BindIndexBuffer(Video::IndexBuffer* buffer) override
+        {
+            indexBuffer = buffer;
+            profilerModel.RecordBufferBinding();
+        }
+        void SetupDrawMode(const Video::GeometryPrimitives primitive) override
+        {
+        }
+        void SetupWorldMatrix(const Math::Matrix4f& worldMatrix, const Video::ShaderComposition* shaderComposition) override
+        {
+        }
+        void SetupInstanceData(const Math::Matrix4f* worldMatrices, unsigned int numInstances, const Video::ShaderComposition* shaderComposition) override
+        {
+            numInstanceMatrices += numInstances;
+        }
+        void Draw(unsigned int numVertices) override
+        {
+            ValidateState(1);
+            profilerModel.RecordDrawCall(numVertices / 3);
+        }
+        void DrawIndexed(unsigned int numIndices) override
+        {
+            ValidateState(1);
+            profilerModel.RecordDrawCall(numIndices / 3);
+        }
+        void DrawInstanced(unsigned int numVertices, unsigned int numInstances) override
+        {
+            ValidateState(numInstances);
+            profilerModel.RecordDrawCall(numVertices / 3 * numInstances);
+        }
+        void DrawInstancedIndexed(unsigned int numIndices, unsigned int numInstances) override
+        {
+            ValidateState(numInstances);
+            profilerModel.RecordDrawCall(numIndices / 3 * numInstances);
+        }
+
+        const Scene::RenderQueue*       queue               = nullptr;
+        size_t                          packetIndex         = 0;
+        size_t                          numErrors           = 0;
+        size_t                          numInstanceMatrices = 0;
+
+        const Video::ShaderComposition* shader          = nullptr;
+        const Video::Texture*           textures[Scene::DrawPacket::maxNumTextures] = { nullptr };
+        Video::VertexBuffer*            vertexBuffer    = nullptr;
+        Video::IndexBuffer*             indexBuffer     = nullptr;
+
+        Video::RendererProfilerModel    profilerModel;
+
+    private:
+
+        void ValidateState(unsigned int numInstances)
+        {
+            const auto& packet = queue->GetPacket(packetIndex);
+            packetIndex += numInstances;
+
+            auto packetShader = (numInstances > 1 ? packet.instancedShader : packet.shader);
+            if (!packetShader)
+                packetShader = queue->defaultShader;
+
+            bool valid = (shader == packetShader && vertexBuffer == packet.vertexBuffer);
+
+            if (packet.indexBuffer && indexBuffer != packet.indexBuffer)
+                valid = false;
+
+            for (unsigned int layer = 0; layer < packet.numTextures; ++layer)
+            {
+                if (textures[layer] != packet.textures[layer])
+                    valid = false;
+            }
+
+            if (!valid)
+                ++numErrors;
+        }
+
+};
+
+template <typename T> T* FakePointer(size_t id)
+{
+    return reinterpret_cast<T*>((id + 1) * 64);
+}
+
+int main()
+{
+    #if 1//!RENDER QUEUE TEST!
+    {
+
+    const size_t numPackets         = 100000;
+    const size_t numShaders         = 4;
+    const size_t numTextures        = 16;
+    const size_t numVertexBuffers   = 1024;
+
+    auto timer = Platform::Timer::Create();
+
+    /* Generate random draw packets */
+    std::mt19937 randomEngine;
+    std::uniform_int_distribution<size_t> shaderDist(0, numShaders - 1), textureDist(0, numTextures - 1), bufferDist(0, numVertexBuffers - 1);
+    std::uniform_real_distribution<float> depthDist(0.1f, 1000.0f);
+
+    std::vector<Scene::DrawPacket> packets(numPackets);
+
+    for (auto& packet : packets)
+    {
+        const auto bufferID = bufferDist(randomEngine);
+
+        /* Packets with shader ID 0 have no shader, i.e. they use the default shader of the queue */
+        const auto shaderID = shaderDist(randomEngine);
+
+        packet.shader       = (shaderID > 0 ? FakePointer<Video::ShaderComposition>(shaderID) : nullptr);
+        packet.textures[0]  = FakePointer<Video::Texture>(textureDist(randomEngine));
+        packet.numTextures  = 1;
+        packet.vertexBuffer = FakePointer<Video::VertexBuffer>(bufferID);
+        packet.indexBuffer  = FakePointer<Video::IndexBuffer>(bufferID);
+        packet.numIndices   = 36;
+        packet.depth        = depthDist(randomEngine);
+    }
+
+    Scene::RenderQueue queue;
+    queue.defaultShader = FakePointer<Video::ShaderComposition>(numShaders);
+
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        IO::Log::Message("Frame " + ToStr(frame) + ":");
+        IO::Log::ScopedIndent indent;
+
+        queue.Clear();
+
+        {
+            IO::ScopedLogTimer logTimer(*timer, "Record " + ToStr(numPackets) + " draw packets: ");
+            for (const auto& packet : packets)
+                queue.Push(packet);
+        }
+
+        /* Submit unsorted queue */
+        CountingDispatcher unsortedDispatcher;
+        unsortedDispatcher.queue = &queue;
+        queue.Submit(unsortedDispatcher, &unsortedDispatcher.profilerModel);
+
+        /* Sort and submit queue */
+        {
+            IO::ScopedLogTimer logTimer(*timer, "Sort draw packets: ");
+            queue.Sort();
+        }
+
+        CountingDispatcher dispatcher;
+        dispatcher.queue = &queue;
+        {
+            IO::ScopedLogTimer logTimer(*timer, "Submit draw packets: ");
+            queue.Submit(dispatcher, &dispatcher.profilerModel);
+        }
+
+        /*
+        Validate the order of the sort keys and the depth (front-to-back) within equal states,
+        and that all packets with equal states are contiguous (i.e. the state IDs don't alias)
+        */
+        typedef std::tuple<const void*, const void*, const void*> StateTriple;
+
+        std::set<StateTriple> stateTriples;
+        size_t numOrderErrors = 0, numStateGroups = (queue.NumPackets() > 0 ? 1 : 0);
+
+        for (size_t i = 0; i < queue.NumPackets(); ++i)
+        {
+            const auto& packet = queue.GetPacket(i);
+            stateTriples.insert(StateTriple(packet.shader, packet.textures[0], packet.vertexBuffer));
+        }
+
+        for (size_t i = 1; i < queue.NumPackets(); ++i)
+        {
+            const auto& prev = queue.GetPacket(i - 1);
+            const auto& next = queue.GetPacket(i);
+
+            if (prev.shader != next.shader || prev.textures[0] != next.textures[0] || prev.vertexBuffer != next.vertexBuffer)
+                ++numStateGroups;
+
+            if (queue.GetSortKey(i - 1) > queue.GetSortKey(i))
+                ++numOrderErrors;
+            else if (prev.shader == next.shader && prev.textures[0] == next.textures[0] && prev.vertexBuffer == next.vertexBuffer)
+            {
+                /* Sort key only contains the upper 16 bits of the depth */
+                if ((FloatToOrderedBits(prev.depth) >> 16) > (FloatToOrderedBits(next.depth) >> 16))
+                    ++numOrderErrors;
+            }
+        }
+
+        const auto& unsortedModel   = unsortedDispatcher.profilerModel;
+        const auto& sortedModel     = dispatcher.profilerModel;
+
+        IO::Log::Message("Draw calls: " + ToStr(sortedModel.NumDrawCalls()) + " (expected " + ToStr(numPackets) + ")");
+        IO::Log::Message("Shader bindings: " + ToStr(unsortedModel.NumShaderBindings()) + " unsorted, " + ToStr(sortedModel.NumShaderBindings()) + " sorted (expected " + ToStr(numShaders) + ")");
+        IO::Log::Message("Texture bindings: " + ToStr(unsortedModel.NumTextureBindings()) + " unsorted, " + ToStr(sortedModel.NumTextureBindings()) + " sorted");
+        IO::Log::Message("Buffer bindings: " + ToStr(unsortedModel.NumBufferBindings()) + " unsorted, " + ToStr(sortedModel.NumBufferBindings()) + " sorted");
+        IO::Log::Message("Skipped bindings: " + ToStr(sortedModel.NumSkippedBindings()));
+        IO::Log::Message("State errors: " + ToStr(unsortedDispatcher.numErrors + dispatcher.numErrors) + " (expected 0)");
+        IO::Log::Message("Order errors: " + ToStr(numOrderErrors) + " (expected 0)");
+        IO::Log::Message("State groups: " + ToStr(numStateGroups) + " (expected " + ToStr(stateTriples.size()) + ")");
+    }
+
+    }
+    #endif
+
+    #if 1//!INSTANCE BATCHER TEST!
+    {
+
+    const size_t numGeometries  = 8;
+    const size_t numNodes       = 10000;
+
+    /* Generate draw packets of many geometry nodes, which share only a few geometries */
+    std::mt19937 randomEngine;
+    std::uniform_int_distribution<size_t> geometryDist(0, numGeometries - 1);
+    std::uniform_real_distribution<float> depthDist(0.1f, 1000.0f);
+
+    Scene::RenderQueue queue;
+
+    for (size_t i = 0; i < numNodes; ++i)
+    {
+        const auto geometryID = geometryDist(randomEngine);
+
+        Scene::DrawPacket packet;
+        {
+            packet.shader           = FakePointer<Video::ShaderComposition>(0);
+            packet.instancedShader  = FakePointer<Video::ShaderComposition>(1);
+            packet.vertexBuffer     = FakePointer<Video::VertexBuffer>(geometryID);
+            packet.indexBuffer      = FakePointer<Video::IndexBuffer>(geometryID);
+            packet.numIndices       = 36;
+            packet.depth            = depthDist(randomEngine);
+            packet.worldMatrix.SetPosition({ static_cast<float>(i), 0, 0 });
+        }
+        queue.Push(packet);
+    }
+
+    /* Add two nodes without instanced shader, which can not be batched */
+    Scene::DrawPacket singlePacket;
+    {
+        singlePacket.shader         = FakePointer<Video::ShaderComposition>(0);
+        singlePacket.vertexBuffer   = FakePointer<Video::VertexBuffer>(numGeometries);
+        singlePacket.numVertices    = 3;
+    }
+    queue.Push(singlePacket);
+    queue.Push(singlePacket);
+
+    queue.Sort();
+
+    /* Build instance batches */
+    Scene::InstanceBatcher batcher;
+    batcher.maxNumInstances = 1024;
+    batcher.Build(queue);
+
+    /* Validate that the instance matrices are in the same order as the packets */
+    size_t numMatrixErrors = 0;
+
+    for (const auto& batch : batcher.GetBatches())
+    {
+        if (batch.numInstances > 1)
+        {
+            for (unsigned int i = 0; i < batch.numInstances; ++i)
+            {
+                const auto& matrix = batcher.GetInstanceMatrices()[batch.firstInstance + i];
+                if (matrix.GetPosition().x != queue.GetPacket(batch.firstPacket + i).worldMatrix.GetPosition().x)
+                    ++numMatrixErrors;
+            }
+        }
+    }
+
+    CountingDispatcher dispatcher;
+    dispatcher.queue = &queue;
+    queue.Submit(dispatcher, batcher, &dispatcher.profilerModel);
+
+    const auto& model = dispatcher.profilerModel;
+
+    IO::Log::Message("Instance batches: " + ToStr(batcher.NumDrawCalls()) + " for " + ToStr(queue.NumPackets()) + " draw packets");
+    IO::Log::Message("Draw calls: " + ToStr(model.NumDrawCalls()) + ", batched draw calls: " + ToStr(model.NumBatchedDrawCalls()));
+    IO::Log::Message("Drawn packets: " + ToStr(dispatcher.packetIndex) + " (expected " + ToStr(queue.NumPackets()) + ")");
+    IO::Log::Message("Instance matrices: " + ToStr(dispatcher.numInstanceMatrices) + " (expected " + ToStr(numNodes) + ")");
+    IO::Log::Message("State errors: " + ToStr(dispatcher.numErrors) + " (expected 0)");
+    IO::Log::Message("Matrix errors: " + ToStr(numMatrixErrors) + " (expected 0)");
+
+    }
+    #endif
+
+    #if 1//!LOD SELECTOR TEST!
+    {
+
+    /* Generate LOD geometry with four (empty) levels */
+    Scene::LODGeometry lodGeometry;
+
+    for (int i = 0; i < 4; ++i)
+        lodGeometry.lodGeometries.push_back(std::make_shared<Scene::CompositionGeometry>());
+
+    lodGeometry.lodDistances = { 10.0f, 20.0f, 40.0f };
+    lodGeometry.boundingVolume.SetupSphere({ 1.0f, {} });
+
+    /* Setup selector with the reference view and a low resolution shadow map view */
+    Scene::Projection cameraProj, shadowMapProj;
+
+    cameraProj.SetViewport({ {}, { 1024, 768 } });
+    cameraProj.SetFOV(1.29154f);
+
+    shadowMapProj.SetViewport({ {}, { 256, 256 } });
+    shadowMapProj.SetFOV(1.29154f);
+
+    Scene::LODSelector selector;
+    Math::Matrix4f worldMatrix;
+
+    const int camera = 0, shadowMap = 1;
+
+    /* Move camera back and forth around the second switch distance and count the level switches */
+    size_t numSwitches = 0, prevLevel = 0, shadowMapLevel = 0;
+
+    for (int frame = 0; frame < 100; ++frame)
+    {
+        const auto distance = 20.0f + (frame % 2 == 0 ? -1.0f : 1.0f);
+
+        selector.SetupView(&camera, { 0, 0, -distance }, cameraProj);
+        const auto level = selector.SelectLevel(lodGeometry, &worldMatrix, worldMatrix);
+
+        /* Render the same geometry into the shadow map, which must not reset the camera's selection */
+        selector.SetupView(&shadowMap, { 0, 0, -distance }, shadowMapProj);
+        shadowMapLevel = selector.SelectLevel(lodGeometry, &worldMatrix, worldMatrix);
+
+        if (frame > 0 && level != prevLevel)
+            ++numSwitches;
+        prevLevel = level;
+    }
+
+    IO::Log::Message("Level switches within hysteresis band: " + ToStr(numSwitches) + " (expected 0)");
+    IO::Log::Message("Shadow map level: " + ToStr(shadowMapLevel) + " (expected 3)");
+
+    /* Cube map projections only have a 1x1 viewport for the aspect ratio, so the face size is passed explicitly */
+    Scene::Projection cubeMapProj;
+
+    cubeMapProj.SetViewport({ {}, { 1, 1 } });
+    cubeMapProj.SetFOV(90.0f * Math::deg2rad);
+
+    const int cubeMap = 2;
+    selector.SetupView(&cubeMap, { 0, 0, -5.0f }, cubeMapProj, 768);
+
+    IO::Log::Message("Cube map level: " + ToStr(selector.SelectLevel(lodGeometry, &worldMatrix, worldMatrix)) + " (expected 0)");
+
+    /* Select levels of many instances in a single batched pass */
+    std::vector<Scene::LODRequest> requests(10000);
+
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        auto& req = requests[i];
+        req.geometry = &lodGeometry;
+        req.instance = &req;
+        req.worldMatrix.SetPosition({ 0, 0, static_cast<float>(i % 100) });
+    }
+
+    selector.SetupView(&camera, {}, cameraProj);
+    selector.SelectLevels(requests);
+
+    size_t numLevelErrors = 0;
+
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        if (requests[i].level != lodGeometry.SelectLODIndex(static_cast<float>(i % 100)))
+            ++numLevelErrors;
+    }
+
+    IO::Log::Message("Batched selection errors: " + ToStr(numLevelErrors) + " (expected 0)");
+    IO::Log::Message("Selection states: " + ToStr(selector.NumStates()) + " (expected " + ToStr(requests.size() + 3) + ")");
+
+    /* Release the states of a destroyed instance and a destroyed view */
+    selector.ReleaseInstance(&requests[0]);
+    selector.ReleaseView(&shadowMap);
+
+    IO::Log::Message("Selection states after release: " + ToStr(selector.NumStates()) + " (expected " + ToStr(requests.size() + 1) + ")");
+
+    /* Views and instances, which are no longer used, are released automatically */
+    selector.maxStateAge = 10;
+
+    for (int frame = 0; frame < 20; ++frame)
+    {
+        selector.SetupView(&camera, { 0, 0, -5.0f }, cameraProj);
+        selector.SelectLevel(lodGeometry, &worldMatrix, worldMatrix);
+    }
+
+    IO::Log::Message("Selection states after 20 frames with a single instance: " + ToStr(selector.NumStates()) + " (expected 1)");
+
+    }
+    #endif
+
+    IO::Console::Wait();
+
+    return 0;
+}
@@ -633,7 +633,7 @@ void SSCTTest::CreateScene()
 
     auto worldNode = Scene::LoadMesh(
         sceneManager, sceneGraph, modelFilename + ".obj",
-        (Scene::ModelReader::Flags::OptimizeGeometryGraph | Scene::ModelReader::Flags::GenerateTangentSpace)
+        (Scene::ModelReader::Flags::OptimizeGeometryGraph | Scene::ModelReader::Flags::GenerateTangentSpace | Scene::ModelReader::Flags::CookedCache)
     );
 
     worldNode->transform.SetScale(Math::Vector3f(0.01f));
@@ -650,7 +650,7 @@ void SSCTTest::CreateScene()
 
     auto worldNode = Scene::LoadMesh(
         sceneManager, sceneGraph, modelFilename + ".obj",
-        (Scene::ModelReader::Flags::OptimizeGeometryGraph | Scene::ModelReader::Flags::GenerateTangentSpace)
+        (Scene::ModelReader::Flags::OptimizeGeometryGraph | Scene::ModelReader::Flags::GenerateTangentSpace | Scene::ModelReader::Flags::CookedCache)
     );
 
     auto worldWindowsNode = Scene::LoadMesh(
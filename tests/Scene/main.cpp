@@ -264,6 +264,13 @@ int main()
         auto obj1 = sceneMngr.CreateGeometryNode(sceneMngr.GenerateIcoSphere());
         sceneGraph.AddChild(obj1);
 
+        // Load model asynchronously (its GPU resources are committed in the main loop)
+        auto asyncMdl = sceneMngr.LoadGeometryAsync(mdlFile, Scene::ModelReader::Flags::OptimizeGeometryGraph);
+
+        auto asyncMdlNode = sceneMngr.CreateGeometryNode();
+        asyncMdlNode->transform.SetPosition({ 5, 0, 5 });
+        sceneGraph.AddChild(asyncMdlNode);
+
         // Get frame
         auto frame = renderContext->GetFrame();
         renderContext->SetupClearColor(Video::ColorRGBub(20, 40, 100).Cast<float>());
@@ -399,6 +406,12 @@ int main()
         // Main loop
         while (frame->ReceiveEvents() && !KEY_DOWN(Escape))
         {
+            // Commit asynchronous loads (upload at most 4 MB per frame)
+            sceneMngr.CommitAsyncLoads(4*1024*1024);
+
+            if (!asyncMdlNode->geometry && asyncMdl->IsReady())
+                asyncMdlNode->geometry = asyncMdl->Get();
+
             // Game logic
             if (KEY_HIT(F3))
                 term.Enable(!term.IsEnabled());
@@ -468,6 +481,25 @@ int main()
 
             #endif
 
+            // Update global transformations and bounding volume hierarchy once per frame
+            sceneGraph.UpdateGlobalTransforms();
+            sceneMngr.UpdateBoundingVolumeHierarchy();
+
+            #if 0 // BVH PICKING TEST
+
+            {
+                auto point = IO::Mouse::Instance()->GetFrameMousePosition().position.Cast<float>();
+                auto ray = camera.PickingRay(point);
+
+                std::vector<Scene::BoundingVolumeHierarchy::RayHit> hits;
+                sceneMngr.GetBoundingVolumeHierarchy().QueryRay(ray, hits);
+
+                if (!hits.empty())
+                    IO::Log::Message("Picked node at distance " + ToStr(hits.front().distance));
+            }
+
+            #endif
+
             // Rendering
             renderContext->ClearBuffers();
             {
@@ -0,0 +1,197 @@
+// ForkENGINE: SkeletonPose Test
+// 17/10/2026
+
+#include "../TestUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace Fork;
+
+typedef Scene::Skeleton::Joint Joint;
+
+//! Animates the joints with random local transformations.
+static void AnimateJoints(const std::vector<Joint*>& joints)
+{
+    for (auto joint : joints)
+    {
+        joint->transform.SetRotation(Math::Quaternionf(Random(), Random(), Random()));
+        joint->transform.SetScale({ 1.0f + Random()*0.1f, 1.0f, 1.0f + Random()*0.1f });
+    }
+}
+
+//! Generates a clip with random rotation keyframes for all joints.
+static Anim::SkeletalAnimationPtr GenerateClip(
+    const Scene::SkeletonPtr& skeleton, const Scene::FlatSkeleton& flatSkeleton,
+    const std::vector<Joint*>& joints, size_t numKeyframes)
+{
+    auto anim = std::make_shared<Anim::SkeletalAnimation>(skeleton);
+
+    for (auto joint : joints)
+    {
+        Anim::SkeletalAnimation::KeyframeJoint keyJoint(joint);
+
+        for (size_t frame = 0; frame < numKeyframes; ++frame)
+        {
+            auto transform = joint->transform;
+            transform.SetRotation(Math::Quaternionf(Random(), Random(), Random()));
+            keyJoint.keyframeSequence.AddTransform(frame, transform);
+        }
+
+        keyJoint.keyframeSequence.BuildKeyframes();
+        anim->keyframeJoints.push_back(keyJoint);
+    }
+
+    anim->SetupJointIndices(flatSkeleton);
+    anim->playback.Play(0, numKeyframes - 1, 6.0);
+
+    return anim;
+}
+
+int main()
+{
+    IO::Log::AddDefaultEventHandler();
+
+    #if 1//!SKELETON POSE TEST!
+    {
+
+    const size_t numJoints = 64;
+    const size_t numCharacters = 500;
+    const size_t numFrames = 10;
+    const size_t numKeyframes = 30;
+    const double frameTime = 1.0/60.0;
+
+    auto timer = Platform::Timer::Create();
+
+    /* Create skeleton and flat skeleton */
+    auto skeleton = std::make_shared<Scene::Skeleton>();
+
+    std::vector<Joint*> joints;
+    GenerateJoints(skeleton->rootJoint, 0, numJoints, joints);
+    skeleton->rootJoint.UpdateOriginMatrix();
+
+    auto flatSkeleton = std::make_shared<Scene::FlatSkeleton>(*skeleton);
+
+    /* Compare skinning matrices of the joint hierarchy and the skeleton pose */
+    AnimateJoints(joints);
+
+    Scene::SkeletonPose referencePose(flatSkeleton);
+    for (auto joint : joints)
+        referencePose.SetLocalTransform(flatSkeleton->FindJoint(joint), joint->transform);
+    referencePose.UpdateMatrices();
+
+    std::vector<Math::Matrix4f> matrices(skeleton->rootJoint.HierarchySize());
+    skeleton->rootJoint.FillMatrixBuffer(matrices.data(), matrices.size(), true, true);
+
+    float maxDiff = 0.0f;
+    for (size_t i = 0; i < matrices.size(); ++i)
+    {
+        for (size_t j = 0; j < 16; ++j)
+            maxDiff = std::max(maxDiff, std::abs(matrices[i].Ptr()[j] - referencePose.GetSkinMatrices()[i].Ptr()[j]));
+    }
+
+    IO::Log::Message("Skeleton with " + ToStr(flatSkeleton->NumJoints()) + " joints: max. difference to FillMatrixBuffer = " + ToStr(maxDiff));
+
+    /* Benchmark crowd update */
+    std::vector<Scene::SkeletonPosePtr> poses;
+    std::vector<Scene::SkeletonPose*> posePtrs;
+
+    for (size_t i = 0; i < numCharacters; ++i)
+    {
+        poses.push_back(std::make_shared<Scene::SkeletonPose>(flatSkeleton));
+        posePtrs.push_back(poses.back().get());
+    }
+
+    auto hierarchyTime = Measure(
+        *timer,
+        [&]()
+        {
+            for (size_t frame = 0; frame < numFrames; ++frame)
+            {
+                for (size_t i = 0; i < numCharacters; ++i)
+                {
+                    /* Mark all joints as modified, like an animation does */
+                    for (auto joint : joints)
+                        joint->transform.SetPosition(joint->transform.GetPosition());
+                    skeleton->rootJoint.FillMatrixBuffer(matrices.data(), matrices.size(), true, true);
+                }
+            }
+        }
+    );
+
+    auto serialTime = Measure(
+        *timer,
+        [&]()
+        {
+            for (size_t frame = 0; frame < numFrames; ++frame)
+            {
+                for (auto pose : posePtrs)
+                    pose->UpdateMatrices();
+            }
+        }
+    );
+
+    auto parallelTime = Measure(
+        *timer,
+        [&]()
+        {
+            for (size_t frame = 0; frame < numFrames; ++frame)
+                Scene::SkeletonPose::UpdateMatrices(posePtrs);
+        }
+    );
+
+    IO::Log::Message(
+        ToStr(numCharacters) + " characters (per frame): joint hierarchy = " + ToStr(hierarchyTime / numFrames, 2) +
+        " ms, skeleton poses = " + ToStr(serialTime / numFrames, 2) + " ms, skeleton poses (parallel) = " +
+        ToStr(parallelTime / numFrames, 2) + " ms"
+    );
+
+    /* Benchmark animated crowd update (keyframe sampling and matrices) */
+    std::vector<Anim::SkeletalAnimationPtr> clips;
+    std::vector<Anim::SkeletalAnimation*> clipPtrs;
+
+    for (size_t i = 0; i < numCharacters; ++i)
+    {
+        clips.push_back(GenerateClip(skeleton, *flatSkeleton, joints, numKeyframes));
+        clipPtrs.push_back(clips.back().get());
+    }
+
+    auto animatedSerialTime = Measure(
+        *timer,
+        [&]()
+        {
+            for (size_t frame = 0; frame < numFrames; ++frame)
+            {
+                for (size_t i = 0; i < numCharacters; ++i)
+                {
+                    clipPtrs[i]->UpdatePose(*posePtrs[i], frameTime);
+                    posePtrs[i]->UpdateMatrices();
+                }
+            }
+        }
+    );
+
+    auto animatedParallelTime = Measure(
+        *timer,
+        [&]()
+        {
+            for (size_t frame = 0; frame < numFrames; ++frame)
+                Anim::SkeletalAnimation::UpdatePoses(clipPtrs, posePtrs, frameTime);
+        }
+    );
+
+    IO::Log::Message(
+        ToStr(numCharacters) + " animated characters (per frame): skeletal animations = " + ToStr(animatedSerialTime / numFrames, 2) +
+        " ms, skeletal animations (parallel) = " + ToStr(animatedParallelTime / numFrames, 2) + " ms"
+    );
+
+    }
+    #endif
+
+    IO::Console::Wait();
+
+    return 0;
+}
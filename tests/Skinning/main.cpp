@@ -0,0 +1,172 @@
+// ForkENGINE: Skinning Test
+// 17/10/2026
+
+#include "../TestUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace Fork;
+
+typedef Scene::Skeleton::Joint Joint;
+
+//! Generates a random mesh with up to three joint influences per vertex (stored joint-major in the joints).
+static void GenerateSkinnedMesh(Scene::Simple3DMeshGeometry& mesh, size_t numVertices, const std::vector<Joint*>& joints)
+{
+    for (size_t i = 0; i < numVertices; ++i)
+    {
+        Math::Vector3f normal { Random(), Random(), Random() };
+        normal.Normalize();
+        mesh.AddVertex(Video::Simple3DVertex({ Random()*5.0f, Random()*5.0f, Random()*5.0f }, normal, { 0, 0 }));
+
+        const auto numInfluences = static_cast<size_t>(std::rand() % 3) + 1;
+        const auto firstJoint = static_cast<size_t>(std::rand()) % joints.size();
+
+        for (size_t k = 0; k < numInfluences; ++k)
+        {
+            const auto weight = 0.1f + static_cast<float>(std::rand() % 100) / 100.0f;
+            joints[(firstJoint + k) % joints.size()]->weights.push_back({ static_cast<unsigned int>(i), weight });
+        }
+    }
+}
+
+int main()
+{
+    IO::Log::AddDefaultEventHandler();
+
+    #if 1//!SKINNING TEST!
+    {
+
+    const size_t numJoints = 64;
+    const size_t numVertices = 200000;
+    const size_t numFrames = 10;
+
+    auto timer = Platform::Timer::Create();
+
+    /* Create skeleton, skinned mesh and skin weights */
+    auto skeleton = std::make_shared<Scene::Skeleton>();
+
+    std::vector<Joint*> joints;
+    GenerateJoints(skeleton->rootJoint, 0, numJoints, joints);
+    skeleton->rootJoint.UpdateOriginMatrix();
+
+    Scene::Simple3DMeshGeometry mesh;
+    GenerateSkinnedMesh(mesh, numVertices, joints);
+
+    const auto bindVertices = mesh.vertices;
+
+    auto flatSkeleton = std::make_shared<Scene::FlatSkeleton>(*skeleton);
+    Scene::SkinWeights skinWeights(*flatSkeleton, numVertices);
+
+    /* Animate skeleton pose */
+    Scene::SkeletonPose pose(flatSkeleton);
+
+    for (auto joint : joints)
+    {
+        auto transform = joint->transform;
+        transform.SetRotation(Math::Quaternionf(Random(), Random(), Random()));
+        pose.SetLocalTransform(flatSkeleton->FindJoint(joint), transform);
+    }
+
+    pose.UpdateMatrices();
+
+    /* Compare vertex-major SIMD skinning with the joint-major scalar reference */
+    skinWeights.SkinMesh(pose, bindVertices, mesh);
+
+    const auto& skinMatrices = pose.GetSkinMatrices();
+
+    std::vector<Math::Vector3f> referencePositions(numVertices), referenceNormals(numVertices);
+    std::vector<float> weightSums(numVertices, 0.0f);
+
+    for (auto joint : joints)
+    {
+        for (const auto& vertexWeight : joint->weights)
+            weightSums[vertexWeight.index] += vertexWeight.weight;
+    }
+
+    for (auto joint : joints)
+    {
+        const auto& matrix = skinMatrices[flatSkeleton->FindJoint(joint)];
+
+        for (const auto& vertexWeight : joint->weights)
+        {
+            const auto v = vertexWeight.index;
+            const auto weight = vertexWeight.weight / weightSums[v];
+            const auto& vertex = bindVertices[v];
+
+            referencePositions[v] += (matrix * vertex.coord) * weight;
+            referenceNormals[v] += matrix.RotateVector(vertex.normal) * weight;
+        }
+    }
+
+    Math::AABB3f referenceBox;
+    float maxDiff = 0.0f;
+
+    for (size_t v = 0; v < numVertices; ++v)
+    {
+        referenceNormals[v].Normalize();
+        referenceBox.InsertPoint(referencePositions[v]);
+
+        maxDiff = std::max(maxDiff, (mesh.vertices[v].coord - referencePositions[v]).Length());
+        maxDiff = std::max(maxDiff, (mesh.vertices[v].normal - referenceNormals[v]).Length());
+    }
+
+    maxDiff = std::max(maxDiff, (mesh.boundingVolume.box.min - referenceBox.min).Length());
+    maxDiff = std::max(maxDiff, (mesh.boundingVolume.box.max - referenceBox.max).Length());
+
+    IO::Log::Message(
+        "Skinned mesh with " + ToStr(numVertices) + " vertices and " + ToStr(flatSkeleton->NumJoints()) +
+        " joints: max. difference to joint-major reference = " + ToStr(maxDiff) + (maxDiff < 0.001f ? " (passed)" : " (FAILED)")
+    );
+
+    /* Benchmark skinning into a plain array */
+    std::vector<Math::Vector3f> positions(numVertices), normals(numVertices);
+
+    const Video::AttributeConstIterator srcPositions(&(bindVertices[0].coord), numVertices, sizeof(Video::Simple3DVertex));
+    const Video::AttributeConstIterator srcNormals(&(bindVertices[0].normal), numVertices, sizeof(Video::Simple3DVertex));
+    const Video::AttributeIterator dstPositions(positions.data(), numVertices, sizeof(Math::Vector3f));
+    const Video::AttributeIterator dstNormals(normals.data(), numVertices, sizeof(Math::Vector3f));
+
+    auto referenceTime = Measure(
+        *timer,
+        [&]()
+        {
+            for (size_t frame = 0; frame < numFrames; ++frame)
+            {
+                std::fill(positions.begin(), positions.end(), Math::Vector3f());
+                for (auto joint : joints)
+                {
+                    const auto& matrix = skinMatrices[flatSkeleton->FindJoint(joint)];
+                    for (const auto& vertexWeight : joint->weights)
+                        positions[vertexWeight.index] += (matrix * bindVertices[vertexWeight.index].coord) * (vertexWeight.weight / weightSums[vertexWeight.index]);
+                }
+            }
+        }
+    );
+
+    Scene::BoundingVolume boundingVolume;
+
+    auto skinTime = Measure(
+        *timer,
+        [&]()
+        {
+            for (size_t frame = 0; frame < numFrames; ++frame)
+                skinWeights.Skin(pose, srcPositions, &srcNormals, dstPositions, &dstNormals, &boundingVolume);
+        }
+    );
+
+    IO::Log::Message(
+        "Per frame: joint-major reference (positions only) = " + ToStr(referenceTime / numFrames, 2) +
+        " ms, vertex-major skinning (positions, normals and bounds) = " + ToStr(skinTime / numFrames, 2) + " ms"
+    );
+
+    }
+    #endif
+
+    IO::Console::Wait();
+
+    return 0;
+}
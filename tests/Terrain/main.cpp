@@ -0,0 +1,207 @@
+// ForkENGINE: Terrain Test
+// 17/10/2026
+
+#include <fengine/core.h>
+#include <fengine/scene.h>
+#include <fengine/using.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Fork;
+
+//! Returns the test height at the specified sample position.
+static float TestHeight(unsigned int x, unsigned int z)
+{
+    return std::sin(x*0.02f)*std::cos(z*0.013f) + std::sin(x*0.11f + z*0.07f)*0.3f;
+}
+
+int main()
+{
+    IO::Log::AddDefaultEventHandler();
+
+    #if 1//!CDLOD TERRAIN TEST!
+    {
+
+    const unsigned int heightFieldSize  = 1025;
+    const unsigned int tileSize         = 128;
+    const unsigned int leafNodeSize     = 32;
+
+    auto timer = Platform::Timer::Create();
+
+    /* Generate height field and write it into a tiled height file */
+    Video::ImageFloat heightField({ heightFieldSize, heightFieldSize, 1 }, Video::ImageColorFormats::Gray);
+
+    auto heights = heightField.RawBuffer();
+
+    for (unsigned int z = 0; z < heightFieldSize; ++z)
+    {
+        for (unsigned int x = 0; x < heightFieldSize; ++x)
+            heights[z*heightFieldSize + x] = TestHeight(x, z);
+    }
+
+    {
+        IO::ScopedLogTimer logTimer(*timer, "Write terrain tiles: ");
+        Scene::TerrainTileFile::WriteTiles("TerrainTiles.fth", heightField, tileSize);
+    }
+
+    /* Build quad-tree with a tile cache, which can only hold 8 tiles */
+    auto tileSource = std::make_shared<Scene::TerrainTileFile>("TerrainTiles.fth");
+    auto tileCache = std::make_shared<Scene::TerrainTileCache>(tileSource, 8*tileSize*tileSize*sizeof(float));
+
+    Scene::TerrainQuadTree::Description treeDesc;
+    {
+        treeDesc.leafNodeSize   = leafNodeSize;
+        treeDesc.numLODLevels   = 6;
+        treeDesc.detailDistance = 48.0f;
+        treeDesc.scale          = { 1.0f, 50.0f, 1.0f };
+    }
+
+    auto terrain = std::make_shared<Scene::TerrainGeometry>();
+    terrain->tileCache  = tileCache;
+    terrain->quadTree   = std::make_shared<Scene::TerrainQuadTree>();
+
+    {
+        IO::ScopedLogTimer logTimer(*timer, "Build terrain quad-tree: ");
+        terrain->quadTree->Build(*tileCache, treeDesc);
+    }
+
+    terrain->ComputeBoundingVolume();
+
+    const auto& quadTree = *terrain->quadTree;
+
+    IO::Log::Message("Loaded tiles: " + ToStr(tileCache->NumLoadedTiles()) + " (expected " + ToStr(tileSource->NumTiles().Area()) + ")");
+    IO::Log::Message("Resident tiles: " + ToStr(tileCache->NumResidentTiles()) + " (expected 8)");
+
+    /* Validate node bounds against the height field */
+    size_t numBoundErrors = 0;
+
+    for (unsigned int level = 0; level < quadTree.NumLODLevels(); ++level)
+    {
+        const auto numNodes = quadTree.NumNodes(level);
+        const auto nodeSize = leafNodeSize << level;
+
+        for (unsigned int nz = 0; nz < numNodes.height; ++nz)
+        {
+            for (unsigned int nx = 0; nx < numNodes.width; ++nx)
+            {
+                float minHeight = std::numeric_limits<float>::max(), maxHeight = std::numeric_limits<float>::lowest();
+
+                for (unsigned int z = nz*nodeSize; z <= std::min((nz + 1)*nodeSize, heightFieldSize - 1); ++z)
+                {
+                    for (unsigned int x = nx*nodeSize; x <= std::min((nx + 1)*nodeSize, heightFieldSize - 1); ++x)
+                    {
+                        minHeight = std::min(minHeight, heights[z*heightFieldSize + x]);
+                        maxHeight = std::max(maxHeight, heights[z*heightFieldSize + x]);
+                    }
+                }
+
+                const auto& bounds = quadTree.GetNodeBounds(level, nx, nz);
+                if (bounds.minHeight != minHeight || bounds.maxHeight != maxHeight)
+                    ++numBoundErrors;
+            }
+        }
+    }
+
+    const auto& box = terrain->boundingVolume.box;
+
+    IO::Log::Message("Node bound errors: " + ToStr(numBoundErrors) + " (expected 0)");
+    IO::Log::Message("Bounding box size: " + ToStr(box.max.x - box.min.x) + " x " + ToStr(box.max.z - box.min.z) + " (expected 1024 x 1024)");
+
+    /* Select nodes from several camera positions (looking along the Z axis) */
+    Scene::Projection projection;
+    projection.SetViewport({ {}, { 1024, 768 } });
+    projection.SetPlanes(0.1f, 10000.0f);
+
+    const auto numLeaves = quadTree.NumNodes(0).width;
+
+    size_t numOverlaps = 0, numLevelJumps = 0;
+
+    for (float cameraZ : { -200.0f, 100.0f, 500.0f })
+    {
+        const Math::Point3f cameraPos { 300.0f, 60.0f, cameraZ };
+
+        Math::Matrix4f viewMatrix;
+        viewMatrix.SetPosition(-cameraPos);
+
+        const Scene::ViewFrustum frustum(projection.GetMatrixLH() * viewMatrix);
+
+        std::vector<Scene::TerrainNodeSelection> selection;
+        terrain->SelectNodes(frustum, cameraPos, selection);
+
+        /* Rasterize the selected quadrants into the leaf node grid */
+        std::vector<int> leafLevels(numLeaves*numLeaves, -1);
+
+        for (const auto& node : selection)
+        {
+            const auto numCells = node.size / leafNodeSize;
+            const auto quadSize = std::max(1u, numCells / 2);
+
+            for (unsigned int i = 0; i < 4; ++i)
+            {
+                if ((node.quadrantMask & (1u << i)) == 0)
+                    continue;
+
+                const auto startX = node.origin.x / leafNodeSize + (numCells > 1 ? (i & 1)*quadSize : 0);
+                const auto startZ = node.origin.y / leafNodeSize + (numCells > 1 ? (i >> 1)*quadSize : 0);
+
+                for (auto z = startZ; z < std::min(startZ + quadSize, numLeaves); ++z)
+                {
+                    for (auto x = startX; x < std::min(startX + quadSize, numLeaves); ++x)
+                    {
+                        auto& leafLevel = leafLevels[z*numLeaves + x];
+                        if (leafLevel >= 0)
+                            ++numOverlaps;
+                        leafLevel = static_cast<int>(node.lodLevel);
+                    }
+                }
+
+                if (numCells == 1)
+                    break;
+            }
+        }
+
+        /* Adjacent nodes must not differ by more than one LOD level, otherwise the morphing can not close the cracks */
+        for (unsigned int z = 0; z < numLeaves; ++z)
+        {
+            for (unsigned int x = 0; x < numLeaves; ++x)
+            {
+                const auto level = leafLevels[z*numLeaves + x];
+                if (level < 0)
+                    continue;
+
+                if (x + 1 < numLeaves && leafLevels[z*numLeaves + x + 1] >= 0 && std::abs(level - leafLevels[z*numLeaves + x + 1]) > 1)
+                    ++numLevelJumps;
+                if (z + 1 < numLeaves && leafLevels[(z + 1)*numLeaves + x] >= 0 && std::abs(level - leafLevels[(z + 1)*numLeaves + x]) > 1)
+                    ++numLevelJumps;
+            }
+        }
+
+        IO::Log::Message("Selected nodes from Z = " + ToStr(cameraZ) + ": " + ToStr(selection.size()));
+    }
+
+    IO::Log::Message("Overlapping nodes: " + ToStr(numOverlaps) + " (expected 0)");
+    IO::Log::Message("LOD level jumps: " + ToStr(numLevelJumps) + " (expected 0)");
+
+    /* Fully morphed grid vertices must lie on the grid of the next lower level-of-detail */
+    size_t numMorphErrors = 0;
+
+    for (unsigned int i = 0; i <= leafNodeSize; ++i)
+    {
+        const auto pos = static_cast<float>(i) / leafNodeSize;
+        const auto morphed = Scene::TerrainQuadTree::MorphVertex({ pos, pos }, leafNodeSize, 1.0f);
+        const auto expected = static_cast<float>(i - i % 2) / leafNodeSize;
+
+        if (std::abs(morphed.x - expected) > Math::epsilon || std::abs(morphed.y - expected) > Math::epsilon)
+            ++numMorphErrors;
+    }
+
+    IO::Log::Message("Morph errors: " + ToStr(numMorphErrors) + " (expected 0)");
+
+    }
+    #endif
+
+    IO::Console::Wait();
+
+    return 0;
+}
@@ -10,5 +10,41 @@
 #include <fengine/using.h>
 #include <fengine/helper.h>
 
+#include <cstdlib>
+#include <vector>
+
+
+//! Measures the duration (in milliseconds) of the specified function.
+template <class Function> double Measure(Fork::Platform::Timer& timer, Function func)
+{
+    timer.Start();
+    func();
+    timer.Stop();
+    return timer.GetElapsedTime() / 1000.0;
+}
+
+//! Returns a pseudo random value in the range [-1, 1].
+inline float Random()
+{
+    return static_cast<float>(std::rand() % 2001) / 1000.0f - 1.0f;
+}
+
+//! Generates a humanoid-like joint hierarchy (a few branches near the root, then long chains).
+inline void GenerateJoints(
+    Fork::Scene::Skeleton::Joint& joint, size_t depth, size_t maxNumJoints, std::vector<Fork::Scene::Skeleton::Joint*>& joints)
+{
+    joints.push_back(&joint);
+
+    const size_t numChildren = (depth < 2 ? 3 : 1);
+
+    for (size_t i = 0; i < numChildren && joints.size() < maxNumJoints; ++i)
+    {
+        auto child = joint.CreateChild();
+        child->transform.SetPosition({ Random(), Random() + 1.0f, Random() });
+        child->transform.SetRotation(Fork::Math::Quaternionf(Random(), Random(), Random()));
+        GenerateJoints(*child, depth + 1, maxNumJoints, joints);
+    }
+}
+
 
 #endif